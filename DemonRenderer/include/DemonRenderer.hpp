@@ -4,13 +4,29 @@
 #include "core/layer.hpp"
 #include "core/log.hpp"
 #include "core/timer.hpp"
+#include "core/fixedTimestep.hpp"
 #include "core/physics.hpp"
+#include "core/benchmark.hpp"
+#include "core/resourceRegistry.hpp"
+#include "core/transformSystem.hpp"
+#include "core/spinSystem.hpp"
+#include "core/scriptSystem.hpp"
+#include "core/spatialSort.hpp"
+#include "core/commandBuffer.hpp"
+#include "core/jobSystem.hpp"
+#include "core/systemScheduler.hpp"
+#include "core/renderThread.hpp"
+#include "core/memoryResources.hpp"
+#include "core/allocationAudit.hpp"
+#include "core/memoryTracker.hpp"
+#include "core/gpuMemory.hpp"
 
 #include "assets/cubeMap.hpp"
 #include "assets/managedTexture.hpp"
 #include "assets/mesh.hpp"
 #include "assets/shader.hpp"
 #include "assets/texture.hpp"
+#include "assets/renderTarget.hpp"
 #include "assets/textureUnitManager.hpp"
 
 #include "buffers/FBO.hpp"
@@ -28,6 +44,8 @@
 #include "components/render.hpp"
 #include "components/script.hpp"
 #include "components/transform.hpp"
+#include "components/angularVelocity.hpp"
+#include "components/analyticSpin.hpp"
 #include "components/order.hpp"
 #include "components/colliders.hpp"
 #include "components/lodassign.hpp"
@@ -36,12 +54,18 @@
 #include "events/eventHandler.hpp"
 
 #include "rendering/camera.hpp"
+#include "rendering/clusteredLighting.hpp"
 #include "rendering/computePass.hpp"
 #include "rendering/depthOnlyPass.hpp"
+#include "rendering/gpuProfiler.hpp"
 #include "rendering/lights.hpp"
 #include "rendering/material.hpp"
+#include "rendering/particleSystem.hpp"
+#include "rendering/analyticAnimation.hpp"
 #include "rendering/renderer.hpp"
 #include "rendering/renderPass.hpp"
+#include "rendering/renderProxy.hpp"
+#include "rendering/renderSnapshot.hpp"
 #include "rendering/uniformDataTypes.hpp"
 
 #include "windows/GLFW_GL_GC.hpp"
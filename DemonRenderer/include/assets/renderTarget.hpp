@@ -0,0 +1,33 @@
+/** \file renderTarget.hpp */
+#pragma once
+#include <glad/gl.h>
+#include "assets/texture.hpp"
+
+/** \struct RenderTargetDescription
+*   \brief Size, sized internal format, mip level count and sample count of a render target.
+*/
+struct RenderTargetDescription
+{
+	uint32_t width{ 0 };
+	uint32_t height{ 0 };
+	uint32_t format{ GL_RGBA8 }; //!< Any sized internal format, e.g. GL_R11F_G11F_B10F or GL_DEPTH_COMPONENT32F
+	uint32_t levels{ 1 }; //!< Mip levels to allocate, these are never generated automatically
+	uint32_t samples{ 1 }; //!< Greater than one creates a multisampled texture
+};
+
+/** \class RenderTarget
+*   \brief A texture which is rendered to.
+*	Unlike a loaded Texture, storage is exactly what is described: no mip chain is forced on it and no mips are
+*	generated. It can be used anywhere a Texture can, e.g. as a material sampler or compute image.
+*/
+class RenderTarget : public Texture
+{
+public:
+	RenderTarget() = delete; //!< Deleted default constructor
+	explicit RenderTarget(const RenderTargetDescription& desc); //!< Constructor which takes a RenderTargetDescription
+	RenderTarget(RenderTarget& other) = delete; //!< Deleted copy constructor
+	RenderTarget(RenderTarget&& other) = delete; //!< Deleted move constructor
+	RenderTarget& operator=(RenderTarget& other) = delete; //!< Deleted copy assignment operator
+	RenderTarget& operator=(RenderTarget&& other) = delete; //!< Delete move assignment operator
+	inline bool isDepth() const noexcept { return m_channels == 0; } //!< Is this a depth and/or stencil target
+};
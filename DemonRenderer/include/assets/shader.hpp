@@ -79,6 +79,7 @@ private:
 	void dispatchUniform(uint32_t location, const glm::vec3& data) const; //!< Upload a vec3 uniform
 	void dispatchUniform(uint32_t location, const glm::vec4& data) const; //!< Upload a vec4 uniform
 	void dispatchUniform(uint32_t location, const glm::mat4& data) const; //!< Upload a mat4 uniform
+	void dispatchUniform(uint32_t location, const glm::mat3x4& data) const; //!< Upload a mat3x4 uniform, used for affine transforms stored as rows
 private:
 	ShaderType m_type{ShaderType::uninitailised}; //!< Type of the shader
 	uint32_t m_ID; //!< Device side ID of the shader program
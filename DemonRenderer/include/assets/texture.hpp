@@ -23,7 +23,6 @@ struct TextureDescription
 class Texture : public ManagedTexture
 {
 public:
-	Texture() = delete; //!< Deleted default constructor
 	explicit Texture(const char* filepath); //!< Constructor which takes a path to an image file to be loaded
 	explicit Texture(const TextureDescription& desc); //!< Constructor which takes a TextureDescription
 	Texture(Texture& other) = delete; //!< Deleted copy constructor
@@ -39,12 +38,20 @@ public:
 	inline uint32_t [[nodiscard]] getHeightf() noexcept { return static_cast<float>(m_height); } //!< Get the height in pixels as a floating point number
 	inline uint32_t [[nodiscard]] getChannels() noexcept { return m_channels; } //!< Get the number of channels in the texture
 	inline bool [[nodiscard]] isHDR() noexcept { return m_isHDR; } //!< Get whether or not the texture is high dynamic range
-	
-private:
+	inline uint32_t [[nodiscard]] getFormat() const noexcept { return m_format; } //!< Get the sized internal format
+	inline uint32_t [[nodiscard]] getLevels() const noexcept { return m_levels; } //!< Get the number of mip levels allocated
+	inline uint32_t [[nodiscard]] getSamples() const noexcept { return m_samples; } //!< Get the number of samples per pixel
+	uint64_t [[nodiscard]] getByteSize() const noexcept; //!< Get the device memory used by all levels and samples
+	static uint32_t getBytesPerPixel(uint32_t format) noexcept; //!< Bytes used by one pixel of a sized internal format
+protected:
+	Texture() = default; //!< Default constructor, required by subclasses which allocate their own storage
 	uint32_t m_width{ 0 }; //!< Width in pixels
 	uint32_t m_height{ 0 }; //!< Height in pixels
 	uint32_t m_channels{ 0 }; //!< Number of channels
 	bool m_isHDR{ false }; //!< Is the texture high dynamic range
+	uint32_t m_format{ 0 }; //!< Sized internal format
+	uint32_t m_levels{ 0 }; //!< Number of mip levels
+	uint32_t m_samples{ 1 }; //!< Samples per pixel
 private:
 	void init(uint32_t width, uint32_t height, uint32_t channels, unsigned char* data, bool isHDR); //!< Initialise the texture
 };
@@ -7,7 +7,7 @@
 
 #include "buffers/FBOlayout.hpp"
 #include "buffers/RBO.hpp"
-#include "assets/texture.hpp"
+#include "assets/renderTarget.hpp"
 #include "events/windowEvents.hpp"
 
 /** \class FBO
@@ -21,7 +21,7 @@ class FBO
 {
 public:
 	FBO() { m_ID = 0; }; // Default framebuffer
-	FBO(glm::ivec2 size, FBOLayout layout);
+	FBO(glm::ivec2 size, FBOLayout layout, uint32_t samples = 1); //!< Constructor which takes a size, layout and optionally a sample count
 	FBO(FBO& other) = delete; //!< Deleted copy constructor
 	FBO(FBO&& other) = delete; //!< Deleted move constructor
 	FBO& operator=(FBO& other) = delete; //!< Deleted copy assignment operator
@@ -31,12 +31,15 @@ public:
 	void onResize(WindowResizeEvent& e); // On resize function
 	uint32_t getID() { return m_ID; } //!< Get the API specific render ID
 	std::shared_ptr<Texture> getTarget(uint32_t index);
+	uint64_t getByteSize() const noexcept { return m_byteSize; } //!< Device memory used by all attachments
+	glm::ivec2 getSize() const noexcept { return m_size; } //!< Size of the framebuffer
 protected:	
 	FBOLayout m_layout; //! Layout of FBO attachements
-	std::vector<std::shared_ptr<Texture>> m_sampledTargets; //!< Sampled targets, colour or depth
+	std::vector<std::shared_ptr<RenderTarget>> m_sampledTargets; //!< Sampled targets, colour or depth
 	std::vector<std::shared_ptr<RBO>> m_nonSampledTargets; //!< Non sample targets
 	glm::ivec2 m_size{ glm::ivec2(0,0) }; //!< Size of the framebuffer
 	uint32_t m_ID{ 0 };
+	uint64_t m_byteSize{ 0 }; //!< Device memory used by all attachments
 private:
 	static uint32_t s_ID;
 
@@ -4,8 +4,9 @@
 #include <vector>
 
 /** \enum AttachmentType
-*	Possible attachments for a frame buffer */
-enum class AttachmentType { Colour, ColourHDR, Depth, Stencil, DepthAndStencil };
+*	Possible attachments for a frame buffer.
+*	ColourPackedHDR is a 32 bit R11G11B10F target for HDR colour which has no use for alpha */
+enum class AttachmentType { Colour, ColourHDR, ColourPackedHDR, Depth, Stencil, DepthAndStencil };
 
 using Attachment = std::pair<AttachmentType, bool>;
 
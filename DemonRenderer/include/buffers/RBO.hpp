@@ -14,13 +14,17 @@ class RBO
 {
 public:
 	RBO() = delete; //!< Deleted deafult constructor
-	RBO(AttachmentType type, glm::ivec2 size);  //!< Construtor which takes a type and size
+	RBO(AttachmentType type, glm::ivec2 size, uint32_t samples = 1);  //!< Construtor which takes a type, size and optionally a sample count
 	RBO(RBO& other) = delete; //!< Deleted copy constructor
 	RBO(RBO&& other) = delete; //!< Deleted move constructor
 	RBO& operator=(RBO& other) = delete; //!< Deleted copy assignment operator
 	RBO& operator=(RBO&& other) = delete; //!< Delete move assignment operator
 	~RBO(); //!< Destructor
 	uint32_t getID() const noexcept{ return m_ID; } //!< Returns the device ID of the RBO
+	uint32_t getFormat() const noexcept { return m_format; } //!< Returns the sized internal format
+	uint64_t getByteSize() const noexcept { return m_byteSize; } //!< Returns the device memory used by the RBO
 private: 
 	uint32_t m_ID{ 0 }; //!< Device ID of the RBO
+	uint32_t m_format{ 0 }; //!< Sized internal format
+	uint64_t m_byteSize{ 0 }; //!< Device memory used
 };
@@ -6,6 +6,7 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include "core/gpuMemory.hpp"
 
 using namespace std;
 
@@ -48,6 +49,7 @@ SSBO::SSBO(uint32_t size, uint32_t elementCount, T* data) : m_size(size), m_elem
 {
 	glCreateBuffers(1, &m_ID);
 	glNamedBufferData(m_ID, m_size, data, GL_DYNAMIC_DRAW);
+	GPUMemory::onCreate(GPUResourceType::storageBuffer, m_ID, m_size);
 }
 
 template<typename T>
@@ -0,0 +1,21 @@
+/** \file analyticSpin.hpp */
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/** \struct AnalyticSpin
+* \brief Constant spin which is evaluated from time rather than integrated.
+* The same data is held in the AnalyticAnimation instance buffer, so the vertex shader rebuilds the orientation from
+* a time uniform and the entity's LocalTRS and WorldMatrix are never touched after creation.
+*/
+
+struct AnalyticSpin
+{
+
+	glm::quat initialRotation{ glm::quat(1.f, 0.f, 0.f, 0.f) }; //!< Orientation at time zero
+	glm::vec3 axis{ 0.f, 0.f, 1.f }; //!< Unit axis of rotation in local space
+	float radiansPerSecond{ 0.f }; //!< Rate of rotation about the axis
+	uint32_t instance{ 0 }; //!< Index into the instance buffer
+
+};
@@ -0,0 +1,15 @@
+/** \file angularVelocity.hpp */
+#pragma once
+#include <glm/glm.hpp>
+
+/** \struct AngularVelocity
+* \brief Constant spin about the entity's local axes in radians per second.
+* Integrated by the SpinSystem, which mirrors it into structure of arrays storage.
+*/
+
+struct AngularVelocity
+{
+
+	glm::vec3 radiansPerSecond{ glm::vec3(0.f) }; //Euler angle rates
+
+};
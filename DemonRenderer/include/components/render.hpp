@@ -1,9 +1,7 @@
 /** \file render.hpp */
 #pragma once
 
-#include <memory>
-#include "buffers/VAO.hpp"
-#include "rendering/material.hpp"
+#include "core/resourceRegistry.hpp"
 
 /*
 
@@ -15,17 +13,19 @@
  render depth.
  All geometry will take the form of a VAO, SSBO are to be rendered by programmable
  vertex pulling.
+ Resources are referenced by ResourceRegistry handles, keeping the component at 16 bytes.
+ Use ResourceRegistry::get to reach the material or geometry.
 
 */
 
 struct Render
 {
 
-	std::shared_ptr<Material>  material{ nullptr };
-	std::shared_ptr<VAO> geometry{ nullptr };
-	std::shared_ptr<Material> depthMaterial{ nullptr };
-	std::shared_ptr<VAO> depthGeometry{ nullptr };
-
-
+	MaterialHandle material; //!< Material used by render passes
+	VAOHandle geometry; //!< Geometry used by render passes
+	MaterialHandle depthMaterial; //!< Material used by depth passes
+	VAOHandle depthGeometry; //!< Geometry used by depth passes
 
 };
+
+static_assert(sizeof(Render) == 16, "Render should be four 32-bit handles");
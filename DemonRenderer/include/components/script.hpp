@@ -6,6 +6,14 @@
 #include "rendering/scene.hpp"
 #include <memory>
 
+/** \class Script
+*    \brief Base of all scripts.
+*    Scripts are components stored directly in the registry, so every script type has its own contiguous pool and
+*    is updated by the ScriptSystem in a loop over that pool. Derived scripts must be final so those loops call them
+*    directly. Set threadSafe to true in a script which only touches its own entity's existing components to let
+*    the ScriptSystem update it across threads.
+*/
+
 class Script
 {
 
@@ -16,36 +24,11 @@ public:
 	virtual void onKeyPress(KeyPressedEvent& e) = 0;
 	virtual void onKeyRelease(KeyReleasedEvent& e) = 0;
 
+	static constexpr auto in_place_delete = true; //!< Scripts hold references so are never moved within their pool
+	static constexpr bool threadSafe = false; //!< Can onUpdate run concurrently with other scripts of the same type
+
 protected:
 	//Create a reference to the registry set in the scene.
 	entt::registry& m_registry;
 	entt::entity m_entity;
 };
-
-/** \class ScriptComp
-*    \brief A script component to be added to an entity and can have a script attached
-*/
-
-class ScriptComp
-{
-
-public:
-
-	ScriptComp() = default;
-
-	void onUpdate(float timestep) { if (m_script) m_script->onUpdate(timestep); }
-	void onImGuiRender() { if (m_script) m_script->onImGuiRender(); }
-	void onKeyPress(KeyPressedEvent& e) { if (m_script) m_script->onKeyPress(e); }
-	void onKeyRelease(KeyReleasedEvent& e) { if (m_script) m_script->onKeyRelease(e); }
-
-	template <typename T, typename ...Args> void attachScript(Args&& ...args)
-	{
-		T* ptr = new T(std::forward<Args>(args)...);
-		m_script.reset(static_cast<Script*>(ptr));
-	}
-
-private:
-
-	std::shared_ptr<Script> m_script{ nullptr };
-
-};
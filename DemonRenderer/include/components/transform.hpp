@@ -5,47 +5,62 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 
-/** \struct Transform
-* \brief A transform component*/
+/** \struct LocalTRS
+* \brief Local translation, rotation and scale of an entity.
+* Written by scripts and gameplay code, the WorldMatrix is composed from it by the TransformSystem.
+* Tag the entity with TransformDirty (TransformSystem::markDirty) after changing it.
+*/
 
-struct Transform
+struct LocalTRS
 {
 
-	glm::mat4 transform{ glm::mat4{1.f} }; //Overall transform
 	glm::quat rotation{ glm::quat(glm::vec3(0.f)) }; // Orientation as a quaternion
 	glm::vec3 translation{ glm::vec3(0.f) }; //Translation such as position
 	glm::vec3 scale{ glm::vec3(1.f) }; //Scale
 
-	Transform() = default; //default constructor
+	LocalTRS() = default; //default constructor
 
-	Transform
+	LocalTRS
 	(const glm::vec3& t, const glm::vec3& r, const glm::vec3 s) :
-		translation(t),
 		rotation(glm::quat(r)),
+		translation(t),
 		scale(s)
 	{
-		recalc();
 	}
 
-	void recalc()
-	{
+};
 
-		glm::mat4 t = glm::translate(glm::mat4(1.f), translation);
-		glm::mat4 r = glm::toMat4(rotation);
-		glm::mat4 s = glm::scale(glm::mat4(1.f), scale);
+/** \struct WorldMatrix
+* \brief Affine world transform stored as three rows of a 3x4 matrix.
+* Each row holds the rotation and scale in xyz and the translation in w, which matches a GLSL mat3x4
+* multiplied as vec4(position, 1.0) * u_model. Uploading it costs 48 bytes rather than 64 for a mat4.
+*/
 
-		transform = t * r * s;
-	}
+struct WorldMatrix
+{
 
-	void recalc(const glm::mat4& parent)
-	{
+	glm::mat3x4 rows{ glm::vec4(1.f, 0.f, 0.f, 0.f), glm::vec4(0.f, 1.f, 0.f, 0.f), glm::vec4(0.f, 0.f, 1.f, 0.f) }; //Rows of the affine transform
 
-		glm::mat4 t = glm::translate(glm::mat4(1.f), translation);
-		glm::mat4 r = glm::toMat4(rotation);
-		glm::mat4 s = glm::scale(glm::mat4(1.f), scale);
+	glm::vec3 getAxis(int axis) const { return { rows[0][axis], rows[1][axis], rows[2][axis] }; } //Scaled basis vector, 0 is right, 1 is up, 2 is back
+	glm::vec3 getTranslation() const { return { rows[0].w, rows[1].w, rows[2].w }; } //World position
+	glm::mat4 toMat4() const { return glm::transpose(glm::mat4(rows)); } //Full 4x4 matrix, for cameras and other non per-instance uses
 
-		transform = parent * t * r * s;
+};
 
-	}
+/** \struct TransformDirty
+* \brief Empty tag marking entities whose WorldMatrix must be recomposed from their LocalTRS.
+*/
+
+struct TransformDirty {};
+
+/** \struct PreviousTRS
+* \brief The entity's LocalTRS as of the start of the last fixed simulation step.
+* Entities carrying it are drawn blended between it and their current LocalTRS, see TransformSystem::interpolate.
+*/
+
+struct PreviousTRS
+{
+
+	LocalTRS local; //Local transform before the step
 
-};
\ No newline at end of file
+};
@@ -0,0 +1,79 @@
+/** \file aabbTree.hpp */
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory_resource>
+#include "core/broadPhaseBackend.hpp"
+#include "core/memoryResources.hpp"
+
+/** \class AABBTree
+*	\brief Dynamic bounding volume tree broadphase.
+*	Each leaf stores a fattened copy of its box, grown by a margin and stretched in the direction it last moved, so
+*	small movements stay inside the fat box and leave the tree untouched. Leaves which escape are removed and
+*	reinserted by surface area cost, and every node on the way back to the root is rebalanced with AVL style rotations.
+*	Pairs of overlapping fat boxes persist between frames and only the leaves which moved are queried for new ones.
+*	Unlike the plane sweep it has no preferred axis, so a bending belt costs no more than a straight one.
+*	The pair set gains and loses entries every frame, so its nodes and the leaf map's come from the tree's own pool.
+*/
+
+class AABBTree : public BroadPhaseBackend
+{
+public:
+	AABBTree() = default; //!< Default constructor
+	AABBTree(float margin, float displacementMultiplier = 4.f) : m_margin(margin), m_displacementMultiplier(displacementMultiplier) {} //!< Constructor which takes the fattening margin
+
+	void build(const std::vector<std::pair<entt::entity, AABB>>& boxes) override; //!< Replace the contents with a top down median split build
+	void addEntity(entt::entity entity, const AABB& entityAABB) override; //!< Insert a leaf
+	void updateEntity(entt::entity entity, const AABB& entityAABB) override; //!< Move a leaf, only reinserted if it left its fat box
+	void eraseEntity(entt::entity entity) override; //!< Remove a leaf
+	void clear() override; //!< Remove everything
+
+	const std::vector<EntityPair>& getPairs() override; //!< Pairs of entities whose boxes overlap
+	void query(const AABB& region, std::vector<entt::entity>& result) const override; //!< Walk the tree, skipping subtrees which miss the region
+	[[nodiscard]] inline size_t size() const noexcept override { return m_leaves.size(); } //!< Number of leaves
+	[[nodiscard]] inline BroadPhaseType getType() const noexcept override { return BroadPhaseType::AABBTree; } //!< Which backend this is
+	[[nodiscard]] inline int32_t getHeight() const noexcept { return m_root == nullNode ? 0 : m_nodes[m_root].height; } //!< Height of the tree, log2 of the leaf count when balanced
+	[[nodiscard]] inline uint32_t getReinsertCount() const noexcept { return m_reinsertCount; } //!< Leaves which have left their fat boxes since the last build
+private:
+	static constexpr int32_t nullNode{ -1 }; //!< No node
+	static constexpr size_t hashNodeSize{ 32 }; //!< Holds a hash node of either container with the standard libraries we build with, larger nodes pass through
+
+	/** \struct Node */
+	struct Node
+	{
+		AABB fat; //!< Leaf: the fattened box. Branch: the union of its children
+		AABB tight; //!< Leaf: the box as given
+		entt::entity entity{ entt::null }; //!< Leaf: owner of the box
+		int32_t parent{ nullNode }; //!< Parent node, or next free node when on the free list
+		int32_t child1{ nullNode }; //!< First child, null for leaves
+		int32_t child2{ nullNode }; //!< Second child, null for leaves
+		int32_t height{ -1 }; //!< 0 for leaves, -1 when free
+		bool moved{ false }; //!< Leaf: queued to be queried for new pairs
+		inline bool isLeaf() const noexcept { return child1 == nullNode; } //!< Is this a leaf
+	};
+
+	int32_t allocateNode(); //!< Take a node from the free list, growing the pool if needed
+	void freeNode(int32_t node); //!< Return a node to the free list
+	void insertLeaf(int32_t leaf); //!< Find the cheapest sibling for a leaf and link it in
+	void removeLeaf(int32_t leaf); //!< Unlink a leaf, its sibling takes its parent's place
+	int32_t balance(int32_t node); //!< Rotate the node's taller child up if the heights differ by more than one
+	void refit(int32_t node); //!< Rebalance and refit from a node up to the root
+	int32_t buildRange(std::vector<int32_t>& leaves, size_t begin, size_t end); //!< Build a subtree over a range of leaves
+	void fatten(Node& node, const AABB& tight, const glm::vec3& displacement) const; //!< Set a leaf's tight and fat boxes
+	void markMoved(int32_t leaf); //!< Queue a leaf to be queried for new pairs
+
+	BlockPool m_hashNodes{ "AABB tree hash nodes", hashNodeSize }; //!< Nodes of m_leaves and m_pairSet, declared first so it outlives them
+	std::vector<Node> m_nodes; //!< Node pool
+	int32_t m_root{ nullNode }; //!< Root of the tree
+	int32_t m_freeList{ nullNode }; //!< First free node
+	std::pmr::unordered_map<entt::entity, int32_t> m_leaves{ &m_hashNodes }; //!< Entity to leaf node
+	std::vector<int32_t> m_moved; //!< Leaves to query for new pairs
+	std::pmr::unordered_set<uint64_t> m_pairSet{ &m_hashNodes }; //!< Pairs of leaves whose fat boxes overlap
+	std::vector<EntityPair> m_pairs; //!< Pairs whose tight boxes overlap, rebuilt by getPairs when stale
+	bool m_pairsDirty{ true }; //!< Has anything moved since m_pairs was built
+	uint32_t m_reinsertCount{ 0 }; //!< Leaves reinserted since the last build
+
+	float m_margin{ 0.25f }; //!< Distance a fat box extends past its tight box
+	float m_displacementMultiplier{ 4.f }; //!< How many frames of movement a fat box is stretched by
+};
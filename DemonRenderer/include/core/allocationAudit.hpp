@@ -0,0 +1,142 @@
+/** \file allocationAudit.hpp */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "tracy/Tracy.hpp"
+
+/** \struct AllocationRecord
+*	\brief One allocation made while the audit was armed, kept with its call stack for the report
+*/
+struct AllocationRecord
+{
+	static constexpr uint32_t maxDepth{ 16 }; //!< Return addresses kept per allocation
+
+	const char* zone{ nullptr }; //!< Innermost audited zone, owned by the audit, null outside of any
+	size_t bytes{ 0 }; //!< Size requested
+	uint64_t frame{ 0 }; //!< Frame the allocation was made in
+	uint32_t depth{ 0 }; //!< Return addresses captured, zero where stacks are not supported
+	std::array<void*, maxDepth> stack{}; //!< Return addresses, innermost first
+};
+
+/** \struct AllocationZoneStats
+*	\brief Allocations attributed to one audited zone
+*/
+struct AllocationZoneStats
+{
+	const char* name{ nullptr }; //!< Zone name, owned by the audit
+	uint64_t lastFrameAllocations{ 0 }; //!< Allocations in the last complete frame
+	uint64_t lastFrameBytes{ 0 }; //!< Bytes in the last complete frame
+	uint64_t armedAllocations{ 0 }; //!< Allocations since the audit was armed
+	uint64_t armedBytes{ 0 }; //!< Bytes since the audit was armed
+};
+
+/** \class AllocationAudit
+*	\brief Counts heap allocations per frame and per zone through the global operator new hook.
+*	Frame totals are always counted. Once enabled, allocations are also attributed to the innermost zone opened with
+*	ZoneAuditedN on the allocating thread, or counted as outside any zone. Arming marks the point from which the frame
+*	should be allocation free: armed allocations send their call stacks to Tracy, the first few are recorded with
+*	their own stacks for the report, and the worst frame is tracked against a threshold. An unattended run started with
+*	--allocation-audit [warmup frames] [frames] [allocations per frame] arms itself after the warmup, stops the
+*	application once the frames are done and sets a failing exit code if any armed frame went over the threshold.
+*	Everything the hook touches is preallocated, so counting never allocates.
+*/
+class AllocationAudit
+{
+public:
+	/** \class Zone
+	*	\brief Attributes the calling thread's allocations to a name for the zone's lifetime, see ZoneAuditedN
+	*/
+	class Zone
+	{
+	public:
+		explicit Zone(const char* name) noexcept; //!< Open a zone, name must outlive the zone
+		~Zone(); //!< Close the zone
+		Zone(Zone& other) = delete; //!< Deleted copy constructor
+		Zone(Zone&& other) = delete; //!< Deleted move constructor
+		Zone& operator=(Zone& other) = delete; //!< Deleted copy assignment operator
+		Zone& operator=(Zone&& other) = delete; //!< Deleted move assignment operator
+	};
+
+	[[nodiscard]] static bool onAllocate(size_t bytes) noexcept; //!< Count an allocation, called by operator new, true when it should be traced with a call stack
+	static void onFree() noexcept; //!< Count a free, called by operator delete
+	static void onFrameEnd(); //!< Close the frame's counters and step an unattended run, called by the application
+
+	static void setEnabled(bool enabled) noexcept { s_enabled.store(enabled, std::memory_order_relaxed); } //!< Attribute allocations to zones
+	static void arm() noexcept; //!< Expect no more allocations, clearing the armed counters and records, enables zones
+	static void disarm() noexcept { s_armed.store(false, std::memory_order_relaxed); } //!< Stop treating allocations as unexpected
+	static void configureRun(uint32_t warmupFrames, uint32_t frames, uint64_t threshold) noexcept; //!< Start an unattended run
+	static void parseArguments(int argc, char** argv); //!< Configure a run from --allocation-audit on the command line
+	static void report(); //!< Log the armed totals, the worst zones and the recorded allocations with their call stacks
+
+	[[nodiscard]] static inline bool isEnabled() noexcept { return s_enabled.load(std::memory_order_relaxed); } //!< Are zones being attributed
+	[[nodiscard]] static inline bool isArmed() noexcept { return s_armed.load(std::memory_order_relaxed); } //!< Is the frame expected to be allocation free
+	[[nodiscard]] static inline bool isRunConfigured() noexcept { return s_runFrames > 0; } //!< Was an unattended run requested
+	[[nodiscard]] static inline bool isRunFinished() noexcept { return s_runFinished; } //!< Has the unattended run done all its frames
+	[[nodiscard]] static inline bool hasRunFailed() noexcept { return s_runFailed; } //!< Did an armed frame allocate more than the threshold
+	[[nodiscard]] static inline uint64_t getLastFrameAllocations() noexcept { return s_lastFrameAllocations; } //!< Allocations in the last complete frame
+	[[nodiscard]] static inline uint64_t getLastFrameBytes() noexcept { return s_lastFrameBytes; } //!< Bytes allocated in the last complete frame
+	[[nodiscard]] static inline uint64_t getLastFrameFrees() noexcept { return s_lastFrameFrees; } //!< Frees in the last complete frame
+	[[nodiscard]] static inline uint64_t getArmedFrames() noexcept { return s_armedFrames; } //!< Complete frames since arming
+	[[nodiscard]] static inline uint64_t getArmedAllocations() noexcept { return s_armedAllocations.load(std::memory_order_relaxed); } //!< Allocations since arming
+	[[nodiscard]] static inline uint64_t getWorstArmedFrame() noexcept { return s_worstArmedFrame; } //!< Most allocations in one armed frame
+	[[nodiscard]] static inline uint64_t getThreshold() noexcept { return s_threshold; } //!< Allocations an armed frame may make
+	[[nodiscard]] static size_t getZoneCount() noexcept; //!< Zones seen so far
+	[[nodiscard]] static AllocationZoneStats getZone(size_t index) noexcept; //!< Counters of a zone
+
+	static constexpr uint32_t maxZones{ 128 }; //!< Zones tracked, allocations in any beyond this count as outside a zone
+	static constexpr uint32_t maxZoneDepth{ 32 }; //!< Nested zones tracked per thread
+	static constexpr uint32_t maxRecords{ 32 }; //!< Armed allocations recorded with call stacks
+	static constexpr int32_t callstackDepth{ 16 }; //!< Frames of call stack sent to Tracy for armed allocations
+private:
+	/** \struct ZoneCounters
+	*	\brief Lock free counters of one zone, the slot is claimed by the first allocation in it
+	*/
+	struct ZoneCounters
+	{
+		std::atomic<const char*> key{ nullptr }; //!< Name pointer the slot was claimed with, compared but never read through
+		std::atomic<bool> ready{ false }; //!< Has label been written
+		char label[48]{}; //!< Copy of the name, so zones named by strings which go away stay readable
+		std::atomic<uint64_t> frameAllocations{ 0 }; //!< Allocations this frame
+		std::atomic<uint64_t> frameBytes{ 0 }; //!< Bytes this frame
+		uint64_t lastFrameAllocations{ 0 }; //!< Allocations last frame
+		uint64_t lastFrameBytes{ 0 }; //!< Bytes last frame
+		std::atomic<uint64_t> armedAllocations{ 0 }; //!< Allocations since arming
+		std::atomic<uint64_t> armedBytes{ 0 }; //!< Bytes since arming
+	};
+
+	[[nodiscard]] static ZoneCounters* findZone(const char* name) noexcept; //!< Find or claim the slot for a zone
+	[[nodiscard]] static const char* currentZone() noexcept; //!< Innermost zone open on the calling thread, null if none
+
+	inline static std::atomic<bool> s_enabled{ false }; //!< Attribute allocations to zones
+	inline static std::atomic<bool> s_armed{ false }; //!< Allocations are unexpected
+	inline static std::atomic<uint64_t> s_frameAllocations{ 0 }; //!< Allocations this frame
+	inline static std::atomic<uint64_t> s_frameBytes{ 0 }; //!< Bytes this frame
+	inline static std::atomic<uint64_t> s_frameFrees{ 0 }; //!< Frees this frame
+	inline static std::atomic<uint64_t> s_armedAllocations{ 0 }; //!< Allocations since arming
+	inline static std::atomic<uint64_t> s_armedBytes{ 0 }; //!< Bytes since arming
+	inline static std::atomic<uint32_t> s_recordCount{ 0 }; //!< Armed allocations seen, only the first maxRecords are kept
+	inline static uint64_t s_lastFrameAllocations{ 0 }; //!< Allocations last frame
+	inline static uint64_t s_lastFrameBytes{ 0 }; //!< Bytes last frame
+	inline static uint64_t s_lastFrameFrees{ 0 }; //!< Frees last frame
+	inline static std::atomic<uint64_t> s_frame{ 0 }; //!< Frames ended, read by allocating threads
+	inline static uint64_t s_armedFrames{ 0 }; //!< Frames ended while armed
+	inline static uint64_t s_worstArmedFrame{ 0 }; //!< Most allocations in an armed frame
+
+	inline static uint64_t s_runWarmup{ 0 }; //!< Frames before an unattended run arms
+	inline static uint64_t s_runFrames{ 0 }; //!< Armed frames an unattended run measures, 0 when no run was requested
+	inline static uint64_t s_threshold{ 0 }; //!< Allocations an armed frame may make
+	inline static bool s_runFinished{ false }; //!< Has the run measured all its frames
+	inline static bool s_runFailed{ false }; //!< Did an armed frame go over the threshold
+
+	static std::array<ZoneCounters, maxZones> s_zones; //!< Per zone counters, defined with the source as ZoneCounters is incomplete in here
+	inline static std::array<AllocationRecord, maxRecords> s_records; //!< First armed allocations
+	inline static std::array<std::atomic<bool>, maxRecords> s_recordReady{}; //!< Has the allocating thread finished writing each record
+	inline static thread_local std::array<const char*, maxZoneDepth> t_zones{}; //!< Open zones on this thread, innermost last
+	inline static thread_local uint32_t t_zoneDepth{ 0 }; //!< Zones open on this thread, may exceed maxZoneDepth
+};
+
+//! A Tracy zone whose allocations are also counted by the AllocationAudit, one per scope like ZoneScopedN
+#define ZoneAuditedN(name) ZoneScopedN(name); AllocationAudit::Zone allocationAuditZone(name)
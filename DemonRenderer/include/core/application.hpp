@@ -5,7 +5,14 @@
 
 #include "core/log.hpp"
 #include "core/timer.hpp"
+#include "core/fixedTimestep.hpp"
 #include "core/layer.hpp"
+#include "core/resourceRegistry.hpp"
+#include "core/jobSystem.hpp"
+#include "core/memoryResources.hpp"
+#include "core/allocationAudit.hpp"
+#include "core/memoryTracker.hpp"
+#include "core/renderThread.hpp"
 #include "windows/GLFWSystem.hpp"
 #include "windows/GLFWWindowImpl.hpp"
 
@@ -16,11 +23,18 @@
 #include "rendering/camera.hpp"
 #include "rendering/renderPass.hpp"
 #include "rendering/renderer.hpp"
+#include "rendering/renderSnapshot.hpp"
 
 
 
 /** \class Application 
  *  \brief Provides an application with a window, OpenGL context, logger (spdlog) and a timer.
+ *  When the layer asks for it the OpenGL context moves to a render thread, which draws frame N from its snapshot
+ *  while the main thread updates frame N + 1. ImGui is built on the main thread and its draw lists are captured into
+ *  the snapshot; its platform windows need GL on the main thread, so they are folded into the main window until the
+ *  application falls back to single threaded rendering.
+ *  Each frame the layer updates once with the frame's time and then steps its simulation at the fixed rate set by
+ *  m_fixedTimestep, so physics gives the same results at any frame rate.
  */
 class Application
 {
@@ -33,7 +47,11 @@ protected:
 	GLFWWindowImpl m_window; //!< GLFW Window
 private:
 	void onUpdate(float timestep); //!< Update everything
-	void onRender() const; //!< Do all drawing
+	void onFixedUpdate(float timestep); //!< Run the fixed simulation steps the frame's time covers
+	void onExtract(uint64_t frame); //!< Take the frame's snapshots
+	void onRender(uint64_t frame); //!< Do all drawing
+	void renderFrame(uint64_t frame); //!< Draw, present and end a frame on the render thread
+	void setRenderThreaded(bool threaded); //!< Start or stop the render thread between frames
 	void onImGuiRender(); //!< Draw all ImGui wigdets
 	void onClose(WindowCloseEvent& e); //!< Run when the window is closed
 	void onResize(WindowResizeEvent& e); //!< Run when the window is resized
@@ -51,11 +69,16 @@ private:
 
 protected:
 	std::unique_ptr<Layer> m_layer; //!< Application layer
+	FixedTimestep m_fixedTimestep; //!< Simulation rate and substep limit, set up by the derived application
 private:
 	LogSystem m_logSystem;	//!< System which initialises the logger
 	GLFWSystem m_windowsSystem; //!< System which initialises and terminated GLFW
 	bool m_running{ true }; //!< Controls whether or not the application is running
 	bool m_ImGuiOpen{ true }; //!< Boolean for IMGui window
+	RenderThread m_renderThread; //!< Draws frames while the next one is updated, when the layer uses it
+	std::array<ImGuiSnapshot, RenderSnapshot::slots> m_imGuiSnapshots; //!< ImGui draw data of the frames in flight
+	uint64_t m_frame{ 0 }; //!< Frames updated so far, picks the snapshot slot
+	bool m_imGuiViewports{ false }; //!< Were ImGui platform windows enabled before the render thread started
 };
 
 // To be defined in users code
@@ -0,0 +1,37 @@
+/** \file benchmark.hpp */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <filesystem>
+
+/** \struct BenchmarkResult
+*	\brief Timing statistics for a single benchmark case, all times are in milliseconds
+*/
+struct BenchmarkResult
+{
+	std::string name{ "" }; //!< Name of the case
+	uint64_t elements{ 0 }; //!< Number of elements processed per iteration (lights, entities, particles...)
+	uint32_t iterations{ 0 }; //!< Number of timed iterations
+	double minMs{ 0.0 }; //!< Fastest iteration
+	double meanMs{ 0.0 }; //!< Average iteration
+	double medianMs{ 0.0 }; //!< Median iteration
+	double p95Ms{ 0.0 }; //!< 95th percentile iteration
+	double nsPerElement() const { return elements ? (meanMs * 1.0e6) / static_cast<double>(elements) : 0.0; } //!< Average cost of one element in nanoseconds
+};
+
+/** \class Benchmark
+*	\brief Small timing harness shared by the engine and application benchmarks.
+*	A case is warmed up and then timed for a number of iterations. Frame driven cases (GPU work which must be
+*	presented to be measured) can collect their own samples and build a result with fromSamples.
+*/
+class Benchmark
+{
+public:
+	static BenchmarkResult run(const std::string& name, uint64_t elements, uint32_t iterations, const std::function<void()>& func, uint32_t warmup = 2); //!< Time func over a number of iterations
+	static BenchmarkResult fromSamples(const std::string& name, uint64_t elements, std::vector<double> samplesMs); //!< Build a result from samples collected elsewhere
+	static void log(const BenchmarkResult& result); //!< Write a result to the log
+	static bool writeCSV(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results); //!< Write a set of results to a CSV file, creating directories as needed
+};
@@ -0,0 +1,77 @@
+/** \file broadPhaseBackend.hpp */
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+using AABB = std::pair<glm::vec3, glm::vec3>;
+using EntityPair = std::pair<entt::entity, entt::entity>;
+
+/** \enum BroadPhaseType
+*	\brief The broadphase backends which can be selected at runtime
+*/
+enum class BroadPhaseType : uint32_t
+{
+	PlaneSweep, //!< Incremental sweep and prune along one axis
+	AABBTree, //!< Dynamic bounding volume tree of fattened boxes
+	HashGrid //!< Uniform grid of cells hashed into a map
+};
+
+/** \class BroadPhaseBackend
+*	\brief Interface shared by the broadphase data structures.
+*	A backend holds one box per entity and reports the pairs of entities whose boxes overlap. build replaces the
+*	contents in one go, while add, update and erase keep it current as colliders come, move and go. query appends
+*	every entity whose box overlaps a region to the result.
+*/
+class BroadPhaseBackend
+{
+public:
+	virtual ~BroadPhaseBackend() = default; //!< Destructor
+	virtual void build(const std::vector<std::pair<entt::entity, AABB>>& boxes) = 0; //!< Replace the contents
+	virtual void addEntity(entt::entity entity, const AABB& entityAABB) = 0; //!< Add an entity's box
+	virtual void updateEntity(entt::entity entity, const AABB& entityAABB) = 0; //!< Move an entity's box
+	virtual void eraseEntity(entt::entity entity) = 0; //!< Remove an entity's box
+	virtual void clear() = 0; //!< Remove everything
+	virtual const std::vector<EntityPair>& getPairs() = 0; //!< Pairs of entities whose boxes overlap
+	virtual void query(const AABB& region, std::vector<entt::entity>& result) const = 0; //!< Append the entities whose boxes overlap the region
+	[[nodiscard]] virtual size_t size() const noexcept = 0; //!< Number of boxes
+	[[nodiscard]] virtual BroadPhaseType getType() const noexcept = 0; //!< Which backend this is
+
+	[[nodiscard]] static inline const char* getName(BroadPhaseType type) noexcept; //!< Display name of a backend
+	[[nodiscard]] static inline bool overlaps(const AABB& a, const AABB& b) noexcept; //!< Do two boxes overlap, touching counts
+	[[nodiscard]] static inline uint64_t pairKey(entt::entity a, entt::entity b) noexcept; //!< Order independent key for a pair
+	[[nodiscard]] static inline EntityPair pairFromKey(uint64_t key) noexcept; //!< The pair a key was made from, lowest entity first
+};
+
+const char* BroadPhaseBackend::getName(BroadPhaseType type) noexcept
+{
+	switch (type)
+	{
+	case BroadPhaseType::PlaneSweep: return "Plane sweep";
+	case BroadPhaseType::AABBTree: return "AABB tree";
+	case BroadPhaseType::HashGrid: return "Hash grid";
+	}
+	return "Unknown";
+}
+
+bool BroadPhaseBackend::overlaps(const AABB& a, const AABB& b) noexcept
+{
+	return a.first.x <= b.second.x && b.first.x <= a.second.x &&
+		a.first.y <= b.second.y && b.first.y <= a.second.y &&
+		a.first.z <= b.second.z && b.first.z <= a.second.z;
+}
+
+uint64_t BroadPhaseBackend::pairKey(entt::entity a, entt::entity b) noexcept
+{
+	uint64_t lo = static_cast<uint64_t>(entt::to_integral(a));
+	uint64_t hi = static_cast<uint64_t>(entt::to_integral(b));
+	if (lo > hi) std::swap(lo, hi);
+	return (hi << 32) | lo;
+}
+
+EntityPair BroadPhaseBackend::pairFromKey(uint64_t key) noexcept
+{
+	return { static_cast<entt::entity>(static_cast<uint32_t>(key)), static_cast<entt::entity>(static_cast<uint32_t>(key >> 32)) };
+}
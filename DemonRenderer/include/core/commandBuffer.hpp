@@ -0,0 +1,190 @@
+/** \file commandBuffer.hpp */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <entt/entt.hpp>
+
+/** \struct PendingEntity
+*	\brief An entity recorded for creation, it only exists once the buffer has been applied, see CommandBuffer::resolve
+*/
+struct PendingEntity
+{
+	uint32_t lane; //!< Lane the creation was recorded in
+	uint32_t index; //!< Creation within the lane
+};
+
+/** \struct CommandBatch
+*	\brief Structural changes made by one CommandBuffer::apply, passed to its listeners
+*/
+struct CommandBatch
+{
+	std::span<const entt::entity> created; //!< Entities created by the batch
+	std::span<const entt::entity> destroyed; //!< Entities destroyed by the batch in ascending order, no longer valid
+};
+
+/** \class CommandBuffer
+*	\brief Structural changes to a registry recorded during a frame and applied together at a sync point.
+*	Each recording thread claims its own lane the first time it records after an apply, so recording never takes a
+*	lock and never touches the registry. apply creates every pending entity with one ranged create, adds each component
+*	type with one ranged insert, removes with ranged removes and destroys last, so a destroy recorded alongside an
+*	emplace wins. Listeners connected to onApplied then hear about the whole batch at once. Within a lane the last
+*	emplace of a type on an entity wins, across lanes the order is unspecified.
+*	Only apply and resolve must be called from the thread which owns the registry, with no recording in flight.
+*/
+class CommandBuffer
+{
+public:
+	CommandBuffer(); //!< Default constructor
+	CommandBuffer(CommandBuffer& other) = delete; //!< Deleted copy constructor
+	CommandBuffer(CommandBuffer&& other) = delete; //!< Deleted move constructor
+	CommandBuffer& operator=(CommandBuffer& other) = delete; //!< Deleted copy assignment operator
+	CommandBuffer& operator=(CommandBuffer&& other) = delete; //!< Deleted move assignment operator
+
+	PendingEntity create(); //!< Record the creation of an entity
+	void destroy(entt::entity entity); //!< Record the destruction of an entity, destroying one twice is harmless
+	template<typename Type> void emplace(entt::entity entity, Type component); //!< Record adding, or replacing, a component
+	template<typename Type> void emplace(PendingEntity entity, Type component); //!< Record adding a component to a pending entity, from the thread which recorded its creation
+	template<typename Type> void remove(entt::entity entity); //!< Record removing a component if the entity has it
+
+	void apply(entt::registry& registry); //!< Make every recorded change then notify the listeners once
+	[[nodiscard]] entt::entity resolve(PendingEntity entity) const; //!< Entity created for a pending one by the last apply
+	[[nodiscard]] auto onApplied() noexcept { return entt::sink{ m_onApplied }; } //!< Listeners told about each applied batch
+	[[nodiscard]] size_t getCommandCount() const noexcept; //!< Commands recorded since the last apply, from the recording side only
+
+	static constexpr uint32_t maxLanes{ 64 }; //!< Most threads which can record between two applies
+private:
+	/** \class PoolBase
+	*	\brief Recorded emplaces and removes of one component type in one lane
+	*/
+	class PoolBase
+	{
+	public:
+		virtual ~PoolBase() = default; //!< Virtual destructor
+		virtual void apply(entt::registry& registry, std::span<const entt::entity> created) = 0; //!< Add then remove the components
+		virtual void clear() = 0; //!< Forget the commands, keeping their memory
+		[[nodiscard]] virtual size_t size() const = 0; //!< Number of commands
+	};
+
+	/** \class Pool
+	*	\brief Commands for a component type, kept as typed arrays so they can be inserted in one go
+	*/
+	template<typename Type>
+	class Pool : public PoolBase
+	{
+	public:
+		void apply(entt::registry& registry, std::span<const entt::entity> created) override;
+		void clear() override { m_targets.clear(); m_values.clear(); m_removed.clear(); }
+		[[nodiscard]] size_t size() const override { return m_targets.size() + m_removed.size(); }
+
+		std::vector<std::pair<entt::entity, uint32_t>> m_targets; //!< Entity, or index of a pending entity when the entity is null
+		std::vector<Type> m_values; //!< Component for each target
+		std::vector<entt::entity> m_removed; //!< Entities losing the component
+	private:
+		entt::sparse_set m_fresh; //!< Scratch, entities gaining the component in packed order
+		std::vector<Type> m_freshValues; //!< Scratch, their components
+	};
+
+	/** \struct Lane
+	*	\brief Everything recorded by one thread, on its own cache lines
+	*/
+	struct alignas(64) Lane
+	{
+		std::atomic<std::thread::id> owner{}; //!< Thread recording into the lane
+		uint32_t createCount{ 0 }; //!< Pending entities recorded
+		std::vector<entt::entity> created; //!< Entities made for the pending ones by the last apply
+		std::vector<entt::entity> destroyed; //!< Entities to destroy
+		std::vector<std::pair<entt::id_type, std::unique_ptr<PoolBase>>> pools; //!< Component commands by type, kept between applies
+
+		template<typename Type> Pool<Type>& assure(); //!< Pool for a type, made on first use
+	};
+
+	Lane* acquireLane(); //!< The calling thread's lane, claiming one if needed, nullptr if every lane is taken
+
+	std::array<Lane, maxLanes> m_lanes; //!< Per thread recordings
+	std::atomic<uint32_t> m_laneCount{ 0 }; //!< Lanes claimed since the last apply
+	uint64_t m_epoch; //!< Changes at every apply so threads know to claim a lane again
+	std::vector<entt::entity> m_created; //!< Entities created by the last apply
+	std::vector<entt::entity> m_destroyed; //!< Entities destroyed by the last apply
+	entt::sigh<void(const CommandBatch&)> m_onApplied; //!< Batch listeners
+};
+
+template<typename Type>
+void CommandBuffer::emplace(entt::entity entity, Type component)
+{
+	if (entity == entt::null) return;
+	if (Lane* lane = acquireLane()) {
+		auto& pool = lane->assure<Type>();
+		pool.m_targets.emplace_back(entity, 0);
+		pool.m_values.push_back(std::move(component));
+	}
+}
+
+template<typename Type>
+void CommandBuffer::emplace(PendingEntity entity, Type component)
+{
+	// Pending entities belong to the lane which recorded their creation
+	if (entity.lane >= maxLanes) return;
+	Lane& lane = m_lanes[entity.lane];
+	auto& pool = lane.assure<Type>();
+	pool.m_targets.emplace_back(entt::entity{ entt::null }, entity.index);
+	pool.m_values.push_back(std::move(component));
+}
+
+template<typename Type>
+void CommandBuffer::remove(entt::entity entity)
+{
+	if (Lane* lane = acquireLane()) lane->assure<Type>().m_removed.push_back(entity);
+}
+
+template<typename Type>
+CommandBuffer::Pool<Type>& CommandBuffer::Lane::assure()
+{
+	const entt::id_type id = entt::type_hash<Type>::value();
+	for (auto& [type, pool] : pools)
+	{
+		if (type == id) return static_cast<Pool<Type>&>(*pool);
+	}
+	pools.emplace_back(id, std::make_unique<Pool<Type>>());
+	return static_cast<Pool<Type>&>(*pools.back().second);
+}
+
+template<typename Type>
+void CommandBuffer::Pool<Type>::apply(entt::registry& registry, std::span<const entt::entity> created)
+{
+	auto& storage = registry.storage<Type>();
+
+	// Replace in place where the entity already has the component, otherwise gather for one insert
+	m_fresh.clear();
+	m_freshValues.clear();
+	for (size_t i = 0; i < m_targets.size(); i++)
+	{
+		const auto [target, pending] = m_targets[i];
+		if (target == entt::null && pending >= created.size()) continue;
+		const entt::entity entity = target == entt::null ? created[pending] : target;
+		if (!registry.valid(entity)) continue;
+
+		if (storage.contains(entity)) {
+			if constexpr (!std::is_empty_v<Type>) registry.replace<Type>(entity, std::move(m_values[i]));
+		}
+		else if (m_fresh.contains(entity)) m_freshValues[m_fresh.index(entity)] = std::move(m_values[i]);
+		else {
+			m_fresh.push(entity);
+			m_freshValues.push_back(std::move(m_values[i]));
+		}
+	}
+
+	if (!m_fresh.empty()) {
+		if constexpr (std::is_empty_v<Type>) registry.insert<Type>(m_fresh.data(), m_fresh.data() + m_fresh.size());
+		else registry.insert<Type>(m_fresh.data(), m_fresh.data() + m_fresh.size(), m_freshValues.begin());
+	}
+
+	if (!m_removed.empty()) registry.remove<Type>(m_removed.begin(), m_removed.end());
+}
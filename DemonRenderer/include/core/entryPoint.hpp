@@ -7,10 +7,12 @@ extern Application* startApplication();
 
 int main(int argc, char** argv)
 {
+	AllocationAudit::parseArguments(argc, argv);
+
 	auto application = startApplication();
 	application->run();
 	delete application;
 
-	return 0;
+	return AllocationAudit::hasRunFailed() ? 1 : 0;
 }
 
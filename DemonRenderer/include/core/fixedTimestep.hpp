@@ -0,0 +1,37 @@
+/** \file fixedTimestep.hpp */
+
+#pragma once
+#include <cstdint>
+
+/** \class FixedTimestep
+ *  \brief Turns variable frame times into a whole number of fixed simulation steps.
+ *  Each frame's time is added to an accumulator and advance returns how many steps of getStep seconds it now holds.
+ *  The remainder, as a fraction of a step, is getAlpha: how far the frame being drawn is between the last two
+ *  simulation states. At most maxSubsteps steps run per frame and time beyond that is dropped, so after a stall the
+ *  simulation slows down for a frame instead of every following frame running more steps to catch up.
+ */
+
+class FixedTimestep
+{
+public:
+	explicit FixedTimestep(float rate = 60.f, uint32_t maxSubsteps = 4) noexcept; //!< Constructor taking steps per second and the most steps run in one frame
+	[[nodiscard]] uint32_t advance(float frameTime) noexcept; //!< Add a frame's time in seconds and give back the number of steps to run
+	void reset() noexcept; //!< Drop any accumulated time
+	void setRate(float rate) noexcept; //!< Set the steps per second, clamped to at least one
+	void setMaxSubsteps(uint32_t maxSubsteps) noexcept; //!< Set the most steps run in one frame, at least one
+
+	[[nodiscard]] inline float getStep() const noexcept { return m_step; } //!< Length of a step in seconds
+	[[nodiscard]] inline float getRate() const noexcept { return 1.f / m_step; } //!< Steps per second
+	[[nodiscard]] inline float getAlpha() const noexcept { return m_accumulator / m_step; } //!< Fraction of a step accumulated since the last one, in [0, 1)
+	[[nodiscard]] inline uint32_t getMaxSubsteps() const noexcept { return m_maxSubsteps; } //!< Most steps run in one frame
+	[[nodiscard]] inline uint32_t getLastSteps() const noexcept { return m_lastSteps; } //!< Steps given by the last advance
+	[[nodiscard]] inline uint64_t getStepCount() const noexcept { return m_stepCount; } //!< Steps given since construction
+	[[nodiscard]] inline uint64_t getDroppedSteps() const noexcept { return m_droppedSteps; } //!< Whole steps dropped by the substep limit
+private:
+	float m_step{ 1.f / 60.f }; //!< Step length in seconds
+	float m_accumulator{ 0.f }; //!< Time not yet simulated, always less than a step between frames
+	uint32_t m_maxSubsteps{ 4 }; //!< Most steps per frame
+	uint32_t m_lastSteps{ 0 }; //!< Steps given by the last advance
+	uint64_t m_stepCount{ 0 }; //!< Total steps given
+	uint64_t m_droppedSteps{ 0 }; //!< Total steps dropped
+};
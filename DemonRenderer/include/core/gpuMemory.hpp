@@ -0,0 +1,115 @@
+/** \file gpuMemory.hpp */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** \enum GPUResourceType
+*	\brief Kind of GL object device memory is allocated for
+*/
+enum class GPUResourceType : uint8_t
+{
+	texture, //!< Sampled 2D texture with its full mip chain
+	renderTarget, //!< Texture attached to an FBO
+	cubeMap, //!< Six faced cube map
+	renderbuffer, //!< RBO attached to an FBO
+	vertexBuffer, //!< VBO storage
+	indexBuffer, //!< IBO storage
+	uniformBuffer, //!< UBO storage
+	storageBuffer, //!< SSBO storage
+	count //!< Number of types
+};
+
+/** \struct GPUTypeStats
+*	\brief Device memory held by one type of resource
+*/
+struct GPUTypeStats
+{
+	const char* name{ nullptr }; //!< Name of the type
+	uint64_t bytes{ 0 }; //!< Bytes held
+	uint64_t peakBytes{ 0 }; //!< Most bytes held at once
+	uint32_t count{ 0 }; //!< Resources alive
+};
+
+/** \struct GPUOwnerStats
+*	\brief Device memory held by the resources created under one owner
+*/
+struct GPUOwnerStats
+{
+	std::string name; //!< Owner, a pass, material or system
+	uint64_t bytes{ 0 }; //!< Bytes held
+	uint32_t count{ 0 }; //!< Resources alive
+	std::array<uint64_t, static_cast<size_t>(GPUResourceType::count)> typeBytes{}; //!< Bytes held per type
+};
+
+/** \class GPUMemory
+*	\brief Accounts for the device memory of every GL resource the engine creates.
+*	GL has no portable way to ask how much memory is in use, so sizes are worked out when storage is allocated, from the
+*	format, dimensions, mip levels and samples of textures and the byte size of buffers, and given back when the object
+*	is deleted. Each resource is charged to the innermost GPUMemory::Owner open on the creating thread, which lets the
+*	totals be split by pass, material or system as well as by type. A total budget can be set, creating a resource which
+*	takes the total over it logs an error once per crossing. Sizes are what the formats require, drivers may pad them.
+*/
+class GPUMemory
+{
+public:
+	/** \class Owner
+	*	\brief Charges GL resources created on the calling thread to a name for the owner's lifetime.
+	*	Owners nest, so declaring one per section of a long setup function charges each section to its own name.
+	*/
+	class Owner
+	{
+	public:
+		explicit Owner(const char* name) noexcept : m_previous(t_owner) { t_owner = name; } //!< Open an owner, name must outlive it
+		~Owner() { t_owner = m_previous; } //!< Close the owner
+		Owner(Owner& other) = delete; //!< Deleted copy constructor
+		Owner(Owner&& other) = delete; //!< Deleted move constructor
+		Owner& operator=(Owner& other) = delete; //!< Deleted copy assignment operator
+		Owner& operator=(Owner&& other) = delete; //!< Deleted move assignment operator
+	private:
+		const char* m_previous; //!< Owner to restore
+	};
+
+	static void onCreate(GPUResourceType type, uint32_t id, uint64_t bytes); //!< Charge the storage of a newly allocated GL object
+	static void onDestroy(GPUResourceType type, uint32_t id); //!< Give back a GL object's storage, any type sharing its GL namespace finds it, so a texture's destructor releases a render target
+
+	static void setBudget(uint64_t bytes) noexcept; //!< Set the total budget, zero removes it
+	static bool writeReport(const std::filesystem::path& path); //!< Write the totals by type and by owner as JSON
+
+	[[nodiscard]] static uint64_t getTotalBytes() noexcept; //!< Bytes held by every resource
+	[[nodiscard]] static uint64_t getPeakBytes() noexcept; //!< Most bytes held at once
+	[[nodiscard]] static uint64_t getBudget() noexcept; //!< Total budget, zero for none
+	[[nodiscard]] static GPUTypeStats getTypeStats(GPUResourceType type) noexcept; //!< Totals of one type
+	[[nodiscard]] static std::vector<GPUOwnerStats> getOwnerStats(); //!< Totals of every owner, largest first
+	[[nodiscard]] static const char* getName(GPUResourceType type) noexcept; //!< Name of a type
+
+	static constexpr size_t typeCount{ static_cast<size_t>(GPUResourceType::count) }; //!< Number of types
+private:
+	/** \struct Allocation
+	*	\brief A live GL object's storage
+	*/
+	struct Allocation
+	{
+		uint64_t bytes; //!< Bytes charged
+		uint32_t owner; //!< Index into s_owners
+		GPUResourceType type; //!< Type charged
+	};
+
+	[[nodiscard]] static uint64_t keyOf(GPUResourceType type, uint32_t id) noexcept; //!< Key of a GL object, unique within its GL namespace
+	[[nodiscard]] static uint32_t ownerIndex(const char* name); //!< Find or add an owner, the lock must be held
+
+	inline static std::mutex s_mutex; //!< Guards everything below, resources can be released on the render thread
+	inline static std::unordered_map<uint64_t, Allocation> s_allocations; //!< Live GL objects
+	inline static std::vector<GPUOwnerStats> s_owners; //!< Totals per owner, in order of first use
+	inline static std::array<GPUTypeStats, typeCount> s_types{}; //!< Totals per type
+	inline static uint64_t s_totalBytes{ 0 }; //!< Bytes held
+	inline static uint64_t s_peakBytes{ 0 }; //!< Most bytes held at once
+	inline static uint64_t s_budget{ 0 }; //!< Total budget, zero for none
+	inline static bool s_overBudget{ false }; //!< Is the total over the budget, so each crossing is only reported once
+	inline static thread_local const char* t_owner{ nullptr }; //!< Owner of resources created on this thread
+};
@@ -0,0 +1,62 @@
+/** \file hashGrid.hpp */
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "core/broadPhaseBackend.hpp"
+
+/** \class HashGrid
+*	\brief Uniform spatial hash grid broadphase.
+*	Space is cut into cubic cells and each box is listed in every cell it touches, with only occupied cells stored in
+*	a hash map. Moving a box costs nothing unless it crosses a cell boundary. A pair sharing several cells is only
+*	reported from the first cell they share, so no pair set is needed. Best when the boxes are of similar size and
+*	the cell is a little larger than the typical box.
+*/
+
+class HashGrid : public BroadPhaseBackend
+{
+public:
+	HashGrid() = default; //!< Default constructor
+	HashGrid(float cellSize) : m_cellSize(cellSize), m_inverseCellSize(1.f / cellSize) {} //!< Constructor which takes the cell size
+
+	void build(const std::vector<std::pair<entt::entity, AABB>>& boxes) override; //!< Replace the contents
+	void addEntity(entt::entity entity, const AABB& entityAABB) override; //!< List a box in its cells
+	void updateEntity(entt::entity entity, const AABB& entityAABB) override; //!< Move a box, only touching the cells if its range changed
+	void eraseEntity(entt::entity entity) override; //!< Remove a box from its cells
+	void clear() override; //!< Remove everything
+
+	const std::vector<EntityPair>& getPairs() override; //!< Pairs of entities whose boxes overlap
+	void query(const AABB& region, std::vector<entt::entity>& result) const override; //!< Test the boxes in the cells the region touches
+	[[nodiscard]] inline size_t size() const noexcept override { return m_boxes.size(); } //!< Number of boxes
+	[[nodiscard]] inline BroadPhaseType getType() const noexcept override { return BroadPhaseType::HashGrid; } //!< Which backend this is
+	[[nodiscard]] inline float getCellSize() const noexcept { return m_cellSize; } //!< Edge length of a cell
+	[[nodiscard]] inline size_t getCellCount() const noexcept { return m_cells.size(); } //!< Number of occupied cells
+private:
+	/** \struct Box */
+	struct Box
+	{
+		entt::entity entity; //!< Owner of the box
+		AABB bounds; //!< The box
+		glm::ivec3 cellMin; //!< First cell the box touches
+		glm::ivec3 cellMax; //!< Last cell the box touches
+	};
+
+	[[nodiscard]] inline glm::ivec3 cellOf(const glm::vec3& point) const noexcept { return glm::ivec3(glm::floor(point * m_inverseCellSize)); } //!< Cell containing a point
+	[[nodiscard]] static inline uint64_t cellKey(const glm::ivec3& cell) noexcept; //!< Pack a cell into a map key, 21 bits per axis
+	void link(uint32_t box); //!< List a box in each of its cells
+	void unlink(uint32_t box); //!< Take a box out of each of its cells
+
+	std::vector<Box> m_boxes; //!< Boxes, indexed by the cells
+	std::unordered_map<entt::entity, uint32_t> m_boxIndex; //!< Entity to box index
+	std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; //!< Occupied cells and the boxes in them
+	std::vector<EntityPair> m_pairs; //!< Pairs whose boxes overlap, rebuilt by getPairs when stale
+	bool m_pairsDirty{ true }; //!< Has anything moved since m_pairs was built
+
+	float m_cellSize{ 8.f }; //!< Edge length of a cell, a little over the average asteroid's diameter
+	float m_inverseCellSize{ 1.f / 8.f }; //!< Reciprocal of the cell size
+};
+
+uint64_t HashGrid::cellKey(const glm::ivec3& cell) noexcept
+{
+	constexpr uint64_t mask = (1ull << 21) - 1ull;
+	return ((static_cast<uint64_t>(cell.x) & mask) << 42) | ((static_cast<uint64_t>(cell.y) & mask) << 21) | (static_cast<uint64_t>(cell.z) & mask);
+}
@@ -0,0 +1,244 @@
+/** \file jobSystem.hpp */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class JobCounter;
+
+/** \struct Job
+*	\brief A function and its captured arguments, small enough to copy between queues by value
+*/
+struct Job
+{
+	static constexpr size_t payloadSize{ 48 }; //!< Bytes available for captures
+
+	void (*function)(Job& job) { nullptr }; //!< Entry point, reads its captures from data
+	JobCounter* counter{ nullptr }; //!< Decremented once the job has run, may be null
+	alignas(16) std::array<std::byte, payloadSize> data{}; //!< Captures, trivially copyable
+};
+
+/** \class JobCounter
+*	\brief Counts jobs which have been submitted but not yet run.
+*	Wait on it with JobSystem::wait, or give it continuations with JobSystem::runAfter, which are submitted as soon as
+*	the count reaches zero. The final decrement happens under a lock, so a waiter returning from wait can safely
+*	destroy the counter.
+*/
+class JobCounter
+{
+public:
+	JobCounter() = default; //!< Default constructor
+	JobCounter(JobCounter& other) = delete; //!< Deleted copy constructor
+	JobCounter(JobCounter&& other) = delete; //!< Deleted move constructor
+	JobCounter& operator=(JobCounter& other) = delete; //!< Deleted copy assignment operator
+	JobCounter& operator=(JobCounter&& other) = delete; //!< Deleted move assignment operator
+
+	[[nodiscard]] inline uint32_t getPending() const noexcept { return m_pending.load(std::memory_order_acquire); } //!< Jobs not yet run
+	[[nodiscard]] inline bool isDone() const noexcept { return getPending() == 0; } //!< Have all jobs run
+private:
+	friend class JobSystem;
+	std::atomic<uint32_t> m_pending{ 0 }; //!< Jobs not yet run
+	std::mutex m_mutex; //!< Guards the final decrement and the continuations
+	std::vector<Job> m_continuations; //!< Jobs to submit when the count reaches zero
+};
+
+/** \class WorkStealingDeque
+*	\brief Chase-Lev deque of jobs, after Le, Pop, Cohen and Zappa Nardelli's C11 formulation.
+*	The owning worker pushes and pops at the bottom without contention, other workers steal from the top with a
+*	single compare and swap. Jobs are stored by value in a fixed ring, a full deque refuses the push.
+*/
+class WorkStealingDeque
+{
+public:
+	static constexpr int64_t capacity{ 2048 }; //!< Jobs held before pushes are refused, a power of two
+
+	bool push(const Job& job); //!< Owner only, false when full
+	bool pop(Job& job); //!< Owner only, newest first
+	bool steal(Job& job); //!< Any thread, oldest first
+	[[nodiscard]] inline int64_t size() const noexcept { return std::max<int64_t>(0, m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed)); } //!< Approximate number of jobs
+private:
+	alignas(64) std::atomic<int64_t> m_top{ 0 }; //!< Next job to steal
+	alignas(64) std::atomic<int64_t> m_bottom{ 0 }; //!< Next free slot
+	alignas(64) std::array<Job, capacity> m_jobs; //!< Ring of jobs
+};
+
+/** \class JobSystem
+*	\brief Work stealing thread pool shared by the engine's parallel loops.
+*	init makes the calling thread the main thread, worker 0, and starts a worker per remaining hardware thread, each
+*	with its own deque and named for Tracy. A worker runs its own newest job first and, when it has none, steals the
+*	oldest job of another worker. Threads waiting on a counter run jobs rather than block. parallelFor splits a range
+*	lazily: a worker only hands half of its remaining range to the others while its own deque is empty, so ranges are
+*	split as often as idle workers need and no more. Jobs for GL work go to the main thread's queue, which it drains
+*	in runMainThreadJobs and while waiting. Without init, or from threads which are not workers, jobs run inline.
+*/
+class JobSystem
+{
+public:
+	static void init(uint32_t threadCount = 0); //!< Start the workers, 0 uses every hardware thread, the calling thread counts as one
+	static void shutdown(); //!< Finish and join the workers
+
+	template<typename Func> static void run(JobCounter& counter, Func&& func); //!< Submit a job
+	template<typename Func> static void runAfter(JobCounter& dependency, JobCounter& counter, Func&& func); //!< Submit a job once dependency reaches zero
+	template<typename Func> static void runOnMainThread(JobCounter& counter, Func&& func); //!< Queue a job which must run on the main thread, such as GL calls
+	template<typename Func> static void parallelFor(size_t begin, size_t end, Func&& func, size_t minGrain = 1, uint32_t maxThreads = 0); //!< Call func(first, last) over pieces of a range and wait, maxThreads of 0 allows every worker
+	static void wait(JobCounter& counter); //!< Run jobs until the counter reaches zero
+	static void runMainThreadJobs(); //!< Run the jobs queued for the main thread, main thread only
+
+	[[nodiscard]] static inline uint32_t getThreadCount() noexcept { return std::max<uint32_t>(1, static_cast<uint32_t>(s_workers.size())); } //!< Workers including the main thread
+	[[nodiscard]] static inline bool isRunning() noexcept { return s_running.load(std::memory_order_acquire); } //!< Have the workers been started
+	[[nodiscard]] static inline bool isMainThread() noexcept { return t_workerIndex == 0; } //!< Is the calling thread the one which called init
+	[[nodiscard]] static inline uint32_t getThreadIndex() noexcept { return t_workerIndex; } //!< Calling thread's worker index, 0 for the main thread, ~0u for threads the pool did not start
+
+	static constexpr uint32_t piecesPerThread{ 64 }; //!< parallelFor's smallest piece is the range over this many per worker, at least
+private:
+	static constexpr uint32_t notWorker{ ~0u }; //!< Worker index of threads the pool did not start
+
+	/** \struct Worker */
+	struct Worker
+	{
+		WorkStealingDeque deque; //!< Jobs submitted by this worker
+		std::thread thread; //!< The worker's thread, not used for the main thread
+	};
+
+	/** \struct ForRange */
+	template<typename Func>
+	struct ForRange
+	{
+		Func* func; //!< Body, owned by the parallelFor call
+		size_t begin; //!< First index
+		size_t end; //!< One past the last index
+		size_t grain; //!< Indices processed between splitting checks
+	};
+
+	template<typename Func> static Job makeJob(JobCounter* counter, Func&& func); //!< Pack a callable into a job
+	template<typename Func> static void runRange(Job& job); //!< Body of a parallelFor job
+	static void submit(const Job& job); //!< Push onto the calling worker's deque, or run inline
+	static void execute(Job job); //!< Run a job and count it off
+	static void finish(JobCounter* counter); //!< Count a job off, submitting continuations at zero
+	static bool tryRunOne(); //!< Run one of our jobs, or a stolen one, false if there were none
+	static bool hasWork(); //!< Does any deque hold a job
+	static void workerLoop(uint32_t index); //!< Body of a worker thread
+
+	inline static std::vector<std::unique_ptr<Worker>> s_workers; //!< Every worker, the main thread is index 0
+	inline static std::atomic<bool> s_running{ false }; //!< Cleared to stop the workers
+	inline static std::atomic<uint32_t> s_wake{ 0 }; //!< Bumped to wake sleeping workers
+	inline static std::atomic<uint32_t> s_sleeping{ 0 }; //!< Workers waiting on s_wake
+	inline static std::mutex s_mainMutex; //!< Guards s_mainJobs
+	inline static std::vector<Job> s_mainJobs; //!< Jobs which must run on the main thread
+	inline static thread_local uint32_t t_workerIndex{ notWorker }; //!< Calling thread's worker index
+};
+
+template<typename Func>
+Job JobSystem::makeJob(JobCounter* counter, Func&& func)
+{
+	using Callable = std::decay_t<Func>;
+	static_assert(sizeof(Callable) <= Job::payloadSize, "Job captures must fit in the payload, capture large data by reference");
+	static_assert(alignof(Callable) <= 16, "Job captures must not be over aligned");
+	static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>, "Job captures must be trivially copyable");
+
+	Job job;
+	job.counter = counter;
+	job.function = [](Job& self) { (*std::launder(reinterpret_cast<Callable*>(self.data.data())))(); };
+	new (job.data.data()) Callable(std::forward<Func>(func));
+	return job;
+}
+
+template<typename Func>
+void JobSystem::run(JobCounter& counter, Func&& func)
+{
+	counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+	submit(makeJob(&counter, std::forward<Func>(func)));
+}
+
+template<typename Func>
+void JobSystem::runAfter(JobCounter& dependency, JobCounter& counter, Func&& func)
+{
+	counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+	const Job job = makeJob(&counter, std::forward<Func>(func));
+	{
+		std::lock_guard<std::mutex> lock(dependency.m_mutex);
+		if (dependency.m_pending.load(std::memory_order_acquire) > 0) {
+			dependency.m_continuations.push_back(job);
+			return;
+		}
+	}
+	submit(job);
+}
+
+template<typename Func>
+void JobSystem::runOnMainThread(JobCounter& counter, Func&& func)
+{
+	counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+	const Job job = makeJob(&counter, std::forward<Func>(func));
+	if (isMainThread() || !isRunning()) {
+		execute(job);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(s_mainMutex);
+	s_mainJobs.push_back(job);
+}
+
+template<typename Func>
+void JobSystem::parallelFor(size_t begin, size_t end, Func&& func, size_t minGrain, uint32_t maxThreads)
+{
+	if (begin >= end) return;
+	const size_t count = end - begin;
+	const uint32_t threads = maxThreads > 0 ? std::min(maxThreads, getThreadCount()) : getThreadCount();
+
+	// Pieces are small enough for idle workers to take a share, and no smaller than the caller allows
+	size_t grain = std::max<size_t>({ minGrain, 1, count / (static_cast<size_t>(getThreadCount()) * piecesPerThread) });
+	if (maxThreads > 0) grain = std::max(grain, (count + threads - 1) / threads);
+
+	if (threads <= 1 || count <= grain || t_workerIndex == notWorker || !isRunning()) {
+		func(begin, end);
+		return;
+	}
+
+	using Body = std::remove_reference_t<Func>;
+	JobCounter counter;
+	counter.m_pending.store(1, std::memory_order_relaxed);
+	Job root;
+	root.counter = &counter;
+	root.function = &JobSystem::runRange<Body>;
+	const ForRange<Body> range{ &func, begin, end, grain };
+	std::memcpy(root.data.data(), &range, sizeof(range));
+	execute(root);
+	wait(counter);
+}
+
+template<typename Func>
+void JobSystem::runRange(Job& job)
+{
+	ForRange<Func> range;
+	std::memcpy(&range, job.data.data(), sizeof(range));
+	WorkStealingDeque& deque = s_workers[t_workerIndex]->deque;
+
+	while (range.begin < range.end)
+	{
+		// Lazy binary splitting, half the remainder is offered to thieves only once the last offer has been taken
+		if (range.end - range.begin > range.grain && deque.size() == 0) {
+			const size_t mid = range.begin + (range.end - range.begin) / 2;
+			Job half = job;
+			const ForRange<Func> upper{ range.func, mid, range.end, range.grain };
+			std::memcpy(half.data.data(), &upper, sizeof(upper));
+			job.counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+			submit(half);
+			range.end = mid;
+			continue;
+		}
+
+		const size_t pieceEnd = std::min(range.end, range.begin + range.grain);
+		(*range.func)(range.begin, pieceEnd);
+		range.begin = pieceEnd;
+	}
+}
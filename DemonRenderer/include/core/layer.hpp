@@ -7,17 +7,28 @@
 /**
 \class Layer
 \brief A convient abstraction of rendering and events into a layer which can be placed in the application.
-Intended for use as a base class. onRender and onUpdate must be implemented, thats why they are pure virtual functions.
+Intended for use as a base class. onUpdate must be implemented, thats why it is a pure virtual function.
 Event handling is optional, it is possible to just use the event handler some user input and other action may not be required.
 ImGUI renderering is also optional.
+A layer either draws in onRender, on the main thread, or splits drawing in two so the application can draw on a render
+thread: onExtract copies everything drawing needs into the frame's snapshot while the update thread owns the scene,
+and onRenderFrame draws from that snapshot alone. Such a layer returns true from useRenderThread; returning false,
+as the default does, falls back to calling onExtract and onRenderFrame back to back on the main thread.
+Simulation that must not depend on the frame rate goes in onFixedUpdate, which runs zero or more times a frame with the
+application's fixed step after onUpdate. onInterpolate then gives how far the frame is between the last two steps.
 */
 class Layer
 {
 public:
 	Layer(GLFWWindowImpl& win) : m_winRef(win) {}; //!< Constructor
-	virtual void onRender() = 0; //!< Runs when layer is renderered
+	virtual void onRender() {}; //!< Runs when layer is renderered
+	virtual void onExtract(uint64_t frame) {}; //!< Runs at the sync point between update and render, copy what onRenderFrame reads into the frame's snapshot
+	virtual void onRenderFrame(uint64_t frame) { onRender(); }; //!< Draw a frame, on the render thread when useRenderThread is true
+	[[nodiscard]] virtual bool useRenderThread() const { return false; } //!< Polled each frame, true when onRenderFrame only reads snapshots and GL objects
 	virtual void onImGUIRender() {}; //!< Runs when layer is renderered
 	virtual void onUpdate(float timestep) = 0;//!< Runs every frame
+	virtual void onFixedUpdate(float timestep) {}; //!< Runs once per fixed simulation step, timestep is always the step length
+	virtual void onInterpolate(float alpha) {}; //!< Runs every frame after the fixed steps, alpha is the fraction of a step still to simulate
 	virtual void onClose(WindowCloseEvent& e) {}; //!< Run when the window is closed
 	virtual void onResize(WindowResizeEvent& e) {}; //!< Run when the window is resized
 	virtual void onKeyPressed(KeyPressedEvent& e) {}; //!< Run when a key is press and the window is focused
@@ -0,0 +1,122 @@
+/** \file memoryResources.hpp */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/** \class FrameArena
+*	\brief Bump allocator for memory which only lives until the end of the frame.
+*	Allocating moves an offset through one block with a compare and swap, so any thread may allocate and deallocating
+*	does nothing. reset releases everything at once; it must not race with allocations, Memory::onFrameStart calls it
+*	before the layer updates. A frame which outgrows the block is served from overflow allocations and the next reset
+*	grows the block to fit, so the arena settles at the frame's high water mark. The block and overflow are reported to
+*	Tracy as a named memory pool and the bytes used each frame are plotted under the same name.
+*/
+class FrameArena final : public std::pmr::memory_resource
+{
+public:
+	explicit FrameArena(const char* name, size_t capacity = 1u << 20); //!< Constructor taking the Tracy pool name, which must outlive the arena, and the block size
+	~FrameArena() override; //!< Destructor, frees the block and any overflow
+	FrameArena(FrameArena& other) = delete; //!< Deleted copy constructor
+	FrameArena(FrameArena&& other) = delete; //!< Deleted move constructor
+	FrameArena& operator=(FrameArena& other) = delete; //!< Deleted copy assignment operator
+	FrameArena& operator=(FrameArena&& other) = delete; //!< Deleted move assignment operator
+
+	void reset(); //!< Release everything allocated since the last reset, growing the block if it overflowed
+	[[nodiscard]] inline const char* getName() const noexcept { return m_name; } //!< Tracy pool name
+	[[nodiscard]] inline size_t getCapacity() const noexcept { return m_capacity; } //!< Size of the block in bytes
+	[[nodiscard]] inline size_t getUsed() const noexcept { return m_offset.load(std::memory_order_relaxed) + m_overflowBytes; } //!< Bytes allocated since the last reset, only while no job is allocating
+	[[nodiscard]] inline size_t getLastUsed() const noexcept { return m_lastUsed; } //!< Bytes the previous frame allocated
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override; //!< Bump the offset, or overflow
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {} //!< Freed by reset
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; } //!< Only an arena can free its own memory
+	void* allocateOverflow(size_t bytes, size_t alignment); //!< Allocation which did not fit in the block
+
+	/** \struct Overflow
+	*	\brief An allocation made outside the block, freed by the next reset
+	*/
+	struct Overflow
+	{
+		void* ptr; //!< Start of the allocation
+		size_t bytes; //!< Size of the allocation
+		size_t alignment; //!< Alignment it was made with
+	};
+
+	const char* m_name; //!< Tracy pool name
+	std::byte* m_block{ nullptr }; //!< Memory handed out in order
+	size_t m_capacity{ 0 }; //!< Size of m_block
+	std::atomic<size_t> m_offset{ 0 }; //!< Bytes of m_block used, including alignment padding
+	std::mutex m_overflowMutex; //!< Guards the overflow list
+	std::vector<Overflow> m_overflow; //!< Allocations which did not fit this frame
+	size_t m_overflowBytes{ 0 }; //!< Bytes in m_overflow
+	size_t m_lastUsed{ 0 }; //!< Bytes the previous frame allocated
+};
+
+/** \class BlockPool
+*	\brief Fixed size block allocator for node based containers.
+*	Blocks are carved from chunks of blocksPerChunk and recycled through an intrusive free list, so a std::pmr map or
+*	set which inserts and erases every frame stops going to the heap once it has reached its largest size. Requests
+*	larger than a block, such as a hash table's bucket array, are passed through to the heap. Every block and passed
+*	through allocation in use is reported to Tracy under the pool's name. Not thread safe, give each container that is
+*	used from different threads its own pool.
+*/
+class BlockPool final : public std::pmr::memory_resource
+{
+public:
+	BlockPool(const char* name, size_t blockSize, size_t blocksPerChunk = 256); //!< Constructor taking the Tracy pool name, which must outlive the pool, the block size and how many blocks each chunk holds
+	~BlockPool() override; //!< Destructor, frees every chunk, containers using the pool must be destroyed first
+	BlockPool(BlockPool& other) = delete; //!< Deleted copy constructor
+	BlockPool(BlockPool&& other) = delete; //!< Deleted move constructor
+	BlockPool& operator=(BlockPool& other) = delete; //!< Deleted copy assignment operator
+	BlockPool& operator=(BlockPool&& other) = delete; //!< Deleted move assignment operator
+
+	[[nodiscard]] inline const char* getName() const noexcept { return m_name; } //!< Tracy pool name
+	[[nodiscard]] inline size_t getBlockSize() const noexcept { return m_blockSize; } //!< Largest allocation served from a block
+	[[nodiscard]] inline size_t getBlocksInUse() const noexcept { return m_blocksInUse; } //!< Blocks handed out and not returned
+	[[nodiscard]] inline size_t getChunkCount() const noexcept { return m_chunks.size(); } //!< Chunks allocated so far
+	[[nodiscard]] inline size_t getPassedThrough() const noexcept { return m_passedThrough; } //!< Allocations too large for a block currently in use
+
+	static constexpr size_t blockAlignment{ alignof(std::max_align_t) }; //!< Alignment of every block
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override; //!< Pop a block, or pass through to the heap
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override; //!< Push a block back, or free a passed through allocation
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; } //!< Only a pool can take its own blocks back
+	[[nodiscard]] inline bool fits(size_t bytes, size_t alignment) const noexcept { return bytes <= m_blockSize && alignment <= blockAlignment; } //!< Is a request served from a block
+	void grow(); //!< Add a chunk and thread its blocks onto the free list
+
+	/** \struct FreeBlock
+	*	\brief A block on the free list, overlaid on the block's own memory
+	*/
+	struct FreeBlock
+	{
+		FreeBlock* next; //!< Next free block
+	};
+
+	const char* m_name; //!< Tracy pool name
+	size_t m_blockSize; //!< Block size, a multiple of blockAlignment
+	size_t m_blocksPerChunk; //!< Blocks in each chunk
+	std::vector<std::byte*> m_chunks; //!< Chunks to free on destruction
+	FreeBlock* m_free{ nullptr }; //!< Head of the free list
+	size_t m_blocksInUse{ 0 }; //!< Blocks handed out
+	size_t m_passedThrough{ 0 }; //!< Oversized allocations live
+};
+
+/** \class Memory
+*	\brief Engine wide memory resources.
+*	frame is the per frame arena, for scratch containers which are filled and dropped within one update, for example
+*	std::pmr::vector<int32_t> stack(&Memory::frame()). Nothing allocated from it may be kept past the frame, so members,
+*	snapshots for the render thread and anything a job can still touch after the frame ends must use the heap.
+*/
+class Memory
+{
+public:
+	[[nodiscard]] static inline FrameArena& frame() noexcept { return s_frame; } //!< The per frame arena
+	static void onFrameStart(); //!< Release the previous frame's scratch memory, called by the application at the frame mark
+private:
+	inline static FrameArena s_frame{ "Frame arena" }; //!< Scratch memory for one frame
+};
@@ -0,0 +1,121 @@
+/** \file memoryTracker.hpp */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/** \enum MemoryTag
+*	\brief Subsystem a heap allocation is charged to
+*/
+enum class MemoryTag : uint8_t
+{
+	untagged, //!< Allocated outside of any tagged scope
+	assets, //!< Imported models, decoded images and shader sources
+	ecs, //!< Registry storage, scripts and deferred commands
+	physics, //!< Broadphase structures and sensors
+	rendering, //!< Extraction, render passes and particles
+	ui, //!< ImGui and the layer's widgets
+	count //!< Number of tags
+};
+
+/** \enum MemoryBudgetAction
+*	\brief What happens when a tag goes over its budget
+*/
+enum class MemoryBudgetAction : uint8_t
+{
+	log, //!< Log an error once per crossing
+	fail //!< Log an error and assert, stopping debug builds
+};
+
+/** \struct MemoryTagStats
+*	\brief Counters of one tag
+*/
+struct MemoryTagStats
+{
+	const char* name{ nullptr }; //!< Name of the tag
+	uint64_t currentBytes{ 0 }; //!< Bytes allocated and not freed
+	uint64_t peakBytes{ 0 }; //!< Most bytes held at once since the peaks were reset
+	uint64_t liveAllocations{ 0 }; //!< Allocations not freed
+	uint64_t totalAllocations{ 0 }; //!< Allocations made since startup
+	uint64_t budgetBytes{ 0 }; //!< Budget, zero for none
+	MemoryBudgetAction action{ MemoryBudgetAction::log }; //!< What going over the budget does
+	bool overBudget{ false }; //!< Was the budget exceeded in the last frame
+};
+
+/** \class MemoryTracker
+*	\brief Charges every heap allocation made through the global operator new to a subsystem tag.
+*	The tag is the innermost MemoryTracker::Scope open on the allocating thread. Each block carries a small header with
+*	its size and tag, so a free is charged back to the tag that made it whichever thread frees it. Memory whose header
+*	does not check out, such as a block the runtime allocated itself and handed to this operator delete, is freed as is. Current, peak and
+*	allocation counts are kept per tag; budgets are checked at the end of each frame against the frame's peak, so a
+*	spike within the frame is still caught. The counters are plotted in Tracy and can be written out as JSON.
+*	Aligned allocations and the pools in memoryResources.hpp bypass the hook and are not counted.
+*/
+class MemoryTracker
+{
+public:
+	/** \class Scope
+	*	\brief Charges the calling thread's allocations to a tag for the scope's lifetime, restoring the outer tag after
+	*/
+	class Scope
+	{
+	public:
+		explicit Scope(MemoryTag tag) noexcept : m_previous(t_tag) { t_tag = tag; } //!< Open a scope
+		~Scope() { t_tag = m_previous; } //!< Close the scope
+		Scope(Scope& other) = delete; //!< Deleted copy constructor
+		Scope(Scope&& other) = delete; //!< Deleted move constructor
+		Scope& operator=(Scope& other) = delete; //!< Deleted copy assignment operator
+		Scope& operator=(Scope&& other) = delete; //!< Deleted move assignment operator
+	private:
+		MemoryTag m_previous; //!< Tag to restore
+	};
+
+	[[nodiscard]] static void* onAllocate(void* block, size_t bytes) noexcept; //!< Write the header to a block of headerSize + bytes and charge it, returns the memory after the header, called by operator new
+	[[nodiscard]] static void* onFree(void* ptr) noexcept; //!< Charge a free back to its tag, returns the block to release, called by operator delete
+	static void onFrameEnd(); //!< Check the budgets and plot the counters, called by the application
+
+	static void setBudget(MemoryTag tag, uint64_t bytes, MemoryBudgetAction action = MemoryBudgetAction::log) noexcept; //!< Set a tag's budget, zero removes it
+	static void resetPeaks() noexcept; //!< Start the peaks again from the current bytes
+	static bool writeReport(const std::filesystem::path& path); //!< Write every tag's counters as JSON
+
+	[[nodiscard]] static MemoryTagStats getStats(MemoryTag tag) noexcept; //!< Counters of a tag
+	[[nodiscard]] static const char* getName(MemoryTag tag) noexcept; //!< Name of a tag
+	[[nodiscard]] static uint64_t getTotalBytes() noexcept; //!< Bytes held across every tag
+	[[nodiscard]] static inline MemoryTag getCurrentTag() noexcept { return t_tag; } //!< Tag the calling thread is allocating under
+
+	static constexpr size_t headerSize{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ }; //!< Bytes in front of each block, keeping the memory after it aligned as operator new must
+	static constexpr size_t tagCount{ static_cast<size_t>(MemoryTag::count) }; //!< Number of tags
+private:
+	/** \struct Header
+	*	\brief Written in front of each allocation
+	*/
+	struct Header
+	{
+		uint64_t bytes; //!< Size requested
+		uint32_t check; //!< Derived from the block's address, so memory the hook never saw is recognised on free
+		MemoryTag tag; //!< Tag charged
+	};
+	static_assert(sizeof(Header) <= headerSize, "The allocation header must fit in front of the block");
+	[[nodiscard]] static inline uint32_t checkFor(const void* block, uint64_t bytes) noexcept { return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(block) ^ bytes) * 0x9E3779B97F4A7C15ull >> 32); } //!< Header check value
+
+	/** \struct TagCounters
+	*	\brief Lock free counters of one tag, with its budget which only the main thread touches
+	*/
+	struct TagCounters
+	{
+		std::atomic<uint64_t> currentBytes{ 0 }; //!< Bytes held
+		std::atomic<uint64_t> peakBytes{ 0 }; //!< Most bytes held since the peaks were reset
+		std::atomic<uint64_t> framePeakBytes{ 0 }; //!< Most bytes held this frame
+		std::atomic<uint64_t> liveAllocations{ 0 }; //!< Allocations not freed
+		std::atomic<uint64_t> totalAllocations{ 0 }; //!< Allocations made
+		uint64_t budgetBytes{ 0 }; //!< Budget, zero for none
+		MemoryBudgetAction action{ MemoryBudgetAction::log }; //!< What going over the budget does
+		bool overBudget{ false }; //!< Was the budget exceeded last frame, so each crossing is only reported once
+	};
+
+	static std::array<TagCounters, tagCount> s_tags; //!< Per tag counters, defined with the source as TagCounters is incomplete in here
+	inline static thread_local MemoryTag t_tag{ MemoryTag::untagged }; //!< Tag of the innermost scope on this thread
+};
@@ -0,0 +1,93 @@
+/** \file narrowPhase.hpp */
+#pragma once
+#include <array>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include "components/colliders.hpp"
+#include "components/transform.hpp"
+#include "core/broadPhaseBackend.hpp"
+
+/** \struct OrientedBox
+*	\brief A world space OBB, read from an OBBCollider and its WorldMatrix once rather than per query
+*/
+struct OrientedBox
+{
+	glm::vec3 centre{ 0.f }; //!< World position
+	std::array<glm::vec3, 3> axes{ glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f, 1.f, 0.f), glm::vec3(0.f, 0.f, 1.f) }; //!< Unit right, up and back axes
+	glm::vec3 halfExtents{ 0.f }; //!< Half size along each axis, in world units
+	static OrientedBox fromCollider(const OBBCollider& obb, const WorldMatrix& world); //!< Build from a collider, removing any scale from the axes
+	[[nodiscard]] AABB getBounds() const; //!< Axis aligned box around the OBB
+};
+
+/** \class SphereBatch
+*	\brief Sphere centres and radii laid out as separate arrays so the narrow phase can load eight at a time
+*/
+class SphereBatch
+{
+public:
+	void clear(); //!< Remove every sphere
+	void reserve(size_t count); //!< Reserve space for a number of spheres
+	void add(entt::entity entity, const glm::vec3& centre, float radius); //!< Add a sphere, a radius of zero makes it a point
+	void gather(const entt::registry& registry, const std::vector<entt::entity>& entities); //!< Add the sphere colliders among some entities, such as broadphase candidates
+	void gatherAll(const entt::registry& registry); //!< Add every sphere collider in the registry
+	[[nodiscard]] inline size_t size() const noexcept { return m_entities.size(); } //!< Number of spheres
+	[[nodiscard]] inline const float* getX() const noexcept { return m_x.data(); } //!< Centre x of every sphere
+	[[nodiscard]] inline const float* getY() const noexcept { return m_y.data(); } //!< Centre y of every sphere
+	[[nodiscard]] inline const float* getZ() const noexcept { return m_z.data(); } //!< Centre z of every sphere
+	[[nodiscard]] inline const float* getRadius() const noexcept { return m_radius.data(); } //!< Radius of every sphere
+	[[nodiscard]] inline const std::vector<entt::entity>& getEntities() const noexcept { return m_entities; } //!< Owner of every sphere
+private:
+	std::vector<float> m_x; //!< Centre x
+	std::vector<float> m_y; //!< Centre y
+	std::vector<float> m_z; //!< Centre z
+	std::vector<float> m_radius; //!< Radius
+	std::vector<entt::entity> m_entities; //!< Owners
+};
+
+/** \class BoxSpherePairBatch
+*	\brief OBB and sphere pairs laid out as separate arrays, one lane per pair, so every lane can hold a different box
+*/
+class BoxSpherePairBatch
+{
+public:
+	static constexpr size_t centreField{ 0 }; //!< First of the box centre's x, y and z arrays
+	static constexpr size_t axesField{ 3 }; //!< First of the nine axis arrays, axis k component j is at axesField + 3k + j
+	static constexpr size_t halfExtentsField{ 12 }; //!< First of the half extent arrays
+	static constexpr size_t sphereField{ 15 }; //!< First of the sphere centre's x, y and z arrays, followed by the radius
+	static constexpr size_t fieldCount{ 19 }; //!< Number of arrays
+
+	void clear(); //!< Remove every pair
+	void add(const OrientedBox& box, entt::entity boxEntity, const glm::vec3& centre, float radius, entt::entity sphereEntity); //!< Add a pair
+	void gather(const entt::registry& registry, const std::vector<EntityPair>& pairs); //!< Add the broadphase pairs made of one OBB collider and one sphere collider
+	[[nodiscard]] inline size_t size() const noexcept { return m_pairs.size(); } //!< Number of pairs
+	[[nodiscard]] inline const float* getField(size_t field) const noexcept { return m_fields[field].data(); } //!< One of the arrays
+	[[nodiscard]] inline const std::vector<EntityPair>& getPairs() const noexcept { return m_pairs; } //!< Box then sphere entity of every pair
+private:
+	std::array<std::vector<float>, fieldCount> m_fields; //!< Box and sphere data, one array per scalar
+	std::vector<EntityPair> m_pairs; //!< Box then sphere entity of every pair
+};
+
+/** \class NarrowPhase
+*	\brief Batched OBB to point and OBB to sphere distances.
+*	Distances are evaluated eight lanes at a time with AVX2 when the CPU supports it, otherwise by the scalar fallback,
+*	which computes the same expression one lane at a time. The distance to a box is the length of the per axis
+*	excess of the point's projection over the half extents, which is zero inside the box. distanceToPoint is the
+*	closest point construction from Real-Time Collision Detection and is kept as the reference the batches are
+*	validated against.
+*/
+class NarrowPhase
+{
+public:
+	static float distanceToPoint(const OrientedBox& box, const glm::vec3& point); //!< Reference distance from a box to a point
+	static void distancesToPoints(const OrientedBox& box, const float* x, const float* y, const float* z, size_t count, float* out); //!< One box against many points
+	static void distancesToSpheres(const OrientedBox& box, const SphereBatch& spheres, std::vector<float>& out); //!< One box against many spheres, negative when overlapping
+	static void distancesForPairs(const BoxSpherePairBatch& pairs, std::vector<float>& out); //!< Each pair's box against its sphere, negative when overlapping
+
+	static bool hasAVX2(); //!< Can this CPU run the AVX2 path
+	static void setSIMDEnabled(bool enabled); //!< Use the AVX2 path when available, off forces the scalar fallback
+	[[nodiscard]] static bool isSIMDEnabled() noexcept { return s_useSIMD; } //!< Is the AVX2 path in use
+	static bool validate(uint32_t count = 10007, uint32_t seed = 1); //!< Check both paths against the reference on random boxes and points, logging any mismatch
+private:
+	static bool s_useSIMD; //!< Use the AVX2 path, only ever true when the CPU supports it
+};
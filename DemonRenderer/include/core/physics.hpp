@@ -2,6 +2,12 @@
 #pragma once
 
 #include "core/planeSweep.hpp"
+#include "core/aabbTree.hpp"
+#include "core/hashGrid.hpp"
+#include "core/narrowPhase.hpp"
+#include "core/proximityCache.hpp"
+#include "core/spatialIndex.hpp"
+#include "core/memoryResources.hpp"
 #include "rendering/scene.hpp"
 //#include "gameObjects/collidable.hpp"
 #include "components/colliders.hpp"
@@ -10,7 +16,7 @@
 
 namespace Physics
 {
-	float DistanceOBBToPoint(Scene* scene, const OBBCollider& obb, const glm::vec3& point); //!< Distance between an OBB and a point
+	float DistanceOBBToPoint(Scene* scene, const OBBCollider& obb, const glm::vec3& point); //!< Distance between an OBB and a point, see NarrowPhase for batches
 	float DistanceOBBToSphere(Scene* scene, const OBBCollider& obb, const SphereCollider& sphere); //!< Distance between an OBB and a sphere
 }
 
@@ -18,28 +24,51 @@ using AABB = std::pair<glm::vec3, glm::vec3>;
 
 /** \class BroadPhase
 *	\brief BroadPhase physics. Maintains a subset of entities which need checking for collisions
+*	Every collider's AABB is kept in one broadphase backend, which can be swapped at runtime. Each update refreshes
+*	the AABBs of colliders which have moved, the backend updates just those boxes, and the overlapping pairs are
+*	read straight from it. Sensors track which colliders are within distance shells of a moving box and report only
+*	the changes, see ProximityCache. Radius and k nearest queries go through a k-d tree over the colliders' bounding
+*	spheres, rebuilt on first use after any collider has moved, see SpatialIndex. Colliders created or destroyed
+*	through the scene's CommandBuffer join and leave in one go when it is applied.
 */
 
 class BroadPhase
 {
 public:
 	BroadPhase() = default; //!< Default constructor
+	~BroadPhase(); //!< Destructor which disconnects from the scene's command buffer
 	void init(std::shared_ptr<Scene> scene); //!< Initialise all internal structures
 	void onUpdate(float timestep); //!< Runs once per frame
 public:
-	std::vector<entt::entity> OOBcandidates; //!< Candidate entities for collision checks
-	std::vector<entt::entity> sphereCandidates; //!< Candidate entities for collision checks
+	std::vector<entt::entity> OOBcandidates; //!< OBB collider entities in at least one overlapping pair
+	std::vector<entt::entity> sphereCandidates; //!< Sphere collider entities in at least one overlapping pair
 	void erase(entt::entity entity); //!< Erase entity from the broadphase model
 
-	const std::unordered_map<entt::entity, AABB>& getBoxColliderAABBs() const { return m_BoxColliderAABBs; } //!< A getter for the box collider AABBS
-	const std::unordered_map<entt::entity, AABB>& getSphereColliderAABBs() const { return m_SphereColliderAABBs; } //!< A getter for the sphere collider AABBS
+	void setBackend(BroadPhaseType type); //!< Switch backend, the new one is built from the current AABBs
+	[[nodiscard]] inline BroadPhaseType getBackendType() const noexcept { return m_backend->getType(); } //!< The backend in use
+	[[nodiscard]] static std::unique_ptr<BroadPhaseBackend> createBackend(BroadPhaseType type); //!< Make a backend with the settings used for the belt
+	const std::vector<EntityPair>& getPairs() { return m_backend->getPairs(); } //!< Pairs of colliders whose AABBs overlap
+	void query(const AABB& region, std::vector<entt::entity>& result) const; //!< Append the colliders whose AABBs overlap a region
+
+	uint32_t addSensor(ProximityTarget target, const std::vector<float>& shells) { return m_proximity.addSensor(target, shells); } //!< Add a proximity sensor with distance shells
+	void updateSensor(uint32_t sensor, const OrientedBox& shape); //!< Move a sensor, measuring the colliders near it and appending proximity events
+	const std::vector<ProximityEvent>& getProximityEvents() const noexcept { return m_proximity.getEvents(); } //!< Events from the sensors updated since onUpdate
+	const SpatialIndex& getSpatialIndex(); //!< Bounding spheres of every collider, rebuilt if any have changed since it was last used
+	const std::pmr::unordered_map<entt::entity, AABB>& getBoxColliderAABBs() const { return m_BoxColliderAABBs; } //!< A getter for the box collider AABBS
+	const std::pmr::unordered_map<entt::entity, AABB>& getSphereColliderAABBs() const { return m_SphereColliderAABBs; } //!< A getter for the sphere collider AABBS
 
 private:
-	std::unordered_map<entt::entity, AABB> m_BoxColliderAABBs; //!< AABBs for entities with OBB colliders
-	std::unordered_map<entt::entity, AABB> m_SphereColliderAABBs; //!< AABBs for entities with sphere colliders
+	void onCommandsApplied(const CommandBatch& batch); //!< Add created colliders and erase destroyed ones
+
+	BlockPool m_colliderNodes{ "Collider AABB nodes", 48 }; //!< Nodes of both AABB maps, asteroids join and leave them as the belt is mined
+	std::pmr::unordered_map<entt::entity, AABB> m_BoxColliderAABBs{ &m_colliderNodes }; //!< AABBs for entities with OBB colliders
+	std::pmr::unordered_map<entt::entity, AABB> m_SphereColliderAABBs{ &m_colliderNodes }; //!< AABBs for entities with sphere colliders
 	std::shared_ptr<Scene> m_scene; //!< Create a shared pointer for the main scene
 
-	PlaneSweep m_OBBPlaneSweep; //!< Create a planesweep for the OBBs
-	PlaneSweep m_spherePlaneSweep; //!< Create a planesweep for the sphere colliders
+	ProximityCache m_proximity; //!< Sensor to collider pairs and their events
+	std::vector<entt::entity> m_sensorCandidates; //!< Scratch for sensor queries
+	SpatialIndex m_index; //!< Radius and nearest queries over the colliders
+	bool m_indexDirty{ true }; //!< Has a collider changed since m_index was built
+	std::unique_ptr<BroadPhaseBackend> m_backend{ createBackend(BroadPhaseType::AABBTree) }; //!< Backend holding every collider
 
-};
\ No newline at end of file
+};
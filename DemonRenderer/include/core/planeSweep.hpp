@@ -1,37 +1,74 @@
+/** \file planeSweep.hpp */
 #pragma once
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
-#include <entt/entt.hpp>
-#include <glm/glm.hpp>
-
-using AABB = std::pair<glm::vec3, glm::vec3>;
+#include "core/broadPhaseBackend.hpp"
 
 /** \class PlaneSweep
-*	\brief A broad phase approach which looks at everything with a window, and intervals along the negative z-axis
-*
+*	\brief Incremental sweep and prune along one axis, the z-axis by default.
+*	Box endpoints are kept in a single sorted array. A bulk build sorts once and sweeps to find the initial overlaps,
+*	after which moving a box insertion sorts just its two endpoints. Because boxes move little between frames each
+*	endpoint only travels a few places, and every time a min passes a max the pair's overlap on the axis is retested
+*	and the persistent pair set updated. getPairs filters those pairs down to boxes which overlap on all three axes.
+*	Boxes are grown along the sweep axis by the window, behind by x and ahead by y.
+*	Works best when the boxes are spread along the sweep axis, as a belt running down z is.
 */
 
-class PlaneSweep
+class PlaneSweep : public BroadPhaseBackend
 {
 
 public:
 
 	PlaneSweep() = default;
-	PlaneSweep(glm::vec2 windowSize) : m_window(windowSize) {} //!< Constructor which takes a window
+	PlaneSweep(glm::vec2 windowSize, int axis = 2) : m_window(windowSize), m_axis(axis) {} //!< Constructor which takes a window and the axis to sweep
+
+	void build(const std::vector<std::pair<entt::entity, AABB>>& boxes) override; //!< Replace the contents with one sort and one sweep
+	void addEntity(entt::entity entity, const AABB& entityAABB) override; //!< Add entity to the data structures
+	void updateEntity(entt::entity entity, const AABB& entityAABB) override; //!< Move an entity's box, cheap when it has moved a little
+	void eraseEntity(entt::entity entity) override; //!< Erase from the data structures
+	void clear() override; //!< Remove everything
 
-	const std::vector<entt::entity>& getCloseEntities(const AABB& ship); //!< Gets entities in the interval
-	void addEntity(entt::entity entity, const AABB& entityAABB); //!< Add entity to the data structures
-	void eraseEntity(entt::entity entity); //!< Erase from the data structures
+	const std::vector<EntityPair>& getPairs() override; //!< Pairs of entities whose boxes overlap
+	void query(const AABB& region, std::vector<entt::entity>& result) const override; //!< Binary search the axis and scan the boxes which could reach the region
+	[[nodiscard]] inline size_t size() const noexcept override { return m_boxes.size(); } //!< Number of boxes
+	[[nodiscard]] inline BroadPhaseType getType() const noexcept override { return BroadPhaseType::PlaneSweep; } //!< Which backend this is
+	[[nodiscard]] inline size_t getAxisPairCount() const noexcept { return m_pairSet.size(); } //!< Pairs overlapping on the sweep axis only
 
 private:
 
-	std::vector<std::pair<float, entt::entity>> m_startPoints; //!< Points when entities start in the z-axis
-	std::vector<std::pair<float, entt::entity>> m_endPoints; //!< Points when entities end in the z-axis
-	std::vector<entt::entity> m_closeEntities; //!< Vector of entities currently in the window
+	/** \struct Endpoint */
+	struct Endpoint
+	{
+		float value; //!< Position along the sweep axis
+		uint32_t box; //!< Index into m_boxes
+		bool isMin; //!< Start or end of the box
+	};
+
+	/** \struct Box */
+	struct Box
+	{
+		entt::entity entity; //!< Owner of the box
+		AABB bounds; //!< Box without the window
+		uint32_t minEndpoint; //!< Index of the start in m_endpoints
+		uint32_t maxEndpoint; //!< Index of the end in m_endpoints
+	};
+
+	inline float lowOf(const AABB& box) const noexcept { return box.first[m_axis] - m_window.x; } //!< Start along the sweep axis
+	inline float highOf(const AABB& box) const noexcept { return box.second[m_axis] + m_window.y; } //!< End along the sweep axis
+	void swapEndpoints(uint32_t a, uint32_t b); //!< Exchange neighbouring endpoints and update the pair set if a min passed a max
+	void sortEndpoint(uint32_t index); //!< Insertion sort one endpoint into place
 
-	std::vector<std::pair<float, entt::entity>>::iterator m_startPosition{ m_startPoints.begin() }; //!< Position in start points
-	std::vector<std::pair<float, entt::entity>>::iterator m_endPosition{ m_endPoints.begin() }; //!< Position in end points
+	std::vector<Endpoint> m_endpoints; //!< Start and end points of every box, sorted along the sweep axis
+	std::vector<Box> m_boxes; //!< Boxes, indexed by endpoints
+	std::unordered_map<entt::entity, uint32_t> m_boxIndex; //!< Entity to box index
+	std::unordered_set<uint64_t> m_pairSet; //!< Pairs overlapping on the sweep axis
+	std::vector<EntityPair> m_pairs; //!< Pairs overlapping on every axis, rebuilt by getPairs when stale
+	bool m_pairsDirty{ true }; //!< Has anything moved since m_pairs was built
+	float m_maxExtent{ 0.f }; //!< Longest box along the sweep axis so far, bounds how far back a query looks
 
 	glm::vec2 m_window{ 0.5f, 0.2f }; //!< Window to be used for the planesweep
+	int m_axis{ 2 }; //!< Axis being swept
 
-};
\ No newline at end of file
+};
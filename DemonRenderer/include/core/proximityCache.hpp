@@ -0,0 +1,76 @@
+/** \file proximityCache.hpp */
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "core/narrowPhase.hpp"
+
+/** \enum ProximityPhase
+*	\brief How an entity's membership of a shell changed this frame
+*/
+enum class ProximityPhase : uint8_t
+{
+	enter, //!< Inside the shell this frame but not last frame
+	stay, //!< Inside the shell this frame and last frame
+	exit //!< Inside the shell last frame but not this frame
+};
+
+/** \enum ProximityTarget
+*	\brief Which colliders a sensor measures its distance to
+*/
+enum class ProximityTarget : uint8_t
+{
+	spheres, //!< Sphere colliders, measured from the sensor's box
+	boxes //!< OBB colliders, measured from the sensor's centre
+};
+
+/** \struct ProximityEvent
+*	\brief A change, or lack of one, in an entity's distance from a sensor
+*/
+struct ProximityEvent
+{
+	uint32_t sensor; //!< Sensor which measured the distance
+	uint32_t shell; //!< Index of the shell, shells are ordered nearest first
+	entt::entity entity; //!< Collider entity
+	ProximityPhase phase; //!< Enter, stay or exit
+	float distance; //!< Distance this frame, infinity if it has left the broadphase query
+};
+
+/** \class ProximityCache
+*	\brief Persistent sensor to collider pairs, bucketed into distance shells.
+*	Each sensor has ascending shell distances and remembers the innermost shell every nearby collider was inside last
+*	frame. An update is given the broadphase candidates around the sensor, measures them all in one narrow phase batch
+*	and compares each collider's innermost shell with the remembered one. Entering a shell emits enter, remaining emits
+*	stay and leaving, or dropping out of the candidates, emits exit. The cost follows the number of nearby colliders
+*	rather than the number in the scene.
+*/
+class ProximityCache
+{
+public:
+	uint32_t addSensor(ProximityTarget target, const std::vector<float>& shells); //!< Add a sensor with shells, a distance under a shell's value is inside it
+	[[nodiscard]] float getRange(uint32_t sensor) const; //!< Distance of the outermost shell
+	[[nodiscard]] ProximityTarget getTarget(uint32_t sensor) const { return m_sensors[sensor].target; } //!< What the sensor measures to
+	void update(uint32_t sensor, const OrientedBox& shape, const entt::registry& registry, const std::vector<entt::entity>& candidates); //!< Measure the candidates and append events
+	void beginFrame() { m_events.clear(); } //!< Clear last frame's events
+	void erase(entt::entity entity); //!< Forget an entity without emitting events, for when it is destroyed
+	void reset(); //!< Forget every tracked entity, keeping the sensors
+	[[nodiscard]] const std::vector<ProximityEvent>& getEvents() const noexcept { return m_events; } //!< Events from every sensor updated this frame
+	[[nodiscard]] size_t getTrackedCount(uint32_t sensor) const { return m_sensors[sensor].inside.size(); } //!< Colliders inside any of a sensor's shells
+private:
+	/** \struct Sensor */
+	struct Sensor
+	{
+		ProximityTarget target; //!< What the sensor measures to
+		std::vector<float> shells; //!< Shell distances, ascending
+		std::unordered_map<entt::entity, uint32_t> inside; //!< Innermost shell each tracked collider was inside last frame
+	};
+
+	void emit(uint32_t sensor, entt::entity entity, uint32_t previous, uint32_t current, float distance); //!< Events for a change between innermost shells
+
+	std::vector<Sensor> m_sensors; //!< All sensors
+	std::vector<ProximityEvent> m_events; //!< Events since beginFrame
+	std::unordered_map<entt::entity, uint32_t> m_current; //!< Scratch, innermost shells this frame
+	std::vector<entt::entity> m_measured; //!< Scratch, candidates which were measured
+	std::vector<float> m_distances; //!< Scratch, distance of each measured candidate
+	SphereBatch m_spheres; //!< Scratch, sphere candidates
+	BoxSpherePairBatch m_boxes; //!< Scratch, box candidates paired with the sensor's centre
+};
@@ -0,0 +1,57 @@
+/** \file renderThread.hpp */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct GLFWwindow;
+
+/** \class RenderThread
+*	\brief Owns the GL context and draws frames from snapshots while the update thread simulates the next one.
+*	start moves the window's context to a new thread. Each frame the update thread fills a snapshot and calls submit,
+*	which waits for the previous frame to finish drawing before handing this one over, so the update thread is never
+*	more than one frame ahead and input reaches the screen at most a frame later than when single threaded. Snapshots
+*	are double buffered: while frame N is drawn from one slot, frame N + 1 is written to the other. The render function
+*	must only read its frame's snapshot and GL objects; ResourceRegistry::onFrameEnd runs there too, so resources must
+*	not be created or destroyed from the update thread while the render thread is running. stop gives the context back.
+*/
+class RenderThread
+{
+public:
+	RenderThread() = default; //!< Default constructor
+	RenderThread(RenderThread& other) = delete; //!< Deleted copy constructor
+	RenderThread(RenderThread&& other) = delete; //!< Deleted move constructor
+	RenderThread& operator=(RenderThread& other) = delete; //!< Deleted copy assignment operator
+	RenderThread& operator=(RenderThread&& other) = delete; //!< Deleted move assignment operator
+	~RenderThread() { stop(); } //!< Destructor, stops the thread
+
+	void start(GLFWwindow* window, std::function<void(uint64_t)> renderFrame); //!< Release the window's context on this thread and start drawing on a new one
+	void stop(); //!< Draw the frame in flight, join and make the context current on the calling thread again
+	void submit(uint64_t frame); //!< Wait for the previous frame to be drawn, then hand over this frame's snapshot
+
+	[[nodiscard]] inline bool isRunning() const noexcept { return m_thread.joinable(); } //!< Has the thread been started
+	[[nodiscard]] inline float getWaitMs() const noexcept { return m_waitMs; } //!< Time the last submit waited for the render thread
+	[[nodiscard]] inline float getRenderMs() const noexcept { return m_renderMs.load(std::memory_order_relaxed); } //!< Time the render thread took to draw its last frame
+	[[nodiscard]] static inline bool isRenderThread() noexcept { return t_isRenderThread; } //!< Is the calling thread a render thread
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void loop(); //!< Body of the render thread
+
+	GLFWwindow* m_window{ nullptr }; //!< Window whose context the thread owns
+	std::function<void(uint64_t)> m_renderFrame; //!< Draws a frame from its snapshot
+	std::thread m_thread; //!< The render thread
+	std::mutex m_mutex; //!< Guards the hand over
+	std::condition_variable m_handOver; //!< Signalled when a frame is submitted, finished or the thread is stopped
+	uint64_t m_frame{ 0 }; //!< Frame handed over
+	bool m_pending{ false }; //!< Is a frame submitted and not yet drawn
+	bool m_stopping{ false }; //!< Should the thread exit once nothing is pending
+	float m_waitMs{ 0.f }; //!< Time the last submit waited
+	std::atomic<float> m_renderMs{ 0.f }; //!< Time the last frame took to draw
+	inline static thread_local bool t_isRenderThread{ false }; //!< Set on the render thread
+};
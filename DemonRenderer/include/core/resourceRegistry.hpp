@@ -0,0 +1,216 @@
+/** \file resourceRegistry.hpp */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include "core/log.hpp"
+
+class Shader;
+class Material;
+class VAO;
+class Texture;
+class FBO;
+
+/** \struct ResourceHandle
+*	\brief A 32-bit generational handle to a resource held by the ResourceRegistry.
+*	The low 20 bits are a slot index and the high 12 bits are the slot's generation when the handle was issued.
+*	Generation 0 is never issued so a default constructed handle is always null.
+*/
+template<typename T>
+struct ResourceHandle
+{
+	static constexpr uint32_t indexBits{ 20 }; //!< Bits used by the slot index
+	static constexpr uint32_t indexMask{ (1u << indexBits) - 1u }; //!< Mask for the slot index
+	static constexpr uint32_t generationMask{ (1u << (32u - indexBits)) - 1u }; //!< Mask for the generation once shifted down
+
+	uint32_t id{ 0 }; //!< Packed index and generation
+
+	ResourceHandle() = default; //!< Null handle
+	ResourceHandle(uint32_t index, uint32_t generation) : id((generation << indexBits) | (index & indexMask)) {} //!< Pack an index and generation
+	[[nodiscard]] inline uint32_t getIndex() const noexcept { return id & indexMask; } //!< Slot index
+	[[nodiscard]] inline uint32_t getGeneration() const noexcept { return id >> indexBits; } //!< Generation the handle was issued with
+	[[nodiscard]] inline bool isNull() const noexcept { return id == 0; } //!< True for a default constructed handle
+	explicit operator bool() const noexcept { return id != 0; } //!< True when the handle was issued by the registry, it may still be stale
+	bool operator==(const ResourceHandle& other) const noexcept { return id == other.id; }
+	bool operator!=(const ResourceHandle& other) const noexcept { return id != other.id; }
+};
+
+using ShaderHandle = ResourceHandle<Shader>;
+using MaterialHandle = ResourceHandle<Material>;
+using VAOHandle = ResourceHandle<VAO>;
+using TextureHandle = ResourceHandle<Texture>;
+using FBOHandle = ResourceHandle<FBO>;
+
+/** \class ResourcePool
+*	\brief Slot storage for one resource type.
+*	Destroyed resources are invalidated immediately by bumping the slot's generation, but the resource itself is kept
+*	alive until it is collected a few frames later so that any GPU work already submitted can still use it.
+*/
+template<typename T>
+class ResourcePool
+{
+public:
+	ResourceHandle<T> add(const std::shared_ptr<T>& resource); //!< Register a resource and return a handle to it
+	[[nodiscard]] T* get(ResourceHandle<T> handle) const; //!< Get the resource, nullptr and an error if the handle is stale
+	[[nodiscard]] std::shared_ptr<T> getShared(ResourceHandle<T> handle) const; //!< Get shared ownership of the resource
+	[[nodiscard]] inline bool isValid(ResourceHandle<T> handle) const noexcept; //!< Does the handle refer to a live resource
+	void destroy(ResourceHandle<T> handle, uint64_t frame); //!< Invalidate the handle and queue the resource for release
+	void collect(uint64_t frame, uint64_t latency); //!< Release resources which were destroyed at least latency frames ago
+	void clear(); //!< Release everything, pending or not
+	[[nodiscard]] inline uint32_t getLiveCount() const noexcept { return m_liveCount; } //!< Number of live resources
+	[[nodiscard]] inline uint32_t getPendingCount() const noexcept { return static_cast<uint32_t>(m_pending.size()); } //!< Number of resources awaiting release
+private:
+	/** \struct Slot */
+	struct Slot
+	{
+		std::shared_ptr<T> resource{ nullptr }; //!< The resource, null when the slot is free
+		uint32_t generation{ 1 }; //!< Current generation, handles with any other generation are stale
+	};
+	/** \struct Pending */
+	struct Pending
+	{
+		std::shared_ptr<T> resource{ nullptr }; //!< Resource kept alive until collected
+		uint32_t index{ 0 }; //!< Slot to return to the free list
+		uint64_t frame{ 0 }; //!< Frame on which it was destroyed
+	};
+	std::vector<Slot> m_slots; //!< All slots, indexed by handle
+	std::vector<uint32_t> m_freeList; //!< Slots available for reuse
+	std::vector<Pending> m_pending; //!< Resources awaiting release
+	uint32_t m_liveCount{ 0 }; //!< Number of live resources
+};
+
+/** \class ResourceRegistry
+*	\brief Hands out generational handles for shaders, materials, VAOs, textures and FBOs.
+*	Components store handles rather than shared pointers, which keeps them small and avoids touching reference counts
+*	while iterating. Handles are validated on access and destruction is deferred until onFrameEnd has been called
+*	enough times for the GPU to have finished with the resource.
+*/
+class ResourceRegistry
+{
+public:
+	template<typename T> static ResourceHandle<T> add(const std::shared_ptr<T>& resource) { return pool<T>().add(resource); } //!< Register a resource
+	template<typename T> [[nodiscard]] static T* get(ResourceHandle<T> handle) { return pool<T>().get(handle); } //!< Access a resource, nullptr if the handle is null or stale
+	template<typename T> [[nodiscard]] static std::shared_ptr<T> getShared(ResourceHandle<T> handle) { return pool<T>().getShared(handle); } //!< Shared ownership of a resource
+	template<typename T> [[nodiscard]] static bool isValid(ResourceHandle<T> handle) { return pool<T>().isValid(handle); } //!< Does the handle refer to a live resource
+	template<typename T> static void destroy(ResourceHandle<T> handle) { pool<T>().destroy(handle, s_frame); } //!< Deferred destruction of a resource
+	template<typename T> [[nodiscard]] static ResourcePool<T>& pool(); //!< Storage for a resource type
+
+	static void onFrameEnd(); //!< Advance the frame counter and release resources the GPU is finished with
+	static void clear(); //!< Release all resources, called before the context is destroyed
+	[[nodiscard]] static inline uint64_t getFrame() noexcept { return s_frame; } //!< Frames completed so far
+	static constexpr uint64_t releaseLatency{ 3 }; //!< Frames a destroyed resource is kept alive for
+private:
+	inline static uint64_t s_frame{ 0 }; //!< Frame counter used for deferred destruction
+};
+
+template<typename T>
+ResourcePool<T>& ResourceRegistry::pool()
+{
+	static_assert(std::is_same_v<T, Shader> || std::is_same_v<T, Material> || std::is_same_v<T, VAO> || std::is_same_v<T, Texture> || std::is_same_v<T, FBO>,
+		"ResourceRegistry only manages shaders, materials, VAOs, textures and FBOs");
+	static ResourcePool<T> s_pool;
+	return s_pool;
+}
+
+template<typename T>
+ResourceHandle<T> ResourcePool<T>::add(const std::shared_ptr<T>& resource)
+{
+	if (!resource) {
+		spdlog::error("ResourceRegistry: attempted to register a null resource");
+		return ResourceHandle<T>();
+	}
+
+	uint32_t index;
+	if (!m_freeList.empty()) {
+		index = m_freeList.back();
+		m_freeList.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(m_slots.size());
+		if (index > ResourceHandle<T>::indexMask) {
+			spdlog::error("ResourceRegistry: out of slots ({} resources registered)", index);
+			return ResourceHandle<T>();
+		}
+		m_slots.emplace_back();
+	}
+
+	auto& slot = m_slots[index];
+	slot.resource = resource;
+	m_liveCount++;
+	return ResourceHandle<T>(index, slot.generation);
+}
+
+template<typename T>
+bool ResourcePool<T>::isValid(ResourceHandle<T> handle) const noexcept
+{
+	const uint32_t index = handle.getIndex();
+	return !handle.isNull() && index < m_slots.size() && m_slots[index].generation == handle.getGeneration() && m_slots[index].resource;
+}
+
+template<typename T>
+T* ResourcePool<T>::get(ResourceHandle<T> handle) const
+{
+	if (handle.isNull()) return nullptr;
+	if (!isValid(handle)) {
+		spdlog::error("ResourceRegistry: stale handle (index {}, generation {})", handle.getIndex(), handle.getGeneration());
+		return nullptr;
+	}
+	return m_slots[handle.getIndex()].resource.get();
+}
+
+template<typename T>
+std::shared_ptr<T> ResourcePool<T>::getShared(ResourceHandle<T> handle) const
+{
+	if (handle.isNull()) return nullptr;
+	if (!isValid(handle)) {
+		spdlog::error("ResourceRegistry: stale handle (index {}, generation {})", handle.getIndex(), handle.getGeneration());
+		return nullptr;
+	}
+	return m_slots[handle.getIndex()].resource;
+}
+
+template<typename T>
+void ResourcePool<T>::destroy(ResourceHandle<T> handle, uint64_t frame)
+{
+	if (!isValid(handle)) {
+		spdlog::warn("ResourceRegistry: destroy called with a null or stale handle");
+		return;
+	}
+
+	auto& slot = m_slots[handle.getIndex()];
+	m_pending.push_back({ std::move(slot.resource), handle.getIndex(), frame });
+	slot.resource = nullptr;
+	// Skip generation 0 when wrapping so the null handle can never become valid
+	slot.generation = (slot.generation & ResourceHandle<T>::generationMask) == ResourceHandle<T>::generationMask ? 1 : slot.generation + 1;
+	m_liveCount--;
+}
+
+template<typename T>
+void ResourcePool<T>::collect(uint64_t frame, uint64_t latency)
+{
+	size_t kept = 0;
+	for (size_t i = 0; i < m_pending.size(); i++)
+	{
+		if (frame - m_pending[i].frame >= latency) m_freeList.push_back(m_pending[i].index);
+		else {
+			if (kept != i) m_pending[kept] = std::move(m_pending[i]);
+			kept++;
+		}
+	}
+	m_pending.resize(kept);
+}
+
+template<typename T>
+void ResourcePool<T>::clear()
+{
+	m_pending.clear();
+	m_freeList.clear();
+	for (auto& slot : m_slots) {
+		if (slot.resource) slot.generation = (slot.generation & ResourceHandle<T>::generationMask) == ResourceHandle<T>::generationMask ? 1 : slot.generation + 1;
+		slot.resource = nullptr;
+	}
+	for (uint32_t i = static_cast<uint32_t>(m_slots.size()); i > 0; i--) m_freeList.push_back(i - 1);
+	m_liveCount = 0;
+}
@@ -0,0 +1,102 @@
+/** \file scriptSystem.hpp */
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include <entt/entt.hpp>
+#include "components/script.hpp"
+#include "core/jobSystem.hpp"
+
+/** \class ScriptSystem
+*	\brief Creates scripts in per type pools and updates them type by type.
+*	Each script type is a component, so all RotationScripts sit together in one pool, all ControllerScripts in
+*	another and so on, constructed in place with no heap allocation per entity. Updates walk one pool at a time and,
+*	as script types are final, call each script directly rather than through the vtable. Types which declare
+*	threadSafe are split across the job system's workers once their pool is large enough.
+*/
+class ScriptSystem
+{
+public:
+	template<typename T, typename ...Args> static T& attach(std::shared_ptr<Scene> scene, entt::entity entity, Args&& ...args); //!< Construct a script on an entity, the script is passed the entity and scene followed by args
+	static void onUpdate(entt::registry& registry, float timestep); //!< Update every script, one type at a time
+	static void onImGuiRender(entt::registry& registry); //!< Draw every script's widgets
+	static void onKeyPress(entt::registry& registry, KeyPressedEvent& e); //!< Pass a key press to every script
+	static void onKeyRelease(entt::registry& registry, KeyReleasedEvent& e); //!< Pass a key release to every script
+
+	static void setThreadCount(uint32_t count) noexcept { s_threadCount = count > 0 ? count : 1; } //!< Maximum threads used to update a thread safe type
+	[[nodiscard]] static inline uint32_t getThreadCount() noexcept { return s_threadCount; } //!< Maximum threads used to update a thread safe type
+
+	static constexpr size_t minScriptsPerThread{ 4096 }; //!< Below this a worker thread costs more than it saves
+private:
+	/** \struct ScriptType
+	*	\brief Per type entry points, one of these exists for each script type rather than each script
+	*/
+	struct ScriptType
+	{
+		void (*update)(entt::registry&, float); //!< Update the type's pool
+		void (*imGuiRender)(entt::registry&); //!< Draw widgets for the type's pool
+		void (*keyPress)(entt::registry&, KeyPressedEvent&); //!< Pass a key press to the type's pool
+		void (*keyRelease)(entt::registry&, KeyReleasedEvent&); //!< Pass a key release to the type's pool
+	};
+
+	template<typename T> static void registerType(); //!< Add T to the type table the first time it is attached
+	template<typename T> static void update(entt::registry& registry, float timestep); //!< Update one type, in parallel if it allows
+	template<typename T, typename Func> static void forEach(entt::storage_for_t<T>& pool, size_t begin, size_t end, Func&& func); //!< Visit a range of a pool, skipping destroyed slots
+
+	inline static std::vector<ScriptType> s_types; //!< Registered script types in the order they were first attached
+	inline static uint32_t s_threadCount{ std::max(1u, std::thread::hardware_concurrency()) }; //!< Maximum threads used to update a thread safe type
+};
+
+template<typename T, typename ...Args>
+T& ScriptSystem::attach(std::shared_ptr<Scene> scene, entt::entity entity, Args&& ...args)
+{
+	static_assert(std::is_base_of_v<Script, T>, "Scripts must derive from Script");
+	static_assert(std::is_final_v<T>, "Script types must be final so their updates are not virtual calls");
+	registerType<T>();
+	return scene->m_entities.emplace<T>(entity, entity, scene, std::forward<Args>(args)...);
+}
+
+template<typename T>
+void ScriptSystem::registerType()
+{
+	static const bool registered = [] {
+		s_types.push_back({
+			&ScriptSystem::update<T>,
+			[](entt::registry& registry) { auto& pool = registry.storage<T>(); forEach<T>(pool, 0, pool.size(), [](T& script) { script.onImGuiRender(); }); },
+			[](entt::registry& registry, KeyPressedEvent& e) { auto& pool = registry.storage<T>(); forEach<T>(pool, 0, pool.size(), [&e](T& script) { script.onKeyPress(e); }); },
+			[](entt::registry& registry, KeyReleasedEvent& e) { auto& pool = registry.storage<T>(); forEach<T>(pool, 0, pool.size(), [&e](T& script) { script.onKeyRelease(e); }); }
+		});
+		return true;
+	}();
+	(void)registered;
+}
+
+template<typename T>
+void ScriptSystem::update(entt::registry& registry, float timestep)
+{
+	auto& pool = registry.storage<T>();
+	const size_t count = pool.size();
+	auto updateScript = [timestep](T& script) { script.onUpdate(timestep); };
+
+	if constexpr (T::threadSafe)
+	{
+		JobSystem::parallelFor(0, count, [&pool, &updateScript](size_t begin, size_t end) { forEach<T>(pool, begin, end, updateScript); }, minScriptsPerThread, s_threadCount);
+		return;
+	}
+
+	forEach<T>(pool, 0, count, updateScript);
+}
+
+template<typename T, typename Func>
+void ScriptSystem::forEach(entt::storage_for_t<T>& pool, size_t begin, size_t end, Func&& func)
+{
+	// Scripts are deleted in place, so destroyed scripts leave tombstones in the packed array rather than moving others
+	const auto* packed = pool.data();
+	for (size_t i = begin; i < end; i++)
+	{
+		if (packed[i] == entt::tombstone) continue;
+		func(pool.get(packed[i]));
+	}
+}
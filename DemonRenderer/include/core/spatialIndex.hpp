@@ -0,0 +1,99 @@
+/** \file spatialIndex.hpp */
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+/** \struct SpatialHit
+*	\brief An entity found by a spatial query and its distance from the query centre to the entity's bounding sphere
+*/
+struct SpatialHit
+{
+	entt::entity entity{ entt::null }; //!< Entity found
+	float distance{ 0.f }; //!< Distance to the surface of its bounding sphere, negative when the centre is inside it
+};
+
+/** \struct RadiusQuery
+*	\brief Everything whose bounding sphere comes within a radius of a point
+*/
+struct RadiusQuery
+{
+	glm::vec3 centre{ 0.f }; //!< Point to search around
+	float radius{ 0.f }; //!< Search radius
+};
+
+/** \struct NearestQuery
+*	\brief The k entities whose bounding spheres are nearest a point
+*/
+struct NearestQuery
+{
+	glm::vec3 centre{ 0.f }; //!< Point to search around
+	uint32_t k{ 1 }; //!< Number of entities wanted
+	float maxDistance{ std::numeric_limits<float>::max() }; //!< Ignore anything further away than this
+};
+
+/** \struct QueryRange
+*	\brief Where one query of a batch wrote its hits in the shared output buffer
+*/
+struct QueryRange
+{
+	uint32_t offset{ 0 }; //!< First hit
+	uint32_t count{ 0 }; //!< Hits written
+	bool truncated{ false }; //!< More hits were found than there was room for
+};
+
+/** \class SpatialIndex
+*	\brief Static k-d tree over bounding spheres for radius and k nearest queries.
+*	Points are stored in one array, every range split at its median along the longest axis of the centres in it, so
+*	the tree needs no node storage. Ranges of leafSize points or fewer are scanned linearly. Queries never allocate:
+*	they write into buffers supplied by the caller and traverse with a fixed size stack. Batched versions run many
+*	queries and pack their hits one after another into a single buffer. Rebuilding is cheap enough to do lazily
+*	whenever the colliders have moved, see BroadPhase::getSpatialIndex.
+*/
+class SpatialIndex
+{
+public:
+	static constexpr uint32_t leafSize{ 8 }; //!< Ranges this small are scanned rather than split
+
+	void clear(); //!< Remove every point
+	void reserve(size_t count); //!< Reserve space for a number of points
+	void add(entt::entity entity, const glm::vec3& centre, float radius); //!< Add a bounding sphere, build must be called before querying
+	void build(); //!< Arrange the points into the tree
+
+	uint32_t withinRadius(const glm::vec3& centre, float radius, std::span<SpatialHit> out) const; //!< Hits within the radius in any order, returns how many were found which may exceed out's size
+	uint32_t nearest(const glm::vec3& centre, std::span<SpatialHit> out, float maxDistance = std::numeric_limits<float>::max()) const; //!< The out.size() nearest hits sorted nearest first, returns how many were written
+	void withinRadius(std::span<const RadiusQuery> queries, std::span<SpatialHit> out, std::span<QueryRange> ranges) const; //!< Run a batch of radius queries, ranges must be as long as queries
+	void nearest(std::span<const NearestQuery> queries, std::span<SpatialHit> out, std::span<QueryRange> ranges) const; //!< Run a batch of nearest queries, ranges must be as long as queries
+
+	[[nodiscard]] inline size_t size() const noexcept { return m_points.size(); } //!< Number of points
+	[[nodiscard]] inline bool isBuilt() const noexcept { return m_built; } //!< Has build been called since the last change
+private:
+	/** \struct Point */
+	struct Point
+	{
+		glm::vec3 centre; //!< Centre of the bounding sphere
+		float radius; //!< Radius of the bounding sphere
+		entt::entity entity; //!< Owner
+		uint32_t axis; //!< Split axis when this point is the median of a range
+	};
+
+	/** \struct Range */
+	struct Range
+	{
+		uint32_t begin; //!< First point
+		uint32_t end; //!< One past the last point
+		float bound; //!< No point in the range can be nearer than this
+	};
+
+	static constexpr size_t maxDepth{ 64 }; //!< Traversal stack size, the tree is balanced so this is never reached
+
+	void buildRange(uint32_t begin, uint32_t end); //!< Split a range at its median and recurse
+	[[nodiscard]] inline float distanceTo(const Point& point, const glm::vec3& centre) const noexcept { return glm::length(point.centre - centre) - point.radius; } //!< Distance to a point's sphere
+
+	std::vector<Point> m_points; //!< Points in tree order once built
+	float m_maxRadius{ 0.f }; //!< Largest radius, widens the pruning tests
+	bool m_built{ false }; //!< Has build been called since the last change
+};
@@ -0,0 +1,69 @@
+/** \file spatialSort.hpp */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+#include "rendering/scene.hpp"
+
+/** \class SpatialSort
+*	\brief Periodically reorders component pools so that entities which are close in space are close in memory.
+*	A pass computes the bounds of every WorldMatrix, gives each entity a 30 bit Morton code of its position, sorts the
+*	WorldMatrix pool by that code and then sorts the transform, render, LOD, bounds and collider pools to match.
+*	Work is spread over frames under a time budget: bounds and codes are computed in chunks, and each pool sort is one
+*	step, so a frame never starts a step once its budget is spent. Passes where few entities are out of order finish
+*	without sorting anything. Sorting moves components, so anything caching component addresses, such as a SpinSystem,
+*	must be registered with addInvalidation. The scene's render proxies are always invalidated.
+*/
+class SpatialSort
+{
+public:
+	SpatialSort() = default; //!< Default constructor
+	SpatialSort(SpatialSort& other) = delete; //!< Deleted copy constructor
+	SpatialSort(SpatialSort&& other) = delete; //!< Deleted move constructor
+	SpatialSort& operator=(SpatialSort& other) = delete; //!< Deleted copy assignment operator
+	SpatialSort& operator=(SpatialSort&& other) = delete; //!< Deleted move assignment operator
+
+	bool onUpdate(Scene& scene, float timestep); //!< Advance the current pass within the budget, true if any pool was reordered
+	void request() noexcept { m_sinceLastPass = m_interval; } //!< Start a pass on the next update
+	void addInvalidation(std::function<void()> invalidate) { m_invalidations.push_back(std::move(invalidate)); } //!< Call a function after any update which moved components, for caches of component addresses
+
+	void setInterval(float seconds) noexcept { m_interval = seconds; } //!< Time between the start of passes
+	void setBudget(float milliseconds) noexcept { m_budgetMs = milliseconds; } //!< Time a pass may use per frame
+	[[nodiscard]] inline float getBudget() const noexcept { return m_budgetMs; } //!< Time a pass may use per frame
+	[[nodiscard]] inline bool isRunning() const noexcept { return m_phase != Phase::idle; } //!< Is a pass part way through
+	[[nodiscard]] inline uint32_t getPassCount() const noexcept { return m_passCount; } //!< Passes completed
+	[[nodiscard]] inline uint32_t getSortCount() const noexcept { return m_sortCount; } //!< Passes which reordered the pools
+	[[nodiscard]] inline float getLastOutOfOrder() const noexcept { return m_lastOutOfOrder; } //!< Fraction of neighbouring entities out of order when last measured
+
+	[[nodiscard]] static uint32_t morton3D(const glm::vec3& unit) noexcept; //!< Interleave 10 bits per axis of a position in [0,1]
+
+	static constexpr size_t chunkSize{ 8192 }; //!< Entities processed between budget checks
+	static constexpr float sortThreshold{ 0.01f }; //!< Fraction of out of order neighbours below which sorting is skipped
+private:
+	/** \enum Phase
+	*	Step of the current pass
+	*/
+	enum class Phase { idle, bounds, codes, sortPrimary, sortFollowers };
+
+	bool step(Scene& scene); //!< Do one unit of work, true if a pool was reordered
+	[[nodiscard]] uint32_t codeOf(entt::entity entity) const noexcept; //!< Morton code of an entity, entities created mid pass sort last
+
+	Phase m_phase{ Phase::idle }; //!< Step of the current pass
+	size_t m_cursor{ 0 }; //!< Position in the pool or follower list
+	glm::vec3 m_min{ 0.f }; //!< Bounds of every position this pass
+	glm::vec3 m_max{ 0.f }; //!< Bounds of every position this pass
+	uint32_t m_previousCode{ 0 }; //!< Code of the previous entity in storage order
+	size_t m_outOfOrder{ 0 }; //!< Neighbours out of order this pass
+	std::vector<uint32_t> m_codes; //!< Morton codes indexed by entity index
+	std::vector<std::function<void()>> m_invalidations; //!< Called whenever a pool was reordered
+
+	float m_interval{ 2.f }; //!< Time between the start of passes
+	float m_budgetMs{ 0.5f }; //!< Time a pass may use per frame
+	float m_sinceLastPass{ 0.f }; //!< Time since the last pass started
+	uint32_t m_passCount{ 0 }; //!< Passes completed
+	uint32_t m_sortCount{ 0 }; //!< Passes which reordered the pools
+	float m_lastOutOfOrder{ 0.f }; //!< Fraction of neighbours out of order when last measured
+};
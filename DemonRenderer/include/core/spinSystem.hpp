@@ -0,0 +1,59 @@
+/** \file spinSystem.hpp */
+#pragma once
+
+#include <vector>
+#include <entt/entt.hpp>
+#include "components/transform.hpp"
+#include "components/angularVelocity.hpp"
+
+/** \class SpinSystem
+*	\brief Integrates constant angular velocities for every entity with AngularVelocity, LocalTRS and WorldMatrix.
+*	Orientations and per-entity delta quaternions are mirrored into structure of arrays storage, so a fixed step is one
+*	quaternion multiply and normalise per entity (four at a time with SSE) with no trigonometry. Results are written
+*	back to LocalTRS and WorldMatrix in a single sequential pass. Large sets are split across the job system's workers.
+*	The mirror is rebuilt lazily whenever an involved component is added or removed, call invalidate after editing an
+*	AngularVelocity or sorting the transform pools.
+*/
+class SpinSystem
+{
+public:
+	explicit SpinSystem(entt::registry& registry, float fixedTimestep = 1.f / 60.f); //!< Constructor which connects to the registry's signals
+	~SpinSystem(); //!< Destructor which disconnects from the registry
+	SpinSystem(SpinSystem& other) = delete; //!< Deleted copy constructor
+	SpinSystem(SpinSystem&& other) = delete; //!< Deleted move constructor
+	SpinSystem& operator=(SpinSystem& other) = delete; //!< Deleted copy assignment operator
+	SpinSystem& operator=(SpinSystem&& other) = delete; //!< Deleted move assignment operator
+
+	void onUpdate(float timestep); //!< Run as many fixed steps as the accumulated time allows
+	void step(); //!< Advance every spinning entity by one fixed step
+	void invalidate() noexcept { m_dirty = true; } //!< Rebuild the mirrored data before the next step
+
+	void setFixedTimestep(float timestep); //!< Change the step length, delta quaternions are recomputed
+	[[nodiscard]] inline float getFixedTimestep() const noexcept { return m_fixedTimestep; } //!< Length of a step in seconds
+	void setThreadCount(uint32_t count) noexcept { m_threadCount = count > 0 ? count : 1; } //!< Maximum threads used by a step
+	[[nodiscard]] inline uint32_t getThreadCount() const noexcept { return m_threadCount; } //!< Maximum threads used by a step
+	void setPaused(bool paused) noexcept { m_paused = paused; } //!< Pause or resume spinning
+	[[nodiscard]] inline bool isPaused() const noexcept { return m_paused; } //!< Is spinning paused
+	[[nodiscard]] inline size_t size() const noexcept { return m_entities.size(); } //!< Number of spinning entities at the last rebuild
+
+	static constexpr uint32_t maxSubsteps{ 4 }; //!< Steps per update before the accumulator is dropped
+	static constexpr size_t minEntitiesPerThread{ 16384 }; //!< Below this a worker thread costs more than it saves
+private:
+	void onStructureChanged(entt::registry& registry, entt::entity entity) { m_dirty = true; } //!< Signal handler
+	void rebuild(); //!< Mirror the registry into the arrays
+	void process(size_t begin, size_t end); //!< Integrate and write back a range of entities
+	void integrate(size_t begin, size_t end); //!< Rotate a range of orientations by their deltas, begin and end are multiples of 4
+
+	entt::registry& m_registry; //!< Registry being spun
+	float m_fixedTimestep; //!< Length of a step in seconds
+	float m_accumulator{ 0.f }; //!< Time not yet stepped
+	uint32_t m_threadCount; //!< Maximum threads used by a step
+	bool m_paused{ false }; //!< Is spinning paused
+	bool m_dirty{ true }; //!< Do the arrays need rebuilding
+
+	std::vector<entt::entity> m_entities; //!< Spinning entities
+	std::vector<LocalTRS*> m_locals; //!< Local transforms, stable until a LocalTRS is removed
+	std::vector<WorldMatrix*> m_worlds; //!< World matrices, stable until a WorldMatrix is removed
+	std::vector<float> m_qx, m_qy, m_qz, m_qw; //!< Current orientations, padded to a multiple of 4
+	std::vector<float> m_dx, m_dy, m_dz, m_dw; //!< Rotation applied each step, padded to a multiple of 4
+};
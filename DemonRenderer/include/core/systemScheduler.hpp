@@ -0,0 +1,112 @@
+/** \file systemScheduler.hpp */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <entt/entt.hpp>
+#include "core/jobSystem.hpp"
+
+/** \class SystemAccess
+*	\brief Components and shared resources a system reads and writes.
+*	Two systems conflict when either writes something the other reads or writes. Resources are anything outside the
+*	registry, such as the broadphase or the particle system, named by a string. An exclusive system, one which makes
+*	structural changes or reorders pools, conflicts with every other system.
+*/
+class SystemAccess
+{
+public:
+	template<typename... Types> SystemAccess& reads() { (m_reads.push_back(entt::type_hash<Types>::value()), ...); return *this; } //!< Declare components read
+	template<typename... Types> SystemAccess& writes() { (m_writes.push_back(entt::type_hash<Types>::value()), ...); return *this; } //!< Declare components written
+	SystemAccess& readsResource(std::string_view name) { m_reads.push_back(entt::hashed_string::value(name.data(), name.size())); return *this; } //!< Declare a resource read
+	SystemAccess& writesResource(std::string_view name) { m_writes.push_back(entt::hashed_string::value(name.data(), name.size())); return *this; } //!< Declare a resource written
+	SystemAccess& exclusive() noexcept { m_exclusive = true; return *this; } //!< Declare that nothing else may run alongside
+
+	[[nodiscard]] bool conflictsWith(const SystemAccess& other) const; //!< Must the two systems be ordered
+	[[nodiscard]] inline bool isExclusive() const noexcept { return m_exclusive; } //!< Does the system run alone
+private:
+	std::vector<entt::id_type> m_reads; //!< Components and resources read
+	std::vector<entt::id_type> m_writes; //!< Components and resources written
+	bool m_exclusive{ false }; //!< Conflicts with every system
+};
+
+/** \struct SystemTiming
+*	\brief When a system ran in the last frame, relative to the start of SystemScheduler::run, all times in milliseconds
+*/
+struct SystemTiming
+{
+	float startMs{ 0.f }; //!< Start of the system
+	float durationMs{ 0.f }; //!< Time the system took
+	float averageMs{ 0.f }; //!< Smoothed duration, used for the critical path
+	uint32_t thread{ 0 }; //!< Job system thread which ran it, 0 is the main thread
+	bool critical{ false }; //!< Is the system on the critical path
+};
+
+/** \class SystemScheduler
+*	\brief Runs a frame's systems as a dependency graph on the job system.
+*	Systems are added once with their access. Each system depends on every earlier system it conflicts with, so
+*	conflicting systems keep the order they were added in while independent ones run alongside each other. Redundant
+*	edges are dropped, leaving the graph export readable. run starts the systems without dependencies and each system,
+*	as it finishes, starts any dependent whose other dependencies have finished. Systems marked mainThread, such as
+*	those polling input or calling GL, are handed to the main thread.
+*	The critical path is the chain of dependent systems with the largest total average duration; no amount of extra
+*	threads makes a frame faster than it, so it names the systems worth optimising.
+*/
+class SystemScheduler
+{
+public:
+	SystemScheduler() = default; //!< Default constructor
+	SystemScheduler(SystemScheduler& other) = delete; //!< Deleted copy constructor
+	SystemScheduler(SystemScheduler&& other) = delete; //!< Deleted move constructor
+	SystemScheduler& operator=(SystemScheduler& other) = delete; //!< Deleted copy assignment operator
+	SystemScheduler& operator=(SystemScheduler&& other) = delete; //!< Deleted move assignment operator
+
+	uint32_t add(const std::string& name, const SystemAccess& access, std::function<void()> func, bool mainThread = false); //!< Add a system after those already added, returns its index
+	void run(); //!< Run every system once, returns when all have finished
+	bool exportGraph(const std::filesystem::path& path) const; //!< Write the graph with the last frame's timings as Graphviz DOT, critical path in red
+
+	[[nodiscard]] inline size_t size() const noexcept { return m_systems.size(); } //!< Number of systems
+	[[nodiscard]] inline const std::string& getName(uint32_t system) const { return m_systems[system].name; } //!< Name of a system
+	[[nodiscard]] inline bool isMainThread(uint32_t system) const { return m_systems[system].mainThread; } //!< Must a system run on the main thread
+	[[nodiscard]] inline std::span<const uint32_t> getDependencies(uint32_t system) const { return m_systems[system].dependencies; } //!< Systems which must finish first
+	[[nodiscard]] inline const SystemTiming& getTiming(uint32_t system) const { return m_systems[system].timing; } //!< Timing of a system in the last frame
+	[[nodiscard]] inline float getFrameMs() const noexcept { return m_frameMs; } //!< Wall time of the last run
+	[[nodiscard]] inline float getSerialMs() const noexcept { return m_serialMs; } //!< Sum of the last run's system durations
+	[[nodiscard]] inline float getCriticalPathMs() const noexcept { return m_criticalPathMs; } //!< Average duration of the critical path
+
+	static constexpr float smoothing{ 0.1f }; //!< Weight of the latest frame in each average
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/** \struct System */
+	struct System
+	{
+		std::string name; //!< Shown in Tracy, the panel and the export
+		SystemAccess access; //!< What it reads and writes
+		std::function<void()> func; //!< Body
+		bool mainThread; //!< Must run on the main thread
+		std::vector<uint32_t> dependencies; //!< Earlier systems it must wait for, without redundant edges
+		std::vector<uint32_t> dependents; //!< Later systems waiting for it
+		SystemTiming timing; //!< Last frame's timing
+	};
+
+	void build(); //!< Work out the edges
+	void launch(uint32_t system); //!< Submit a system whose dependencies have finished
+	void execute(uint32_t system); //!< Run and time a system, then launch its ready dependents
+	void findCriticalPath(); //!< Mark the critical path from the averages
+
+	std::vector<System> m_systems; //!< Systems in the order they were added
+	std::vector<std::atomic<uint32_t>> m_remaining; //!< Dependencies each system is still waiting for this frame
+	bool m_dirty{ true }; //!< Must the edges be rebuilt
+	JobCounter* m_counter{ nullptr }; //!< Counter of the run in progress
+	Clock::time_point m_frameStart; //!< Start of the run in progress
+	float m_frameMs{ 0.f }; //!< Wall time of the last run
+	float m_serialMs{ 0.f }; //!< Sum of the last run's durations
+	float m_criticalPathMs{ 0.f }; //!< Average duration of the critical path
+};
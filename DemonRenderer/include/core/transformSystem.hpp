@@ -0,0 +1,50 @@
+/** \file transformSystem.hpp */
+#pragma once
+
+#include <entt/entt.hpp>
+#include "components/transform.hpp"
+
+/** \class TransformSystem
+*	\brief Composes WorldMatrix components from LocalTRS components in batches.
+*	The rotation is expanded straight from the quaternion and the scale folded into its columns, so no intermediate
+*	mat4s are built or multiplied. Only entities tagged with TransformDirty are recomposed by update.
+*	Entities with a PreviousTRS are drawn between simulation steps: storePrevious records their LocalTRS before each
+*	fixed step and interpolate blends the two into the matrix that is drawn, leaving the simulated WorldMatrix alone.
+*/
+class TransformSystem
+{
+public:
+	static inline void compose(const LocalTRS& local, WorldMatrix& world) noexcept; //!< Compose a single world matrix
+	static void update(entt::registry& registry); //!< Compose all dirty entities and clear their tags
+	static void updateAll(entt::registry& registry); //!< Compose every entity regardless of its tag
+	static void markDirty(entt::registry& registry, entt::entity entity); //!< Tag an entity whose LocalTRS has changed
+	static LocalTRS& emplace(entt::registry& registry, entt::entity entity, const LocalTRS& local = LocalTRS()); //!< Add LocalTRS and a composed WorldMatrix to an entity
+	static inline void interpolate(const LocalTRS& previous, const LocalTRS& current, float alpha, WorldMatrix& world) noexcept; //!< Compose the transform alpha of the way from previous to current
+	static void storePrevious(entt::registry& registry); //!< Copy LocalTRS into PreviousTRS, call before each fixed step
+	static void emplacePrevious(entt::registry& registry, entt::entity entity); //!< Interpolate an entity, starting from its current LocalTRS
+};
+
+void TransformSystem::compose(const LocalTRS& local, WorldMatrix& world) noexcept
+{
+	const glm::quat& q = local.rotation;
+	const glm::vec3& s = local.scale;
+	const glm::vec3& t = local.translation;
+
+	const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	// Row i is (R[i][0] * sx, R[i][1] * sy, R[i][2] * sz, t[i]) where R is the rotation in row major order
+	world.rows[0] = glm::vec4((1.f - 2.f * (yy + zz)) * s.x, 2.f * (xy - wz) * s.y, 2.f * (xz + wy) * s.z, t.x);
+	world.rows[1] = glm::vec4(2.f * (xy + wz) * s.x, (1.f - 2.f * (xx + zz)) * s.y, 2.f * (yz - wx) * s.z, t.y);
+	world.rows[2] = glm::vec4(2.f * (xz - wy) * s.x, 2.f * (yz + wx) * s.y, (1.f - 2.f * (xx + yy)) * s.z, t.z);
+}
+
+void TransformSystem::interpolate(const LocalTRS& previous, const LocalTRS& current, float alpha, WorldMatrix& world) noexcept
+{
+	LocalTRS blended;
+	blended.translation = glm::mix(previous.translation, current.translation, alpha);
+	blended.rotation = glm::slerp(previous.rotation, current.rotation, alpha); // Takes the shorter arc
+	blended.scale = glm::mix(previous.scale, current.scale, alpha);
+	compose(blended, world);
+}
@@ -0,0 +1,68 @@
+/** \file analyticAnimation.hpp */
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+
+#include "buffers/SSBO.hpp"
+#include "rendering/material.hpp"
+#include "components/transform.hpp"
+#include "components/analyticSpin.hpp"
+
+/** Constants shared between the analytic animation and assets/shaders/PBR/pbrVertexAnalytic.glsl */
+namespace AnalyticConsts
+{
+	constexpr uint32_t instanceBinding = 3; //!< SSBO binding of the instance buffer
+	constexpr const char* timeUniformName = "u_time"; //!< Seconds since the animation started
+	constexpr const char* instanceUniformName = "u_instance"; //!< Index of the instance being drawn
+}
+
+/**	\struct GPUAnalyticInstance
+*	\brief std430 layout of one instance in the instance buffer
+*/
+struct GPUAnalyticInstance
+{
+	glm::vec4 initialRotation; //!< Quaternion at time zero stored xyzw
+	glm::vec4 axisRate; //!< Unit axis in xyz and radians per second in w
+	glm::vec4 translation; //!< World position in xyz
+	glm::vec4 scale; //!< Scale in xyz
+};
+
+/**	\class AnalyticAnimation
+*	\brief Spins entities on the GPU from a single time value.
+*	Each entity's initial orientation, spin and static translation and scale are written once to an instance buffer.
+*	Materials drawing these entities use a vertex shader which rebuilds the model matrix from that data and a time
+*	uniform, so nothing is integrated or uploaded per entity on the CPU. evaluate gives the CPU the same result for
+*	code which needs the current orientation, such as collision.
+*/
+class AnalyticAnimation
+{
+public:
+	AnalyticAnimation() = default; //!< Default constructor
+	AnalyticAnimation(AnalyticAnimation& other) = delete; //!< Deleted copy constructor
+	AnalyticAnimation(AnalyticAnimation&& other) = delete; //!< Deleted move constructor
+	AnalyticAnimation& operator=(AnalyticAnimation& other) = delete; //!< Deleted copy assignment operator
+	AnalyticAnimation& operator=(AnalyticAnimation&& other) = delete; //!< Deleted move assignment operator
+
+	uint32_t add(entt::registry& registry, entt::entity entity, const glm::vec3& eulerRates); //!< Spin an entity with a LocalTRS at the given Euler angle rates, returns its instance index
+	[[nodiscard]] AnalyticSpin add(const LocalTRS& local, const glm::vec3& eulerRates); //!< Add an instance for an entity not yet in the registry, the caller attaches the returned spin
+	void addMaterial(const std::shared_ptr<Material>& material); //!< Register a material whose shader reads the instance buffer and time
+	void upload(); //!< Create the instance buffer, call once all instances have been added
+	void onUpdate(float timestep); //!< Advance time, touches no GL
+	void bind(float time) const; //!< Pass a time to the registered materials and bind the instance buffer, on the thread owning the context
+	void clear(); //!< Remove all instances and restart time
+
+	[[nodiscard]] inline float getTime() const noexcept { return static_cast<float>(m_time); } //!< Time used by the shaders
+	[[nodiscard]] inline uint32_t size() const noexcept { return static_cast<uint32_t>(m_instances.size()); } //!< Number of instances
+	[[nodiscard]] WorldMatrix evaluate(const entt::registry& registry, entt::entity entity) const; //!< World matrix the shader is currently drawing the entity with
+
+	[[nodiscard]] static glm::quat evaluateRotation(const AnalyticSpin& spin, float time) noexcept; //!< Orientation at a time, matches the vertex shader
+	[[nodiscard]] static WorldMatrix evaluate(const AnalyticSpin& spin, const LocalTRS& initial, float time) noexcept; //!< World matrix at a time, matches the vertex shader
+private:
+	std::vector<GPUAnalyticInstance> m_instances; //!< CPU copy of the instance buffer
+	std::vector<std::shared_ptr<Material>> m_materials; //!< Materials fed the time uniform
+	std::shared_ptr<SSBO> m_instanceBuffer{ nullptr }; //!< Static instance buffer
+	double m_time{ 0.0 }; //!< Seconds since the animation started, accumulated in double so long sessions do not drift
+};
@@ -17,7 +17,7 @@ class CameraFrustrum
 public:
 	CameraFrustrum() = default; //!< Default constructor
 	CameraFrustrum(const Camera& cam); //!< Overloaded constructor which takes in Camera as a parameter
-	bool intersects(const AABB& aabb); //!< Boolean function which checks to see if an AABB intersects with the camera frustum
+	bool intersects(const AABB& aabb) const; //!< Boolean function which checks to see if an AABB intersects with the camera frustum
 
 private:
 	std::array<glm::vec4, 6> m_planes; //!< Array which holds the planes of the frustum
@@ -0,0 +1,100 @@
+/** \file clusteredLighting.hpp */
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "buffers/SSBO.hpp"
+#include "buffers/UBOmanager.hpp"
+#include "rendering/material.hpp"
+#include "rendering/camera.hpp"
+#include "rendering/scene.hpp"
+
+/** Constants shared between the clustered lighting system and its shaders. These MUST match the values in
+*	assets/shaders/Lighting/ClusterBuild.glsl, ClusterCull.glsl and the lit fragment shaders.
+*/
+namespace ClusterConsts
+{
+	constexpr uint32_t gridX = 16; //!< Number of tiles across the screen
+	constexpr uint32_t gridY = 9; //!< Number of tiles down the screen
+	constexpr uint32_t gridZ = 24; //!< Number of exponential depth slices
+	constexpr uint32_t clusterCount = gridX * gridY * gridZ; //!< Total number of froxels
+	constexpr uint32_t maxLightsPerCluster = 256; //!< Cap on lights referenced by one cluster
+	constexpr uint32_t averageLightsPerCluster = 64; //!< Used to size the shared light index list
+	constexpr uint32_t maxPointLights = 4096; //!< Capacity of the point light buffer
+	constexpr uint32_t maxSpotLights = 4096; //!< Capacity of the spot light buffer
+	constexpr uint32_t cullGroupSize = 128; //!< Local size of the cull shader
+
+	constexpr uint32_t pointLightBinding = 4; //!< SSBO binding of the point lights
+	constexpr uint32_t spotLightBinding = 5; //!< SSBO binding of the spot lights
+	constexpr uint32_t clusterAABBBinding = 6; //!< SSBO binding of the view space cluster bounds
+	constexpr uint32_t lightGridBinding = 7; //!< SSBO binding of the per cluster offset and counts
+	constexpr uint32_t lightIndexBinding = 8; //!< SSBO binding of the light index list
+	constexpr uint32_t indexCounterBinding = 9; //!< SSBO binding of the atomic index counter
+
+	constexpr float lightCutOff = 5.f / 256.f; //!< Attenuation below which a light is treated as out of range
+}
+
+/**	\struct GPUPointLight
+*	\brief A point light packed for std430 storage
+*/
+struct GPUPointLight
+{
+	glm::vec4 positionRange{ 0.f }; //!< World space position in xyz, range in w
+	glm::vec4 colour{ 0.f }; //!< Colour in rgb, w unused
+	glm::vec4 constants{ 0.f }; //!< Constant, linear and quadratic attenuation in xyz, w unused
+};
+
+/**	\struct GPUSpotLight
+*	\brief A spot light packed for std430 storage
+*/
+struct GPUSpotLight
+{
+	glm::vec4 positionRange{ 0.f }; //!< World space position in xyz, range in w
+	glm::vec4 colour{ 0.f }; //!< Colour in rgb, w unused
+	glm::vec4 directionCutOff{ 0.f }; //!< Direction in xyz, inner cut off cosine in w
+	glm::vec4 constantsOuterCutOff{ 0.f }; //!< Attenuation constants in xyz, outer cut off cosine in w
+};
+
+/**	\class ClusteredLighting
+*	\brief Clustered forward lighting for many point and spot lights.
+*	The view frustum of the main camera is divided into a froxel grid (screen tiles by exponential depth slices).
+*	Each frame a compute pass bins the scene's point and spot lights into the grid, writing a per cluster list of
+*	light indices. Lit fragment shaders find their cluster from gl_FragCoord and view depth and only iterate the
+*	lights in that list, so shading cost depends on local light density rather than the total light count.
+*/
+class ClusteredLighting
+{
+public:
+	ClusteredLighting() = default; //!< Default constructor, init must be called before use
+	void init(const Camera& camera, const glm::ivec2& screenSize, float zNear, float zFar); //!< Create buffers and build the cluster grid for a projection
+	void onUpdate(const Scene& scene); //!< Pack and upload the scene's point and spot lights
+	void onUpdate(std::span<const PointLight> pointLights, std::span<const SpotLight> spotLights); //!< Pack and upload copies of a scene's lights, such as those in a render snapshot
+	void dispatch(const Camera& camera); //!< Cull lights into clusters and bind the buffers for shading
+	void setClusterUniforms(UBOManager& UBOmanager) const; //!< Write the b_clusters values for a render pass
+	inline uint32_t getPointLightCount() const noexcept { return static_cast<uint32_t>(m_pointLights.size()); } //!< Returns the number of uploaded point lights
+	inline uint32_t getSpotLightCount() const noexcept { return static_cast<uint32_t>(m_spotLights.size()); } //!< Returns the number of uploaded spot lights
+	inline bool isInitialised() const noexcept { return m_cullMaterial != nullptr; } //!< Returns true once init has been called
+
+	static float getLightRange(const glm::vec3& colour, const glm::vec3& constants); //!< Distance at which attenuation falls below ClusterConsts::lightCutOff
+private:
+	void bindBuffers(); //!< Bind all SSBOs to their binding points
+
+	std::shared_ptr<SSBO> m_pointLightSSBO{ nullptr }; //!< Packed point lights
+	std::shared_ptr<SSBO> m_spotLightSSBO{ nullptr }; //!< Packed spot lights
+	std::shared_ptr<SSBO> m_clusterAABBSSBO{ nullptr }; //!< View space min and max of each cluster
+	std::shared_ptr<SSBO> m_lightGridSSBO{ nullptr }; //!< Offset, point count and spot count of each cluster
+	std::shared_ptr<SSBO> m_lightIndexSSBO{ nullptr }; //!< Light indices for all clusters
+	std::shared_ptr<SSBO> m_indexCounterSSBO{ nullptr }; //!< Atomic counter used to allocate space in the index list
+
+	std::shared_ptr<Material> m_buildMaterial{ nullptr }; //!< Builds the cluster bounds
+	std::shared_ptr<Material> m_cullMaterial{ nullptr }; //!< Bins lights into clusters
+
+	std::vector<GPUPointLight> m_pointLights; //!< CPU side staging of point lights
+	std::vector<GPUSpotLight> m_spotLights; //!< CPU side staging of spot lights
+
+	glm::vec4 m_clusterGrid{ 0.f }; //!< Grid dimensions in xyz
+	glm::vec4 m_clusterDepth{ 0.f }; //!< Tile size in pixels in xy, depth slice scale and bias in zw
+};
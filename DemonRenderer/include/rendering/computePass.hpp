@@ -49,5 +49,6 @@ struct ComputePass
 	std::shared_ptr<Material> material;
 	glm::ivec3 workgroups{ glm::ivec3{0,0,0} };
 	MemoryBarrier barrier{ MemoryBarrier::None };
+	std::string name; //!< Name the GPU profiler times the pass under, defaults to its type and position in the renderer
 	
 };
\ No newline at end of file
@@ -42,6 +42,7 @@ struct DepthPass
 	std::shared_ptr<Scene> scene; //!< Scene being rendered
 	ViewPort viewPort; //!< Portion of the render target being rendered too
 	bool clearDepth{ true }; //!< Should the depth buffer be cleared by this parse?
+	std::string name; //!< Name the GPU profiler times the pass under, defaults to its type and position in the renderer
 
 	void parseScene(); //!< Populate variable based on the scene
 };
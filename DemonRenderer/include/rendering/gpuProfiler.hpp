@@ -0,0 +1,99 @@
+/** \file gpuProfiler.hpp */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \struct GPUPassTiming
+*	\brief Rolling GPU time of one profiled scope, in milliseconds
+*/
+struct GPUPassTiming
+{
+	std::string name; //!< Scope name, usually a render pass
+	float lastMs{ 0.f }; //!< Most recent frame read back
+	float minMs{ 0.f }; //!< Fastest frame in the window
+	float avgMs{ 0.f }; //!< Mean over the window
+	float p95Ms{ 0.f }; //!< 95th percentile over the window
+	uint32_t samples{ 0 }; //!< Frames in the window
+};
+
+/** \class GPUProfiler
+*	\brief Times named scopes on the GPU with GL_TIMESTAMP queries, without ever waiting on the GPU.
+*	Each frame writes its queries into one slot of a ring; onFrameEnd moves to the next slot and reads back the one it
+*	is about to reuse, which was issued latency frames earlier and has normally finished. A slot whose last query is
+*	still not available is counted as late and dropped rather than stalled on. Time spent in a scope is summed over the
+*	frame, so a scope opened several times, such as a renderer drawn more than once, reports its total. Every renderer
+*	shares the one profiler, so passes of different renderers are told apart by name. begin, end and onFrameEnd make
+*	GL calls and must be on the thread the context is current on; the timings may be read from any thread.
+*/
+class GPUProfiler
+{
+public:
+	/** \class Scope
+	*	\brief Times the GPU work issued during its lifetime
+	*/
+	class Scope
+	{
+	public:
+		explicit Scope(uint32_t scope) { begin(scope); } //!< Open the scope
+		~Scope() { end(); } //!< Close the scope
+		Scope(Scope& other) = delete; //!< Deleted copy constructor
+		Scope(Scope&& other) = delete; //!< Deleted move constructor
+		Scope& operator=(Scope& other) = delete; //!< Deleted copy assignment operator
+		Scope& operator=(Scope&& other) = delete; //!< Deleted move assignment operator
+	};
+
+	[[nodiscard]] static uint32_t getScope(const std::string& name); //!< Find or add a scope, returns an id for begin
+	static void begin(uint32_t scope); //!< Write a start timestamp for a scope, scopes nest
+	static void end(); //!< Write the end timestamp of the innermost open scope
+	static void onFrameEnd(); //!< Close the frame and read back the oldest slot, called by the application after presenting
+	static void clear(); //!< Delete every query, called while the context is still alive
+
+	[[nodiscard]] static std::vector<GPUPassTiming> getTimings(); //!< Timings of every scope which has been read back, in order of first use
+	[[nodiscard]] static uint64_t getLateFrames() noexcept; //!< Frames dropped because their queries were not ready in time
+	static bool exportCSV(const std::filesystem::path& path); //!< Write the timings as CSV
+
+	static constexpr uint32_t latency{ 3 }; //!< Frames between issuing a frame's queries and reading them
+	static constexpr uint32_t maxScopes{ 64 }; //!< Scopes tracked, beyond this begin is ignored
+	static constexpr uint32_t maxDepth{ 16 }; //!< Scopes open at once
+	static constexpr uint32_t windowSize{ 128 }; //!< Frames the rolling statistics cover
+private:
+	/** \struct Slot
+	*	\brief Queries of one frame in flight, two per scope opened
+	*/
+	struct Slot
+	{
+		std::vector<uint32_t> queries; //!< Timestamp queries, start and end of each record in turn, grown as needed and reused
+		std::vector<uint32_t> records; //!< Scope of each begin this frame
+	};
+
+	/** \struct Window
+	*	\brief Last windowSize frame times of one scope
+	*/
+	struct Window
+	{
+		std::string name; //!< Scope name
+		std::array<float, windowSize> samples{}; //!< Frame times in milliseconds, a ring
+		uint32_t count{ 0 }; //!< Samples held
+		uint32_t next{ 0 }; //!< Where the next sample goes
+		float last{ 0.f }; //!< Most recent sample
+	};
+
+	static void collect(Slot& slot); //!< Read a slot back into the windows if its queries are ready, then empty it
+
+	static constexpr uint32_t noRecord{ UINT32_MAX }; //!< Open scope which was ignored
+	inline static std::array<Slot, latency + 1> s_slots; //!< Ring of frames in flight
+	inline static uint32_t s_current{ 0 }; //!< Slot being written
+	inline static std::array<uint32_t, maxDepth> s_open{}; //!< Record of each open scope, innermost last
+	inline static uint32_t s_depth{ 0 }; //!< Scopes open
+	inline static std::array<uint64_t, maxScopes> s_frameNs{}; //!< Nanoseconds per scope of the slot being read back
+	inline static std::array<bool, maxScopes> s_frameSeen{}; //!< Was each scope opened in the slot being read back
+
+	inline static std::mutex s_mutex; //!< Guards the windows and the late count, read from other threads
+	inline static std::vector<Window> s_windows; //!< Statistics per scope, ids index it
+	inline static uint64_t s_lateFrames{ 0 }; //!< Slots dropped as not ready
+};
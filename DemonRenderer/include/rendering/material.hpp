@@ -24,12 +24,15 @@ public:
 	void unsetValue(const std::string& name); //!< Disable a uniform, so it will not be passed to the shader
 	void apply(); //!< BInd the shader and upload all data
 	const std::string& getTransformUniformName() const { return m_transformUniformName; } //!< Returns the name of the transform uniform
+	const std::string& getInstanceUniformName() const { return m_instanceUniformName; } //!< Returns the name of the per draw instance index uniform, empty if unused
+	void setInstanceUniformName(const std::string& name) { m_instanceUniformName = name; } //!< Sets the name of the per draw instance index uniform
 	inline uint32_t getPrimitive() const { return m_primitive; } //!< Returns the rendering primitive
 	void setPrimitive(uint32_t primitive) { m_primitive = primitive; } //!< Sets the rendering primitive
 	
 private:
 	std::unordered_map <std::string, UniformData> dataCache; //!< Internal data storage for uniforms
 	std::string m_transformUniformName{ "" };//!< The name of the transform uniform
+	std::string m_instanceUniformName{ "" };//!< The name of the instance index uniform, set from an entity's AnalyticSpin
 public:
 	std::shared_ptr<Shader> m_shader{ nullptr }; //!< The materials shader
 
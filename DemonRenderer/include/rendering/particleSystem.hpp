@@ -0,0 +1,134 @@
+/** \file particleSystem.hpp */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <array>
+#include <glm/glm.hpp>
+
+#include "buffers/SSBO.hpp"
+#include "rendering/material.hpp"
+
+/** Constants shared between the particle system and its shaders in assets/shaders/Particles */
+namespace ParticleConsts
+{
+	constexpr uint32_t groupSize = 256; //!< Local size of the emit and simulate shaders
+	constexpr uint32_t maxEmitters = 32; //!< Emitters which can be uploaded in one frame
+	constexpr uint32_t invalidEmitter = UINT32_MAX; //!< Index addEmitter returns once maxEmitters is reached, burst ignores it
+	constexpr uint32_t desktopCapacity = 1 << 20; //!< Default pool size on hardware
+	constexpr uint32_t softwareCapacity = 1 << 16; //!< Default pool size under a software rasteriser such as llvmpipe
+
+	constexpr uint32_t particleBinding = 10; //!< SSBO binding of the particle pool
+	constexpr uint32_t deadListBinding = 11; //!< SSBO binding of the dead list
+	constexpr uint32_t aliveListBinding = 12; //!< SSBO binding of the alive list being read (and drawn)
+	constexpr uint32_t aliveNextListBinding = 13; //!< SSBO binding of the alive list being written
+	constexpr uint32_t counterBinding = 14; //!< SSBO binding of the counters
+	constexpr uint32_t indirectBinding = 15; //!< SSBO binding of the dispatch and draw arguments
+	constexpr uint32_t emitterBinding = 2; //!< SSBO binding of this frame's emitters
+
+	constexpr uint32_t emitArgsOffset = 0; //!< Byte offset of the emit dispatch arguments
+	constexpr uint32_t simulateArgsOffset = 3 * sizeof(uint32_t); //!< Byte offset of the simulate dispatch arguments
+	constexpr uint32_t drawArgsOffset = 6 * sizeof(uint32_t); //!< Byte offset of the draw arrays arguments
+}
+
+/**	\struct ParticleEmitter
+*	\brief CPU side description of a particle emitter
+*/
+struct ParticleEmitter
+{
+	glm::vec3 position{ 0.f }; //!< World space centre of emission
+	float positionSpread{ 0.f }; //!< Radius of the sphere particles are spawned in
+	glm::vec3 velocity{ 0.f }; //!< Base velocity of new particles
+	float velocitySpread{ 1.f }; //!< Radius of the random velocity added to the base velocity
+	glm::vec4 colour{ 1.f }; //!< Colour, values above one will bloom
+	glm::vec2 lifetime{ 1.f, 2.f }; //!< Minimum and maximum lifetime in seconds
+	glm::vec2 size{ 0.1f, 0.f }; //!< Billboard half size at birth and at death
+	float drag{ 0.f }; //!< Fraction of velocity lost per second
+	float rate{ 0.f }; //!< Particles emitted per second, zero for burst only emitters
+	bool enabled{ true }; //!< Is continuous emission enabled
+};
+
+/**	\class ParticleSystem
+*	\brief GPU resident particle system.
+*	Particles live in a fixed size pool. Free slots are held in a dead list and live particles in a pair of alive
+*	index lists which are swapped each frame. Emission pops the dead list, simulation appends survivors to the next
+*	alive list and pushes expired particles back onto the dead list, all with atomics. The surviving count is
+*	written into an indirect draw command so particle state never returns to the CPU.
+*/
+class ParticleSystem
+{
+private:
+	/**	\struct GPUEmitter
+	*	\brief An emitter packed for std430 storage
+	*/
+	struct GPUEmitter
+	{
+		glm::vec4 positionSpread; //!< Position in xyz, position spread in w
+		glm::vec4 velocitySpread; //!< Velocity in xyz, velocity spread in w
+		glm::vec4 colour; //!< Colour
+		glm::vec4 lifeSize; //!< Minimum lifetime, maximum lifetime, start size, end size
+		glm::vec4 drag; //!< Drag in x, yzw unused
+		glm::uvec4 range; //!< First emit index and count in xy, zw unused
+	};
+public:
+	/**	\struct Emission
+	*	\brief A frame's packed emission, taken on the update thread for a later dispatch
+	*/
+	struct Emission
+	{
+		std::vector<GPUEmitter> emitters; //!< Emitters with particles to spawn, each owning a range of emit invocations
+		uint32_t total{ 0 }; //!< Particles requested across all emitters
+		float timestep{ 0.f }; //!< Simulation timestep
+	};
+
+	ParticleSystem() = delete; //!< Deleted default constructor
+	explicit ParticleSystem(uint32_t capacity); //!< Constructor takes the size of the particle pool
+	ParticleSystem(ParticleSystem& other) = delete; //!< Deleted copy constructor
+	ParticleSystem(ParticleSystem&& other) = delete; //!< Deleted move constructor
+	ParticleSystem& operator=(ParticleSystem& other) = delete; //!< Deleted copy assignment operator
+	ParticleSystem& operator=(ParticleSystem&& other) = delete; //!< Deleted move assignment operator
+	~ParticleSystem(); //!< Destructor
+
+	[[nodiscard]] uint32_t addEmitter(const ParticleEmitter& emitter); //!< Add an emitter, returns its index or ParticleConsts::invalidEmitter if the limit has been reached
+	ParticleEmitter& getEmitter(uint32_t index) { assert(index < m_emitters.size() && "Invalid particle emitter index"); return m_emitters[index]; } //!< Access an emitter, the index must be one addEmitter returned successfully
+	void burst(uint32_t emitterIndex, uint32_t count); //!< Emit count particles from an emitter next frame
+	void onUpdate(float timestep); //!< Accumulate emission for the frame
+	void dispatch(); //!< Extract and run emission and simulation on the GPU
+	void extract(Emission& emission); //!< Pack the frame's emission and reset the accumulators, touches no GL
+	void dispatch(const Emission& emission); //!< Run emission and simulation on the GPU from an extracted emission
+	void draw(); //!< Draw the alive particles as additive billboards into the currently bound target
+	inline uint32_t getCapacity() const noexcept { return m_capacity; } //!< Returns the size of the particle pool
+	inline uint32_t getLastEmitCount() const noexcept { return m_lastEmitCount; } //!< Returns the number of particles requested by the last extract
+	inline uint32_t getVertexArrayID() const noexcept { return m_VAO; } //!< Returns the ID of the vertex array bound by draw
+
+	static bool isSoftwareRenderer(); //!< True when running on a software rasteriser such as llvmpipe
+	static uint32_t getDefaultCapacity(); //!< Desktop or software capacity depending on the renderer
+private:
+	uint32_t m_capacity{ 0 }; //!< Size of the particle pool
+	uint32_t m_current{ 0 }; //!< Which alive list is read this frame
+	uint32_t m_frame{ 0 }; //!< Frame counter used to seed the GPU random numbers
+	uint32_t m_lastEmitCount{ 0 }; //!< Particles requested in the last extract
+	float m_timestep{ 0.f }; //!< Simulation timestep for the next extract
+
+	std::vector<ParticleEmitter> m_emitters; //!< All emitters
+	std::vector<float> m_emitAccumulators; //!< Fractional particles carried between frames for each emitter
+	std::vector<uint32_t> m_pendingBursts; //!< Burst counts waiting for the next dispatch
+	Emission m_emission; //!< Staging for this frame's emitters, used by dispatch()
+
+	std::shared_ptr<SSBO> m_particles{ nullptr }; //!< The particle pool
+	std::shared_ptr<SSBO> m_deadList{ nullptr }; //!< Indices of free particles
+	std::array<std::shared_ptr<SSBO>, 2> m_aliveLists; //!< Double buffered indices of alive particles
+	std::shared_ptr<SSBO> m_counters{ nullptr }; //!< Dead count, alive count, next alive count, emit count
+	std::shared_ptr<SSBO> m_indirectArgs{ nullptr }; //!< Emit and simulate dispatch arguments and the draw arguments
+	std::shared_ptr<SSBO> m_emitterBuffer{ nullptr }; //!< This frame's emitters
+
+	std::shared_ptr<Material> m_beginMaterial{ nullptr }; //!< Rolls counters over and sizes the dispatches
+	std::shared_ptr<Material> m_emitMaterial{ nullptr }; //!< Spawns new particles
+	std::shared_ptr<Material> m_simulateMaterial{ nullptr }; //!< Integrates and compacts particles
+	std::shared_ptr<Material> m_endMaterial{ nullptr }; //!< Writes the draw arguments
+	std::shared_ptr<Material> m_drawMaterial{ nullptr }; //!< Billboard shader
+
+	uint32_t m_VAO{ 0 }; //!< Empty vertex array, billboards are built from gl_VertexID
+};
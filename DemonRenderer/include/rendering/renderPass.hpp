@@ -1,5 +1,6 @@
 #pragma once
 #include "rendering/depthOnlyPass.hpp"
+#include "rendering/particleSystem.hpp"
 
 /**	\struct RenderPass
 *	\brief A render pass which only performs rasterisation
@@ -13,6 +14,8 @@ struct RenderPass
 	ViewPort viewPort; //!< Portion of the render target being rendered too
 	bool clearColour{ true };//!< Should the colour buffer be cleared by this parse?
 	bool clearDepth{ true }; //!< Should the depth buffer be cleared by this parse?
+	std::vector<std::shared_ptr<ParticleSystem>> particleSystems; //!< Particle systems drawn after the pass's geometry
+	std::string name; //!< Name the GPU profiler times the pass under, defaults to its type and position in the renderer
 
 	void parseScene(); //!< Populate variable based on the scene
 };
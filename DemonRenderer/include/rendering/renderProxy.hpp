@@ -0,0 +1,78 @@
+/** \file renderProxy.hpp */
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+#include "components/render.hpp"
+#include "components/transform.hpp"
+#include "components/lodassign.hpp"
+
+using AABB = std::pair<glm::vec3, glm::vec3>;
+
+/** \struct RenderProxy
+*	\brief Everything the renderer needs to cull and draw one entity, packed together.
+*/
+struct RenderProxy
+{
+	glm::mat3x4 model; //!< Rows of the world matrix
+	glm::vec3 boundsMin; //!< World space bounds, valid when hasBounds is set
+	uint32_t flags; //!< Combination of the flag constants below
+	glm::vec3 boundsMax; //!< World space bounds, valid when hasBounds is set
+	int32_t instance; //!< AnalyticSpin instance index, -1 when the entity has none
+	Render render; //!< Material and geometry handles
+	uint32_t lodIndex; //!< LOD level to draw
+	int32_t lodNumber; //!< LOD mode, 1 draws a range of the index buffer
+	entt::entity entity; //!< Source entity
+	uint32_t padding; //!< Keeps the proxy a multiple of 16 bytes
+
+	static constexpr uint32_t hasBounds{ 1u << 0 }; //!< The entity has an AABB and can be culled
+	static constexpr uint32_t hasLOD{ 1u << 1 }; //!< The entity has a LODAssign, required by colour passes
+};
+
+/**	\class RenderProxyList
+*	\brief A densely packed copy of the scene's renderable entities.
+*	Built from every entity with Render and WorldMatrix, plus their optional AABB, LODAssign and AnalyticSpin.
+*	Component addresses are cached when the list is rebuilt, which happens whenever one of those components is added
+*	or removed, so a sync is a single linear copy with no sparse set lookups. The renderer syncs each scene once per
+*	frame and every pass then culls and draws from the one contiguous array. Call invalidate after sorting any of the
+*	source pools. Entities with a PreviousTRS are drawn alpha of the way between their previous and current LocalTRS,
+*	their bounds are left at the simulated position so culling matches the physics.
+*/
+class RenderProxyList
+{
+public:
+	explicit RenderProxyList(entt::registry& registry); //!< Constructor which connects to the registry's signals
+	~RenderProxyList(); //!< Destructor which disconnects from the registry
+	RenderProxyList(RenderProxyList& other) = delete; //!< Deleted copy constructor
+	RenderProxyList(RenderProxyList&& other) = delete; //!< Deleted move constructor
+	RenderProxyList& operator=(RenderProxyList& other) = delete; //!< Deleted copy assignment operator
+	RenderProxyList& operator=(RenderProxyList&& other) = delete; //!< Deleted move assignment operator
+
+	void sync(float alpha = 1.f); //!< Rebuild if needed then copy the current component values into the proxies, alpha blends interpolated entities
+	void invalidate() noexcept { m_dirty = true; } //!< Rebuild on the next sync
+	[[nodiscard]] inline const std::vector<RenderProxy>& getProxies() const noexcept { return m_proxies; } //!< Proxies as of the last sync
+	[[nodiscard]] inline size_t size() const noexcept { return m_proxies.size(); } //!< Number of proxies
+private:
+	void onStructureChanged(entt::registry& registry, entt::entity entity) { m_dirty = true; } //!< Signal handler
+	void rebuild(); //!< Collect the renderable entities and cache their component addresses
+
+	/** \struct Source
+	*	\brief Cached component addresses for one proxy
+	*/
+	struct Source
+	{
+		const Render* render; //!< Render component
+		const WorldMatrix* world; //!< World matrix
+		const LODAssign* lod; //!< LOD assignment, may be null
+		const AABB* bounds; //!< Bounds, may be null
+		const LocalTRS* local; //!< Current local transform, null unless previous is set
+		const PreviousTRS* previous; //!< Local transform before the last fixed step, may be null
+	};
+
+	entt::registry& m_registry; //!< Registry being mirrored
+	std::vector<RenderProxy> m_proxies; //!< Packed proxies
+	std::vector<Source> m_sources; //!< Where each proxy is copied from
+	bool m_dirty{ true }; //!< Does the list need rebuilding
+};
@@ -0,0 +1,54 @@
+/** \file renderSnapshot.hpp */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <imgui.h>
+#include "rendering/camera.hpp"
+#include "components/render.hpp"
+
+/** \struct DrawPacket
+*	\brief One draw, resolved from a render proxy when the snapshot was taken
+*/
+struct DrawPacket
+{
+	glm::mat3x4 model; //!< Rows of the world matrix
+	Render render; //!< Material and geometry handles
+	int32_t instance; //!< AnalyticSpin instance index, -1 when the entity has none
+	uint32_t lodIndex; //!< LOD level to draw
+	int32_t lodNumber; //!< LOD mode, 1 draws a range of the index buffer
+};
+
+/**	\class RenderSnapshot
+*	\brief Everything a renderer reads from the scene for one frame, taken on the update thread.
+*	Renderer::extract syncs the scenes, culls each render pass against the main camera and keeps only the visible
+*	draws, so drawing the snapshot never touches the registry. The update thread fills one snapshot while the render
+*	thread draws the other, slot picks which one a frame uses.
+*/
+class RenderSnapshot
+{
+public:
+	std::vector<std::vector<DrawPacket>> renderPasses; //!< Visible draws of each render pass, in the order passes were added
+	std::vector<std::vector<DrawPacket>> depthPasses; //!< Draws of each depth pass, in the order passes were added
+	Camera camera; //!< Main pass camera the render passes were culled with
+
+	static constexpr size_t slots{ 2 }; //!< Snapshots in flight, one written and one drawn
+	[[nodiscard]] static constexpr size_t slot(uint64_t frame) noexcept { return static_cast<size_t>(frame % slots); } //!< Which snapshot a frame uses
+};
+
+/**	\class ImGuiSnapshot
+*	\brief A frame's ImGui draw data, kept for the render thread once ImGui has moved on to the next frame.
+*	capture swaps the buffers of ImGui's draw lists with its own rather than copying them, so ImGui starts the next
+*	frame with the previous snapshot's storage and nothing is allocated once both have grown to size.
+*/
+class ImGuiSnapshot
+{
+public:
+	void capture(ImDrawData* drawData); //!< Take the draw lists of a rendered ImGui frame, call after ImGui::Render
+	void render(); //!< Draw with the OpenGL backend, on the thread owning the context
+private:
+	std::vector<std::unique_ptr<ImDrawList>> m_lists; //!< Storage swapped with ImGui's lists
+	ImDrawData m_drawData; //!< Draw data pointing at m_lists
+};
@@ -4,11 +4,16 @@
 #include "rendering/renderPass.hpp"
 #include "rendering/depthOnlyPass.hpp"
 #include "rendering/computePass.hpp"
+#include "rendering/renderSnapshot.hpp"
+#include "rendering/gpuProfiler.hpp"
 #include <array>
 #include "cameraFrustum.hpp"
 
 /**	\class Renderer
 *	\brief Holds and executes a series of render passes
+*	Drawing is split in two so it can happen on a render thread: extract reads the scenes into a snapshot on the
+*	update thread and render(snapshot) makes the GL calls. render() does both, for single threaded use.
+*	Each pass is timed on the GPU by the GPUProfiler under the pass's name.
 */
 
 
@@ -25,8 +30,12 @@ public:
 	size_t [[nodiscard]] getRenderPassCount() noexcept { return m_renderPasses.size(); } //!< Returns number of renderpasses
 	size_t [[nodiscard]] getDepthPassCount() noexcept { return m_depthPasses.size(); } //!< Returns number of renderpasses
 	size_t [[nodiscard]] getComputePassCount() noexcept { return m_computePasses.size(); } //!< Returns number of renderpasses
-	void render() const; //!< Execute all render passes
+	void render() const; //!< Extract and execute all render passes
+	void extract(RenderSnapshot& snapshot, float alpha = 1.f) const; //!< Sync the scenes and keep each pass's visible draws, touches no GL. Alpha is how far between fixed steps to draw
+	void render(const RenderSnapshot& snapshot) const; //!< Execute all render passes from a snapshot taken by extract
 	void setViewport(int x, int y, int width, int height) const;
+
+	static constexpr size_t cullingGrain{ 1024 }; //!< Fewest proxies culled by one job
 	//size_t LODindex{ 2 };
 
 private:
@@ -38,7 +47,12 @@ private:
 	std::vector<DepthPass> m_depthPasses; //!< Internal storage for depth only passes
 	std::vector<ComputePass> m_computePasses; //!< Internal storage for compute passes
 	std::vector<std::pair<PassType, size_t>> m_renderOrder; //!< Internal storage or order of passes, similar to a sparse set
-	static uint32_t s_ID; //!< Static variable use to check for redundant bind calls.	
+	std::vector<uint32_t> m_passScopes; //!< GPU profiler scope of each pass, in render order
+	mutable std::vector<uint8_t> m_visible; //!< Culling result for each proxy of the pass being extracted, filled in parallel
+	mutable RenderSnapshot m_snapshot; //!< Snapshot used by render()
+	static uint32_t s_targetID; //!< Currently bound framebuffer, used to skip redundant binds
+	static uint32_t s_VAOID; //!< Currently bound vertex array, used to skip redundant binds
+	static uint32_t s_imageID; //!< Texture last bound to an image unit, used to skip redundant binds
 	static ViewPort s_viewID; //!< Static instance of the Viewport struct, use to check if the viewport has already been bound or not.
 	
 	
@@ -4,6 +4,8 @@
 #include "rendering/lights.hpp"
 //#include "gameObjects/actor.hpp"
 #include <entt/entt.hpp> //commented out actor.hpp and added entt.hpp as we are working with registries instead.
+#include "rendering/renderProxy.hpp"
+#include "core/commandBuffer.hpp"
 
 /** \struct Scene
 *	\brief Holds everything which makes up a scene
@@ -14,6 +16,8 @@ struct Scene
 	std::vector<DirectionalLight> m_directionalLights; //!< Directional lights
 	std::vector<PointLight> m_pointLights; //!< Point lights
 	std::vector<SpotLight> m_spotLights; //!< Spot lights
+	RenderProxyList m_renderProxies{ m_entities }; //!< Packed renderables, synced by the renderer once per frame
+	CommandBuffer m_commands; //!< Structural changes recorded during the frame, applied to m_entities at its sync point
 
 	
 
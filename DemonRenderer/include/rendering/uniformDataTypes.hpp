@@ -9,7 +9,7 @@
 #include "assets/texture.hpp"
 #include "assets/cubeMap.hpp"
 
-using UniformDataTypes = std::variant<bool, int32_t, uint32_t, int32_t*, uint32_t*, float, glm::vec2, glm::ivec2, glm::vec3, glm::ivec3, glm::vec4, glm::ivec4, glm::mat4, std::shared_ptr<Texture>, std::shared_ptr<CubeMap>>;
+using UniformDataTypes = std::variant<bool, int32_t, uint32_t, int32_t*, uint32_t*, float, glm::vec2, glm::ivec2, glm::vec3, glm::ivec3, glm::vec4, glm::ivec4, glm::mat3x4, glm::mat4, std::shared_ptr<Texture>, std::shared_ptr<CubeMap>>;
 
 /**	\struct UniformData
 *	\brief Single instance of data, i.e. a data for a single uniform
@@ -28,6 +28,7 @@ namespace UniformConsts
 {
 	const std::unordered_map<GLenum, std::function<void(std::shared_ptr<Shader>, const std::string&, const UniformData&)>>  UDT =
 	{
+		{GL_INT , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<int>(name, std::get<int32_t>(matInfo.data)); } },
 		{GL_FLOAT , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<float>(name, (float)std::get<float>(matInfo.data)); } },
 		{GL_FLOAT_VEC2 , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<glm::vec2>(name, std::get<glm::vec2>(matInfo.data)); } },
 		{GL_FLOAT_VEC3 , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<glm::vec3>(name, std::get<glm::vec3>(matInfo.data)); } },
@@ -37,6 +38,7 @@ namespace UniformConsts
 			else shader->uploadUniform<int>(name, matInfo.size, std::get<int*>(matInfo.data));
 			} 
 		},
+		{GL_FLOAT_MAT3x4 , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<glm::mat3x4>(name, std::get<glm::mat3x4>(matInfo.data)); } },
 		{GL_FLOAT_MAT4 , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<glm::mat4>(name, std::get<glm::mat4>(matInfo.data)); } },
 		{GL_SAMPLER_CUBE , [](std::shared_ptr<Shader> shader, const std::string& name, const UniformData& matInfo) {shader->uploadUniform<int>(name, std::get<std::shared_ptr<CubeMap>>(matInfo.data)->getUnit()); } }
 	};
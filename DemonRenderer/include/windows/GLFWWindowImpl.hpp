@@ -28,6 +28,9 @@ public:
 	void doOpen(const WindowProperties& properties) override; //!< Open a window with properties
 	void doOnUpdate(float timestep) override; //!< Update the window
 	void doSetVSync(bool VSync) override; //!< Set the VSync
+	void pollEvents(); //!< Process window events without drawing, used while a render thread presents
+	void present(); //!< Swap buffers without drawing ImGui, on the thread owning the context
+	[[nodiscard]] inline GLFWwindow* getNativeWindow() const noexcept { return m_nativeWindow.get(); } //!< Returns the GLFW window
 	[[nodiscard]] virtual bool doIsKeyPressed(int32_t keyCode) const override; //!< Function acts on is key pressed
 	[[nodiscard]] virtual bool doIsMouseButtonPressed(int32_t mouseButton) const override; //!< Function acts on is mouse button pressed
 	[[nodiscard]] virtual glm::vec2 doGetMousePosition() const override; //!< Function acts on get mouse position
@@ -4,9 +4,12 @@
 
 #include "stbImage/stb_image.h"
 #include "core/log.hpp"
+#include "core/gpuMemory.hpp"
+#include "core/memoryTracker.hpp"
 
 CubeMap::CubeMap(const std::array<const char*, 6>& filepaths, bool isHDR)
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::assets);
     int32_t width = 0, height = 0, channels = 0;
     unsigned char* data = nullptr;
     float* dataf = nullptr;
@@ -62,6 +65,8 @@ CubeMap::CubeMap(const std::array<const char*, 6>& filepaths, bool isHDR)
         glTextureSubImage3D(m_ID, 0, 0, 0, 0, width, height, 1, format, storageDataType, data);
         stbi_image_free(data);
     }
+    // One level of six faces, 8 bit or half float channels
+    GPUMemory::onCreate(GPUResourceType::cubeMap, m_ID, static_cast<uint64_t>(width) * height * channels * (isHDR ? 2 : 1) * 6);
     
     for (size_t i = 1; i < 6; i++) {
         if (isHDR) {
@@ -81,5 +86,6 @@ CubeMap::CubeMap(const std::array<const char*, 6>& filepaths, bool isHDR)
 
 CubeMap::~CubeMap()
 {
+    GPUMemory::onDestroy(GPUResourceType::cubeMap, m_ID);
     glDeleteTextures(1, &m_ID);
 }
\ No newline at end of file
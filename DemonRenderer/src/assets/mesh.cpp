@@ -1,10 +1,12 @@
 #include "assets/mesh.hpp"
 #include "core/log.hpp"
+#include "core/memoryTracker.hpp"
 
 Model::Model(std::filesystem::path path, uint32_t options) : 
 	m_options(options),
 	m_rootPath(std::filesystem::path(path).remove_filename())
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::assets);
 	auto scene = aiImportFile(path.string().c_str(), aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_FlipUVs);
 	if(scene) processNode(scene->mRootNode, scene);
 	else spdlog::error("No model loaded: scene is empty. Error msg: {}", aiGetErrorString());
@@ -0,0 +1,75 @@
+#include "assets/renderTarget.hpp"
+#include "core/log.hpp"
+#include "core/gpuMemory.hpp"
+#include <algorithm>
+
+RenderTarget::RenderTarget(const RenderTargetDescription& desc)
+{
+	m_width = desc.width;
+	m_height = desc.height;
+	m_format = desc.format;
+	m_levels = std::max(desc.levels, 1u);
+	m_samples = std::max(desc.samples, 1u);
+
+	switch (m_format)
+	{
+	case GL_DEPTH_COMPONENT16:
+	case GL_DEPTH_COMPONENT24:
+	case GL_DEPTH_COMPONENT32:
+	case GL_DEPTH_COMPONENT32F:
+	case GL_DEPTH24_STENCIL8:
+	case GL_DEPTH32F_STENCIL8:
+	case GL_STENCIL_INDEX8:
+		m_channels = 0;
+		break;
+	case GL_R8:
+	case GL_R16F:
+	case GL_R32F:
+		m_channels = 1;
+		m_isHDR = m_format != GL_R8;
+		break;
+	case GL_RG8:
+	case GL_RG16F:
+	case GL_RG32F:
+		m_channels = 2;
+		m_isHDR = m_format != GL_RG8;
+		break;
+	case GL_RGB8:
+		m_channels = 3;
+		break;
+	case GL_R11F_G11F_B10F:
+	case GL_RGB16F:
+	case GL_RGB32F:
+		m_channels = 3;
+		m_isHDR = true;
+		break;
+	case GL_RGBA16F:
+	case GL_RGBA32F:
+		m_channels = 4;
+		m_isHDR = true;
+		break;
+	default:
+		m_channels = 4;
+		break;
+	}
+
+	if (m_samples > 1)
+	{
+		glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &m_ID);
+		glTextureStorage2DMultisample(m_ID, m_samples, m_format, m_width, m_height, GL_TRUE);
+		m_levels = 1;
+	}
+	else
+	{
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+
+		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, m_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_ID, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+
+		glTextureStorage2D(m_ID, m_levels, m_format, m_width, m_height);
+	}
+	GPUMemory::onCreate(GPUResourceType::renderTarget, m_ID, getByteSize());
+}
@@ -1,10 +1,12 @@
 #include "assets/shader.hpp"
 #include "core/log.hpp"
+#include "core/memoryTracker.hpp"
 #include <fstream>
 #include <array>
 
 Shader::Shader(const ShaderDescription& desc)
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::assets);
 	// Compile source file
 	switch (desc.type) {
 	case ShaderType::rasterization :
@@ -310,6 +312,11 @@ void Shader::dispatchUniform(uint32_t location, const glm::mat4& data) const
 	glUniformMatrix4fv(location, 1, false, glm::value_ptr(data));	
 }
 
+void Shader::dispatchUniform(uint32_t location, const glm::mat3x4& data) const
+{
+	glUniformMatrix3x4fv(location, 1, false, glm::value_ptr(data));
+}
+
 void Shader::dispatchUniform(uint32_t location, const glm::vec3& data) const
 {
 	glUniform3fv(location, 1, glm::value_ptr(data));
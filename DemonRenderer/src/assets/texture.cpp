@@ -2,10 +2,14 @@
 #include "assets/texture.hpp"
 #include "stbImage/stb_image.h"
 #include "core/log.hpp"
+#include "core/gpuMemory.hpp"
+#include "core/memoryTracker.hpp"
+#include <algorithm>
 
 
 Texture::Texture(const char* filepath)
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::assets);
 	int width, height, channels;
 	unsigned char* data = stbi_load(filepath, &width, &height, &channels, 0);
 
@@ -22,6 +26,7 @@ Texture::Texture(const TextureDescription& desc)
 
 Texture::~Texture()
 {
+	GPUMemory::onDestroy(GPUResourceType::texture, m_ID);
 	glDeleteTextures(1, &m_ID);
 }
 
@@ -47,25 +52,30 @@ void Texture::init(uint32_t width, uint32_t height, uint32_t channels, unsigned
 
 	int32_t mipCount = 1 + floor(log2(std::max(width, height)));
 	if (channels == 0) { // HACK for depth, maybe good to rpelace this
+		m_format = GL_DEPTH_COMPONENT32;
 		glTextureStorage2D(m_ID, mipCount, GL_DEPTH_COMPONENT32, width, height);
 		if (data) glTextureSubImage2D(m_ID, 0, 0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, data);
 	}
 	else if (channels == 3) {
 		if (isHDR) {
+			m_format = GL_RGB16F;
 			glTextureStorage2D(m_ID, mipCount, GL_RGB16F, width, height);
 			if (data) glTextureSubImage2D(m_ID, 0, 0, 0, width, height, GL_RGB, GL_FLOAT, data);
 		}
 		else {
+			m_format = GL_RGB8;
 			glTextureStorage2D(m_ID, mipCount, GL_RGB8, width, height);
 			if (data) glTextureSubImage2D(m_ID, 0, 0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
 		}
 	}
 	else if (channels == 4) {
 		if (isHDR) {
+			m_format = GL_RGBA16F;
 			glTextureStorage2D(m_ID, mipCount, GL_RGBA16F, width, height);
 			if (data) glTextureSubImage2D(m_ID, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, data);
 		}
 		else {
+			m_format = GL_RGBA8;
 			glTextureStorage2D(m_ID, mipCount, GL_RGBA8, width, height);
 			if (data) glTextureSubImage2D(m_ID, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
 		}
@@ -78,5 +88,60 @@ void Texture::init(uint32_t width, uint32_t height, uint32_t channels, unsigned
 	m_height = height;
 	m_channels = channels;
 	m_isHDR = isHDR;
+	m_levels = mipCount;
+	GPUMemory::onCreate(GPUResourceType::texture, m_ID, getByteSize());
+}
+
+uint64_t Texture::getByteSize() const noexcept
+{
+	uint64_t size = 0;
+	uint64_t bytesPerPixel = getBytesPerPixel(m_format);
+	for (uint32_t level = 0; level < m_levels; level++)
+	{
+		uint64_t levelWidth = std::max(m_width >> level, 1u);
+		uint64_t levelHeight = std::max(m_height >> level, 1u);
+		size += levelWidth * levelHeight * bytesPerPixel;
+	}
+	return size * m_samples;
+}
+
+uint32_t Texture::getBytesPerPixel(uint32_t format) noexcept
+{
+	// Sizes as requested by the format, drivers may pad 3 byte and 24 bit depth formats to 4 bytes
+	switch (format)
+	{
+	case GL_R8:
+	case GL_STENCIL_INDEX8:
+		return 1;
+	case GL_RG8:
+	case GL_R16F:
+	case GL_DEPTH_COMPONENT16:
+		return 2;
+	case GL_RGB8:
+	case GL_DEPTH_COMPONENT24:
+		return 3;
+	case GL_RGBA8:
+	case GL_RG16F:
+	case GL_R32F:
+	case GL_R11F_G11F_B10F:
+	case GL_RGB10_A2:
+	case GL_DEPTH_COMPONENT32:
+	case GL_DEPTH_COMPONENT32F:
+	case GL_DEPTH24_STENCIL8:
+		return 4;
+	case GL_RGB16F:
+		return 6;
+	case GL_RGBA16F:
+	case GL_RG32F:
+	case GL_DEPTH32F_STENCIL8:
+		return 8;
+	case GL_RGB32F:
+		return 12;
+	case GL_RGBA32F:
+		return 16;
+	default:
+		spdlog::warn("Unknown texture format {:#x} when calculating size", format);
+		return 0;
+	}
 }
 
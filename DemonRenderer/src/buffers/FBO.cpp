@@ -4,7 +4,7 @@
 
 uint32_t FBO::s_ID = 0;
 
-FBO::FBO(glm::ivec2 size, FBOLayout layout) : 
+FBO::FBO(glm::ivec2 size, FBOLayout layout, uint32_t samples) : 
 	m_layout(layout),
 	m_size(size)
 {
@@ -15,30 +15,42 @@ FBO::FBO(glm::ivec2 size, FBOLayout layout) :
 	{
 		if (isSampled)
 		{
-			TextureDescription td;
-			td.width = m_size.x;
-			td.height = m_size.y;
+			// Render targets get a single level, nothing renders to or generates lower mips
+			RenderTargetDescription rtd;
+			rtd.width = m_size.x;
+			rtd.height = m_size.y;
+			rtd.samples = samples;
 
 			switch (type)
 			{
 			case AttachmentType::Colour:
-				td.channels = 4;
-				m_sampledTargets.push_back(std::make_shared<Texture>(td));
+				rtd.format = GL_RGBA8;
+				m_sampledTargets.push_back(std::make_shared<RenderTarget>(rtd));
 				glNamedFramebufferTexture(m_ID, GL_COLOR_ATTACHMENT0 + colourAttachementCount, m_sampledTargets.back()->getID(), 0);
 				colourAttachementCount++;
 				break;
 			case AttachmentType::ColourHDR:
-				td.channels = 4;
-				td.isHDR = true;
-				m_sampledTargets.push_back(std::make_shared<Texture>(td));
+				rtd.format = GL_RGBA16F;
+				m_sampledTargets.push_back(std::make_shared<RenderTarget>(rtd));
+				glNamedFramebufferTexture(m_ID, GL_COLOR_ATTACHMENT0 + colourAttachementCount, m_sampledTargets.back()->getID(), 0);
+				colourAttachementCount++;
+				break;
+			case AttachmentType::ColourPackedHDR:
+				rtd.format = GL_R11F_G11F_B10F;
+				m_sampledTargets.push_back(std::make_shared<RenderTarget>(rtd));
 				glNamedFramebufferTexture(m_ID, GL_COLOR_ATTACHMENT0 + colourAttachementCount, m_sampledTargets.back()->getID(), 0);
 				colourAttachementCount++;
 				break;
 			case AttachmentType::Depth:
-				td.channels = 0;
-				m_sampledTargets.push_back(std::make_shared<Texture>(td));
+				rtd.format = GL_DEPTH_COMPONENT32;
+				m_sampledTargets.push_back(std::make_shared<RenderTarget>(rtd));
 				glNamedFramebufferTexture(m_ID, GL_DEPTH_ATTACHMENT, m_sampledTargets.back()->getID(), 0);
 				break;
+			case AttachmentType::DepthAndStencil:
+				rtd.format = GL_DEPTH24_STENCIL8;
+				m_sampledTargets.push_back(std::make_shared<RenderTarget>(rtd));
+				glNamedFramebufferTexture(m_ID, GL_DEPTH_STENCIL_ATTACHMENT, m_sampledTargets.back()->getID(), 0);
+				break;
 			default:
 				spdlog::error("Unsupported FBO sampled attachment type: {}", static_cast<int>(type));
 				break;
@@ -49,16 +61,22 @@ FBO::FBO(glm::ivec2 size, FBOLayout layout) :
 			switch (type)
 			{
 			case AttachmentType::Colour:
-				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size));
+			case AttachmentType::ColourHDR:
+			case AttachmentType::ColourPackedHDR:
+				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size, samples));
 				glNamedFramebufferRenderbuffer(m_ID, GL_COLOR_ATTACHMENT0 + colourAttachementCount, GL_RENDERBUFFER, m_nonSampledTargets.back()->getID());
 				colourAttachementCount++;
 				break;
 			case AttachmentType::Depth:
-				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size));
+				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size, samples));
 				glNamedFramebufferRenderbuffer(m_ID, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_nonSampledTargets.back()->getID());
 				break;
+			case AttachmentType::Stencil:
+				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size, samples));
+				glNamedFramebufferRenderbuffer(m_ID, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_nonSampledTargets.back()->getID());
+				break;
 			case AttachmentType::DepthAndStencil:
-				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size));
+				m_nonSampledTargets.push_back(std::make_shared<RBO>(type, size, samples));
 				glNamedFramebufferRenderbuffer(m_ID, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_nonSampledTargets.back()->getID());
 				break;
 			default:
@@ -76,6 +94,11 @@ FBO::FBO(glm::ivec2 size, FBOLayout layout) :
 
 	if (glCheckNamedFramebufferStatus(m_ID, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		spdlog::error("Framebuffer is not complete!");
+
+	for (auto& target : m_sampledTargets) m_byteSize += target->getByteSize();
+	for (auto& target : m_nonSampledTargets) m_byteSize += target->getByteSize();
+
+	spdlog::info("FBO {} {}x{} created, {:.2f} MB", m_ID, m_size.x, m_size.y, static_cast<double>(m_byteSize) / (1024.0 * 1024.0));
 }
 
 FBO::~FBO()
@@ -2,6 +2,7 @@
 
 #include "buffers/IBO.hpp"
 #include "core/log.hpp"
+#include "core/gpuMemory.hpp"
 
 void IBO::init(const std::vector<uint32_t>& indices)
 {
@@ -9,13 +10,17 @@ void IBO::init(const std::vector<uint32_t>& indices)
 		m_count = indices.size();
 		glCreateBuffers(1, &m_ID);
 		glNamedBufferStorage(m_ID, sizeof(uint32_t) * m_count, indices.data(), GL_DYNAMIC_STORAGE_BIT);
+		GPUMemory::onCreate(GPUResourceType::indexBuffer, m_ID, sizeof(uint32_t) * m_count);
 	}
 	else spdlog::error("IBO reinitilisation attempted on IBO with ID {}", m_ID);
 }
 
 IBO::~IBO()
 {
-	if(m_ID) glDeleteBuffers(1, &m_ID);
+	if (m_ID) {
+		GPUMemory::onDestroy(GPUResourceType::indexBuffer, m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
 }
 
 void IBO::edit(const std::vector<uint32_t>& indices, uint32_t offset)
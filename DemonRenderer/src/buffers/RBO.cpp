@@ -1,29 +1,45 @@
 #include <glad/gl.h>
 #include "buffers/RBO.hpp"
+#include "assets/texture.hpp"
+#include "core/gpuMemory.hpp"
+#include <algorithm>
 
-RBO::RBO(AttachmentType type, glm::ivec2 size)
+RBO::RBO(AttachmentType type, glm::ivec2 size, uint32_t samples)
 {
 	glCreateRenderbuffers(1, &m_ID);
 
 	switch (type)
 	{
 	case AttachmentType::Colour:
-		glNamedRenderbufferStorage(m_ID, GL_RGB8, size.x, size.y);
+		m_format = GL_RGB8;
 		break;
 	case AttachmentType::ColourHDR:
-		glNamedRenderbufferStorage(m_ID, GL_RGB16F, size.x, size.y);
+		m_format = GL_RGB16F;
+		break;
+	case AttachmentType::ColourPackedHDR:
+		m_format = GL_R11F_G11F_B10F;
 		break;
 	case AttachmentType::Depth:
-		glNamedRenderbufferStorage(m_ID, GL_DEPTH_COMPONENT32, size.x, size.y);
+		m_format = GL_DEPTH_COMPONENT32;
+		break;
+	case AttachmentType::Stencil:
+		m_format = GL_STENCIL_INDEX8;
 		break;
 	case AttachmentType::DepthAndStencil:
-		glNamedRenderbufferStorage(m_ID, GL_DEPTH24_STENCIL8, size.x, size.y);
+		m_format = GL_DEPTH24_STENCIL8;
 		break;
 	}
+
+	if (samples > 1) glNamedRenderbufferStorageMultisample(m_ID, samples, m_format, size.x, size.y);
+	else glNamedRenderbufferStorage(m_ID, m_format, size.x, size.y);
+
+	m_byteSize = static_cast<uint64_t>(size.x) * size.y * Texture::getBytesPerPixel(m_format) * std::max(samples, 1u);
+	GPUMemory::onCreate(GPUResourceType::renderbuffer, m_ID, m_byteSize);
 }
 
 RBO::~RBO()
 {
+	GPUMemory::onDestroy(GPUResourceType::renderbuffer, m_ID);
 	glDeleteRenderbuffers(1, &m_ID);
 }
 
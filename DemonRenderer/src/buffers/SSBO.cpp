@@ -6,10 +6,12 @@ SSBO::SSBO(uint32_t size, uint32_t elementCount) : m_size(size), m_elementCount(
 {
    glCreateBuffers(1, &m_ID);
    glNamedBufferData(m_ID, m_size, nullptr, GL_DYNAMIC_DRAW);
+   GPUMemory::onCreate(GPUResourceType::storageBuffer, m_ID, m_size);
 }
 
 SSBO::~SSBO()
 {
+	GPUMemory::onDestroy(GPUResourceType::storageBuffer, m_ID);
 	glDeleteBuffers(1, &m_ID);
 }
 
@@ -1,4 +1,5 @@
 #include "buffers/UBO.hpp"
+#include "core/gpuMemory.hpp"
 
 UBO::UBO(const UBOLayout& layout) : m_layout(layout)
 {
@@ -11,12 +12,14 @@ UBO::UBO(const UBOLayout& layout) : m_layout(layout)
 
 	glCreateBuffers(1, &m_ID);
 	glNamedBufferStorage(m_ID, layout.getSize(), NULL, GL_DYNAMIC_STORAGE_BIT);
+	GPUMemory::onCreate(GPUResourceType::uniformBuffer, m_ID, layout.getSize());
 
 	glBindBufferRange(GL_UNIFORM_BUFFER, m_layout.getBindingPoint(), m_ID, 0, m_layout.getSize());
 }
 
 UBO::~UBO()
 {
+	GPUMemory::onDestroy(GPUResourceType::uniformBuffer, m_ID);
 	glDeleteBuffers(1, &m_ID);
 }
 
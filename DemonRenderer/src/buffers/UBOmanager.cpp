@@ -1,4 +1,5 @@
 #include "buffers/UBOmanager.hpp"
+#include "core/allocationAudit.hpp"
 #include "tracy/TracyOpenGL.hpp"
 
 
@@ -22,7 +23,7 @@ bool UBOManager::addUBO(const UBOLayout& layout)
 
 void UBOManager::uploadCachedValues() const
 {
-	ZoneScopedN("UBO");
+	ZoneAuditedN("UBO");
 	TracyGpuZone("UBO");
 
 	for (auto& ubo : m_UBOs)
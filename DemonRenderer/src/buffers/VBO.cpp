@@ -1,6 +1,7 @@
 #include <glad/gl.h>
 #include "buffers/VBO.hpp"
 #include "core/log.hpp"
+#include "core/gpuMemory.hpp"
 
 
 void VBO::init(const std::vector<float> vertices, const VBOLayout& layout)
@@ -10,6 +11,7 @@ void VBO::init(const std::vector<float> vertices, const VBOLayout& layout)
 		m_layout = layout;
 		glCreateBuffers(1, &m_ID);
 		glNamedBufferStorage(m_ID, sizeof(float) * vertices.size(), vertices.data(), GL_DYNAMIC_STORAGE_BIT);
+		GPUMemory::onCreate(GPUResourceType::vertexBuffer, m_ID, sizeof(float) * vertices.size());
 	}
 	else spdlog::error("VBO reinitilisation attempted on VBO with ID {}", m_ID);
 }
@@ -19,13 +21,17 @@ void VBO::init(void* vertices, uint32_t size, const VBOLayout& layout)
 		m_layout = layout;
 		glCreateBuffers(1, &m_ID);
 		glNamedBufferStorage(m_ID, size, vertices, GL_DYNAMIC_STORAGE_BIT);
+		GPUMemory::onCreate(GPUResourceType::vertexBuffer, m_ID, size);
 	}
 	else spdlog::error("VBO reinitilisation attempted on VBO with ID {}", m_ID);
 }
 
 VBO::~VBO()
 {
-	if(m_ID) glDeleteBuffers(1, &m_ID);
+	if (m_ID) {
+		GPUMemory::onDestroy(GPUResourceType::vertexBuffer, m_ID);
+		glDeleteBuffers(1, &m_ID);
+	}
 }
 
 void VBO::edit(const std::vector<float> vertices, uint32_t offset)
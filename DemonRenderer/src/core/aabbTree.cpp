@@ -0,0 +1,411 @@
+/** \file aabbTree.cpp */
+#include "core/aabbTree.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+	AABB combine(const AABB& a, const AABB& b) noexcept
+	{
+		return { glm::min(a.first, b.first), glm::max(a.second, b.second) };
+	}
+
+	float surfaceArea(const AABB& box) noexcept
+	{
+		const glm::vec3 d = box.second - box.first;
+		return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+	}
+
+	bool contains(const AABB& outer, const AABB& inner) noexcept
+	{
+		return glm::all(glm::lessThanEqual(outer.first, inner.first)) && glm::all(glm::greaterThanEqual(outer.second, inner.second));
+	}
+}
+
+void AABBTree::build(const std::vector<std::pair<entt::entity, AABB>>& boxes)
+{
+	ZoneScopedN("AABBTreeBuild");
+	clear();
+	if (boxes.empty()) return;
+
+	m_nodes.reserve(boxes.size() * 2);
+	std::vector<int32_t> leaves;
+	leaves.reserve(boxes.size());
+	for (auto& [entity, bounds] : boxes)
+	{
+		const int32_t leaf = allocateNode();
+		Node& node = m_nodes[leaf];
+		node.entity = entity;
+		node.height = 0;
+		fatten(node, bounds, glm::vec3(0.f));
+		m_leaves[entity] = leaf;
+		leaves.push_back(leaf);
+		markMoved(leaf);
+	}
+
+	m_root = buildRange(leaves, 0, leaves.size());
+	m_nodes[m_root].parent = nullNode;
+}
+
+void AABBTree::addEntity(entt::entity entity, const AABB& entityAABB)
+{
+	if (m_leaves.count(entity)) {
+		updateEntity(entity, entityAABB);
+		return;
+	}
+
+	const int32_t leaf = allocateNode();
+	Node& node = m_nodes[leaf];
+	node.entity = entity;
+	node.height = 0;
+	fatten(node, entityAABB, glm::vec3(0.f));
+	m_leaves[entity] = leaf;
+	insertLeaf(leaf);
+	markMoved(leaf);
+}
+
+void AABBTree::updateEntity(entt::entity entity, const AABB& entityAABB)
+{
+	auto it = m_leaves.find(entity);
+	if (it == m_leaves.end()) {
+		addEntity(entity, entityAABB);
+		return;
+	}
+
+	const int32_t leaf = it->second;
+	m_pairsDirty = true;
+	Node& node = m_nodes[leaf];
+	const glm::vec3 displacement = (entityAABB.first + entityAABB.second - node.tight.first - node.tight.second) * 0.5f;
+
+	// Still inside its fat box, the tree and the fat pairs are unchanged
+	if (contains(node.fat, entityAABB)) {
+		node.tight = entityAABB;
+		return;
+	}
+
+	removeLeaf(leaf);
+	fatten(m_nodes[leaf], entityAABB, displacement);
+	insertLeaf(leaf);
+	markMoved(leaf);
+	m_reinsertCount++;
+}
+
+void AABBTree::eraseEntity(entt::entity entity)
+{
+	auto it = m_leaves.find(entity);
+	if (it == m_leaves.end()) return;
+	const int32_t leaf = it->second;
+	m_leaves.erase(it);
+
+	for (auto pairIt = m_pairSet.begin(); pairIt != m_pairSet.end();)
+	{
+		const auto [lo, hi] = pairFromKey(*pairIt);
+		pairIt = (lo == entity || hi == entity) ? m_pairSet.erase(pairIt) : std::next(pairIt);
+	}
+
+	removeLeaf(leaf);
+	freeNode(leaf);
+	m_pairsDirty = true;
+}
+
+void AABBTree::clear()
+{
+	m_nodes.clear();
+	m_root = nullNode;
+	m_freeList = nullNode;
+	m_leaves.clear();
+	m_moved.clear();
+	m_pairSet.clear();
+	m_pairs.clear();
+	m_pairsDirty = true;
+	m_reinsertCount = 0;
+}
+
+const std::vector<EntityPair>& AABBTree::getPairs()
+{
+	if (!m_pairsDirty) return m_pairs;
+
+	// Drop pairs whose fat boxes have separated, only a reinserted leaf can have caused it
+	if (!m_moved.empty())
+	{
+		for (auto pairIt = m_pairSet.begin(); pairIt != m_pairSet.end();)
+		{
+			const auto [a, b] = pairFromKey(*pairIt);
+			const bool keep = overlaps(m_nodes[m_leaves[a]].fat, m_nodes[m_leaves[b]].fat);
+			pairIt = keep ? std::next(pairIt) : m_pairSet.erase(pairIt);
+		}
+	}
+
+	// Query each moved leaf's fat box for pairs it has gained
+	std::pmr::vector<int32_t> stack(&Memory::frame());
+	for (int32_t leaf : m_moved)
+	{
+		Node& moved = m_nodes[leaf];
+		if (moved.height != 0 || !moved.moved) continue;
+		moved.moved = false;
+
+		stack.push_back(m_root);
+		while (!stack.empty())
+		{
+			const int32_t index = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[index];
+			if (!overlaps(node.fat, moved.fat)) continue;
+			if (node.isLeaf()) {
+				if (index != leaf) m_pairSet.insert(pairKey(moved.entity, node.entity));
+			}
+			else {
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+	m_moved.clear();
+
+	m_pairs.clear();
+	for (uint64_t key : m_pairSet)
+	{
+		const auto [a, b] = pairFromKey(key);
+		if (overlaps(m_nodes[m_leaves[a]].tight, m_nodes[m_leaves[b]].tight)) m_pairs.emplace_back(a, b);
+	}
+	m_pairsDirty = false;
+	return m_pairs;
+}
+
+void AABBTree::query(const AABB& region, std::vector<entt::entity>& result) const
+{
+	if (m_root == nullNode) return;
+
+	// Queries are made many times a frame, a balanced tree's stack fits on the call stack and only spills to the frame arena
+	std::array<std::byte, 512> buffer;
+	std::pmr::monotonic_buffer_resource scratch(buffer.data(), buffer.size(), &Memory::frame());
+	std::pmr::vector<int32_t> stack(&scratch);
+	stack.reserve(64);
+	stack.push_back(m_root);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (!overlaps(node.fat, region)) continue;
+		if (node.isLeaf()) {
+			if (overlaps(node.tight, region)) result.push_back(node.entity);
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+int32_t AABBTree::allocateNode()
+{
+	int32_t index;
+	if (m_freeList != nullNode) {
+		index = m_freeList;
+		m_freeList = m_nodes[index].parent;
+		m_nodes[index] = Node();
+	}
+	else {
+		index = static_cast<int32_t>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+	return index;
+}
+
+void AABBTree::freeNode(int32_t node)
+{
+	m_nodes[node].parent = m_freeList;
+	m_nodes[node].height = -1;
+	m_nodes[node].moved = false;
+	m_freeList = node;
+}
+
+void AABBTree::insertLeaf(int32_t leaf)
+{
+	if (m_root == nullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = nullNode;
+		return;
+	}
+
+	// Descend while it is cheaper to push the leaf further down than to pair it with the current node
+	const AABB leafBox = m_nodes[leaf].fat;
+	int32_t index = m_root;
+	while (!m_nodes[index].isLeaf())
+	{
+		const Node& node = m_nodes[index];
+		const float area = surfaceArea(node.fat);
+		const float combinedArea = surfaceArea(combine(node.fat, leafBox));
+		const float cost = 2.f * combinedArea; // Make a new parent for this node and the leaf
+		const float inheritanceCost = 2.f * (combinedArea - area); // Growth of every ancestor if the leaf goes further down
+
+		auto childCost = [this, &leafBox, inheritanceCost](int32_t child) {
+			const Node& c = m_nodes[child];
+			const float grown = surfaceArea(combine(c.fat, leafBox));
+			return (c.isLeaf() ? grown : grown - surfaceArea(c.fat)) + inheritanceCost;
+		};
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = m_nodes[sibling].parent;
+	const int32_t newParent = allocateNode();
+	Node& parent = m_nodes[newParent];
+	parent.parent = oldParent;
+	parent.fat = combine(leafBox, m_nodes[sibling].fat);
+	parent.height = m_nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent == nullNode) m_root = newParent;
+	else if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+	else m_nodes[oldParent].child2 = newParent;
+
+	refit(oldParent);
+}
+
+void AABBTree::removeLeaf(int32_t leaf)
+{
+	if (leaf == m_root) {
+		m_root = nullNode;
+		return;
+	}
+
+	const int32_t parent = m_nodes[leaf].parent;
+	const int32_t grandParent = m_nodes[parent].parent;
+	const int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	m_nodes[sibling].parent = grandParent;
+	if (grandParent == nullNode) m_root = sibling;
+	else if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+	else m_nodes[grandParent].child2 = sibling;
+	freeNode(parent);
+
+	refit(grandParent);
+}
+
+void AABBTree::refit(int32_t index)
+{
+	while (index != nullNode)
+	{
+		index = balance(index);
+		Node& node = m_nodes[index];
+		const Node& child1 = m_nodes[node.child1];
+		const Node& child2 = m_nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.fat = combine(child1.fat, child2.fat);
+		index = node.parent;
+	}
+}
+
+int32_t AABBTree::balance(int32_t iA)
+{
+	Node& A = m_nodes[iA];
+	if (A.isLeaf() || A.height < 2) return iA;
+
+	const int32_t iB = A.child1;
+	const int32_t iC = A.child2;
+	Node& B = m_nodes[iB];
+	Node& C = m_nodes[iC];
+	const int32_t heightDifference = C.height - B.height;
+
+	// Rotate the taller child up, A keeps its other child and takes the shorter of the grandchildren
+	auto rotate = [this, iA, &A](int32_t iUp, Node& up, const Node& keep, bool upWasChild2) {
+		const int32_t iF = up.child1;
+		const int32_t iG = up.child2;
+		Node& F = m_nodes[iF];
+		Node& G = m_nodes[iG];
+
+		up.child1 = iA;
+		up.parent = A.parent;
+		A.parent = iUp;
+
+		if (up.parent == nullNode) m_root = iUp;
+		else if (m_nodes[up.parent].child1 == iA) m_nodes[up.parent].child1 = iUp;
+		else m_nodes[up.parent].child2 = iUp;
+
+		const bool keepF = F.height > G.height;
+		const int32_t iStay = keepF ? iF : iG; // Stays under the rotated node
+		const int32_t iMove = keepF ? iG : iF; // Moves across to A
+		up.child2 = iStay;
+		if (upWasChild2) A.child2 = iMove;
+		else A.child1 = iMove;
+		m_nodes[iMove].parent = iA;
+
+		A.fat = combine(keep.fat, m_nodes[iMove].fat);
+		A.height = 1 + std::max(keep.height, m_nodes[iMove].height);
+		up.fat = combine(A.fat, m_nodes[iStay].fat);
+		up.height = 1 + std::max(A.height, m_nodes[iStay].height);
+	};
+
+	if (heightDifference > 1) {
+		rotate(iC, C, B, true);
+		return iC;
+	}
+	if (heightDifference < -1) {
+		rotate(iB, B, C, false);
+		return iB;
+	}
+	return iA;
+}
+
+int32_t AABBTree::buildRange(std::vector<int32_t>& leaves, size_t begin, size_t end)
+{
+	if (end - begin == 1) return leaves[begin];
+
+	// Split at the median centre along the longest axis of the centres
+	glm::vec3 low(std::numeric_limits<float>::max());
+	glm::vec3 high(std::numeric_limits<float>::lowest());
+	for (size_t i = begin; i < end; i++)
+	{
+		const AABB& box = m_nodes[leaves[i]].fat;
+		const glm::vec3 centre = (box.first + box.second) * 0.5f;
+		low = glm::min(low, centre);
+		high = glm::max(high, centre);
+	}
+	const glm::vec3 extent = high - low;
+	const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+	const size_t mid = begin + (end - begin) / 2;
+	std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end, [this, axis](int32_t a, int32_t b) {
+		return m_nodes[a].fat.first[axis] + m_nodes[a].fat.second[axis] < m_nodes[b].fat.first[axis] + m_nodes[b].fat.second[axis];
+	});
+
+	const int32_t child1 = buildRange(leaves, begin, mid);
+	const int32_t child2 = buildRange(leaves, mid, end);
+	const int32_t index = allocateNode();
+	Node& node = m_nodes[index];
+	node.child1 = child1;
+	node.child2 = child2;
+	node.fat = combine(m_nodes[child1].fat, m_nodes[child2].fat);
+	node.height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+	m_nodes[child1].parent = index;
+	m_nodes[child2].parent = index;
+	return index;
+}
+
+void AABBTree::fatten(Node& node, const AABB& tight, const glm::vec3& displacement) const
+{
+	// Grow by the margin, then stretch ahead along the way the box is moving
+	node.tight = tight;
+	node.fat = { tight.first - glm::vec3(m_margin), tight.second + glm::vec3(m_margin) };
+	const glm::vec3 stretch = displacement * m_displacementMultiplier;
+	node.fat.first += glm::min(stretch, glm::vec3(0.f));
+	node.fat.second += glm::max(stretch, glm::vec3(0.f));
+}
+
+void AABBTree::markMoved(int32_t leaf)
+{
+	m_pairsDirty = true;
+	if (m_nodes[leaf].moved) return;
+	m_nodes[leaf].moved = true;
+	m_moved.push_back(leaf);
+}
@@ -0,0 +1,265 @@
+/** \file allocationAudit.cpp */
+#include "core/allocationAudit.hpp"
+#include "core/log.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <dbghelp.h>
+#pragma comment(lib, "dbghelp.lib")
+#endif
+
+namespace
+{
+	constexpr const char* outsideZones{ "(outside zones)" }; //!< Name allocations outside any audited zone are counted under
+
+	uint32_t captureStack(std::array<void*, AllocationRecord::maxDepth>& stack) noexcept
+	{
+#ifdef _WIN32
+		// Skip this function and onAllocate, the first frame is operator new
+		return CaptureStackBackTrace(2, AllocationRecord::maxDepth, stack.data(), nullptr);
+#else
+		return 0;
+#endif
+	}
+
+	void logStack(const AllocationRecord& record)
+	{
+#ifdef _WIN32
+		HANDLE process = GetCurrentProcess();
+		static const bool symbolsLoaded = SymInitialize(process, nullptr, TRUE) == TRUE;
+
+		alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + 256];
+		SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+		for (uint32_t i = 0; i < record.depth; i++)
+		{
+			const DWORD64 address = reinterpret_cast<DWORD64>(record.stack[i]);
+			symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+			symbol->MaxNameLen = 255;
+			DWORD64 displacement = 0;
+			IMAGEHLP_LINE64 line{};
+			line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+			DWORD lineDisplacement = 0;
+
+			if (!symbolsLoaded || !SymFromAddr(process, address, &displacement, symbol)) spdlog::warn("      {:#x}", address);
+			else if (SymGetLineFromAddr64(process, address, &lineDisplacement, &line)) spdlog::warn("      {} {}:{}", symbol->Name, line.FileName, line.LineNumber);
+			else spdlog::warn("      {}+{:#x}", symbol->Name, displacement);
+		}
+#else
+		(void)record;
+#endif
+	}
+}
+
+std::array<AllocationAudit::ZoneCounters, AllocationAudit::maxZones> AllocationAudit::s_zones;
+
+AllocationAudit::Zone::Zone(const char* name) noexcept
+{
+	if (t_zoneDepth < maxZoneDepth) t_zones[t_zoneDepth] = name;
+	t_zoneDepth++;
+}
+
+AllocationAudit::Zone::~Zone()
+{
+	t_zoneDepth--;
+}
+
+const char* AllocationAudit::currentZone() noexcept
+{
+	if (t_zoneDepth == 0) return nullptr;
+	return t_zones[std::min(t_zoneDepth, maxZoneDepth) - 1];
+}
+
+AllocationAudit::ZoneCounters* AllocationAudit::findZone(const char* name) noexcept
+{
+	if (!name) name = outsideZones;
+
+	// Slots are claimed in order, so the first free one ends the search
+	for (auto& zone : s_zones)
+	{
+		const char* key = zone.key.load(std::memory_order_acquire);
+		if (!key && zone.key.compare_exchange_strong(key, name, std::memory_order_acq_rel)) {
+			std::strncpy(zone.label, name, sizeof(zone.label) - 1);
+			zone.ready.store(true, std::memory_order_release);
+			return &zone;
+		}
+		if (key == name) return &zone;
+
+		// The same literal can have a different address in each translation unit, wait for a slot just claimed to be labelled
+		while (!zone.ready.load(std::memory_order_acquire)) {}
+		if (std::strncmp(zone.label, name, sizeof(zone.label) - 1) == 0) return &zone;
+	}
+	return nullptr;
+}
+
+bool AllocationAudit::onAllocate(size_t bytes) noexcept
+{
+	s_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	s_frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	const bool armed = isArmed();
+	ZoneCounters* zone = isEnabled() ? findZone(currentZone()) : nullptr;
+	if (zone) {
+		zone->frameAllocations.fetch_add(1, std::memory_order_relaxed);
+		zone->frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+		if (armed) {
+			zone->armedAllocations.fetch_add(1, std::memory_order_relaxed);
+			zone->armedBytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+	}
+	if (!armed) return false;
+
+	s_armedAllocations.fetch_add(1, std::memory_order_relaxed);
+	s_armedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	const uint32_t index = s_recordCount.fetch_add(1, std::memory_order_relaxed);
+	if (index < maxRecords) {
+		AllocationRecord& record = s_records[index];
+		record.zone = zone ? zone->label : nullptr;
+		record.bytes = bytes;
+		record.frame = s_frame.load(std::memory_order_relaxed);
+		record.depth = captureStack(record.stack);
+		s_recordReady[index].store(true, std::memory_order_release);
+	}
+	return true;
+}
+
+void AllocationAudit::onFree() noexcept
+{
+	s_frameFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocationAudit::onFrameEnd()
+{
+	s_lastFrameAllocations = s_frameAllocations.exchange(0, std::memory_order_relaxed);
+	s_lastFrameBytes = s_frameBytes.exchange(0, std::memory_order_relaxed);
+	s_lastFrameFrees = s_frameFrees.exchange(0, std::memory_order_relaxed);
+	for (auto& zone : s_zones)
+	{
+		if (!zone.key.load(std::memory_order_acquire)) break;
+		zone.lastFrameAllocations = zone.frameAllocations.exchange(0, std::memory_order_relaxed);
+		zone.lastFrameBytes = zone.frameBytes.exchange(0, std::memory_order_relaxed);
+	}
+	TracyPlot("Allocations per frame", static_cast<int64_t>(s_lastFrameAllocations));
+
+	if (isArmed()) {
+		s_armedFrames++;
+		s_worstArmedFrame = std::max(s_worstArmedFrame, s_lastFrameAllocations);
+	}
+	const uint64_t frame = s_frame.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	if (!isRunConfigured() || s_runFinished) return;
+	if (frame == s_runWarmup) {
+		spdlog::info("AllocationAudit: armed after {} warmup frames, measuring {} frames", s_runWarmup, s_runFrames);
+		arm();
+	}
+	else if (frame == s_runWarmup + s_runFrames) {
+		disarm();
+		s_runFinished = true;
+		s_runFailed = s_worstArmedFrame > s_threshold;
+		report();
+		if (s_runFailed) spdlog::error("AllocationAudit: FAILED, worst frame made {} allocations, {} allowed", s_worstArmedFrame, s_threshold);
+		else spdlog::info("AllocationAudit: passed, worst frame made {} allocations, {} allowed", s_worstArmedFrame, s_threshold);
+	}
+}
+
+void AllocationAudit::arm() noexcept
+{
+	disarm();
+	s_armedAllocations.store(0, std::memory_order_relaxed);
+	s_armedBytes.store(0, std::memory_order_relaxed);
+	s_armedFrames = 0;
+	s_worstArmedFrame = 0;
+	for (auto& zone : s_zones)
+	{
+		zone.armedAllocations.store(0, std::memory_order_relaxed);
+		zone.armedBytes.store(0, std::memory_order_relaxed);
+	}
+	for (auto& ready : s_recordReady) ready.store(false, std::memory_order_relaxed);
+	s_recordCount.store(0, std::memory_order_relaxed);
+	setEnabled(true);
+	s_armed.store(true, std::memory_order_relaxed);
+}
+
+void AllocationAudit::configureRun(uint32_t warmupFrames, uint32_t frames, uint64_t threshold) noexcept
+{
+	s_runWarmup = std::max(warmupFrames, 1u);
+	s_runFrames = std::max(frames, 1u);
+	s_threshold = threshold;
+	s_runFinished = false;
+	s_runFailed = false;
+	setEnabled(true);
+}
+
+void AllocationAudit::parseArguments(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--allocation-audit") != 0) continue;
+
+		// Optional warmup frames, measured frames and allocations allowed per frame, in that order
+		uint64_t values[3] = { 300, 600, 0 };
+		for (int j = 0; j < 3 && i + 1 < argc; j++)
+		{
+			char* end = nullptr;
+			const uint64_t value = std::strtoull(argv[i + 1], &end, 10);
+			if (end == argv[i + 1] || *end != '\0') break;
+			values[j] = value;
+			i++;
+		}
+		configureRun(static_cast<uint32_t>(values[0]), static_cast<uint32_t>(values[1]), values[2]);
+	}
+}
+
+void AllocationAudit::report()
+{
+	// The report allocates, which would otherwise be recorded against whatever zone called it
+	const bool armed = isArmed();
+	disarm();
+
+	spdlog::info("AllocationAudit: {} allocations, {} bytes over {} armed frames, worst frame {}", s_armedAllocations.load(std::memory_order_relaxed),
+		s_armedBytes.load(std::memory_order_relaxed), s_armedFrames, s_worstArmedFrame);
+
+	std::vector<AllocationZoneStats> zones;
+	for (size_t i = 0; i < getZoneCount(); i++)
+	{
+		AllocationZoneStats zone = getZone(i);
+		if (zone.armedAllocations > 0) zones.push_back(zone);
+	}
+	std::sort(zones.begin(), zones.end(), [](const AllocationZoneStats& a, const AllocationZoneStats& b) { return a.armedAllocations > b.armedAllocations; });
+	for (const auto& zone : zones) spdlog::info("  {:<24} {:>10} allocations {:>12} bytes", zone.name, zone.armedAllocations, zone.armedBytes);
+
+	const uint32_t seen = s_recordCount.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < std::min(seen, maxRecords); i++)
+	{
+		if (!s_recordReady[i].load(std::memory_order_acquire)) continue;
+		const AllocationRecord& record = s_records[i];
+		spdlog::warn("  #{} frame {}, {} bytes in {}", i, record.frame, record.bytes, record.zone ? record.zone : outsideZones);
+		logStack(record);
+	}
+	if (seen > maxRecords) spdlog::warn("  ... {} more armed allocations not recorded", seen - maxRecords);
+
+	if (armed) s_armed.store(true, std::memory_order_relaxed);
+}
+
+size_t AllocationAudit::getZoneCount() noexcept
+{
+	size_t count = 0;
+	while (count < s_zones.size() && s_zones[count].ready.load(std::memory_order_acquire)) count++;
+	return count;
+}
+
+AllocationZoneStats AllocationAudit::getZone(size_t index) noexcept
+{
+	const ZoneCounters& zone = s_zones[index];
+	return { zone.label, zone.lastFrameAllocations, zone.lastFrameBytes, zone.armedAllocations.load(std::memory_order_relaxed), zone.armedBytes.load(std::memory_order_relaxed) };
+}
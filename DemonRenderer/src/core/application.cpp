@@ -5,6 +5,7 @@
 
 Application::Application(const WindowProperties& winProps)
 {
+	JobSystem::init();
 	m_window.open(winProps);
 
 	m_window.handler.onWinClose = [this](WindowCloseEvent& e) {onClose(e);};
@@ -22,15 +23,49 @@ void Application::run()
 
 	while (m_running) {	
 		FrameMark;
-		ZoneScopedN("Run");
+		ZoneAuditedN("Run");
+		Memory::onFrameStart();
 		auto timestep = m_timer.reset();
 
+		// Switch between threaded and single threaded rendering between frames
+		setRenderThreaded(m_layer && m_layer->useRenderThread());
+
 		onUpdate(timestep);
+		onFixedUpdate(timestep);
+		JobSystem::runMainThreadJobs();
 		if(m_window.isHostingImGui()) onImGuiRender();
-		onRender();
 
-		m_window.onUpdate(timestep);
+		m_frame++;
+		onExtract(m_frame);
+		if (m_renderThread.isRunning())
+		{
+			// The render thread picks the snapshot up once it has drawn the previous frame
+			m_renderThread.submit(m_frame);
+			m_window.pollEvents();
+		}
+		else
+		{
+			onRender(m_frame);
+			m_window.onUpdate(timestep);
+			GPUProfiler::onFrameEnd();
+			ResourceRegistry::onFrameEnd();
+		}
+
+		// An unattended allocation audit closes the application once it has measured its frames
+		AllocationAudit::onFrameEnd();
+		MemoryTracker::onFrameEnd();
+		if (AllocationAudit::isRunFinished()) m_running = false;
 	}
+
+	// Draw the frame in flight and take the context back before anything is released
+	setRenderThreaded(false);
+
+	// Anything still queued for the main thread runs while the context is still alive
+	JobSystem::shutdown();
+
+	// Drop the registry's references and the profiler's queries while the context is still alive
+	GPUProfiler::clear();
+	ResourceRegistry::clear();
 }
 
 void Application::onUpdate(float timestep)
@@ -38,13 +73,67 @@ void Application::onUpdate(float timestep)
 	if (m_layer) m_layer->onUpdate(timestep);
 }
 
-void Application::onRender() const
+void Application::onFixedUpdate(float timestep)
+{
+	ZoneAuditedN("FixedUpdate");
+	const uint32_t steps = m_fixedTimestep.advance(timestep);
+	if (!m_layer) return;
+
+	for (uint32_t i = 0; i < steps; i++) m_layer->onFixedUpdate(m_fixedTimestep.getStep());
+	m_layer->onInterpolate(m_fixedTimestep.getAlpha());
+}
+
+void Application::onExtract(uint64_t frame)
+{
+	ZoneAuditedN("Extract");
+	MemoryTracker::Scope memoryScope(MemoryTag::rendering);
+	if (m_layer) m_layer->onExtract(frame);
+	if (m_renderThread.isRunning() && m_window.isHostingImGui()) m_imGuiSnapshots[RenderSnapshot::slot(frame)].capture(ImGui::GetDrawData());
+}
+
+void Application::onRender(uint64_t frame)
 {
-	if (m_layer) m_layer->onRender();
+	MemoryTracker::Scope memoryScope(MemoryTag::rendering);
+	if (m_layer) m_layer->onRenderFrame(frame);
+}
+
+void Application::renderFrame(uint64_t frame)
+{
+	onRender(frame);
+	if (m_window.isHostingImGui()) m_imGuiSnapshots[RenderSnapshot::slot(frame)].render();
+	m_window.present();
+	GPUProfiler::onFrameEnd();
+	ResourceRegistry::onFrameEnd();
+}
+
+void Application::setRenderThreaded(bool threaded)
+{
+	if (threaded == m_renderThread.isRunning()) return;
+
+	if (threaded)
+	{
+		if (m_window.isHostingImGui())
+		{
+			// Platform windows are created and drawn on the main thread, keep ImGui inside the main window instead
+			ImGuiIO& io = ImGui::GetIO();
+			m_imGuiViewports = (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0;
+			io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+			ImGui::DestroyPlatformWindows();
+			// Creates the backend's GL objects if no frame has been drawn yet, later calls make no GL calls
+			ImGui_ImplOpenGL3_NewFrame();
+		}
+		m_renderThread.start(m_window.getNativeWindow(), [this](uint64_t frame) { renderFrame(frame); });
+	}
+	else
+	{
+		m_renderThread.stop();
+		if (m_window.isHostingImGui() && m_imGuiViewports) ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+	}
 }
 
 void Application::onImGuiRender()
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::ui);
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
@@ -119,8 +208,11 @@ void Application::onMouseScrolled(MouseScrolledEvent& e)
 void* operator new (std::size_t count)
 {
 
-	auto ptr = malloc(count);
-	TracyAlloc(ptr, count);
+	// Each block carries a header charging it to the allocating thread's memory tag
+	auto ptr = MemoryTracker::onAllocate(malloc(count + MemoryTracker::headerSize), count);
+	// Allocations after the audit is armed carry their call stacks into the profiler
+	if (AllocationAudit::onAllocate(count)) TracyAllocS(ptr, count, AllocationAudit::callstackDepth);
+	else TracyAlloc(ptr, count);
 	return ptr;
 
 }
@@ -128,8 +220,9 @@ void* operator new (std::size_t count)
 void operator delete (void* ptr) noexcept
 {
 
+	if (ptr) AllocationAudit::onFree();
 	TracyFree(ptr);
-	free(ptr);
+	free(MemoryTracker::onFree(ptr));
 
 }
 
@@ -0,0 +1,73 @@
+#include "core/benchmark.hpp"
+#include "core/log.hpp"
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <fstream>
+
+BenchmarkResult Benchmark::run(const std::string& name, uint64_t elements, uint32_t iterations, const std::function<void()>& func, uint32_t warmup)
+{
+	for (uint32_t i = 0; i < warmup; i++) func();
+
+	std::vector<double> samples;
+	samples.reserve(iterations);
+
+	for (uint32_t i = 0; i < iterations; i++)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		func();
+		auto end = std::chrono::high_resolution_clock::now();
+		samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+	}
+
+	return fromSamples(name, elements, std::move(samples));
+}
+
+BenchmarkResult Benchmark::fromSamples(const std::string& name, uint64_t elements, std::vector<double> samplesMs)
+{
+	BenchmarkResult result;
+	result.name = name;
+	result.elements = elements;
+	result.iterations = static_cast<uint32_t>(samplesMs.size());
+
+	if (samplesMs.empty()) return result;
+
+	std::sort(samplesMs.begin(), samplesMs.end());
+
+	result.minMs = samplesMs.front();
+	result.meanMs = std::accumulate(samplesMs.begin(), samplesMs.end(), 0.0) / static_cast<double>(samplesMs.size());
+	result.medianMs = samplesMs[samplesMs.size() / 2];
+	result.p95Ms = samplesMs[std::min(samplesMs.size() - 1, (samplesMs.size() * 95) / 100)];
+
+	return result;
+}
+
+void Benchmark::log(const BenchmarkResult& result)
+{
+	spdlog::info("[Benchmark] {:<40} n={:<9} min {:8.4f}ms  mean {:8.4f}ms  median {:8.4f}ms  p95 {:8.4f}ms  {:8.2f}ns/elem",
+		result.name, result.elements, result.minMs, result.meanMs, result.medianMs, result.p95Ms, result.nsPerElement());
+}
+
+bool Benchmark::writeCSV(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results)
+{
+	std::error_code ec;
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+	std::ofstream file(path);
+	if (!file.is_open())
+	{
+		spdlog::error("Could not open benchmark output file: {}", path.string());
+		return false;
+	}
+
+	file << "name,elements,iterations,min_ms,mean_ms,median_ms,p95_ms,ns_per_element\n";
+	for (auto& result : results)
+	{
+		file << result.name << ',' << result.elements << ',' << result.iterations << ','
+			<< result.minMs << ',' << result.meanMs << ',' << result.medianMs << ',' << result.p95Ms << ','
+			<< result.nsPerElement() << '\n';
+	}
+
+	spdlog::info("Benchmark results written to {}", path.string());
+	return true;
+}
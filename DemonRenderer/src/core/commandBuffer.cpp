@@ -0,0 +1,129 @@
+/** \file commandBuffer.cpp */
+#include "core/commandBuffer.hpp"
+#include "core/log.hpp"
+#include "core/memoryTracker.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+
+namespace
+{
+	std::atomic<uint64_t> s_nextEpoch{ 1 }; //!< Epochs are unique across every buffer, so one cached value per thread is enough
+}
+
+CommandBuffer::CommandBuffer() :
+	m_epoch(s_nextEpoch.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+CommandBuffer::Lane* CommandBuffer::acquireLane()
+{
+	thread_local uint64_t cachedEpoch{ 0 };
+	thread_local Lane* cachedLane{ nullptr };
+	if (cachedEpoch == m_epoch) return cachedLane;
+
+	// This thread may have claimed a lane already and then recorded into another buffer
+	const std::thread::id self = std::this_thread::get_id();
+	const uint32_t claimed = std::min(m_laneCount.load(std::memory_order_acquire), maxLanes);
+	Lane* lane = nullptr;
+	for (uint32_t i = 0; i < claimed && !lane; i++)
+	{
+		if (m_lanes[i].owner.load(std::memory_order_acquire) == self) lane = &m_lanes[i];
+	}
+
+	if (!lane) {
+		const uint32_t index = m_laneCount.fetch_add(1, std::memory_order_acq_rel);
+		if (index >= maxLanes) {
+			spdlog::error("CommandBuffer: more than {} threads recorded before an apply, command dropped", maxLanes);
+			return nullptr;
+		}
+		lane = &m_lanes[index];
+		lane->owner.store(self, std::memory_order_release);
+	}
+
+	cachedEpoch = m_epoch;
+	cachedLane = lane;
+	return lane;
+}
+
+PendingEntity CommandBuffer::create()
+{
+	Lane* lane = acquireLane();
+	if (!lane) return { maxLanes, 0 };
+	return { static_cast<uint32_t>(lane - m_lanes.data()), lane->createCount++ };
+}
+
+void CommandBuffer::destroy(entt::entity entity)
+{
+	if (Lane* lane = acquireLane()) lane->destroyed.push_back(entity);
+}
+
+void CommandBuffer::apply(entt::registry& registry)
+{
+	ZoneScopedN("CommandBufferApply");
+	MemoryTracker::Scope memoryScope(MemoryTag::ecs);
+	const uint32_t laneCount = std::min(m_laneCount.load(std::memory_order_acquire), maxLanes);
+	m_created.clear();
+	m_destroyed.clear();
+
+	// Every pending entity in one ranged create per lane
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		Lane& lane = m_lanes[i];
+		lane.created.resize(lane.createCount);
+		if (lane.created.empty()) continue;
+		registry.create(lane.created.begin(), lane.created.end());
+		m_created.insert(m_created.end(), lane.created.begin(), lane.created.end());
+	}
+
+	// Then components, one insert per type per lane
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		for (auto& [type, pool] : m_lanes[i].pools)
+		{
+			if (pool->size() > 0) pool->apply(registry, m_lanes[i].created);
+		}
+	}
+
+	// Destroys last so they win over anything else recorded for the entity
+	for (uint32_t i = 0; i < laneCount; i++) m_destroyed.insert(m_destroyed.end(), m_lanes[i].destroyed.begin(), m_lanes[i].destroyed.end());
+	std::sort(m_destroyed.begin(), m_destroyed.end());
+	m_destroyed.erase(std::unique(m_destroyed.begin(), m_destroyed.end()), m_destroyed.end());
+	m_destroyed.erase(std::remove_if(m_destroyed.begin(), m_destroyed.end(), [&registry](entt::entity entity) { return !registry.valid(entity); }), m_destroyed.end());
+	registry.destroy(m_destroyed.begin(), m_destroyed.end());
+
+	// Keep each lane's memory for the next frame, created stays for resolve
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		Lane& lane = m_lanes[i];
+		lane.owner.store(std::thread::id(), std::memory_order_relaxed);
+		lane.createCount = 0;
+		lane.destroyed.clear();
+		for (auto& [type, pool] : lane.pools) pool->clear();
+	}
+	m_laneCount.store(0, std::memory_order_release);
+	m_epoch = s_nextEpoch.fetch_add(1, std::memory_order_relaxed);
+
+	if (!m_created.empty() || !m_destroyed.empty()) m_onApplied.publish(CommandBatch{ m_created, m_destroyed });
+}
+
+entt::entity CommandBuffer::resolve(PendingEntity entity) const
+{
+	if (entity.lane >= maxLanes || entity.index >= m_lanes[entity.lane].created.size()) {
+		spdlog::error("CommandBuffer: pending entity {} of lane {} has not been applied", entity.index, entity.lane);
+		return entt::null;
+	}
+	return m_lanes[entity.lane].created[entity.index];
+}
+
+size_t CommandBuffer::getCommandCount() const noexcept
+{
+	size_t count = 0;
+	const uint32_t laneCount = std::min(m_laneCount.load(std::memory_order_acquire), maxLanes);
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		const Lane& lane = m_lanes[i];
+		count += lane.createCount + lane.destroyed.size();
+		for (auto& [type, pool] : lane.pools) count += pool->size();
+	}
+	return count;
+}
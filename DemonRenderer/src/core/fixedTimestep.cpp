@@ -0,0 +1,45 @@
+/** \file fixedTimestep.cpp */
+
+#include "core/fixedTimestep.hpp"
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(float rate, uint32_t maxSubsteps) noexcept
+{
+	setRate(rate);
+	setMaxSubsteps(maxSubsteps);
+}
+
+uint32_t FixedTimestep::advance(float frameTime) noexcept
+{
+	m_accumulator += std::max(frameTime, 0.f);
+
+	uint32_t steps = static_cast<uint32_t>(m_accumulator / m_step);
+	if (steps > m_maxSubsteps) {
+		// Keep the fraction so alpha stays continuous, drop the whole steps that do not fit
+		m_droppedSteps += steps - m_maxSubsteps;
+		m_accumulator = std::fmod(m_accumulator, m_step);
+		steps = m_maxSubsteps;
+	}
+	else m_accumulator = std::clamp(m_accumulator - static_cast<float>(steps) * m_step, 0.f, std::nextafter(m_step, 0.f));
+
+	m_lastSteps = steps;
+	m_stepCount += steps;
+	return steps;
+}
+
+void FixedTimestep::reset() noexcept
+{
+	m_accumulator = 0.f;
+}
+
+void FixedTimestep::setRate(float rate) noexcept
+{
+	m_step = 1.f / std::max(rate, 1.f);
+	m_accumulator = std::min(m_accumulator, std::nextafter(m_step, 0.f));
+}
+
+void FixedTimestep::setMaxSubsteps(uint32_t maxSubsteps) noexcept
+{
+	m_maxSubsteps = std::max(maxSubsteps, 1u);
+}
@@ -0,0 +1,199 @@
+/** \file gpuMemory.cpp */
+#include "core/gpuMemory.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+	constexpr std::array<const char*, GPUMemory::typeCount> typeNames{ "textures", "render targets", "cube maps", "renderbuffers", "vertex buffers", "index buffers", "uniform buffers", "storage buffers" }; //!< Names in GPUResourceType order
+	constexpr const char* unowned{ "(unowned)" }; //!< Owner of resources created outside any GPUMemory::Owner
+	constexpr const char* poolName{ "GPU memory" }; //!< Tracy memory pool the resources are reported in
+}
+
+uint64_t GPUMemory::keyOf(GPUResourceType type, uint32_t id) noexcept
+{
+	// Textures, renderbuffers and buffers are named from separate GL namespaces
+	uint64_t space = 2;
+	switch (type)
+	{
+	case GPUResourceType::texture:
+	case GPUResourceType::renderTarget:
+	case GPUResourceType::cubeMap:
+		space = 0;
+		break;
+	case GPUResourceType::renderbuffer:
+		space = 1;
+		break;
+	default:
+		break;
+	}
+	return (space << 32) | id;
+}
+
+uint32_t GPUMemory::ownerIndex(const char* name)
+{
+	if (!name) name = unowned;
+	for (uint32_t i = 0; i < s_owners.size(); i++)
+	{
+		if (s_owners[i].name == name) return i;
+	}
+	s_owners.push_back({ name });
+	return static_cast<uint32_t>(s_owners.size() - 1);
+}
+
+void GPUMemory::onCreate(GPUResourceType type, uint32_t id, uint64_t bytes)
+{
+	if (id == 0) return;
+
+	// Storage is immutable in this engine, but release anything left under the same name rather than double counting
+	onDestroy(type, id);
+
+	const uint64_t key = keyOf(type, id);
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	const uint32_t owner = ownerIndex(t_owner);
+	s_allocations[key] = { bytes, owner, type };
+
+	GPUOwnerStats& ownerStats = s_owners[owner];
+	ownerStats.bytes += bytes;
+	ownerStats.count++;
+	ownerStats.typeBytes[static_cast<size_t>(type)] += bytes;
+
+	GPUTypeStats& typeStats = s_types[static_cast<size_t>(type)];
+	typeStats.bytes += bytes;
+	typeStats.peakBytes = std::max(typeStats.peakBytes, typeStats.bytes);
+	typeStats.count++;
+
+	s_totalBytes += bytes;
+	s_peakBytes = std::max(s_peakBytes, s_totalBytes);
+	TracyAllocN(reinterpret_cast<void*>(key), bytes, poolName);
+
+	if (s_budget > 0 && s_totalBytes > s_budget && !s_overBudget) {
+		spdlog::error("GPUMemory: over budget creating {} {} for {}, {:.2f} of {:.2f} MB", typeNames[static_cast<size_t>(type)], id, ownerStats.name,
+			static_cast<double>(s_totalBytes) / (1024.0 * 1024.0), static_cast<double>(s_budget) / (1024.0 * 1024.0));
+		s_overBudget = true;
+	}
+}
+
+void GPUMemory::onDestroy(GPUResourceType type, uint32_t id)
+{
+	const uint64_t key = keyOf(type, id);
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	auto it = s_allocations.find(key);
+	if (it == s_allocations.end()) return;
+
+	const Allocation& allocation = it->second;
+	GPUOwnerStats& ownerStats = s_owners[allocation.owner];
+	ownerStats.bytes -= allocation.bytes;
+	ownerStats.count--;
+	ownerStats.typeBytes[static_cast<size_t>(allocation.type)] -= allocation.bytes;
+
+	GPUTypeStats& typeStats = s_types[static_cast<size_t>(allocation.type)];
+	typeStats.bytes -= allocation.bytes;
+	typeStats.count--;
+
+	s_totalBytes -= allocation.bytes;
+	TracyFreeN(reinterpret_cast<void*>(key), poolName);
+	s_allocations.erase(it);
+
+	if (s_totalBytes <= s_budget) s_overBudget = false;
+}
+
+void GPUMemory::setBudget(uint64_t bytes) noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_budget = bytes;
+	s_overBudget = false;
+}
+
+bool GPUMemory::writeReport(const std::filesystem::path& path)
+{
+	std::error_code error;
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		spdlog::error("GPUMemory: could not open {} for writing", path.string());
+		return false;
+	}
+
+	const std::vector<GPUOwnerStats> owners = getOwnerStats();
+
+	file << "{\n";
+	file << "\t\"totalBytes\": " << getTotalBytes() << ",\n";
+	file << "\t\"peakBytes\": " << getPeakBytes() << ",\n";
+	file << "\t\"budgetBytes\": " << getBudget() << ",\n";
+	file << "\t\"types\": [\n";
+	for (size_t i = 0; i < typeCount; i++)
+	{
+		const GPUTypeStats stats = getTypeStats(static_cast<GPUResourceType>(i));
+		file << "\t\t{ \"name\": \"" << stats.name << "\", \"bytes\": " << stats.bytes << ", \"peakBytes\": " << stats.peakBytes << ", \"count\": " << stats.count
+			<< " }" << (i + 1 < typeCount ? "," : "") << "\n";
+	}
+	file << "\t],\n";
+	file << "\t\"owners\": [\n";
+	for (size_t i = 0; i < owners.size(); i++)
+	{
+		const GPUOwnerStats& owner = owners[i];
+		file << "\t\t{ \"name\": \"" << owner.name << "\", \"bytes\": " << owner.bytes << ", \"count\": " << owner.count << ", \"types\": {";
+		bool first = true;
+		for (size_t j = 0; j < typeCount; j++)
+		{
+			if (owner.typeBytes[j] == 0) continue;
+			file << (first ? " " : ", ") << "\"" << typeNames[j] << "\": " << owner.typeBytes[j];
+			first = false;
+		}
+		file << (first ? "" : " ") << "} }" << (i + 1 < owners.size() ? "," : "") << "\n";
+	}
+	file << "\t]\n";
+	file << "}\n";
+
+	spdlog::info("GPUMemory: report written to {}", path.string());
+	return true;
+}
+
+uint64_t GPUMemory::getTotalBytes() noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	return s_totalBytes;
+}
+
+uint64_t GPUMemory::getPeakBytes() noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	return s_peakBytes;
+}
+
+uint64_t GPUMemory::getBudget() noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	return s_budget;
+}
+
+GPUTypeStats GPUMemory::getTypeStats(GPUResourceType type) noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	GPUTypeStats stats = s_types[static_cast<size_t>(type)];
+	stats.name = getName(type);
+	return stats;
+}
+
+std::vector<GPUOwnerStats> GPUMemory::getOwnerStats()
+{
+	std::vector<GPUOwnerStats> owners;
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		owners = s_owners;
+	}
+	std::sort(owners.begin(), owners.end(), [](const GPUOwnerStats& a, const GPUOwnerStats& b) { return a.bytes > b.bytes; });
+	return owners;
+}
+
+const char* GPUMemory::getName(GPUResourceType type) noexcept
+{
+	const size_t index = static_cast<size_t>(type);
+	return index < typeCount ? typeNames[index] : "invalid";
+}
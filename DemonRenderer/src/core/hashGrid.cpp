@@ -0,0 +1,177 @@
+/** \file hashGrid.cpp */
+#include "core/hashGrid.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+
+void HashGrid::build(const std::vector<std::pair<entt::entity, AABB>>& boxes)
+{
+	ZoneScopedN("HashGridBuild");
+	clear();
+
+	m_boxes.reserve(boxes.size());
+	m_cells.reserve(boxes.size());
+	for (auto& [entity, bounds] : boxes)
+	{
+		const uint32_t index = static_cast<uint32_t>(m_boxes.size());
+		m_boxes.push_back({ entity, bounds, cellOf(bounds.first), cellOf(bounds.second) });
+		m_boxIndex[entity] = index;
+		link(index);
+	}
+}
+
+void HashGrid::addEntity(entt::entity entity, const AABB& entityAABB)
+{
+	if (m_boxIndex.count(entity)) {
+		updateEntity(entity, entityAABB);
+		return;
+	}
+
+	const uint32_t index = static_cast<uint32_t>(m_boxes.size());
+	m_boxes.push_back({ entity, entityAABB, cellOf(entityAABB.first), cellOf(entityAABB.second) });
+	m_boxIndex[entity] = index;
+	link(index);
+	m_pairsDirty = true;
+}
+
+void HashGrid::updateEntity(entt::entity entity, const AABB& entityAABB)
+{
+	auto it = m_boxIndex.find(entity);
+	if (it == m_boxIndex.end()) {
+		addEntity(entity, entityAABB);
+		return;
+	}
+
+	Box& box = m_boxes[it->second];
+	box.bounds = entityAABB;
+	m_pairsDirty = true;
+
+	const glm::ivec3 cellMin = cellOf(entityAABB.first);
+	const glm::ivec3 cellMax = cellOf(entityAABB.second);
+	if (cellMin == box.cellMin && cellMax == box.cellMax) return;
+
+	unlink(it->second);
+	box.cellMin = cellMin;
+	box.cellMax = cellMax;
+	link(it->second);
+}
+
+void HashGrid::eraseEntity(entt::entity entity)
+{
+	auto it = m_boxIndex.find(entity);
+	if (it == m_boxIndex.end()) return;
+	const uint32_t index = it->second;
+	m_boxIndex.erase(it);
+	unlink(index);
+
+	// Move the last box into the hole and repoint its cells
+	const uint32_t last = static_cast<uint32_t>(m_boxes.size() - 1);
+	if (index != last)
+	{
+		m_boxes[index] = m_boxes[last];
+		m_boxIndex[m_boxes[index].entity] = index;
+		const Box& moved = m_boxes[index];
+		for (int x = moved.cellMin.x; x <= moved.cellMax.x; x++)
+			for (int y = moved.cellMin.y; y <= moved.cellMax.y; y++)
+				for (int z = moved.cellMin.z; z <= moved.cellMax.z; z++)
+				{
+					auto& cell = m_cells[cellKey({ x, y, z })];
+					std::replace(cell.begin(), cell.end(), last, index);
+				}
+	}
+	m_boxes.pop_back();
+	m_pairsDirty = true;
+}
+
+void HashGrid::clear()
+{
+	m_boxes.clear();
+	m_boxIndex.clear();
+	m_cells.clear();
+	m_pairs.clear();
+	m_pairsDirty = true;
+}
+
+const std::vector<EntityPair>& HashGrid::getPairs()
+{
+	if (!m_pairsDirty) return m_pairs;
+
+	m_pairs.clear();
+	for (uint32_t a = 0; a < m_boxes.size(); a++)
+	{
+		const Box& boxA = m_boxes[a];
+		for (int x = boxA.cellMin.x; x <= boxA.cellMax.x; x++)
+			for (int y = boxA.cellMin.y; y <= boxA.cellMax.y; y++)
+				for (int z = boxA.cellMin.z; z <= boxA.cellMax.z; z++)
+				{
+					const glm::ivec3 cell(x, y, z);
+					for (uint32_t b : m_cells[cellKey(cell)])
+					{
+						if (b <= a) continue;
+						const Box& boxB = m_boxes[b];
+						// Only the first cell the two boxes share reports the pair
+						if (glm::max(boxA.cellMin, boxB.cellMin) != cell) continue;
+						if (overlaps(boxA.bounds, boxB.bounds)) m_pairs.emplace_back(boxA.entity, boxB.entity);
+					}
+				}
+	}
+	m_pairsDirty = false;
+	return m_pairs;
+}
+
+void HashGrid::query(const AABB& region, std::vector<entt::entity>& result) const
+{
+	const glm::ivec3 regionMin = cellOf(region.first);
+	const glm::ivec3 regionMax = cellOf(region.second);
+	const glm::i64vec3 span = glm::i64vec3(regionMax) - glm::i64vec3(regionMin) + glm::i64vec3(1);
+
+	// A region covering more cells than are occupied is cheaper to test box by box
+	if (static_cast<uint64_t>(span.x * span.y * span.z) > m_cells.size())
+	{
+		for (auto& box : m_boxes) if (overlaps(box.bounds, region)) result.push_back(box.entity);
+		return;
+	}
+
+	for (int x = regionMin.x; x <= regionMax.x; x++)
+		for (int y = regionMin.y; y <= regionMax.y; y++)
+			for (int z = regionMin.z; z <= regionMax.z; z++)
+			{
+				const glm::ivec3 cell(x, y, z);
+				auto it = m_cells.find(cellKey(cell));
+				if (it == m_cells.end()) continue;
+				for (uint32_t index : it->second)
+				{
+					const Box& box = m_boxes[index];
+					// Only the first cell the box shares with the region reports it
+					if (glm::max(box.cellMin, regionMin) != cell) continue;
+					if (overlaps(box.bounds, region)) result.push_back(box.entity);
+				}
+			}
+}
+
+void HashGrid::link(uint32_t index)
+{
+	const Box& box = m_boxes[index];
+	for (int x = box.cellMin.x; x <= box.cellMax.x; x++)
+		for (int y = box.cellMin.y; y <= box.cellMax.y; y++)
+			for (int z = box.cellMin.z; z <= box.cellMax.z; z++)
+				m_cells[cellKey({ x, y, z })].push_back(index);
+}
+
+void HashGrid::unlink(uint32_t index)
+{
+	const Box& box = m_boxes[index];
+	for (int x = box.cellMin.x; x <= box.cellMax.x; x++)
+		for (int y = box.cellMin.y; y <= box.cellMax.y; y++)
+			for (int z = box.cellMin.z; z <= box.cellMax.z; z++)
+			{
+				auto it = m_cells.find(cellKey({ x, y, z }));
+				if (it == m_cells.end()) continue;
+				auto& cell = it->second;
+				auto found = std::find(cell.begin(), cell.end(), index);
+				if (found != cell.end()) {
+					*found = cell.back();
+					cell.pop_back();
+				}
+				if (cell.empty()) m_cells.erase(it);
+			}
+}
@@ -0,0 +1,227 @@
+/** \file jobSystem.cpp */
+#include "core/jobSystem.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <string>
+
+bool WorkStealingDeque::push(const Job& job)
+{
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	const int64_t top = m_top.load(std::memory_order_acquire);
+	if (bottom - top >= capacity) return false;
+
+	m_jobs[bottom & (capacity - 1)] = job;
+	m_bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+bool WorkStealingDeque::pop(Job& job)
+{
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	job = m_jobs[bottom & (capacity - 1)];
+	if (top == bottom) {
+		// Last job, race any thief for it
+		const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+bool WorkStealingDeque::steal(Job& job)
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+	if (top >= bottom) return false;
+
+	// Copied before claiming, the slot may be reused as soon as top moves on; a failed claim discards the copy
+	job = m_jobs[top & (capacity - 1)];
+	return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+void JobSystem::init(uint32_t threadCount)
+{
+	if (isRunning()) {
+		spdlog::error("JobSystem: already initialised");
+		return;
+	}
+
+	if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	s_workers.clear();
+	s_workers.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; i++) s_workers.push_back(std::make_unique<Worker>());
+
+	t_workerIndex = 0;
+	s_running.store(true, std::memory_order_release);
+	for (uint32_t i = 1; i < threadCount; i++) s_workers[i]->thread = std::thread(&JobSystem::workerLoop, i);
+
+	spdlog::info("JobSystem: {} threads", threadCount);
+}
+
+void JobSystem::shutdown()
+{
+	if (!isRunning()) return;
+
+	// Anything still queued is run here, nothing is left half done
+	while (tryRunOne()) {}
+	runMainThreadJobs();
+
+	s_running.store(false, std::memory_order_release);
+	s_wake.fetch_add(1, std::memory_order_seq_cst);
+	s_wake.notify_all();
+	for (auto& worker : s_workers)
+	{
+		if (worker->thread.joinable()) worker->thread.join();
+	}
+
+	s_workers.clear();
+	t_workerIndex = notWorker;
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	uint32_t idle = 0;
+	while (counter.m_pending.load(std::memory_order_acquire) != 0)
+	{
+		if (isMainThread()) runMainThreadJobs();
+		if (tryRunOne()) idle = 0;
+		else if (++idle > 64) std::this_thread::yield();
+	}
+
+	// Whoever made the final decrement still holds the lock until it has let go of the counter
+	std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::runMainThreadJobs()
+{
+	if (!isMainThread()) {
+		spdlog::error("JobSystem: main thread jobs run from another thread");
+		return;
+	}
+
+	std::vector<Job> jobs;
+	{
+		std::lock_guard<std::mutex> lock(s_mainMutex);
+		if (s_mainJobs.empty()) return;
+		jobs.swap(s_mainJobs);
+	}
+
+	ZoneScopedN("MainThreadJobs");
+	for (const Job& job : jobs) execute(job);
+}
+
+void JobSystem::submit(const Job& job)
+{
+	if (t_workerIndex == notWorker || !isRunning() || !s_workers[t_workerIndex]->deque.push(job)) {
+		execute(job);
+		return;
+	}
+
+	// Pairs with the fence in workerLoop, either the sleeper sees the job or we see the sleeper
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (s_sleeping.load(std::memory_order_relaxed) > 0) {
+		s_wake.fetch_add(1, std::memory_order_relaxed);
+		s_wake.notify_one();
+	}
+}
+
+void JobSystem::execute(Job job)
+{
+	job.function(job);
+	finish(job.counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+	if (!counter) return;
+
+	// Only the final decrement takes the lock
+	uint32_t pending = counter->m_pending.load(std::memory_order_relaxed);
+	while (pending > 1)
+	{
+		if (counter->m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) return;
+	}
+
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter->m_mutex);
+		if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		continuations.swap(counter->m_continuations);
+	}
+	for (const Job& job : continuations) submit(job);
+}
+
+bool JobSystem::tryRunOne()
+{
+	if (t_workerIndex == notWorker || s_workers.empty()) return false;
+
+	Job job;
+	if (s_workers[t_workerIndex]->deque.pop(job)) {
+		execute(job);
+		return true;
+	}
+
+	// Start stealing from a different victim each time so thieves spread out
+	thread_local uint32_t victim = t_workerIndex;
+	const uint32_t count = static_cast<uint32_t>(s_workers.size());
+	for (uint32_t i = 0; i < count; i++)
+	{
+		victim = (victim + 1) % count;
+		if (victim == t_workerIndex) continue;
+		if (s_workers[victim]->deque.steal(job)) {
+			execute(job);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::hasWork()
+{
+	for (const auto& worker : s_workers)
+	{
+		if (worker->deque.size() > 0) return true;
+	}
+	return false;
+}
+
+void JobSystem::workerLoop(uint32_t index)
+{
+	t_workerIndex = index;
+	const std::string name = "Job worker " + std::to_string(index);
+	tracy::SetThreadName(name.c_str());
+
+	uint32_t idle = 0;
+	while (s_running.load(std::memory_order_acquire))
+	{
+		if (tryRunOne()) {
+			idle = 0;
+			continue;
+		}
+
+		// Spin briefly, then yield, then sleep until something is submitted
+		if (++idle < 64) continue;
+		if (idle < 256) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		const uint32_t wake = s_wake.load(std::memory_order_relaxed);
+		s_sleeping.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!hasWork() && s_running.load(std::memory_order_acquire)) s_wake.wait(wake, std::memory_order_relaxed);
+		s_sleeping.fetch_sub(1, std::memory_order_relaxed);
+		idle = 0;
+	}
+}
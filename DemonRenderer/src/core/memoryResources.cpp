@@ -0,0 +1,155 @@
+/** \file memoryResources.cpp */
+#include "core/memoryResources.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace
+{
+	constexpr size_t chunkAlignment{ 64 }; //!< Cache line alignment for blocks and chunks
+
+	// The aligned overloads are not the ones the application replaces, so pool memory is only reported under the pool's name
+	std::byte* allocateAligned(size_t bytes, size_t alignment)
+	{
+		return static_cast<std::byte*>(::operator new(bytes, std::align_val_t(std::max(alignment, alignof(std::max_align_t)))));
+	}
+
+	void freeAligned(void* ptr, size_t alignment) noexcept
+	{
+		::operator delete(ptr, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+	}
+}
+
+FrameArena::FrameArena(const char* name, size_t capacity) :
+	m_name(name),
+	m_capacity(std::max<size_t>(capacity, chunkAlignment))
+{
+	m_block = allocateAligned(m_capacity, chunkAlignment);
+	TracyAllocN(m_block, m_capacity, m_name);
+}
+
+FrameArena::~FrameArena()
+{
+	for (auto& overflow : m_overflow)
+	{
+		TracyFreeN(overflow.ptr, m_name);
+		freeAligned(overflow.ptr, overflow.alignment);
+	}
+	TracyFreeN(m_block, m_name);
+	freeAligned(m_block, chunkAlignment);
+}
+
+void FrameArena::reset()
+{
+	ZoneScopedN("FrameArenaReset");
+	const size_t used = m_offset.load(std::memory_order_relaxed) + m_overflowBytes;
+	TracyPlot(m_name, static_cast<int64_t>(used));
+
+	for (auto& overflow : m_overflow)
+	{
+		TracyFreeN(overflow.ptr, m_name);
+		freeAligned(overflow.ptr, overflow.alignment);
+	}
+	m_overflow.clear();
+
+	// Grow to the high water mark so the next frame like this one fits in the block
+	if (m_overflowBytes > 0)
+	{
+		TracyFreeN(m_block, m_name);
+		freeAligned(m_block, chunkAlignment);
+		m_capacity = std::bit_ceil(used);
+		m_block = allocateAligned(m_capacity, chunkAlignment);
+		TracyAllocN(m_block, m_capacity, m_name);
+	}
+
+	m_overflowBytes = 0;
+	m_lastUsed = used;
+	m_offset.store(0, std::memory_order_relaxed);
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+	const uintptr_t base = reinterpret_cast<uintptr_t>(m_block);
+	size_t offset = m_offset.load(std::memory_order_relaxed);
+	while (true)
+	{
+		const size_t start = ((base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - base;
+		if (start + bytes > m_capacity) return allocateOverflow(bytes, alignment);
+		if (m_offset.compare_exchange_weak(offset, start + bytes, std::memory_order_relaxed)) return m_block + start;
+	}
+}
+
+void* FrameArena::allocateOverflow(size_t bytes, size_t alignment)
+{
+	std::byte* ptr = allocateAligned(bytes, alignment);
+	TracyAllocN(ptr, bytes, m_name);
+
+	std::lock_guard<std::mutex> lock(m_overflowMutex);
+	m_overflow.push_back({ ptr, bytes, alignment });
+	m_overflowBytes += bytes;
+	return ptr;
+}
+
+BlockPool::BlockPool(const char* name, size_t blockSize, size_t blocksPerChunk) :
+	m_name(name),
+	m_blockSize((std::max(blockSize, sizeof(FreeBlock)) + blockAlignment - 1) / blockAlignment * blockAlignment),
+	m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1))
+{
+}
+
+BlockPool::~BlockPool()
+{
+	for (std::byte* chunk : m_chunks) freeAligned(chunk, chunkAlignment);
+}
+
+void* BlockPool::do_allocate(size_t bytes, size_t alignment)
+{
+	if (!fits(bytes, alignment)) {
+		std::byte* ptr = allocateAligned(bytes, alignment);
+		TracyAllocN(ptr, bytes, m_name);
+		m_passedThrough++;
+		return ptr;
+	}
+
+	if (!m_free) grow();
+	FreeBlock* block = m_free;
+	m_free = block->next;
+	m_blocksInUse++;
+	TracyAllocN(block, m_blockSize, m_name);
+	return block;
+}
+
+void BlockPool::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+{
+	TracyFreeN(ptr, m_name);
+	if (!fits(bytes, alignment)) {
+		freeAligned(ptr, alignment);
+		m_passedThrough--;
+		return;
+	}
+
+	FreeBlock* block = static_cast<FreeBlock*>(ptr);
+	block->next = m_free;
+	m_free = block;
+	m_blocksInUse--;
+}
+
+void BlockPool::grow()
+{
+	std::byte* chunk = allocateAligned(m_blockSize * m_blocksPerChunk, chunkAlignment);
+	m_chunks.push_back(chunk);
+
+	// Thread back to front so blocks are handed out in address order
+	for (size_t i = m_blocksPerChunk; i-- > 0;)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * m_blockSize);
+		block->next = m_free;
+		m_free = block;
+	}
+}
+
+void Memory::onFrameStart()
+{
+	s_frame.reset();
+}
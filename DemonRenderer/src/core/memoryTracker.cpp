@@ -0,0 +1,142 @@
+/** \file memoryTracker.cpp */
+#include "core/memoryTracker.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <cassert>
+#include <fstream>
+#include <new>
+
+namespace
+{
+	constexpr std::array<const char*, MemoryTracker::tagCount> tagNames{ "untagged", "assets", "ECS", "physics", "rendering", "UI" }; //!< Names in MemoryTag order
+	constexpr std::array<const char*, MemoryTracker::tagCount> plotNames{ "Heap untagged", "Heap assets", "Heap ECS", "Heap physics", "Heap rendering", "Heap UI" }; //!< Tracy plots, which need one pointer per name
+
+	void raiseTo(std::atomic<uint64_t>& peak, uint64_t value) noexcept
+	{
+		uint64_t current = peak.load(std::memory_order_relaxed);
+		while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	}
+}
+
+std::array<MemoryTracker::TagCounters, MemoryTracker::tagCount> MemoryTracker::s_tags;
+
+void* MemoryTracker::onAllocate(void* block, size_t bytes) noexcept
+{
+	if (!block) return nullptr;
+
+	const MemoryTag tag = t_tag;
+	new (block) Header{ bytes, checkFor(block, bytes), tag };
+
+	TagCounters& counters = s_tags[static_cast<size_t>(tag)];
+	const uint64_t current = counters.currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+	raiseTo(counters.peakBytes, current);
+	raiseTo(counters.framePeakBytes, current);
+
+	return static_cast<std::byte*>(block) + headerSize;
+}
+
+void* MemoryTracker::onFree(void* ptr) noexcept
+{
+	if (!ptr) return nullptr;
+
+	void* block = static_cast<std::byte*>(ptr) - headerSize;
+	Header& header = *static_cast<Header*>(block);
+	if (header.check != checkFor(block, header.bytes) || static_cast<size_t>(header.tag) >= tagCount) return ptr;
+	header.check = ~header.check;
+
+	TagCounters& counters = s_tags[static_cast<size_t>(header.tag)];
+	counters.currentBytes.fetch_sub(header.bytes, std::memory_order_relaxed);
+	counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+	return block;
+}
+
+void MemoryTracker::onFrameEnd()
+{
+	for (size_t i = 0; i < tagCount; i++)
+	{
+		TagCounters& counters = s_tags[i];
+		const uint64_t current = counters.currentBytes.load(std::memory_order_relaxed);
+		const uint64_t framePeak = counters.framePeakBytes.exchange(current, std::memory_order_relaxed);
+		TracyPlot(plotNames[i], static_cast<int64_t>(current));
+
+		if (counters.budgetBytes == 0) continue;
+
+		const bool overBudget = framePeak > counters.budgetBytes;
+		if (overBudget && !counters.overBudget) {
+			spdlog::error("MemoryTracker: {} went over its budget, {} of {} bytes", tagNames[i], framePeak, counters.budgetBytes);
+			assert(counters.action != MemoryBudgetAction::fail && "Memory budget exceeded");
+		}
+		counters.overBudget = overBudget;
+	}
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, uint64_t bytes, MemoryBudgetAction action) noexcept
+{
+	TagCounters& counters = s_tags[static_cast<size_t>(tag)];
+	counters.budgetBytes = bytes;
+	counters.action = action;
+	counters.overBudget = false;
+}
+
+void MemoryTracker::resetPeaks() noexcept
+{
+	for (auto& counters : s_tags)
+	{
+		const uint64_t current = counters.currentBytes.load(std::memory_order_relaxed);
+		counters.peakBytes.store(current, std::memory_order_relaxed);
+		counters.framePeakBytes.store(current, std::memory_order_relaxed);
+	}
+}
+
+bool MemoryTracker::writeReport(const std::filesystem::path& path)
+{
+	std::error_code error;
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		spdlog::error("MemoryTracker: could not open {} for writing", path.string());
+		return false;
+	}
+
+	file << "{\n";
+	file << "\t\"totalBytes\": " << getTotalBytes() << ",\n";
+	file << "\t\"tags\": [\n";
+	for (size_t i = 0; i < tagCount; i++)
+	{
+		const MemoryTagStats stats = getStats(static_cast<MemoryTag>(i));
+		file << "\t\t{ \"name\": \"" << stats.name << "\", \"currentBytes\": " << stats.currentBytes << ", \"peakBytes\": " << stats.peakBytes
+			<< ", \"liveAllocations\": " << stats.liveAllocations << ", \"totalAllocations\": " << stats.totalAllocations
+			<< ", \"budgetBytes\": " << stats.budgetBytes << ", \"action\": \"" << (stats.action == MemoryBudgetAction::fail ? "fail" : "log")
+			<< "\", \"overBudget\": " << (stats.overBudget ? "true" : "false") << " }" << (i + 1 < tagCount ? "," : "") << "\n";
+	}
+	file << "\t]\n";
+	file << "}\n";
+
+	spdlog::info("MemoryTracker: report written to {}", path.string());
+	return true;
+}
+
+MemoryTagStats MemoryTracker::getStats(MemoryTag tag) noexcept
+{
+	const TagCounters& counters = s_tags[static_cast<size_t>(tag)];
+	return { getName(tag), counters.currentBytes.load(std::memory_order_relaxed), counters.peakBytes.load(std::memory_order_relaxed),
+		counters.liveAllocations.load(std::memory_order_relaxed), counters.totalAllocations.load(std::memory_order_relaxed), counters.budgetBytes,
+		counters.action, counters.overBudget };
+}
+
+const char* MemoryTracker::getName(MemoryTag tag) noexcept
+{
+	const size_t index = static_cast<size_t>(tag);
+	return index < tagCount ? tagNames[index] : "invalid";
+}
+
+uint64_t MemoryTracker::getTotalBytes() noexcept
+{
+	uint64_t total = 0;
+	for (const auto& counters : s_tags) total += counters.currentBytes.load(std::memory_order_relaxed);
+	return total;
+}
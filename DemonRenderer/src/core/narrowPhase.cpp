@@ -0,0 +1,357 @@
+/** \file narrowPhase.cpp */
+#include "core/narrowPhase.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define NARROW_AVX2 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define NARROW_AVX2_TARGET
+#else
+#define NARROW_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define NARROW_AVX2 0
+#endif
+
+namespace
+{
+	// A box as fifteen scalars: centre, the three axes and the half extents, in BoxSpherePairBatch's field order
+	constexpr size_t boxFieldCount{ 15 };
+
+	// Distance from box to point less the radius, one lane at a time. The box fields are read per lane or from lane 0
+	template<bool perLaneBox>
+	void distancesScalar(const float* const* box, const float* x, const float* y, const float* z, const float* radius, size_t begin, size_t end, float* out)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const size_t b = perLaneBox ? i : 0;
+			const float dx = x[i] - box[0][b];
+			const float dy = y[i] - box[1][b];
+			const float dz = z[i] - box[2][b];
+
+			float sum = 0.f;
+			for (size_t k = 0; k < 3; k++)
+			{
+				const float projection = dx * box[3 + 3 * k][b] + dy * box[4 + 3 * k][b] + dz * box[5 + 3 * k][b];
+				const float excess = std::max(std::fabs(projection) - box[12 + k][b], 0.f);
+				sum += excess * excess;
+			}
+			out[i] = std::sqrt(sum) - (radius ? radius[i] : 0.f);
+		}
+	}
+
+#if NARROW_AVX2
+	// The same expression eight lanes at a time, returns how many lanes were done so the caller can finish the tail
+	template<bool perLaneBox>
+	NARROW_AVX2_TARGET size_t distancesAVX2(const float* const* box, const float* x, const float* y, const float* z, const float* radius, size_t count, float* out)
+	{
+		const __m256 signMask = _mm256_set1_ps(-0.f);
+		const __m256 zero = _mm256_setzero_ps();
+		__m256 boxLanes[boxFieldCount];
+		if constexpr (!perLaneBox) {
+			for (size_t f = 0; f < boxFieldCount; f++) boxLanes[f] = _mm256_set1_ps(box[f][0]);
+		}
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			if constexpr (perLaneBox) {
+				for (size_t f = 0; f < boxFieldCount; f++) boxLanes[f] = _mm256_loadu_ps(box[f] + i);
+			}
+			const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), boxLanes[0]);
+			const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), boxLanes[1]);
+			const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), boxLanes[2]);
+
+			__m256 sum = zero;
+			for (size_t k = 0; k < 3; k++)
+			{
+				const __m256 projection = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, boxLanes[3 + 3 * k]), _mm256_mul_ps(dy, boxLanes[4 + 3 * k])), _mm256_mul_ps(dz, boxLanes[5 + 3 * k]));
+				const __m256 excess = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, projection), boxLanes[12 + k]), zero);
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(excess, excess));
+			}
+
+			__m256 distance = _mm256_sqrt_ps(sum);
+			if (radius) distance = _mm256_sub_ps(distance, _mm256_loadu_ps(radius + i));
+			_mm256_storeu_ps(out + i, distance);
+		}
+		return i;
+	}
+#endif
+
+	template<bool perLaneBox>
+	void distances(bool useSIMD, const float* const* box, const float* x, const float* y, const float* z, const float* radius, size_t count, float* out)
+	{
+		size_t done = 0;
+#if NARROW_AVX2
+		if (useSIMD) done = distancesAVX2<perLaneBox>(box, x, y, z, radius, count, out);
+#endif
+		distancesScalar<perLaneBox>(box, x, y, z, radius, done, count, out);
+	}
+
+	std::array<float, boxFieldCount> flatten(const OrientedBox& box)
+	{
+		return {
+			box.centre.x, box.centre.y, box.centre.z,
+			box.axes[0].x, box.axes[0].y, box.axes[0].z,
+			box.axes[1].x, box.axes[1].y, box.axes[1].z,
+			box.axes[2].x, box.axes[2].y, box.axes[2].z,
+			box.halfExtents.x, box.halfExtents.y, box.halfExtents.z
+		};
+	}
+}
+
+bool NarrowPhase::s_useSIMD = NarrowPhase::hasAVX2();
+
+OrientedBox OrientedBox::fromCollider(const OBBCollider& obb, const WorldMatrix& world)
+{
+	OrientedBox box;
+	box.centre = world.getTranslation();
+	for (int k = 0; k < 3; k++) box.axes[k] = glm::normalize(world.getAxis(k));
+	box.halfExtents = obb.halfExtents;
+	return box;
+}
+
+AABB OrientedBox::getBounds() const
+{
+	// The absolute rotation applied to the half extents
+	const glm::vec3 extent = glm::abs(axes[0]) * halfExtents.x + glm::abs(axes[1]) * halfExtents.y + glm::abs(axes[2]) * halfExtents.z;
+	return { centre - extent, centre + extent };
+}
+
+void SphereBatch::clear()
+{
+	m_x.clear();
+	m_y.clear();
+	m_z.clear();
+	m_radius.clear();
+	m_entities.clear();
+}
+
+void SphereBatch::reserve(size_t count)
+{
+	m_x.reserve(count);
+	m_y.reserve(count);
+	m_z.reserve(count);
+	m_radius.reserve(count);
+	m_entities.reserve(count);
+}
+
+void SphereBatch::add(entt::entity entity, const glm::vec3& centre, float radius)
+{
+	m_x.push_back(centre.x);
+	m_y.push_back(centre.y);
+	m_z.push_back(centre.z);
+	m_radius.push_back(radius);
+	m_entities.push_back(entity);
+}
+
+void SphereBatch::gather(const entt::registry& registry, const std::vector<entt::entity>& entities)
+{
+	reserve(size() + entities.size());
+	for (entt::entity entity : entities)
+	{
+		auto [sphere, world] = registry.try_get<SphereCollider, WorldMatrix>(entity);
+		if (sphere && world) add(entity, world->getTranslation(), sphere->radius);
+	}
+}
+
+void SphereBatch::gatherAll(const entt::registry& registry)
+{
+	auto view = registry.view<SphereCollider, WorldMatrix>();
+	reserve(size() + view.size_hint());
+	view.each([this](entt::entity entity, const SphereCollider& sphere, const WorldMatrix& world) {
+		add(entity, world.getTranslation(), sphere.radius);
+	});
+}
+
+void BoxSpherePairBatch::clear()
+{
+	for (auto& field : m_fields) field.clear();
+	m_pairs.clear();
+}
+
+void BoxSpherePairBatch::add(const OrientedBox& box, entt::entity boxEntity, const glm::vec3& centre, float radius, entt::entity sphereEntity)
+{
+	const auto flat = flatten(box);
+	for (size_t f = 0; f < boxFieldCount; f++) m_fields[f].push_back(flat[f]);
+	m_fields[sphereField].push_back(centre.x);
+	m_fields[sphereField + 1].push_back(centre.y);
+	m_fields[sphereField + 2].push_back(centre.z);
+	m_fields[sphereField + 3].push_back(radius);
+	m_pairs.emplace_back(boxEntity, sphereEntity);
+}
+
+void BoxSpherePairBatch::gather(const entt::registry& registry, const std::vector<EntityPair>& pairs)
+{
+	for (auto [first, second] : pairs)
+	{
+		// Either entity may be the box
+		if (!registry.all_of<OBBCollider>(first)) std::swap(first, second);
+		auto [obb, boxWorld] = registry.try_get<OBBCollider, WorldMatrix>(first);
+		auto [sphere, sphereWorld] = registry.try_get<SphereCollider, WorldMatrix>(second);
+		if (!obb || !boxWorld || !sphere || !sphereWorld) continue;
+		add(OrientedBox::fromCollider(*obb, *boxWorld), first, sphereWorld->getTranslation(), sphere->radius, second);
+	}
+}
+
+float NarrowPhase::distanceToPoint(const OrientedBox& box, const glm::vec3& point)
+{
+	/* Implementation is based Real - Time Collision Detection by Christer Ericson pp 133
+	*  Calculate the closest point on or inside the OBB.
+	*  Distance is calculate from that.
+	*/
+	const glm::vec3 centre = point - box.centre; // Move the problem so the box is at world centre
+	glm::vec3 closestPoint = box.centre;
+
+	// Project along each axis, clamp to the half extents and move the closest point along that axis
+	for (int k = 0; k < 3; k++)
+	{
+		const float dist = std::clamp(glm::dot(centre, box.axes[k]), -box.halfExtents[k], box.halfExtents[k]);
+		closestPoint += box.axes[k] * dist;
+	}
+
+	return glm::length(closestPoint - point);
+}
+
+void NarrowPhase::distancesToPoints(const OrientedBox& box, const float* x, const float* y, const float* z, size_t count, float* out)
+{
+	const auto flat = flatten(box);
+	std::array<const float*, boxFieldCount> fields;
+	for (size_t f = 0; f < boxFieldCount; f++) fields[f] = &flat[f];
+	distances<false>(s_useSIMD, fields.data(), x, y, z, nullptr, count, out);
+}
+
+void NarrowPhase::distancesToSpheres(const OrientedBox& box, const SphereBatch& spheres, std::vector<float>& out)
+{
+	ZoneScopedN("NarrowPhaseSpheres");
+	out.resize(spheres.size());
+	const auto flat = flatten(box);
+	std::array<const float*, boxFieldCount> fields;
+	for (size_t f = 0; f < boxFieldCount; f++) fields[f] = &flat[f];
+	distances<false>(s_useSIMD, fields.data(), spheres.getX(), spheres.getY(), spheres.getZ(), spheres.getRadius(), spheres.size(), out.data());
+}
+
+void NarrowPhase::distancesForPairs(const BoxSpherePairBatch& pairs, std::vector<float>& out)
+{
+	ZoneScopedN("NarrowPhasePairs");
+	out.resize(pairs.size());
+	std::array<const float*, boxFieldCount> fields;
+	for (size_t f = 0; f < boxFieldCount; f++) fields[f] = pairs.getField(f);
+	const size_t s = BoxSpherePairBatch::sphereField;
+	distances<true>(s_useSIMD, fields.data(), pairs.getField(s), pairs.getField(s + 1), pairs.getField(s + 2), pairs.getField(s + 3), pairs.size(), out.data());
+}
+
+bool NarrowPhase::hasAVX2()
+{
+#if NARROW_AVX2 && defined(_MSC_VER)
+	// AVX2 needs the CPU flag and the OS saving the YMM registers
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+	__cpuidex(info, 1, 0);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif NARROW_AVX2
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+void NarrowPhase::setSIMDEnabled(bool enabled)
+{
+	if (enabled && !hasAVX2()) {
+		spdlog::warn("NarrowPhase: AVX2 is not supported on this CPU, using the scalar path");
+		enabled = false;
+	}
+	s_useSIMD = enabled;
+}
+
+bool NarrowPhase::validate(uint32_t count, uint32_t seed)
+{
+	ZoneScopedN("NarrowPhaseValidate");
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> position(-60.f, 60.f);
+	std::uniform_real_distribution<float> unit(-1.f, 1.f);
+	std::uniform_real_distribution<float> extent(0.05f, 5.f);
+
+	auto randomBox = [&]() {
+		OrientedBox box;
+		box.centre = glm::vec3(position(rng), position(rng), position(rng)) * 0.5f;
+		const glm::mat3 rotation = glm::mat3_cast(glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng) + 1.5f)));
+		for (int k = 0; k < 3; k++) box.axes[k] = rotation[k];
+		box.halfExtents = glm::vec3(extent(rng), extent(rng), extent(rng));
+		return box;
+	};
+
+	// A third of the points inside or on the box, the rest anywhere around it
+	auto randomPoint = [&](const OrientedBox& box) {
+		if (rng() % 3 == 0) return box.centre + box.axes[0] * unit(rng) * box.halfExtents.x + box.axes[1] * unit(rng) * box.halfExtents.y + box.axes[2] * unit(rng) * box.halfExtents.z;
+		return box.centre + glm::vec3(position(rng), position(rng), position(rng));
+	};
+
+	auto matches = [](float reference, float value) {
+		return std::fabs(reference - value) <= 1.0e-4f * std::max(1.f, std::fabs(reference));
+	};
+
+	// One box against many spheres, then a different box in every lane
+	const OrientedBox box = randomBox();
+	SphereBatch spheres;
+	BoxSpherePairBatch pairs;
+	std::vector<float> reference(count);
+	std::vector<float> pairReference(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const glm::vec3 centre = randomPoint(box);
+		const float radius = (i % 4 == 0) ? 0.f : extent(rng);
+		spheres.add(static_cast<entt::entity>(i), centre, radius);
+		reference[i] = distanceToPoint(box, centre) - radius;
+
+		const OrientedBox pairBox = randomBox();
+		const glm::vec3 pairCentre = randomPoint(pairBox);
+		pairs.add(pairBox, static_cast<entt::entity>(i), pairCentre, radius, static_cast<entt::entity>(i));
+		pairReference[i] = distanceToPoint(pairBox, pairCentre) - radius;
+	}
+
+	const bool previous = s_useSIMD;
+	bool passed = true;
+	std::vector<float> result;
+	for (bool simd : { false, true })
+	{
+		if (simd && !hasAVX2()) continue;
+		s_useSIMD = simd;
+		const char* path = simd ? "AVX2" : "scalar";
+
+		distancesToSpheres(box, spheres, result);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (matches(reference[i], result[i])) continue;
+			spdlog::error("NarrowPhase: {} sphere {} distance {} expected {}", path, i, result[i], reference[i]);
+			passed = false;
+			break;
+		}
+
+		distancesForPairs(pairs, result);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (matches(pairReference[i], result[i])) continue;
+			spdlog::error("NarrowPhase: {} pair {} distance {} expected {}", path, i, result[i], pairReference[i]);
+			passed = false;
+			break;
+		}
+	}
+	s_useSIMD = previous;
+
+	if (passed) spdlog::info("NarrowPhase: {} boxes and spheres match the reference{}", count, hasAVX2() ? " on the scalar and AVX2 paths" : "");
+	return passed;
+}
@@ -2,158 +2,133 @@
 
 #include "core/physics.hpp"
 #include <iostream>
+#include "core/log.hpp"
+#include "core/memoryTracker.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
 
 
 namespace Physics
 {
-	/* Implementation is based Real - Time Collision Detection by Christer Ericson pp 133
-	*  Calculate the closest point on or inside the OBB.
-	*  Distance is calculate from that.
-	*/
 	float DistanceOBBToPoint(Scene* scene, const OBBCollider& obb, const glm::vec3& point)
 	{
-		//auto& obbActor = scene->m_actors.at(obb.actorIdx);
-
-		auto& obbTransform = scene->m_entities.get<Transform>(obb.entity);
-
-		// ClosestPoint is the closest point inside or on the interior of the OBB
-		glm::vec3 closestPoint = obbTransform.translation; // Set closest point to actor position
-		glm::vec3 centre = point - obbTransform.translation; // Move the problem so actor is at world centre
-
-		// Get axis of OBB
-		glm::vec3 OBBRight = { obbTransform.transform[0][0], obbTransform.transform[0][1], obbTransform.transform[0][2] };
-		glm::vec3 OBBUp = { obbTransform.transform[1][0], obbTransform.transform[1][1], obbTransform.transform[1][2] };
-		glm::vec3 OBBForward = { -obbTransform.transform[2][0], -obbTransform.transform[2][1], -obbTransform.transform[2][2] };
-
-		// Project along each axis, moving closest point as we go
-
-		// Project along X
-		float distX = glm::dot(centre, OBBRight);
-		// Clamp to OBB half extents
-		distX = std::clamp(distX, -obb.halfExtents.x, obb.halfExtents.x);
-		// Move closest point
-		closestPoint += OBBRight * distX;
-
-		// Project along Y
-		float distY = glm::dot(centre, OBBUp);
-		// Clamp to OBB half extents
-		distY = std::clamp(distY, -obb.halfExtents.y, obb.halfExtents.y);
-		// Move closest point
-		closestPoint += OBBUp * distY;
-
-		// Project along Z
-		float distZ = glm::dot(centre, OBBForward);
-		// Clamp to OBB half extents
-		distZ = std::clamp(distZ, -obb.halfExtents.z, obb.halfExtents.z);
-		// Move closest point
-		closestPoint += OBBUp * distZ;
-
-		// Find the distance squared
-		float distanceSquared = glm::dot(closestPoint - point, closestPoint - point);
-
-		return sqrtf(distanceSquared);
-
+		return NarrowPhase::distanceToPoint(OrientedBox::fromCollider(obb, scene->m_entities.get<WorldMatrix>(obb.entity)), point);
 	}
 	float DistanceOBBToSphere(Scene* scene, const OBBCollider& obb, const SphereCollider& sphere)
 	{
-		auto& sphereCentre = scene->m_entities.get<Transform>(sphere.entity).translation;
+		glm::vec3 sphereCentre = scene->m_entities.get<WorldMatrix>(sphere.entity).getTranslation();
 		return DistanceOBBToPoint(scene, obb, sphereCentre) - sphere.radius;
 
 	}
 }
 
+namespace
+{
+	AABB boundsOf(const OBBCollider& obb, const WorldMatrix& world)
+	{
+		return OrientedBox::fromCollider(obb, world).getBounds();
+	}
+
+	AABB boundsOf(const SphereCollider& sphere, const WorldMatrix& world)
+	{
+		const glm::vec3 position = world.getTranslation();
+		return { position - glm::vec3(sphere.radius), position + glm::vec3(sphere.radius) };
+	}
+}
+
 void BroadPhase::init(std::shared_ptr<Scene> scene)
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::physics);
 	/*
 	Init function is used to generate the AABBs for each entity which has a collider within the game. This is called in the main
 	game after the generateLevel function.
 	*/
+	ZoneScopedN("BroadPhaseInit");
 
+	if (m_scene) m_scene->m_commands.onApplied().disconnect<&BroadPhase::onCommandsApplied>(this);
 	m_scene = scene;
-	m_OBBPlaneSweep = PlaneSweep(glm::vec2(0.5f, 0.2f));
-	m_spherePlaneSweep = PlaneSweep(glm::vec2(0.5f, 0.2f));
+	m_scene->m_commands.onApplied().connect<&BroadPhase::onCommandsApplied>(this);
+	m_backend = createBackend(m_backend->getType());
 
 	m_BoxColliderAABBs.clear();
 	m_SphereColliderAABBs.clear();
+	m_proximity.reset();
+	m_indexDirty = true;
+
+	std::vector<std::pair<entt::entity, AABB>> boxes;
 
 	// Setup AABBs for OBB colliders
-	auto viewOBB = m_scene->m_entities.view<OBBCollider, Transform>();
+	auto viewOBB = m_scene->m_entities.view<OBBCollider, WorldMatrix>();
 	for (auto entity : viewOBB)
 	{
-		auto& obb = viewOBB.get<OBBCollider>(entity);
-		auto& transform = viewOBB.get<Transform>(entity);
-
-		glm::vec3 min = transform.translation - obb.halfExtents;
-		glm::vec3 max = transform.translation + obb.halfExtents;
-
-		m_BoxColliderAABBs[entity] = { min, max };
-
-		m_OBBPlaneSweep.addEntity(entity, { min, max }); // Add entity to the plane sweep for OBB
-
-		m_scene->m_entities.emplace<AABB>(entity, min, max);
+		AABB aabb = boundsOf(viewOBB.get<OBBCollider>(entity), viewOBB.get<WorldMatrix>(entity));
+		m_BoxColliderAABBs[entity] = aabb;
+		boxes.emplace_back(entity, aabb);
 	}
 
 	// Setup AABBs for Sphere colliders
-	auto viewSphere = m_scene->m_entities.view<SphereCollider, Transform>();
+	auto viewSphere = m_scene->m_entities.view<SphereCollider, WorldMatrix>();
 	for (auto entity : viewSphere)
 	{
-		auto& sphere = viewSphere.get<SphereCollider>(entity);
-		auto& transform = viewSphere.get<Transform>(entity);
-
-		glm::vec3 min = transform.translation - glm::vec3(sphere.radius);
-		glm::vec3 max = transform.translation + glm::vec3(sphere.radius);
+		AABB aabb = boundsOf(viewSphere.get<SphereCollider>(entity), viewSphere.get<WorldMatrix>(entity));
+		m_SphereColliderAABBs[entity] = aabb;
+		boxes.emplace_back(entity, aabb);
+	}
 
-		m_SphereColliderAABBs[entity] = { min, max };
+	for (auto& [entity, aabb] : boxes) m_scene->m_entities.emplace_or_replace<AABB>(entity, aabb);
 
-		m_spherePlaneSweep.addEntity(entity, { min, max }); // Add entity to the plane sweep for spheres
+	// Bulk build, rather than one insertion per collider
+	m_backend->build(boxes);
 
-		m_scene->m_entities.emplace<AABB>(entity, min, max);
-	}
+}
 
+BroadPhase::~BroadPhase()
+{
+	if (m_scene) m_scene->m_commands.onApplied().disconnect<&BroadPhase::onCommandsApplied>(this);
 }
 
 void BroadPhase::onUpdate(float timestep)
 {
+	MemoryTracker::Scope memoryScope(MemoryTag::physics);
 	
 	
 	if (!m_scene) return;
+	ZoneScopedN("BroadPhase");
 
-	// Clear the candidate lists before updating
-	OOBcandidates.clear();
-	sphereCandidates.clear();
+	auto& registry = m_scene->m_entities;
+	m_proximity.beginFrame();
 
-	// Iterate through entities in the scene with AABB component
-	auto view = m_scene->m_entities.view<AABB>();
-	for (auto entity : view)
-	{
-		// Get the AABB of the current entity
-		auto& aabb = view.get<AABB>(entity);
+	// Refresh the boxes of colliders which have moved, the sweep only reorders those
+	auto refresh = [this, &registry](entt::entity entity, const AABB& aabb, std::pmr::unordered_map<entt::entity, AABB>& cache) {
+		auto& stored = registry.get<AABB>(entity);
+		if (stored == aabb) return;
+		stored = aabb;
+		cache[entity] = aabb;
+		m_backend->updateEntity(entity, aabb);
+		m_indexDirty = true;
+	};
 
-		// Handle OBB collisions with m_OBBPlaneSweep
-		auto closeEntitiesOBB = m_OBBPlaneSweep.getCloseEntities(aabb);
-		for (auto closeEntity : closeEntitiesOBB)
-		{
-			if (m_BoxColliderAABBs.count(closeEntity))
-				if (std::find(OOBcandidates.begin(), OOBcandidates.end(), closeEntity) == OOBcandidates.end())
-				{
-					OOBcandidates.push_back(closeEntity);
-				}
-		}
+	auto viewOBB = registry.view<OBBCollider, WorldMatrix, AABB>();
+	for (auto entity : viewOBB) refresh(entity, boundsOf(viewOBB.get<OBBCollider>(entity), viewOBB.get<WorldMatrix>(entity)), m_BoxColliderAABBs);
 
-		// Handle Sphere collisions with m_spherePlaneSweep
-		auto closeEntitiesSphere = m_spherePlaneSweep.getCloseEntities(aabb);
-		for (auto closeEntity : closeEntitiesSphere)
+	auto viewSphere = registry.view<SphereCollider, WorldMatrix, AABB>();
+	for (auto entity : viewSphere) refresh(entity, boundsOf(viewSphere.get<SphereCollider>(entity), viewSphere.get<WorldMatrix>(entity)), m_SphereColliderAABBs);
+
+	// Candidates are the colliders in at least one overlapping pair
+	OOBcandidates.clear();
+	sphereCandidates.clear();
+	for (auto& [first, second] : m_backend->getPairs())
+	{
+		for (entt::entity entity : { first, second })
 		{
-			if (m_SphereColliderAABBs.count(closeEntity))
-			{
-				if (std::find(sphereCandidates.begin(), sphereCandidates.end(), closeEntity) == sphereCandidates.end())
-				{
-					sphereCandidates.push_back(closeEntity);
-				}
-			}
+			if (m_BoxColliderAABBs.count(entity)) OOBcandidates.push_back(entity);
+			else sphereCandidates.push_back(entity);
 		}
 	}
-	
+	std::sort(OOBcandidates.begin(), OOBcandidates.end());
+	OOBcandidates.erase(std::unique(OOBcandidates.begin(), OOBcandidates.end()), OOBcandidates.end());
+	std::sort(sphereCandidates.begin(), sphereCandidates.end());
+	sphereCandidates.erase(std::unique(sphereCandidates.begin(), sphereCandidates.end()), sphereCandidates.end());
 
 }
 
@@ -161,13 +136,112 @@ void BroadPhase::erase(entt::entity entity)
 {
 
 	
-	m_OBBPlaneSweep.eraseEntity(entity); // Remove the entity from the OBB planesweep
-	m_spherePlaneSweep.eraseEntity(entity); // Remove the entity from the sphere planesweep
+	m_backend->eraseEntity(entity); // Remove the entity from the backend and its pairs
+	m_proximity.erase(entity); // Stop the sensors tracking it
 	
 	OOBcandidates.erase(std::remove(OOBcandidates.begin(), OOBcandidates.end(), entity), OOBcandidates.end()); // Remove the OBB candidates
 	sphereCandidates.erase(std::remove(sphereCandidates.begin(), sphereCandidates.end(), entity), sphereCandidates.end()); // Remove the sphere candidates
 		
 	m_BoxColliderAABBs.erase(entity); // Remove the entity from the box collider AABBs
 	m_SphereColliderAABBs.erase(entity); // Remove the entity from the sphere collider AABBs
+	m_indexDirty = true; // Drop it from the spatial index when next used
+
+}
+
+void BroadPhase::onCommandsApplied(const CommandBatch& batch)
+{
+	ZoneScopedN("BroadPhaseCommands");
+	MemoryTracker::Scope memoryScope(MemoryTag::physics);
+
+	// Destroyed colliders leave the candidates in one pass, the batch's destroyed entities are sorted
+	bool erased = false;
+	for (entt::entity entity : batch.destroyed)
+	{
+		if (m_BoxColliderAABBs.erase(entity) + m_SphereColliderAABBs.erase(entity) == 0) continue;
+		m_backend->eraseEntity(entity);
+		m_proximity.erase(entity);
+		erased = true;
+	}
+	if (erased) {
+		auto destroyed = [&batch](entt::entity entity) { return std::binary_search(batch.destroyed.begin(), batch.destroyed.end(), entity); };
+		std::erase_if(OOBcandidates, destroyed);
+		std::erase_if(sphereCandidates, destroyed);
+		m_indexDirty = true;
+	}
+
+	// Created colliders join with their current bounds
+	auto& registry = m_scene->m_entities;
+	for (entt::entity entity : batch.created)
+	{
+		auto [obb, sphere, world] = registry.try_get<OBBCollider, SphereCollider, WorldMatrix>(entity);
+		if (!world || (!obb && !sphere)) continue;
+
+		const AABB aabb = obb ? boundsOf(*obb, *world) : boundsOf(*sphere, *world);
+		if (obb) m_BoxColliderAABBs[entity] = aabb;
+		else m_SphereColliderAABBs[entity] = aabb;
+		registry.emplace_or_replace<AABB>(entity, aabb);
+		m_backend->addEntity(entity, aabb);
+		m_indexDirty = true;
+	}
+}
+
+void BroadPhase::query(const AABB& region, std::vector<entt::entity>& result) const
+{
+	m_backend->query(region, result);
+}
 
+void BroadPhase::updateSensor(uint32_t sensor, const OrientedBox& shape)
+{
+	MemoryTracker::Scope memoryScope(MemoryTag::physics);
+	if (!m_scene) return;
+
+	// Every collider which could be inside the outermost shell, spheres' AABBs already include their radius
+	const float range = m_proximity.getRange(sensor);
+	const AABB bounds = shape.getBounds();
+	m_sensorCandidates.clear();
+	m_backend->query({ bounds.first - glm::vec3(range), bounds.second + glm::vec3(range) }, m_sensorCandidates);
+
+	m_proximity.update(sensor, shape, m_scene->m_entities, m_sensorCandidates);
+}
+
+const SpatialIndex& BroadPhase::getSpatialIndex()
+{
+	if (!m_indexDirty) return m_index;
+	ZoneScopedN("SpatialIndexRefresh");
+
+	// Spheres' AABBs are cubes around them, boxes are given the sphere around their AABB
+	m_index.clear();
+	m_index.reserve(m_BoxColliderAABBs.size() + m_SphereColliderAABBs.size());
+	for (auto& [entity, aabb] : m_SphereColliderAABBs) m_index.add(entity, (aabb.first + aabb.second) * 0.5f, (aabb.second.x - aabb.first.x) * 0.5f);
+	for (auto& [entity, aabb] : m_BoxColliderAABBs) m_index.add(entity, (aabb.first + aabb.second) * 0.5f, glm::length(aabb.second - aabb.first) * 0.5f);
+	m_index.build();
+
+	m_indexDirty = false;
+	return m_index;
+}
+
+void BroadPhase::setBackend(BroadPhaseType type)
+{
+	MemoryTracker::Scope memoryScope(MemoryTag::physics);
+	if (type == m_backend->getType()) return;
+
+	std::vector<std::pair<entt::entity, AABB>> boxes;
+	boxes.reserve(m_BoxColliderAABBs.size() + m_SphereColliderAABBs.size());
+	for (auto& box : m_BoxColliderAABBs) boxes.push_back(box);
+	for (auto& box : m_SphereColliderAABBs) boxes.push_back(box);
+
+	m_backend = createBackend(type);
+	m_backend->build(boxes);
+}
+
+std::unique_ptr<BroadPhaseBackend> BroadPhase::createBackend(BroadPhaseType type)
+{
+	switch (type)
+	{
+	case BroadPhaseType::PlaneSweep: return std::make_unique<PlaneSweep>(glm::vec2(0.5f, 0.2f));
+	case BroadPhaseType::AABBTree: return std::make_unique<AABBTree>(0.25f);
+	case BroadPhaseType::HashGrid: return std::make_unique<HashGrid>(8.f);
+	}
+	spdlog::error("BroadPhase: unknown backend {}", static_cast<uint32_t>(type));
+	return std::make_unique<AABBTree>(0.25f);
 }
\ No newline at end of file
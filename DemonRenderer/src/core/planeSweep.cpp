@@ -1,92 +1,219 @@
 /** \file planeSweep.cpp */
 #include "core/planeSweep.hpp"
+#include "tracy/Tracy.hpp"
+#include <limits>
 
-void PlaneSweep::addEntity(entt::entity entity, const AABB& entityAABB)
+void PlaneSweep::build(const std::vector<std::pair<entt::entity, AABB>>& boxes)
 {
+	ZoneScopedN("PlaneSweepBuild");
+	clear();
 
-	float startZ = entityAABB.first.z;
-	float endZ = entityAABB.second.z;
-
-	m_startPoints.emplace_back(startZ, entity); // Adds a start point as the first point in the entities AABB and the entity
-	m_endPoints.emplace_back(endZ, entity); // Adds an end point as the first point in the entities AABB and the entity
-
-	std::sort(m_startPoints.begin(), m_startPoints.end()); // Sort the start points
-	std::sort(m_endPoints.begin(), m_endPoints.end()); // Sort the end points
+	m_boxes.reserve(boxes.size());
+	m_endpoints.reserve(boxes.size() * 2);
+	for (auto& [entity, bounds] : boxes)
+	{
+		const uint32_t index = static_cast<uint32_t>(m_boxes.size());
+		m_boxes.push_back({ entity, bounds, 0, 0 });
+		m_boxIndex[entity] = index;
+		m_endpoints.push_back({ lowOf(bounds), index, true });
+		m_endpoints.push_back({ highOf(bounds), index, false });
+		m_maxExtent = std::max(m_maxExtent, highOf(bounds) - lowOf(bounds));
+	}
 
-	m_startPosition = m_startPoints.begin(); // Set the start position as the first point in start points
-	m_endPosition = m_endPoints.begin(); // Set the end position as the first point in end points
+	// One sort, mins before maxes at equal values so touching boxes count as overlapping
+	std::sort(m_endpoints.begin(), m_endpoints.end(), [](const Endpoint& a, const Endpoint& b) {
+		return a.value < b.value || (a.value == b.value && a.isMin && !b.isMin);
+	});
 
+	// One sweep, every box opened while another is open overlaps it on the axis
+	std::vector<uint32_t> active;
+	std::vector<uint32_t> activeSlot(m_boxes.size(), 0);
+	for (uint32_t i = 0; i < m_endpoints.size(); i++)
+	{
+		const Endpoint& endpoint = m_endpoints[i];
+		Box& box = m_boxes[endpoint.box];
+		if (endpoint.isMin)
+		{
+			box.minEndpoint = i;
+			for (uint32_t other : active) m_pairSet.insert(pairKey(box.entity, m_boxes[other].entity));
+			activeSlot[endpoint.box] = static_cast<uint32_t>(active.size());
+			active.push_back(endpoint.box);
+		}
+		else
+		{
+			box.maxEndpoint = i;
+			const uint32_t slot = activeSlot[endpoint.box];
+			active[slot] = active.back();
+			activeSlot[active[slot]] = slot;
+			active.pop_back();
+		}
+	}
+	m_pairsDirty = true;
 }
 
-void PlaneSweep::eraseEntity(entt::entity entity)
+void PlaneSweep::addEntity(entt::entity entity, const AABB& entityAABB)
 {
+	if (m_boxIndex.count(entity)) {
+		updateEntity(entity, entityAABB);
+		return;
+	}
 
-	m_startPoints.erase(
-		std::remove_if(m_startPoints.begin(), m_startPoints.end(), 
-			[entity](const auto& pair) { return pair.second == entity; }),
-		m_startPoints.end()); // All start points with the entity are removed
-
-	m_endPoints.erase(
-		std::remove_if(m_endPoints.begin(), m_endPoints.end(),
-			[entity](const auto& pair) {return pair.second == entity; }),
-		m_endPoints.end()); // All end points with the entity are removed
+	// Start past the end of the axis and slide into place, collecting pairs on the way
+	const uint32_t index = static_cast<uint32_t>(m_boxes.size());
+	const uint32_t first = static_cast<uint32_t>(m_endpoints.size());
+	const float far = std::numeric_limits<float>::max();
+	m_boxes.push_back({ entity, { glm::vec3(far), glm::vec3(far) }, first, first + 1 });
+	m_boxIndex[entity] = index;
+	m_endpoints.push_back({ far, index, true });
+	m_endpoints.push_back({ far, index, false });
 
-	m_closeEntities.clear(); // Clears close entities
+	updateEntity(entity, entityAABB);
+}
 
-	m_startPosition = m_startPoints.begin(); // Start position is reset as the first point in start points
-	m_endPosition = m_endPoints.begin(); // End position is reset as the first point in the end points
+void PlaneSweep::updateEntity(entt::entity entity, const AABB& entityAABB)
+{
+	auto it = m_boxIndex.find(entity);
+	if (it == m_boxIndex.end()) {
+		addEntity(entity, entityAABB);
+		return;
+	}
 
+	Box& box = m_boxes[it->second];
+	const float oldLow = m_endpoints[box.minEndpoint].value;
+	box.bounds = entityAABB;
+	m_endpoints[box.minEndpoint].value = lowOf(entityAABB);
+	m_endpoints[box.maxEndpoint].value = highOf(entityAABB);
+	m_maxExtent = std::max(m_maxExtent, highOf(entityAABB) - lowOf(entityAABB));
+
+	// Move the leading endpoint first so a box never passes its own other end
+	if (lowOf(entityAABB) < oldLow) {
+		sortEndpoint(box.minEndpoint);
+		sortEndpoint(m_boxes[it->second].maxEndpoint);
+	}
+	else {
+		sortEndpoint(box.maxEndpoint);
+		sortEndpoint(m_boxes[it->second].minEndpoint);
+	}
+	m_pairsDirty = true;
 }
 
-const std::vector<entt::entity>& PlaneSweep::getCloseEntities(const AABB& ship)
+void PlaneSweep::eraseEntity(entt::entity entity)
 {
+	auto it = m_boxIndex.find(entity);
+	if (it == m_boxIndex.end()) return;
+	const uint32_t index = it->second;
+	m_boxIndex.erase(it);
 
-	m_closeEntities.clear();
-
-	/*
-		Create the window, taking into account the ship AABB and the window of the plane sweep (m_window)
-	*/
-	float windowStart = ship.first.z - m_window.x;
-	float windowEnd = ship.second.z + m_window.y;
+	for (auto pairIt = m_pairSet.begin(); pairIt != m_pairSet.end();)
+	{
+		const auto [lo, hi] = pairFromKey(*pairIt);
+		pairIt = (lo == entity || hi == entity) ? m_pairSet.erase(pairIt) : std::next(pairIt);
+	}
 
-	m_startPosition = m_startPoints.begin();
-	m_endPosition = m_endPoints.begin();
+	// Remove its endpoints, then repoint the boxes whose endpoints shifted down
+	const uint32_t minEndpoint = m_boxes[index].minEndpoint;
+	const uint32_t maxEndpoint = m_boxes[index].maxEndpoint;
+	m_endpoints.erase(m_endpoints.begin() + maxEndpoint);
+	m_endpoints.erase(m_endpoints.begin() + minEndpoint);
 
-	/*
-		Check to see if the next start point is greater than or equal to the window start point.
-		It will also check to see if m_startPosition is not equal to m_startPoints.end().
-		If it is it will add the entity to close entities and increment the start position iterator.
-	*/
+	// Move the last box into the hole
+	const uint32_t last = static_cast<uint32_t>(m_boxes.size() - 1);
+	if (index != last)
+	{
+		m_boxes[index] = m_boxes[last];
+		m_boxIndex[m_boxes[index].entity] = index;
+	}
+	m_boxes.pop_back();
 
-	while (m_startPosition != m_startPoints.end() && m_startPosition->first <= windowEnd)
+	for (uint32_t i = 0; i < m_endpoints.size(); i++)
 	{
+		Endpoint& endpoint = m_endpoints[i];
+		if (endpoint.box == last) endpoint.box = index;
+		if (i >= minEndpoint) (endpoint.isMin ? m_boxes[endpoint.box].minEndpoint : m_boxes[endpoint.box].maxEndpoint) = i;
+	}
+	m_pairsDirty = true;
+}
 
-		if (m_startPosition->first >= windowStart)
-		{
+void PlaneSweep::clear()
+{
+	m_endpoints.clear();
+	m_boxes.clear();
+	m_boxIndex.clear();
+	m_pairSet.clear();
+	m_pairs.clear();
+	m_pairsDirty = true;
+	m_maxExtent = 0.f;
+}
 
-			if (std::find(m_closeEntities.begin(), m_closeEntities.end(), m_startPosition->second) == m_closeEntities.end())
-			{
-				m_closeEntities.push_back(m_startPosition->second);
-			}
-		}
-		++m_startPosition;
-	}
-	
-	/*
-		Check to see if the next end point is less than the window start point or greater than the window end point.
-		It will also check to see if m_endPosition is not equal to m_endPoints.end().
-		If it is it will add the entity to close entities and increment the end position iterator.
-	*/
-
-	while (m_endPosition != m_endPoints.end() && (m_endPosition->first < windowStart || m_endPosition->first > windowEnd)) //remove it if it's outside of the window
+const std::vector<EntityPair>& PlaneSweep::getPairs()
+{
+	if (!m_pairsDirty) return m_pairs;
+
+	m_pairs.clear();
+	for (uint64_t key : m_pairSet)
 	{
+		const auto [a, b] = pairFromKey(key);
+		if (overlaps(m_boxes[m_boxIndex[a]].bounds, m_boxes[m_boxIndex[b]].bounds)) m_pairs.emplace_back(a, b);
+	}
+	m_pairsDirty = false;
+	return m_pairs;
+}
 
-		m_closeEntities.erase(std::remove(m_closeEntities.begin(), m_closeEntities.end(), m_endPosition->second),
-			m_closeEntities.end());
-		++m_endPosition;
+void PlaneSweep::swapEndpoints(uint32_t a, uint32_t b)
+{
+	Endpoint& first = m_endpoints[a];
+	Endpoint& second = m_endpoints[b];
 
+	// Only a min passing a max can change whether two boxes overlap
+	if (first.isMin != second.isMin && first.box != second.box)
+	{
+		const Box& boxA = m_boxes[first.box];
+		const Box& boxB = m_boxes[second.box];
+		const bool axisOverlap = m_endpoints[boxA.minEndpoint].value <= m_endpoints[boxB.maxEndpoint].value &&
+			m_endpoints[boxB.minEndpoint].value <= m_endpoints[boxA.maxEndpoint].value;
+		const uint64_t key = pairKey(boxA.entity, boxB.entity);
+		if (axisOverlap) m_pairSet.insert(key);
+		else m_pairSet.erase(key);
 	}
 
-	return m_closeEntities; // Return the value of m_close entities
+	std::swap(first, second);
+	Box& boxFirst = m_boxes[m_endpoints[a].box];
+	Box& boxSecond = m_boxes[m_endpoints[b].box];
+	(m_endpoints[a].isMin ? boxFirst.minEndpoint : boxFirst.maxEndpoint) = a;
+	(m_endpoints[b].isMin ? boxSecond.minEndpoint : boxSecond.maxEndpoint) = b;
+}
+
+void PlaneSweep::sortEndpoint(uint32_t index)
+{
+	// Mins sort before maxes at equal values, matching build
+	auto before = [](const Endpoint& a, const Endpoint& b) {
+		return a.value < b.value || (a.value == b.value && a.isMin && !b.isMin);
+	};
 
+	while (index > 0 && before(m_endpoints[index], m_endpoints[index - 1]))
+	{
+		swapEndpoints(index - 1, index);
+		index--;
+	}
+	while (index + 1 < m_endpoints.size() && before(m_endpoints[index + 1], m_endpoints[index]))
+	{
+		swapEndpoints(index, index + 1);
+		index++;
+	}
 }
+
+void PlaneSweep::query(const AABB& region, std::vector<entt::entity>& result) const
+{
+	// Any box reaching the region starts no more than the longest box before it
+	const float low = region.first[m_axis] - m_maxExtent;
+	const float high = region.second[m_axis];
+	auto it = std::lower_bound(m_endpoints.begin(), m_endpoints.end(), low, [](const Endpoint& endpoint, float value) {
+		return endpoint.value < value;
+	});
+	for (; it != m_endpoints.end() && it->value <= high; ++it)
+	{
+		if (!it->isMin) continue;
+		const Box& box = m_boxes[it->box];
+		if (overlaps(box.bounds, region)) result.push_back(box.entity);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+/** \file proximityCache.cpp */
+#include "core/proximityCache.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <limits>
+
+uint32_t ProximityCache::addSensor(ProximityTarget target, const std::vector<float>& shells)
+{
+	if (shells.empty()) spdlog::error("ProximityCache: a sensor needs at least one shell");
+
+	Sensor sensor;
+	sensor.target = target;
+	sensor.shells = shells;
+	std::sort(sensor.shells.begin(), sensor.shells.end());
+	m_sensors.push_back(std::move(sensor));
+	return static_cast<uint32_t>(m_sensors.size() - 1);
+}
+
+float ProximityCache::getRange(uint32_t sensor) const
+{
+	const auto& shells = m_sensors[sensor].shells;
+	return shells.empty() ? 0.f : shells.back();
+}
+
+void ProximityCache::update(uint32_t sensorIndex, const OrientedBox& shape, const entt::registry& registry, const std::vector<entt::entity>& candidates)
+{
+	ZoneScopedN("ProximityUpdate");
+	Sensor& sensor = m_sensors[sensorIndex];
+	const uint32_t outside = static_cast<uint32_t>(sensor.shells.size());
+
+	// Measure every candidate of the right type in one batch
+	if (sensor.target == ProximityTarget::spheres)
+	{
+		m_spheres.clear();
+		m_spheres.gather(registry, candidates);
+		NarrowPhase::distancesToSpheres(shape, m_spheres, m_distances);
+		m_measured = m_spheres.getEntities();
+	}
+	else
+	{
+		m_boxes.clear();
+		m_measured.clear();
+		for (entt::entity entity : candidates)
+		{
+			auto [obb, world] = registry.try_get<OBBCollider, WorldMatrix>(entity);
+			if (!obb || !world) continue;
+			m_boxes.add(OrientedBox::fromCollider(*obb, *world), entity, shape.centre, 0.f, entt::null);
+			m_measured.push_back(entity);
+		}
+		NarrowPhase::distancesForPairs(m_boxes, m_distances);
+	}
+
+	// Compare each collider's innermost shell with last frame's
+	m_current.clear();
+	for (size_t i = 0; i < m_measured.size(); i++)
+	{
+		const float distance = m_distances[i];
+		const uint32_t current = static_cast<uint32_t>(std::upper_bound(sensor.shells.begin(), sensor.shells.end(), distance) - sensor.shells.begin());
+		auto it = sensor.inside.find(m_measured[i]);
+		uint32_t previous = outside;
+		if (it != sensor.inside.end()) {
+			previous = it->second;
+			sensor.inside.erase(it);
+		}
+		if (current < outside) m_current[m_measured[i]] = current;
+		emit(sensorIndex, m_measured[i], previous, current, distance);
+	}
+
+	// Whatever is left was tracked but is no longer near enough to be a candidate, so has left every shell
+	for (auto& [entity, previous] : sensor.inside) emit(sensorIndex, entity, previous, outside, std::numeric_limits<float>::infinity());
+
+	sensor.inside.swap(m_current);
+}
+
+void ProximityCache::emit(uint32_t sensor, entt::entity entity, uint32_t previous, uint32_t current, float distance)
+{
+	// Shells nest, so being inside shell k means being inside every shell after it
+	const uint32_t first = std::min(previous, current);
+	const uint32_t shellCount = static_cast<uint32_t>(m_sensors[sensor].shells.size());
+	for (uint32_t shell = first; shell < shellCount; shell++)
+	{
+		const bool wasInside = previous <= shell;
+		const bool isInside = current <= shell;
+		const ProximityPhase phase = isInside ? (wasInside ? ProximityPhase::stay : ProximityPhase::enter) : ProximityPhase::exit;
+		m_events.push_back({ sensor, shell, entity, phase, distance });
+	}
+}
+
+void ProximityCache::erase(entt::entity entity)
+{
+	for (auto& sensor : m_sensors) sensor.inside.erase(entity);
+}
+
+void ProximityCache::reset()
+{
+	for (auto& sensor : m_sensors) sensor.inside.clear();
+	m_events.clear();
+}
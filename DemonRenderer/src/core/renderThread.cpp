@@ -0,0 +1,90 @@
+/** \file renderThread.cpp */
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+#include "core/renderThread.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include "tracy/TracyOpenGL.hpp"
+
+void RenderThread::start(GLFWwindow* window, std::function<void(uint64_t)> renderFrame)
+{
+	if (isRunning()) {
+		spdlog::error("RenderThread: already running");
+		return;
+	}
+
+	m_window = window;
+	m_renderFrame = std::move(renderFrame);
+	m_pending = false;
+	m_stopping = false;
+
+	// A context can only be current on one thread at a time
+	glfwMakeContextCurrent(nullptr);
+	m_thread = std::thread(&RenderThread::loop, this);
+	spdlog::info("RenderThread: started");
+}
+
+void RenderThread::stop()
+{
+	if (!isRunning()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_handOver.notify_all();
+	m_thread.join();
+
+	glfwMakeContextCurrent(m_window);
+	spdlog::info("RenderThread: stopped, rendering on the main thread");
+}
+
+void RenderThread::submit(uint64_t frame)
+{
+	ZoneScopedN("RenderThreadSubmit");
+	const Clock::time_point start = Clock::now();
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_handOver.wait(lock, [this]() { return !m_pending; });
+		m_waitMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		m_frame = frame;
+		m_pending = true;
+	}
+	m_handOver.notify_all();
+}
+
+void RenderThread::loop()
+{
+	t_isRenderThread = true;
+	tracy::SetThreadName("Render thread");
+	glfwMakeContextCurrent(m_window);
+	TracyGpuContext; // Tracy's GPU context belongs to the thread the GL context is current on
+
+	while (true)
+	{
+		uint64_t frame = 0;
+		{
+			// A pending frame is drawn before stopping
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_handOver.wait(lock, [this]() { return m_pending || m_stopping; });
+			if (!m_pending) break;
+			frame = m_frame;
+		}
+
+		const Clock::time_point start = Clock::now();
+		{
+			ZoneScopedN("RenderFrame");
+			m_renderFrame(frame);
+		}
+		m_renderMs.store(std::chrono::duration<float, std::milli>(Clock::now() - start).count(), std::memory_order_relaxed);
+		FrameMarkNamed("Render thread");
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pending = false;
+		}
+		m_handOver.notify_all();
+	}
+
+	glfwMakeContextCurrent(nullptr);
+}
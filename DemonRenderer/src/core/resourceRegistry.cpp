@@ -0,0 +1,27 @@
+/** \file resourceRegistry.cpp */
+#include "core/resourceRegistry.hpp"
+#include "assets/shader.hpp"
+#include "assets/texture.hpp"
+#include "rendering/material.hpp"
+#include "buffers/VAO.hpp"
+#include "buffers/FBO.hpp"
+
+void ResourceRegistry::onFrameEnd()
+{
+	s_frame++;
+	// Materials hold shaders and textures so release them first
+	pool<Material>().collect(s_frame, releaseLatency);
+	pool<VAO>().collect(s_frame, releaseLatency);
+	pool<FBO>().collect(s_frame, releaseLatency);
+	pool<Texture>().collect(s_frame, releaseLatency);
+	pool<Shader>().collect(s_frame, releaseLatency);
+}
+
+void ResourceRegistry::clear()
+{
+	pool<Material>().clear();
+	pool<VAO>().clear();
+	pool<FBO>().clear();
+	pool<Texture>().clear();
+	pool<Shader>().clear();
+}
@@ -0,0 +1,26 @@
+/** \file scriptSystem.cpp */
+#include "core/scriptSystem.hpp"
+#include "core/memoryTracker.hpp"
+#include "tracy/Tracy.hpp"
+
+void ScriptSystem::onUpdate(entt::registry& registry, float timestep)
+{
+	ZoneScopedN("ScriptSystem");
+	MemoryTracker::Scope memoryScope(MemoryTag::ecs);
+	for (auto& type : s_types) type.update(registry, timestep);
+}
+
+void ScriptSystem::onImGuiRender(entt::registry& registry)
+{
+	for (auto& type : s_types) type.imGuiRender(registry);
+}
+
+void ScriptSystem::onKeyPress(entt::registry& registry, KeyPressedEvent& e)
+{
+	for (auto& type : s_types) type.keyPress(registry, e);
+}
+
+void ScriptSystem::onKeyRelease(entt::registry& registry, KeyReleasedEvent& e)
+{
+	for (auto& type : s_types) type.keyRelease(registry, e);
+}
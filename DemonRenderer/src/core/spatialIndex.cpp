@@ -0,0 +1,181 @@
+/** \file spatialIndex.cpp */
+#include "core/spatialIndex.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <array>
+
+void SpatialIndex::clear()
+{
+	m_points.clear();
+	m_maxRadius = 0.f;
+	m_built = false;
+}
+
+void SpatialIndex::reserve(size_t count)
+{
+	m_points.reserve(count);
+}
+
+void SpatialIndex::add(entt::entity entity, const glm::vec3& centre, float radius)
+{
+	m_points.push_back({ centre, radius, entity, 0 });
+	m_maxRadius = std::max(m_maxRadius, radius);
+	m_built = false;
+}
+
+void SpatialIndex::build()
+{
+	ZoneScopedN("SpatialIndexBuild");
+	buildRange(0, static_cast<uint32_t>(m_points.size()));
+	m_built = true;
+}
+
+void SpatialIndex::buildRange(uint32_t begin, uint32_t end)
+{
+	if (end - begin <= leafSize) return;
+
+	// Split along the longest axis of the centres in the range
+	glm::vec3 low(std::numeric_limits<float>::max());
+	glm::vec3 high(std::numeric_limits<float>::lowest());
+	for (uint32_t i = begin; i < end; i++)
+	{
+		low = glm::min(low, m_points[i].centre);
+		high = glm::max(high, m_points[i].centre);
+	}
+	const glm::vec3 extent = high - low;
+	const uint32_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+	const uint32_t mid = begin + (end - begin) / 2;
+	std::nth_element(m_points.begin() + begin, m_points.begin() + mid, m_points.begin() + end, [axis](const Point& a, const Point& b) {
+		return a.centre[axis] < b.centre[axis];
+	});
+	m_points[mid].axis = axis;
+
+	buildRange(begin, mid);
+	buildRange(mid + 1, end);
+}
+
+uint32_t SpatialIndex::withinRadius(const glm::vec3& centre, float radius, std::span<SpatialHit> out) const
+{
+	if (!m_built) {
+		spdlog::error("SpatialIndex: queried before build");
+		return 0;
+	}
+
+	// Any point in a subtree beyond the split plane by more than this cannot reach the query
+	const float reach = radius + m_maxRadius;
+	uint32_t found = 0;
+	auto test = [&](const Point& point) {
+		const float distance = distanceTo(point, centre);
+		if (distance > radius) return;
+		if (found < out.size()) out[found] = { point.entity, distance };
+		found++;
+	};
+
+	std::array<Range, maxDepth> stack;
+	size_t top = 0;
+	if (!m_points.empty()) stack[top++] = { 0, static_cast<uint32_t>(m_points.size()), 0.f };
+	while (top > 0)
+	{
+		const Range range = stack[--top];
+		if (range.end - range.begin <= leafSize) {
+			for (uint32_t i = range.begin; i < range.end; i++) test(m_points[i]);
+			continue;
+		}
+
+		const uint32_t mid = range.begin + (range.end - range.begin) / 2;
+		const Point& split = m_points[mid];
+		test(split);
+		const float offset = centre[split.axis] - split.centre[split.axis];
+		if (offset <= reach) stack[top++] = { range.begin, mid, 0.f };
+		if (offset >= -reach) stack[top++] = { mid + 1, range.end, 0.f };
+	}
+	return found;
+}
+
+uint32_t SpatialIndex::nearest(const glm::vec3& centre, std::span<SpatialHit> out, float maxDistance) const
+{
+	if (!m_built) {
+		spdlog::error("SpatialIndex: queried before build");
+		return 0;
+	}
+	if (out.empty()) return 0;
+
+	// out holds a max heap of the best so far, so the worst of them is always at the front
+	const size_t k = out.size();
+	size_t count = 0;
+	auto further = [](const SpatialHit& a, const SpatialHit& b) { return a.distance < b.distance; };
+	auto worst = [&]() { return count < k ? maxDistance : out[0].distance; };
+	auto test = [&](const Point& point) {
+		const float distance = distanceTo(point, centre);
+		if (distance > worst()) return;
+		if (count < k) {
+			out[count++] = { point.entity, distance };
+			std::push_heap(out.begin(), out.begin() + count, further);
+		}
+		else {
+			std::pop_heap(out.begin(), out.begin() + count, further);
+			out[count - 1] = { point.entity, distance };
+			std::push_heap(out.begin(), out.begin() + count, further);
+		}
+	};
+
+	// Nearer side first, the far side carries the smallest distance it could possibly hold
+	std::array<Range, maxDepth> stack;
+	size_t top = 0;
+	if (!m_points.empty()) stack[top++] = { 0, static_cast<uint32_t>(m_points.size()), -m_maxRadius };
+	while (top > 0)
+	{
+		const Range range = stack[--top];
+		if (range.bound > worst()) continue;
+		if (range.end - range.begin <= leafSize) {
+			for (uint32_t i = range.begin; i < range.end; i++) test(m_points[i]);
+			continue;
+		}
+
+		const uint32_t mid = range.begin + (range.end - range.begin) / 2;
+		const Point& split = m_points[mid];
+		test(split);
+		const float offset = centre[split.axis] - split.centre[split.axis];
+		const Range left{ range.begin, mid, offset > 0.f ? std::max(range.bound, offset - m_maxRadius) : range.bound };
+		const Range right{ mid + 1, range.end, offset < 0.f ? std::max(range.bound, -offset - m_maxRadius) : range.bound };
+		if (offset > 0.f) {
+			stack[top++] = left;
+			stack[top++] = right;
+		}
+		else {
+			stack[top++] = right;
+			stack[top++] = left;
+		}
+	}
+
+	std::sort_heap(out.begin(), out.begin() + count, further);
+	return static_cast<uint32_t>(count);
+}
+
+void SpatialIndex::withinRadius(std::span<const RadiusQuery> queries, std::span<SpatialHit> out, std::span<QueryRange> ranges) const
+{
+	ZoneScopedN("SpatialIndexRadiusBatch");
+	uint32_t offset = 0;
+	for (size_t i = 0; i < queries.size() && i < ranges.size(); i++)
+	{
+		const uint32_t found = withinRadius(queries[i].centre, queries[i].radius, out.subspan(offset));
+		const uint32_t written = std::min(found, static_cast<uint32_t>(out.size() - offset));
+		ranges[i] = { offset, written, written < found };
+		offset += written;
+	}
+}
+
+void SpatialIndex::nearest(std::span<const NearestQuery> queries, std::span<SpatialHit> out, std::span<QueryRange> ranges) const
+{
+	ZoneScopedN("SpatialIndexNearestBatch");
+	uint32_t offset = 0;
+	for (size_t i = 0; i < queries.size() && i < ranges.size(); i++)
+	{
+		const uint32_t space = std::min(queries[i].k, static_cast<uint32_t>(out.size() - offset));
+		const uint32_t written = nearest(queries[i].centre, out.subspan(offset, space), queries[i].maxDistance);
+		ranges[i] = { offset, written, space < queries[i].k };
+		offset += written;
+	}
+}
@@ -0,0 +1,163 @@
+/** \file spatialSort.cpp */
+#include "core/spatialSort.hpp"
+#include "core/physics.hpp"
+#include "core/memoryTracker.hpp"
+#include "components/render.hpp"
+#include "components/transform.hpp"
+#include "components/lodassign.hpp"
+#include "components/colliders.hpp"
+#include "tracy/Tracy.hpp"
+#include <chrono>
+#include <array>
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+	// Pools sorted to follow the WorldMatrix pool, one per step
+	using FollowerSort = void (*)(entt::registry&);
+	const std::array<FollowerSort, 6> followers = {
+		[](entt::registry& registry) { registry.sort<LocalTRS, WorldMatrix>(); },
+		[](entt::registry& registry) { registry.sort<Render, WorldMatrix>(); },
+		[](entt::registry& registry) { registry.sort<LODAssign, WorldMatrix>(); },
+		[](entt::registry& registry) { registry.sort<AABB, WorldMatrix>(); },
+		[](entt::registry& registry) { registry.sort<SphereCollider, WorldMatrix>(); },
+		[](entt::registry& registry) { registry.sort<OBBCollider, WorldMatrix>(); }
+	};
+
+	// Spread the low 10 bits of v so there are two zero bits between each
+	uint32_t expandBits(uint32_t v) noexcept
+	{
+		v = (v | (v << 16)) & 0x030000FFu;
+		v = (v | (v << 8)) & 0x0300F00Fu;
+		v = (v | (v << 4)) & 0x030C30C3u;
+		v = (v | (v << 2)) & 0x09249249u;
+		return v;
+	}
+}
+
+uint32_t SpatialSort::morton3D(const glm::vec3& unit) noexcept
+{
+	const glm::uvec3 cell = glm::uvec3(glm::clamp(unit * 1024.f, glm::vec3(0.f), glm::vec3(1023.f)));
+	return (expandBits(cell.x) << 2) | (expandBits(cell.y) << 1) | expandBits(cell.z);
+}
+
+uint32_t SpatialSort::codeOf(entt::entity entity) const noexcept
+{
+	const size_t index = static_cast<size_t>(entt::to_entity(entity));
+	return index < m_codes.size() ? m_codes[index] : UINT32_MAX;
+}
+
+bool SpatialSort::onUpdate(Scene& scene, float timestep)
+{
+	ZoneScopedN("SpatialSort");
+	MemoryTracker::Scope memoryScope(MemoryTag::ecs);
+	m_sinceLastPass += timestep;
+	if (m_phase == Phase::idle)
+	{
+		if (m_sinceLastPass < m_interval) return false;
+		m_sinceLastPass = 0.f;
+		m_phase = Phase::bounds;
+		m_cursor = 0;
+		m_min = glm::vec3(FLT_MAX);
+		m_max = glm::vec3(-FLT_MAX);
+	}
+
+	using clock = std::chrono::high_resolution_clock;
+	const auto start = clock::now();
+	bool reordered = false;
+	// Steps are not split, so a step only starts while there is budget left
+	while (m_phase != Phase::idle && std::chrono::duration<float, std::milli>(clock::now() - start).count() < m_budgetMs)
+	{
+		reordered |= step(scene);
+	}
+
+	if (reordered) {
+		scene.m_renderProxies.invalidate();
+		for (auto& invalidate : m_invalidations) invalidate();
+	}
+	return reordered;
+}
+
+bool SpatialSort::step(Scene& scene)
+{
+	auto& registry = scene.m_entities;
+	auto& pool = registry.storage<WorldMatrix>();
+	const entt::entity* packed = pool.data();
+	const size_t count = pool.size();
+
+	switch (m_phase)
+	{
+	case Phase::bounds:
+	{
+		const size_t end = std::min(count, m_cursor + chunkSize);
+		for (size_t i = m_cursor; i < end; i++)
+		{
+			const glm::vec3 position = pool.get(packed[i]).getTranslation();
+			m_min = glm::min(m_min, position);
+			m_max = glm::max(m_max, position);
+		}
+		m_cursor = end;
+		if (m_cursor >= count)
+		{
+			m_phase = Phase::codes;
+			m_cursor = 0;
+			m_outOfOrder = 0;
+			m_previousCode = 0;
+			size_t highest = 0;
+			for (size_t i = 0; i < count; i++) highest = std::max(highest, static_cast<size_t>(entt::to_entity(packed[i])));
+			m_codes.assign(count > 0 ? highest + 1 : 0, UINT32_MAX);
+		}
+		return false;
+	}
+	case Phase::codes:
+	{
+		const glm::vec3 extent = glm::max(m_max - m_min, glm::vec3(1e-6f));
+		const size_t end = std::min(count, m_cursor + chunkSize);
+		for (size_t i = m_cursor; i < end; i++)
+		{
+			const entt::entity entity = packed[i];
+			const size_t index = static_cast<size_t>(entt::to_entity(entity));
+			if (index >= m_codes.size()) continue; // Created during the pass
+			const uint32_t code = morton3D((pool.get(entity).getTranslation() - m_min) / extent);
+			m_codes[index] = code;
+			if (i > 0 && code < m_previousCode) m_outOfOrder++;
+			m_previousCode = code;
+		}
+		m_cursor = end;
+		if (m_cursor >= count)
+		{
+			m_lastOutOfOrder = count > 1 ? static_cast<float>(m_outOfOrder) / static_cast<float>(count - 1) : 0.f;
+			if (m_lastOutOfOrder < sortThreshold)
+			{
+				m_phase = Phase::idle;
+				m_passCount++;
+			}
+			else m_phase = Phase::sortPrimary;
+		}
+		return false;
+	}
+	case Phase::sortPrimary:
+	{
+		// Entities created since their codes were computed have no code and sort to the end
+		registry.sort<WorldMatrix>([this](const entt::entity lhs, const entt::entity rhs) { return codeOf(lhs) < codeOf(rhs); });
+		m_phase = Phase::sortFollowers;
+		m_cursor = 0;
+		return true;
+	}
+	case Phase::sortFollowers:
+	{
+		followers[m_cursor](registry);
+		m_cursor++;
+		if (m_cursor >= followers.size())
+		{
+			m_phase = Phase::idle;
+			m_passCount++;
+			m_sortCount++;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
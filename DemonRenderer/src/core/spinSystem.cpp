@@ -0,0 +1,168 @@
+/** \file spinSystem.cpp */
+#include "core/spinSystem.hpp"
+#include "core/transformSystem.hpp"
+#include "core/jobSystem.hpp"
+#include "core/log.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPIN_SIMD 1
+#else
+#define SPIN_SIMD 0
+#endif
+
+SpinSystem::SpinSystem(entt::registry& registry, float fixedTimestep) :
+	m_registry(registry),
+	m_fixedTimestep(fixedTimestep),
+	m_threadCount(std::max(1u, std::thread::hardware_concurrency()))
+{
+	m_registry.on_construct<AngularVelocity>().connect<&SpinSystem::onStructureChanged>(this);
+	m_registry.on_destroy<AngularVelocity>().connect<&SpinSystem::onStructureChanged>(this);
+	m_registry.on_construct<LocalTRS>().connect<&SpinSystem::onStructureChanged>(this);
+	m_registry.on_destroy<LocalTRS>().connect<&SpinSystem::onStructureChanged>(this);
+	m_registry.on_construct<WorldMatrix>().connect<&SpinSystem::onStructureChanged>(this);
+	m_registry.on_destroy<WorldMatrix>().connect<&SpinSystem::onStructureChanged>(this);
+}
+
+SpinSystem::~SpinSystem()
+{
+	m_registry.on_construct<AngularVelocity>().disconnect(this);
+	m_registry.on_destroy<AngularVelocity>().disconnect(this);
+	m_registry.on_construct<LocalTRS>().disconnect(this);
+	m_registry.on_destroy<LocalTRS>().disconnect(this);
+	m_registry.on_construct<WorldMatrix>().disconnect(this);
+	m_registry.on_destroy<WorldMatrix>().disconnect(this);
+}
+
+void SpinSystem::onUpdate(float timestep)
+{
+	if (m_paused) return;
+
+	m_accumulator += timestep;
+	uint32_t steps = 0;
+	while (m_accumulator >= m_fixedTimestep && steps < maxSubsteps)
+	{
+		step();
+		m_accumulator -= m_fixedTimestep;
+		steps++;
+	}
+	// Spinning is cosmetic, drop time rather than spiral when falling behind
+	if (steps == maxSubsteps) m_accumulator = 0.f;
+}
+
+void SpinSystem::step()
+{
+	ZoneScopedN("SpinSystem");
+	if (m_dirty) rebuild();
+
+	const size_t count = m_entities.size();
+	if (count == 0) return;
+
+	// Split over groups of 4 so no two workers share a SIMD lane group
+	const size_t groups = (count + 3) / 4;
+	JobSystem::parallelFor(0, groups, [this, count](size_t begin, size_t end) {
+		process(begin * 4, std::min(end * 4, count));
+	}, minEntitiesPerThread / 4, m_threadCount);
+}
+
+void SpinSystem::setFixedTimestep(float timestep)
+{
+	if (timestep <= 0.f)
+	{
+		spdlog::error("SpinSystem: fixed timestep must be positive, got {}", timestep);
+		return;
+	}
+	m_fixedTimestep = timestep;
+	m_dirty = true;
+}
+
+void SpinSystem::rebuild()
+{
+	ZoneScopedN("SpinSystemRebuild");
+	auto view = m_registry.view<const AngularVelocity, LocalTRS, WorldMatrix>();
+
+	m_entities.clear();
+	m_locals.clear();
+	m_worlds.clear();
+	for (auto* stream : { &m_qx, &m_qy, &m_qz, &m_qw, &m_dx, &m_dy, &m_dz, &m_dw }) stream->clear();
+
+	for (auto [entity, velocity, local, world] : view.each())
+	{
+		m_entities.push_back(entity);
+		m_locals.push_back(&local);
+		m_worlds.push_back(&world);
+
+		m_qx.push_back(local.rotation.x);
+		m_qy.push_back(local.rotation.y);
+		m_qz.push_back(local.rotation.z);
+		m_qw.push_back(local.rotation.w);
+
+		// The only trigonometry, done once per entity rather than once per entity per frame
+		glm::quat delta(velocity.radiansPerSecond * m_fixedTimestep);
+		m_dx.push_back(delta.x);
+		m_dy.push_back(delta.y);
+		m_dz.push_back(delta.z);
+		m_dw.push_back(delta.w);
+	}
+
+	// Pad with identity rotations so the SIMD loop needs no remainder handling
+	const size_t padded = (m_entities.size() + 3) & ~static_cast<size_t>(3);
+	for (auto* stream : { &m_qx, &m_qy, &m_qz, &m_dx, &m_dy, &m_dz }) stream->resize(padded, 0.f);
+	m_qw.resize(padded, 1.f);
+	m_dw.resize(padded, 1.f);
+
+	m_dirty = false;
+}
+
+void SpinSystem::process(size_t begin, size_t end)
+{
+	ZoneScopedN("SpinSystemRange");
+	integrate(begin, (end + 3) & ~static_cast<size_t>(3));
+
+	// Bulk write back, a linear walk composing straight from the quaternion
+	for (size_t i = begin; i < end; i++)
+	{
+		LocalTRS& local = *m_locals[i];
+		local.rotation = glm::quat(m_qw[i], m_qx[i], m_qy[i], m_qz[i]);
+		TransformSystem::compose(local, *m_worlds[i]);
+	}
+}
+
+void SpinSystem::integrate(size_t begin, size_t end)
+{
+	float* qx = m_qx.data(); float* qy = m_qy.data(); float* qz = m_qz.data(); float* qw = m_qw.data();
+	const float* dx = m_dx.data(); const float* dy = m_dy.data(); const float* dz = m_dz.data(); const float* dw = m_dw.data();
+
+#if SPIN_SIMD
+	const __m128 one = _mm_set1_ps(1.f);
+	for (size_t i = begin; i < end; i += 4)
+	{
+		const __m128 ax = _mm_loadu_ps(qx + i), ay = _mm_loadu_ps(qy + i), az = _mm_loadu_ps(qz + i), aw = _mm_loadu_ps(qw + i);
+		const __m128 bx = _mm_loadu_ps(dx + i), by = _mm_loadu_ps(dy + i), bz = _mm_loadu_ps(dz + i), bw = _mm_loadu_ps(dw + i);
+
+		// q = q * delta, matching glm's operator*
+		__m128 w = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_add_ps(_mm_mul_ps(ay, by), _mm_mul_ps(az, bz)));
+		__m128 x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+		__m128 y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+		__m128 z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+
+		// Renormalise to stop drift accumulating over many steps
+		const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+		const __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+
+		_mm_storeu_ps(qx + i, _mm_mul_ps(x, invLength));
+		_mm_storeu_ps(qy + i, _mm_mul_ps(y, invLength));
+		_mm_storeu_ps(qz + i, _mm_mul_ps(z, invLength));
+		_mm_storeu_ps(qw + i, _mm_mul_ps(w, invLength));
+	}
+#else
+	for (size_t i = begin; i < end; i++)
+	{
+		glm::quat q = glm::normalize(glm::quat(qw[i], qx[i], qy[i], qz[i]) * glm::quat(dw[i], dx[i], dy[i], dz[i]));
+		qx[i] = q.x; qy[i] = q.y; qz[i] = q.z; qw[i] = q.w;
+	}
+#endif
+}
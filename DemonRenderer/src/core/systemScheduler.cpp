@@ -0,0 +1,181 @@
+/** \file systemScheduler.cpp */
+#include "core/systemScheduler.hpp"
+#include "core/allocationAudit.hpp"
+#include "core/log.hpp"
+#include "core/memoryResources.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <fstream>
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+	if (m_exclusive || other.m_exclusive) return true;
+
+	auto overlaps = [](const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b) {
+		return std::any_of(a.begin(), a.end(), [&b](entt::id_type id) { return std::find(b.begin(), b.end(), id) != b.end(); });
+	};
+	return overlaps(m_writes, other.m_writes) || overlaps(m_writes, other.m_reads) || overlaps(m_reads, other.m_writes);
+}
+
+uint32_t SystemScheduler::add(const std::string& name, const SystemAccess& access, std::function<void()> func, bool mainThread)
+{
+	if (m_counter) {
+		spdlog::error("SystemScheduler: {} added while running", name);
+		return static_cast<uint32_t>(m_systems.size());
+	}
+
+	m_systems.push_back({ name, access, std::move(func), mainThread, {}, {}, {} });
+	m_dirty = true;
+	return static_cast<uint32_t>(m_systems.size() - 1);
+}
+
+void SystemScheduler::build()
+{
+	const size_t count = m_systems.size();
+
+	// Systems only depend on earlier ones, so index order is already a topological order
+	std::vector<std::vector<bool>> reaches(count, std::vector<bool>(count, false));
+	for (size_t i = 0; i < count; i++)
+	{
+		auto& system = m_systems[i];
+		system.dependencies.clear();
+		system.dependents.clear();
+
+		// Latest conflicts first, an earlier conflict already reached through a later one is redundant
+		for (size_t j = i; j-- > 0;)
+		{
+			if (reaches[j][i] || !system.access.conflictsWith(m_systems[j].access)) continue;
+			system.dependencies.push_back(static_cast<uint32_t>(j));
+			reaches[j][i] = true;
+			for (size_t k = 0; k < j; k++)
+			{
+				if (reaches[k][j]) reaches[k][i] = true;
+			}
+		}
+		std::reverse(system.dependencies.begin(), system.dependencies.end());
+		for (uint32_t dependency : system.dependencies) m_systems[dependency].dependents.push_back(static_cast<uint32_t>(i));
+	}
+
+	m_remaining = std::vector<std::atomic<uint32_t>>(count);
+	m_dirty = false;
+}
+
+void SystemScheduler::run()
+{
+	ZoneScopedN("SystemScheduler");
+	if (m_systems.empty()) return;
+	if (m_dirty) build();
+
+	for (size_t i = 0; i < m_systems.size(); i++) m_remaining[i].store(static_cast<uint32_t>(m_systems[i].dependencies.size()), std::memory_order_relaxed);
+
+	JobCounter counter;
+	m_counter = &counter;
+	m_frameStart = Clock::now();
+	// Main thread roots run inline as soon as they are launched, so hand out the others first
+	for (bool mainThread : { false, true })
+	{
+		for (uint32_t i = 0; i < m_systems.size(); i++)
+		{
+			if (m_systems[i].dependencies.empty() && m_systems[i].mainThread == mainThread) launch(i);
+		}
+	}
+	JobSystem::wait(counter);
+	m_counter = nullptr;
+
+	m_frameMs = std::chrono::duration<float, std::milli>(Clock::now() - m_frameStart).count();
+	m_serialMs = 0.f;
+	for (auto& system : m_systems) m_serialMs += system.timing.durationMs;
+	findCriticalPath();
+}
+
+void SystemScheduler::launch(uint32_t system)
+{
+	if (m_systems[system].mainThread) JobSystem::runOnMainThread(*m_counter, [this, system]() { execute(system); });
+	else JobSystem::run(*m_counter, [this, system]() { execute(system); });
+}
+
+void SystemScheduler::execute(uint32_t index)
+{
+	auto& system = m_systems[index];
+	const Clock::time_point start = Clock::now();
+	{
+		ZoneTransientN(zone, system.name.c_str(), true);
+		AllocationAudit::Zone auditZone(system.name.c_str());
+		system.func();
+	}
+	const Clock::time_point end = Clock::now();
+
+	auto& timing = system.timing;
+	timing.startMs = std::chrono::duration<float, std::milli>(start - m_frameStart).count();
+	timing.durationMs = std::chrono::duration<float, std::milli>(end - start).count();
+	timing.averageMs = timing.averageMs == 0.f ? timing.durationMs : timing.averageMs + (timing.durationMs - timing.averageMs) * smoothing;
+	timing.thread = std::min(JobSystem::getThreadIndex(), JobSystem::getThreadCount());
+
+	for (uint32_t dependent : system.dependents)
+	{
+		if (m_remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) launch(dependent);
+	}
+}
+
+void SystemScheduler::findCriticalPath()
+{
+	// Longest chain by average duration, walked in index order as every dependency comes earlier
+	const size_t count = m_systems.size();
+	std::pmr::vector<float> finish(count, 0.f, &Memory::frame());
+	std::pmr::vector<uint32_t> previous(count, static_cast<uint32_t>(count), &Memory::frame());
+	uint32_t last = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		auto& system = m_systems[i];
+		system.timing.critical = false;
+		for (uint32_t dependency : system.dependencies)
+		{
+			if (finish[dependency] > finish[i]) {
+				finish[i] = finish[dependency];
+				previous[i] = dependency;
+			}
+		}
+		finish[i] += system.timing.averageMs;
+		if (finish[i] > finish[last]) last = i;
+	}
+
+	m_criticalPathMs = finish[last];
+	for (uint32_t i = last; i < count; i = previous[i]) m_systems[i].timing.critical = true;
+}
+
+bool SystemScheduler::exportGraph(const std::filesystem::path& path) const
+{
+	std::error_code error;
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		spdlog::error("SystemScheduler: could not open {} for writing", path.string());
+		return false;
+	}
+
+	file << "digraph Frame {\n";
+	file << "\trankdir=LR;\n";
+	file << "\tlabel=\"frame " << m_frameMs << "ms, serial " << m_serialMs << "ms, critical path " << m_criticalPathMs << "ms\";\n";
+	file << "\tnode [shape=box, fontname=\"Consolas\"];\n";
+	for (size_t i = 0; i < m_systems.size(); i++)
+	{
+		const auto& system = m_systems[i];
+		file << "\ts" << i << " [label=\"" << system.name << "\\n" << system.timing.averageMs << "ms" << (system.mainThread ? "\\nmain thread" : "") << "\"";
+		if (system.timing.critical) file << ", color=red, penwidth=2";
+		file << "];\n";
+	}
+	for (size_t i = 0; i < m_systems.size(); i++)
+	{
+		for (uint32_t dependency : m_systems[i].dependencies)
+		{
+			file << "\ts" << dependency << " -> s" << i;
+			if (m_systems[i].timing.critical && m_systems[dependency].timing.critical) file << " [color=red, penwidth=2]";
+			file << ";\n";
+		}
+	}
+	file << "}\n";
+
+	spdlog::info("SystemScheduler: graph written to {}", path.string());
+	return true;
+}
@@ -0,0 +1,43 @@
+/** \file transformSystem.cpp */
+#include "core/transformSystem.hpp"
+#include "tracy/Tracy.hpp"
+
+void TransformSystem::update(entt::registry& registry)
+{
+	ZoneScopedN("TransformSystem");
+	auto view = registry.view<const LocalTRS, WorldMatrix, TransformDirty>();
+	view.each([](const LocalTRS& local, WorldMatrix& world) { compose(local, world); });
+	registry.clear<TransformDirty>();
+}
+
+void TransformSystem::updateAll(entt::registry& registry)
+{
+	ZoneScopedN("TransformSystemAll");
+	auto view = registry.view<const LocalTRS, WorldMatrix>();
+	view.each([](const LocalTRS& local, WorldMatrix& world) { compose(local, world); });
+	registry.clear<TransformDirty>();
+}
+
+void TransformSystem::markDirty(entt::registry& registry, entt::entity entity)
+{
+	if (!registry.all_of<TransformDirty>(entity)) registry.emplace<TransformDirty>(entity);
+}
+
+LocalTRS& TransformSystem::emplace(entt::registry& registry, entt::entity entity, const LocalTRS& local)
+{
+	auto& localComp = registry.emplace<LocalTRS>(entity, local);
+	compose(localComp, registry.emplace<WorldMatrix>(entity));
+	return localComp;
+}
+
+void TransformSystem::storePrevious(entt::registry& registry)
+{
+	ZoneScopedN("TransformStorePrevious");
+	auto view = registry.view<const LocalTRS, PreviousTRS>();
+	view.each([](const LocalTRS& local, PreviousTRS& previous) { previous.local = local; });
+}
+
+void TransformSystem::emplacePrevious(entt::registry& registry, entt::entity entity)
+{
+	registry.emplace_or_replace<PreviousTRS>(entity, registry.get<LocalTRS>(entity));
+}
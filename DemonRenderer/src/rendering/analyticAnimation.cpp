@@ -0,0 +1,111 @@
+/** \file analyticAnimation.cpp */
+#include "rendering/analyticAnimation.hpp"
+#include "core/transformSystem.hpp"
+#include "core/log.hpp"
+#include "core/gpuMemory.hpp"
+#include "tracy/Tracy.hpp"
+#include <cmath>
+
+uint32_t AnalyticAnimation::add(entt::registry& registry, entt::entity entity, const glm::vec3& eulerRates)
+{
+	const LocalTRS* local = registry.try_get<LocalTRS>(entity);
+	if (!local) {
+		spdlog::error("AnalyticAnimation: entity {} has no LocalTRS", entt::to_integral(entity));
+		return 0;
+	}
+
+	const AnalyticSpin spin = add(*local, eulerRates);
+	registry.emplace_or_replace<AnalyticSpin>(entity, spin);
+	return spin.instance;
+}
+
+AnalyticSpin AnalyticAnimation::add(const LocalTRS& local, const glm::vec3& eulerRates)
+{
+	// Applying quat(rates * dt) every step tends, as the step shrinks, to a spin about the rates' direction at their
+	// length in radians per second. One Euler rotation by the whole second's angles is not the same rotation.
+	const float rate = glm::length(eulerRates);
+
+	AnalyticSpin spin;
+	spin.initialRotation = local.rotation;
+	spin.axis = rate > 0.f ? eulerRates / rate : glm::vec3(0.f, 0.f, 1.f);
+	spin.radiansPerSecond = rate;
+	spin.instance = static_cast<uint32_t>(m_instances.size());
+
+	GPUAnalyticInstance instance;
+	instance.initialRotation = glm::vec4(spin.initialRotation.x, spin.initialRotation.y, spin.initialRotation.z, spin.initialRotation.w);
+	instance.axisRate = glm::vec4(spin.axis, spin.radiansPerSecond);
+	instance.translation = glm::vec4(local.translation, 1.f);
+	instance.scale = glm::vec4(local.scale, 0.f);
+	m_instances.push_back(instance);
+
+	if (m_instanceBuffer) spdlog::warn("AnalyticAnimation: instance added after upload, call upload again");
+
+	return spin;
+}
+
+void AnalyticAnimation::addMaterial(const std::shared_ptr<Material>& material)
+{
+	m_materials.push_back(material);
+	material->setInstanceUniformName(AnalyticConsts::instanceUniformName);
+	material->setValue(AnalyticConsts::timeUniformName, getTime());
+}
+
+void AnalyticAnimation::upload()
+{
+	if (m_instances.empty()) return;
+
+	const uint32_t count = static_cast<uint32_t>(m_instances.size());
+	GPUMemory::Owner gpuOwner("Analytic animation");
+	m_instanceBuffer = std::make_shared<SSBO>(sizeof(GPUAnalyticInstance) * count, count, m_instances.data());
+	m_instanceBuffer->bind(AnalyticConsts::instanceBinding);
+}
+
+void AnalyticAnimation::onUpdate(float timestep)
+{
+	m_time += timestep;
+}
+
+void AnalyticAnimation::bind(float time) const
+{
+	ZoneScopedN("AnalyticAnimation");
+	for (auto& material : m_materials) material->setValue(AnalyticConsts::timeUniformName, time);
+
+	if (m_instanceBuffer) m_instanceBuffer->bind(AnalyticConsts::instanceBinding);
+}
+
+void AnalyticAnimation::clear()
+{
+	m_instances.clear();
+	m_instanceBuffer.reset();
+	m_time = 0.0;
+}
+
+WorldMatrix AnalyticAnimation::evaluate(const entt::registry& registry, entt::entity entity) const
+{
+	const auto& spin = registry.get<AnalyticSpin>(entity);
+	const auto& instance = m_instances[spin.instance];
+
+	LocalTRS initial;
+	initial.rotation = spin.initialRotation;
+	initial.translation = glm::vec3(instance.translation);
+	initial.scale = glm::vec3(instance.scale);
+	return evaluate(spin, initial, getTime());
+}
+
+glm::quat AnalyticAnimation::evaluateRotation(const AnalyticSpin& spin, float time) noexcept
+{
+	// Same operations in the same order as pbrVertexAnalytic.glsl
+	const float halfAngle = 0.5f * spin.radiansPerSecond * time;
+	const glm::quat delta(std::cos(halfAngle), spin.axis * std::sin(halfAngle));
+	return spin.initialRotation * delta;
+}
+
+WorldMatrix AnalyticAnimation::evaluate(const AnalyticSpin& spin, const LocalTRS& initial, float time) noexcept
+{
+	LocalTRS current = initial;
+	current.rotation = evaluateRotation(spin, time);
+
+	WorldMatrix world;
+	TransformSystem::compose(current, world);
+	return world;
+}
@@ -38,7 +38,7 @@ CameraFrustrum::CameraFrustrum(const Camera& cam)
 
 }
 
-bool CameraFrustrum::intersects(const AABB& aabb)
+bool CameraFrustrum::intersects(const AABB& aabb) const
 {
 
 	/*
@@ -0,0 +1,155 @@
+#include "rendering/clusteredLighting.hpp"
+#include "core/gpuMemory.hpp"
+#include "tracy/TracyOpenGL.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void ClusteredLighting::init(const Camera& camera, const glm::ivec2& screenSize, float zNear, float zFar)
+{
+	using namespace ClusterConsts;
+	GPUMemory::Owner gpuOwner("Clustered lighting");
+
+	m_pointLightSSBO = std::make_shared<SSBO>(sizeof(GPUPointLight) * maxPointLights, maxPointLights);
+	m_spotLightSSBO = std::make_shared<SSBO>(sizeof(GPUSpotLight) * maxSpotLights, maxSpotLights);
+	m_clusterAABBSSBO = std::make_shared<SSBO>(sizeof(glm::vec4) * 2 * clusterCount, clusterCount);
+	m_lightGridSSBO = std::make_shared<SSBO>(sizeof(glm::uvec4) * clusterCount, clusterCount);
+	m_lightIndexSSBO = std::make_shared<SSBO>(sizeof(uint32_t) * clusterCount * averageLightsPerCluster, clusterCount * averageLightsPerCluster);
+	m_indexCounterSSBO = std::make_shared<SSBO>(sizeof(uint32_t), 1);
+
+	ShaderDescription buildDesc;
+	buildDesc.type = ShaderType::compute;
+	buildDesc.computeSrcPath = "./assets/shaders/Lighting/ClusterBuild.glsl";
+	m_buildMaterial = std::make_shared<Material>(std::make_shared<Shader>(buildDesc), "");
+
+	ShaderDescription cullDesc;
+	cullDesc.type = ShaderType::compute;
+	cullDesc.computeSrcPath = "./assets/shaders/Lighting/ClusterCull.glsl";
+	m_cullMaterial = std::make_shared<Material>(std::make_shared<Shader>(cullDesc), "");
+
+	// Exponential depth slicing: slice = log(z) * scale - bias
+	float logRatio = std::log(zFar / zNear);
+	float sliceScale = static_cast<float>(gridZ) / logRatio;
+	float sliceBias = static_cast<float>(gridZ) * std::log(zNear) / logRatio;
+
+	glm::vec2 tileSize = glm::ceil(glm::vec2(screenSize) / glm::vec2(gridX, gridY));
+
+	m_clusterGrid = glm::vec4(gridX, gridY, gridZ, 0.f);
+	m_clusterDepth = glm::vec4(tileSize, sliceScale, sliceBias);
+
+	// Cluster bounds only depend on the projection so are built once
+	m_buildMaterial->setValue("u_inverseProjection", glm::inverse(camera.projection));
+	m_buildMaterial->setValue("u_screenSize", glm::vec2(screenSize));
+	m_buildMaterial->setValue("u_tileSize", tileSize);
+	m_buildMaterial->setValue("u_zNear", zNear);
+	m_buildMaterial->setValue("u_zFar", zFar);
+
+	m_clusterAABBSSBO->bind(clusterAABBBinding);
+	m_buildMaterial->apply();
+	glDispatchCompute(gridX, gridY, gridZ);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void ClusteredLighting::onUpdate(const Scene& scene)
+{
+	onUpdate(scene.m_pointLights, scene.m_spotLights);
+}
+
+void ClusteredLighting::onUpdate(std::span<const PointLight> pointLights, std::span<const SpotLight> spotLights)
+{
+	ZoneScopedN("ClusteredLightingUpdate");
+
+	using namespace ClusterConsts;
+
+	size_t pointCount = std::min<size_t>(pointLights.size(), maxPointLights);
+	size_t spotCount = std::min<size_t>(spotLights.size(), maxSpotLights);
+
+	if (pointCount < pointLights.size() || spotCount < spotLights.size())
+	{
+		spdlog::warn("Clustered lighting capacity exceeded, {} point lights and {} spot lights will be ignored",
+			pointLights.size() - pointCount, spotLights.size() - spotCount);
+	}
+
+	m_pointLights.resize(pointCount);
+	for (size_t i = 0; i < pointCount; i++)
+	{
+		auto& light = pointLights[i];
+		auto& packed = m_pointLights[i];
+		packed.positionRange = glm::vec4(light.position, getLightRange(light.colour, light.constants));
+		packed.colour = glm::vec4(light.colour, 0.f);
+		packed.constants = glm::vec4(light.constants, 0.f);
+	}
+
+	m_spotLights.resize(spotCount);
+	for (size_t i = 0; i < spotCount; i++)
+	{
+		auto& light = spotLights[i];
+		auto& packed = m_spotLights[i];
+		packed.positionRange = glm::vec4(light.position, getLightRange(light.colour, light.constants));
+		packed.colour = glm::vec4(light.colour, 0.f);
+		packed.directionCutOff = glm::vec4(glm::normalize(light.direction), light.cutOffCosine);
+		packed.constantsOuterCutOff = glm::vec4(light.constants, light.outerCutOffCosine);
+	}
+
+	if (!m_pointLights.empty()) m_pointLightSSBO->edit(0, static_cast<uint32_t>(sizeof(GPUPointLight) * m_pointLights.size()), m_pointLights.data());
+	if (!m_spotLights.empty()) m_spotLightSSBO->edit(0, static_cast<uint32_t>(sizeof(GPUSpotLight) * m_spotLights.size()), m_spotLights.data());
+}
+
+void ClusteredLighting::dispatch(const Camera& camera)
+{
+	ZoneScopedN("ClusteredLightingCull");
+	TracyGpuZone("ClusteredLightingCull");
+
+	using namespace ClusterConsts;
+
+	uint32_t zero = 0;
+	m_indexCounterSSBO->edit(0, sizeof(uint32_t), &zero);
+
+	bindBuffers();
+
+	m_cullMaterial->setValue("u_view", camera.view);
+	m_cullMaterial->setValue("u_pointLightCount", static_cast<int32_t>(m_pointLights.size()));
+	m_cullMaterial->setValue("u_spotLightCount", static_cast<int32_t>(m_spotLights.size()));
+	m_cullMaterial->setValue("u_indexCapacity", static_cast<int32_t>(clusterCount * averageLightsPerCluster));
+	m_cullMaterial->apply();
+
+	glDispatchCompute((clusterCount + cullGroupSize - 1) / cullGroupSize, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void ClusteredLighting::setClusterUniforms(UBOManager& UBOmanager) const
+{
+	UBOmanager.setCachedValue("b_clusters", "u_clusterGrid", m_clusterGrid);
+	UBOmanager.setCachedValue("b_clusters", "u_clusterDepth", m_clusterDepth);
+}
+
+float ClusteredLighting::getLightRange(const glm::vec3& colour, const glm::vec3& constants)
+{
+	// Solve constant + linear * d + quadratic * d^2 = maxIntensity / cutOff for d
+	float maxIntensity = std::max(std::max(colour.r, colour.g), colour.b);
+	float target = maxIntensity / ClusterConsts::lightCutOff;
+	float c = constants.x - target;
+	float l = constants.y;
+	float q = constants.z;
+
+	if (c >= 0.f) return 0.f; // Never bright enough to matter
+	if (q <= 0.f)
+	{
+		if (l <= 0.f) return std::numeric_limits<float>::max();
+		return -c / l;
+	}
+
+	return (-l + std::sqrt(l * l - 4.f * q * c)) / (2.f * q);
+}
+
+void ClusteredLighting::bindBuffers()
+{
+	using namespace ClusterConsts;
+
+	m_pointLightSSBO->bind(pointLightBinding);
+	m_spotLightSSBO->bind(spotLightBinding);
+	m_clusterAABBSSBO->bind(clusterAABBBinding);
+	m_lightGridSSBO->bind(lightGridBinding);
+	m_lightIndexSSBO->bind(lightIndexBinding);
+	m_indexCounterSSBO->bind(indexCounterBinding);
+}
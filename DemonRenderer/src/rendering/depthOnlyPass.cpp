@@ -1,5 +1,6 @@
 #include "rendering/depthOnlyPass.hpp"
 #include "components/render.hpp"
+#include "rendering/material.hpp"
 #include <entt/entt.hpp>
 
 void DepthPass::parseScene()
@@ -12,10 +13,12 @@ void DepthPass::parseScene()
 
 		auto& renderComp = depthRenderView.get<Render>(entity);
 
-		if (renderComp.depthMaterial)
+		auto depthMaterial = ResourceRegistry::get(renderComp.depthMaterial);
+
+		if (depthMaterial)
 		{
 
-			for (auto& UBOlayout : renderComp.depthMaterial->m_shader->m_UBOLayouts)
+			for (auto& UBOlayout : depthMaterial->m_shader->m_UBOLayouts)
 			{
 
 				UBOmanager.addUBO(UBOlayout);
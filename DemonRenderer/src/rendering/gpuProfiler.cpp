@@ -0,0 +1,185 @@
+/** \file gpuProfiler.cpp */
+#include <glad/gl.h>
+#include "rendering/gpuProfiler.hpp"
+#include "core/log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+uint32_t GPUProfiler::getScope(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	for (uint32_t i = 0; i < s_windows.size(); i++)
+	{
+		if (s_windows[i].name == name) return i;
+	}
+	if (s_windows.size() >= maxScopes) {
+		spdlog::error("GPUProfiler: more than {} scopes, {} will not be timed", maxScopes, name);
+		return maxScopes;
+	}
+
+	// Reserved up front so a scope added mid run never moves the others under a reader
+	if (s_windows.empty()) s_windows.reserve(maxScopes);
+	s_windows.push_back({ name });
+	return static_cast<uint32_t>(s_windows.size() - 1);
+}
+
+void GPUProfiler::begin(uint32_t scope)
+{
+	if (s_depth >= maxDepth) {
+		s_depth++;
+		return;
+	}
+	if (scope >= maxScopes) {
+		s_open[s_depth++] = noRecord;
+		return;
+	}
+
+	Slot& slot = s_slots[s_current];
+	const uint32_t record = static_cast<uint32_t>(slot.records.size());
+	slot.records.push_back(scope);
+
+	// Queries are only created while the frame's busiest slot is still growing
+	if (slot.queries.size() < slot.records.size() * 2) {
+		const size_t first = slot.queries.size();
+		slot.queries.resize(std::max<size_t>(slot.records.size() * 2, first * 2));
+		glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(slot.queries.size() - first), slot.queries.data() + first);
+	}
+
+	glQueryCounter(slot.queries[record * 2], GL_TIMESTAMP);
+	s_open[s_depth++] = record;
+}
+
+void GPUProfiler::end()
+{
+	if (s_depth == 0) {
+		spdlog::error("GPUProfiler: end without a matching begin");
+		return;
+	}
+	s_depth--;
+	if (s_depth >= maxDepth || s_open[s_depth] == noRecord) return;
+
+	Slot& slot = s_slots[s_current];
+	glQueryCounter(slot.queries[s_open[s_depth] * 2 + 1], GL_TIMESTAMP);
+}
+
+void GPUProfiler::onFrameEnd()
+{
+	if (s_depth > 0) {
+		spdlog::warn("GPUProfiler: {} scopes still open at the end of the frame", s_depth);
+		while (s_depth > 0) end();
+	}
+
+	// The next slot was written latency frames ago, read it before it is reused
+	s_current = (s_current + 1) % static_cast<uint32_t>(s_slots.size());
+	collect(s_slots[s_current]);
+}
+
+void GPUProfiler::collect(Slot& slot)
+{
+	if (slot.records.empty()) return;
+
+	// Nested scopes end out of order, so every end timestamp is checked before any result is read
+	GLuint available = GL_TRUE;
+	for (size_t i = 0; i < slot.records.size() && available == GL_TRUE; i++)
+	{
+		glGetQueryObjectuiv(slot.queries[i * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	}
+	if (available == GL_FALSE) {
+		slot.records.clear();
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_lateFrames++;
+		return;
+	}
+
+	s_frameNs.fill(0);
+	s_frameSeen.fill(false);
+	for (size_t i = 0; i < slot.records.size(); i++)
+	{
+		GLuint64 start = 0;
+		GLuint64 finish = 0;
+		glGetQueryObjectui64v(slot.queries[i * 2], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(slot.queries[i * 2 + 1], GL_QUERY_RESULT, &finish);
+		const uint32_t scope = slot.records[i];
+		if (finish > start) s_frameNs[scope] += finish - start;
+		s_frameSeen[scope] = true;
+	}
+	slot.records.clear();
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	for (uint32_t i = 0; i < s_windows.size(); i++)
+	{
+		if (!s_frameSeen[i]) continue;
+		Window& window = s_windows[i];
+		window.last = static_cast<float>(s_frameNs[i]) * 1e-6f;
+		window.samples[window.next] = window.last;
+		window.next = (window.next + 1) % windowSize;
+		window.count = std::min(window.count + 1, windowSize);
+	}
+}
+
+void GPUProfiler::clear()
+{
+	for (Slot& slot : s_slots)
+	{
+		if (!slot.queries.empty()) glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+		slot.queries.clear();
+		slot.records.clear();
+	}
+	s_depth = 0;
+}
+
+std::vector<GPUPassTiming> GPUProfiler::getTimings()
+{
+	std::vector<GPUPassTiming> result;
+	std::lock_guard<std::mutex> lock(s_mutex);
+	result.reserve(s_windows.size());
+	for (const Window& window : s_windows)
+	{
+		if (window.count == 0) continue;
+
+		std::array<float, windowSize> sorted;
+		std::copy_n(window.samples.begin(), window.count, sorted.begin());
+		float sum = 0.f;
+		for (uint32_t i = 0; i < window.count; i++) sum += sorted[i];
+
+		const uint32_t p95 = static_cast<uint32_t>(std::ceil(0.95f * static_cast<float>(window.count))) - 1;
+		std::nth_element(sorted.begin(), sorted.begin() + p95, sorted.begin() + window.count);
+
+		GPUPassTiming timing;
+		timing.name = window.name;
+		timing.lastMs = window.last;
+		timing.minMs = *std::min_element(sorted.begin(), sorted.begin() + window.count);
+		timing.avgMs = sum / static_cast<float>(window.count);
+		timing.p95Ms = sorted[p95];
+		timing.samples = window.count;
+		result.push_back(std::move(timing));
+	}
+	return result;
+}
+
+uint64_t GPUProfiler::getLateFrames() noexcept
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	return s_lateFrames;
+}
+
+bool GPUProfiler::exportCSV(const std::filesystem::path& path)
+{
+	std::error_code error;
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		spdlog::error("GPUProfiler: could not open {} for writing", path.string());
+		return false;
+	}
+
+	file << "pass,last_ms,min_ms,avg_ms,p95_ms,samples\n";
+	for (const GPUPassTiming& timing : getTimings())
+	{
+		file << timing.name << "," << timing.lastMs << "," << timing.minMs << "," << timing.avgMs << "," << timing.p95Ms << "," << timing.samples << "\n";
+	}
+	spdlog::info("GPUProfiler: timings written to {}", path.string());
+	return true;
+}
@@ -1,4 +1,5 @@
 #include "rendering/material.hpp"
+#include "core/allocationAudit.hpp"
 #include "tracy/TracyOpenGL.hpp"
 
 uint32_t Material::s_ID = 0;
@@ -34,7 +35,7 @@ void Material::unsetValue(const std::string& name)
 
 void Material::apply()
 {
-	ZoneScopedN("Material");
+	ZoneAuditedN("Material");
 	TracyGpuZone("Material");
 	// Bind shader
 	// Checks to see if the id of m_shader is equal to the static variable s_ID.
@@ -0,0 +1,219 @@
+#include "rendering/particleSystem.hpp"
+#include "core/memoryTracker.hpp"
+#include "core/gpuMemory.hpp"
+#include "tracy/TracyOpenGL.hpp"
+#include <numeric>
+#include <cmath>
+#include <string>
+
+ParticleSystem::ParticleSystem(uint32_t capacity) : m_capacity(capacity)
+{
+	GPUMemory::Owner gpuOwner("Particles");
+	using namespace ParticleConsts;
+
+	// Pool is 4 vec4s per particle: position and life, velocity and max life, colour, sizes and drag
+	m_particles = std::make_shared<SSBO>(sizeof(glm::vec4) * 4 * m_capacity, m_capacity);
+
+	// Every slot starts on the dead list
+	std::vector<uint32_t> deadIndices(m_capacity);
+	std::iota(deadIndices.begin(), deadIndices.end(), 0);
+	m_deadList = std::make_shared<SSBO>(sizeof(uint32_t) * m_capacity, m_capacity, deadIndices.data());
+
+	m_aliveLists[0] = std::make_shared<SSBO>(sizeof(uint32_t) * m_capacity, m_capacity);
+	m_aliveLists[1] = std::make_shared<SSBO>(sizeof(uint32_t) * m_capacity, m_capacity);
+
+	glm::uvec4 counters(m_capacity, 0, 0, 0);
+	m_counters = std::make_shared<SSBO>(sizeof(glm::uvec4), 1, &counters);
+
+	std::array<uint32_t, 10> args = { 0, 1, 1, 0, 1, 1, 0, 1, 0, 0 };
+	m_indirectArgs = std::make_shared<SSBO>(sizeof(uint32_t) * args.size(), static_cast<uint32_t>(args.size()), args.data());
+
+	m_emitterBuffer = std::make_shared<SSBO>(sizeof(GPUEmitter) * maxEmitters, maxEmitters);
+
+	auto loadCompute = [](const std::string& path) {
+		ShaderDescription desc;
+		desc.type = ShaderType::compute;
+		desc.computeSrcPath = path;
+		return std::make_shared<Material>(std::make_shared<Shader>(desc), "");
+	};
+
+	m_beginMaterial = loadCompute("./assets/shaders/Particles/Begin.glsl");
+	m_emitMaterial = loadCompute("./assets/shaders/Particles/Emit.glsl");
+	m_simulateMaterial = loadCompute("./assets/shaders/Particles/Simulate.glsl");
+	m_endMaterial = loadCompute("./assets/shaders/Particles/End.glsl");
+
+	ShaderDescription drawDesc;
+	drawDesc.type = ShaderType::rasterization;
+	drawDesc.vertexSrcPath = "./assets/shaders/Particles/Vert.glsl";
+	drawDesc.fragmentSrcPath = "./assets/shaders/Particles/Frag.glsl";
+	m_drawMaterial = std::make_shared<Material>(std::make_shared<Shader>(drawDesc), "");
+
+	glCreateVertexArrays(1, &m_VAO);
+
+	spdlog::info("Particle system created with {} particles ({} MB)", m_capacity, (sizeof(glm::vec4) * 4 + sizeof(uint32_t) * 3) * m_capacity / (1024 * 1024));
+}
+
+ParticleSystem::~ParticleSystem()
+{
+	glDeleteVertexArrays(1, &m_VAO);
+}
+
+uint32_t ParticleSystem::addEmitter(const ParticleEmitter& emitter)
+{
+	if (m_emitters.size() >= ParticleConsts::maxEmitters)
+	{
+		spdlog::error("Could not add particle emitter, the limit of {} has been reached", ParticleConsts::maxEmitters);
+		return ParticleConsts::invalidEmitter;
+	}
+
+	m_emitters.push_back(emitter);
+	m_emitAccumulators.push_back(0.f);
+	m_pendingBursts.push_back(0);
+	return static_cast<uint32_t>(m_emitters.size() - 1);
+}
+
+void ParticleSystem::burst(uint32_t emitterIndex, uint32_t count)
+{
+	if (emitterIndex < m_pendingBursts.size()) m_pendingBursts[emitterIndex] += count;
+}
+
+void ParticleSystem::onUpdate(float timestep)
+{
+	MemoryTracker::Scope memoryScope(MemoryTag::rendering);
+	m_timestep = timestep;
+
+	for (size_t i = 0; i < m_emitters.size(); i++)
+	{
+		auto& emitter = m_emitters[i];
+		if (emitter.enabled) m_emitAccumulators[i] += emitter.rate * timestep;
+	}
+}
+
+void ParticleSystem::dispatch()
+{
+	extract(m_emission);
+	dispatch(m_emission);
+}
+
+void ParticleSystem::extract(Emission& emission)
+{
+	ZoneScopedN("ParticleExtract");
+	MemoryTracker::Scope memoryScope(MemoryTag::rendering);
+
+	// Pack this frame's emission, each emitter owns a contiguous range of emit invocations
+	emission.emitters.clear();
+	uint32_t emitTotal = 0;
+	for (size_t i = 0; i < m_emitters.size(); i++)
+	{
+		auto& emitter = m_emitters[i];
+		uint32_t count = static_cast<uint32_t>(m_emitAccumulators[i]) + m_pendingBursts[i];
+		m_emitAccumulators[i] -= std::floor(m_emitAccumulators[i]);
+		m_pendingBursts[i] = 0;
+		if (count == 0) continue;
+
+		GPUEmitter packed;
+		packed.positionSpread = glm::vec4(emitter.position, emitter.positionSpread);
+		packed.velocitySpread = glm::vec4(emitter.velocity, emitter.velocitySpread);
+		packed.colour = emitter.colour;
+		packed.lifeSize = glm::vec4(emitter.lifetime, emitter.size);
+		packed.drag = glm::vec4(emitter.drag, 0.f, 0.f, 0.f);
+		packed.range = glm::uvec4(emitTotal, count, 0, 0);
+		emission.emitters.push_back(packed);
+
+		emitTotal += count;
+	}
+	emission.total = emitTotal;
+	emission.timestep = m_timestep;
+	m_lastEmitCount = emitTotal;
+	m_timestep = 0.f;
+}
+
+void ParticleSystem::dispatch(const Emission& emission)
+{
+	ZoneScopedN("ParticleDispatch");
+	TracyGpuZone("ParticleDispatch");
+
+	using namespace ParticleConsts;
+
+	const uint32_t emitTotal = emission.total;
+	if (!emission.emitters.empty()) m_emitterBuffer->edit(0, static_cast<uint32_t>(sizeof(GPUEmitter) * emission.emitters.size()), emission.emitters.data());
+
+	m_particles->bind(particleBinding);
+	m_deadList->bind(deadListBinding);
+	m_aliveLists[m_current]->bind(aliveListBinding);
+	m_aliveLists[1 - m_current]->bind(aliveNextListBinding);
+	m_counters->bind(counterBinding);
+	m_indirectArgs->bind(indirectBinding);
+	m_emitterBuffer->bind(emitterBinding);
+
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_indirectArgs->getID());
+
+	// Roll the counters over and size the emit and simulate dispatches
+	m_beginMaterial->setValue("u_requestedEmitCount", static_cast<int32_t>(emitTotal));
+	m_beginMaterial->apply();
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	// Emit
+	m_emitMaterial->setValue("u_emitterCount", static_cast<int32_t>(emission.emitters.size()));
+	m_emitMaterial->setValue("u_seed", static_cast<int32_t>(m_frame));
+	m_emitMaterial->apply();
+	glDispatchComputeIndirect(emitArgsOffset);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	// Simulate and compact into the next alive list
+	m_simulateMaterial->setValue("u_timestep", emission.timestep);
+	m_simulateMaterial->apply();
+	glDispatchComputeIndirect(simulateArgsOffset);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	// Draw arguments from the surviving count
+	m_endMaterial->apply();
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	m_current = 1 - m_current;
+	m_frame++;
+}
+
+void ParticleSystem::draw()
+{
+	ZoneScopedN("ParticleDraw");
+	TracyGpuZone("ParticleDraw");
+
+	using namespace ParticleConsts;
+
+	m_particles->bind(particleBinding);
+	m_aliveLists[m_current]->bind(aliveListBinding);
+
+	m_drawMaterial->apply();
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+	glDepthMask(GL_FALSE);
+
+	glBindVertexArray(m_VAO);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectArgs->getID());
+	glDrawArraysIndirect(GL_TRIANGLES, reinterpret_cast<const void*>(static_cast<uintptr_t>(drawArgsOffset)));
+
+	glDepthMask(GL_TRUE);
+	glDisable(GL_BLEND);
+}
+
+bool ParticleSystem::isSoftwareRenderer()
+{
+	// Asked once while the context is current, so threads without the context can ask later
+	static const bool software = []() {
+		const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+		if (!renderer) return false;
+
+		std::string name(renderer);
+		return name.find("llvmpipe") != std::string::npos || name.find("softpipe") != std::string::npos || name.find("SwiftShader") != std::string::npos;
+	}();
+	return software;
+}
+
+uint32_t ParticleSystem::getDefaultCapacity()
+{
+	return isSoftwareRenderer() ? ParticleConsts::softwareCapacity : ParticleConsts::desktopCapacity;
+}
@@ -1,5 +1,6 @@
 #include "rendering/renderPass.hpp"
 #include "components/render.hpp"
+#include "rendering/material.hpp"
 #include <entt/entt.hpp>
 
 void RenderPass::parseScene()
@@ -13,10 +14,12 @@ void RenderPass::parseScene()
 
 		auto& renderComp = renderView.get<Render>(entity);
 
-		if (renderComp.material)
+		auto material = ResourceRegistry::get(renderComp.material);
+
+		if (material)
 		{
 
-			for (auto& UBOlayout : renderComp.material->m_shader->m_UBOLayouts)
+			for (auto& UBOlayout : material->m_shader->m_UBOLayouts)
 			{
 
 				UBOmanager.addUBO(UBOlayout);
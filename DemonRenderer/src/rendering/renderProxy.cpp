@@ -0,0 +1,97 @@
+/** \file renderProxy.cpp */
+#include "rendering/renderProxy.hpp"
+#include "components/analyticSpin.hpp"
+#include "core/transformSystem.hpp"
+#include "tracy/Tracy.hpp"
+
+RenderProxyList::RenderProxyList(entt::registry& registry) :
+	m_registry(registry)
+{
+	m_registry.on_construct<Render>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<Render>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<WorldMatrix>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<WorldMatrix>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<LODAssign>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<LODAssign>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<AABB>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<AABB>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<AnalyticSpin>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<AnalyticSpin>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<LocalTRS>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<LocalTRS>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_construct<PreviousTRS>().connect<&RenderProxyList::onStructureChanged>(this);
+	m_registry.on_destroy<PreviousTRS>().connect<&RenderProxyList::onStructureChanged>(this);
+}
+
+RenderProxyList::~RenderProxyList()
+{
+	m_registry.on_construct<Render>().disconnect(this);
+	m_registry.on_destroy<Render>().disconnect(this);
+	m_registry.on_construct<WorldMatrix>().disconnect(this);
+	m_registry.on_destroy<WorldMatrix>().disconnect(this);
+	m_registry.on_construct<LODAssign>().disconnect(this);
+	m_registry.on_destroy<LODAssign>().disconnect(this);
+	m_registry.on_construct<AABB>().disconnect(this);
+	m_registry.on_destroy<AABB>().disconnect(this);
+	m_registry.on_construct<AnalyticSpin>().disconnect(this);
+	m_registry.on_destroy<AnalyticSpin>().disconnect(this);
+	m_registry.on_construct<LocalTRS>().disconnect(this);
+	m_registry.on_destroy<LocalTRS>().disconnect(this);
+	m_registry.on_construct<PreviousTRS>().disconnect(this);
+	m_registry.on_destroy<PreviousTRS>().disconnect(this);
+}
+
+void RenderProxyList::sync(float alpha)
+{
+	ZoneScopedN("RenderProxySync");
+	if (m_dirty) rebuild();
+
+	// Component pools are paged, so the cached addresses only move when a component is removed or a pool is sorted
+	const size_t count = m_proxies.size();
+	for (size_t i = 0; i < count; i++)
+	{
+		const Source& source = m_sources[i];
+		RenderProxy& proxy = m_proxies[i];
+
+		if (source.previous && alpha < 1.f) {
+			WorldMatrix blended;
+			TransformSystem::interpolate(source.previous->local, *source.local, alpha, blended);
+			proxy.model = blended.rows;
+		}
+		else proxy.model = source.world->rows;
+		proxy.render = *source.render;
+		if (source.lod) {
+			proxy.lodIndex = static_cast<uint32_t>(source.lod->lodIndex);
+			proxy.lodNumber = source.lod->lodNumber;
+		}
+		if (source.bounds) {
+			proxy.boundsMin = source.bounds->first;
+			proxy.boundsMax = source.bounds->second;
+		}
+	}
+}
+
+void RenderProxyList::rebuild()
+{
+	ZoneScopedN("RenderProxyRebuild");
+	m_proxies.clear();
+	m_sources.clear();
+
+	auto view = m_registry.view<Render, WorldMatrix>();
+	view.each([this](entt::entity entity, const Render& render, const WorldMatrix& world) {
+		Source source{ &render, &world, m_registry.try_get<LODAssign>(entity), m_registry.try_get<AABB>(entity), nullptr, m_registry.try_get<PreviousTRS>(entity) };
+		if (source.previous) source.local = m_registry.try_get<LocalTRS>(entity);
+		if (!source.local) source.previous = nullptr;
+		const AnalyticSpin* spin = m_registry.try_get<AnalyticSpin>(entity);
+
+		RenderProxy proxy{};
+		proxy.flags = (source.bounds ? RenderProxy::hasBounds : 0u) | (source.lod ? RenderProxy::hasLOD : 0u);
+		proxy.instance = spin ? static_cast<int32_t>(spin->instance) : -1;
+		proxy.entity = entity;
+
+		m_sources.push_back(source);
+		m_proxies.push_back(proxy);
+	});
+
+	m_dirty = false;
+}
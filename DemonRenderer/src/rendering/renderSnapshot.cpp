@@ -0,0 +1,36 @@
+/** \file renderSnapshot.cpp */
+#include <glad/gl.h>
+#include "rendering/renderSnapshot.hpp"
+#include <imgui_impl_opengl3.h>
+#include "tracy/Tracy.hpp"
+
+void ImGuiSnapshot::capture(ImDrawData* drawData)
+{
+	ZoneScopedN("ImGuiCapture");
+	m_drawData.Clear();
+	if (!drawData || !drawData->Valid) return;
+
+	while (m_lists.size() < static_cast<size_t>(drawData->CmdListsCount)) m_lists.push_back(std::make_unique<ImDrawList>(nullptr));
+
+	for (int i = 0; i < drawData->CmdListsCount; i++)
+	{
+		// ImGui clears its lists at the start of the next frame, keeping the capacity we hand back
+		ImDrawList* source = drawData->CmdLists[i];
+		ImDrawList* list = m_lists[i].get();
+		list->CmdBuffer.swap(source->CmdBuffer);
+		list->IdxBuffer.swap(source->IdxBuffer);
+		list->VtxBuffer.swap(source->VtxBuffer);
+		list->Flags = source->Flags;
+		m_drawData.AddDrawList(list);
+	}
+
+	m_drawData.DisplayPos = drawData->DisplayPos;
+	m_drawData.DisplaySize = drawData->DisplaySize;
+	m_drawData.FramebufferScale = drawData->FramebufferScale;
+	m_drawData.Valid = true;
+}
+
+void ImGuiSnapshot::render()
+{
+	if (m_drawData.Valid) ImGui_ImplOpenGL3_RenderDrawData(&m_drawData);
+}
@@ -1,32 +1,44 @@
 #pragma once
 
 #include "rendering/renderer.hpp"
+#include "core/allocationAudit.hpp"
+#include "core/memoryTracker.hpp"
 #include "tracy/TracyOpenGL.hpp"
 #include <entt/entt.hpp>
 #include "components/render.hpp"
+#include "rendering/material.hpp"
+#include "buffers/VAO.hpp"
 #include "components/transform.hpp"
 #include "components/lodassign.hpp"
+#include "core/jobSystem.hpp"
+#include "core/memoryResources.hpp"
 #include <iostream>
+#include <algorithm>
 
-uint32_t Renderer::s_ID = 0;
+uint32_t Renderer::s_targetID = 0;
+uint32_t Renderer::s_VAOID = 0;
+uint32_t Renderer::s_imageID = 0;
 ViewPort Renderer::s_viewID = {-1,-1,-1,-1}; //Use arbitrary values for the static variable to check the viewport transforms against, which are then overwritten to make
 //sure it doesn't try to set the viewport more than once.
 
 void Renderer::addRenderPass(const RenderPass& pass)
 {
 	m_renderOrder.push_back(std::pair<PassType, size_t>(PassType::render, m_renderPasses.size()));
+	m_passScopes.push_back(GPUProfiler::getScope(pass.name.empty() ? "Render pass " + std::to_string(m_renderPasses.size()) : pass.name));
 	m_renderPasses.push_back(pass);
 }
 
 void Renderer::addDepthPass(const DepthPass& depthPass)
 {
 	m_renderOrder.push_back(std::pair<PassType, size_t>(PassType::depth, m_depthPasses.size()));
+	m_passScopes.push_back(GPUProfiler::getScope(depthPass.name.empty() ? "Depth pass " + std::to_string(m_depthPasses.size()) : depthPass.name));
 	m_depthPasses.push_back(depthPass);
 }
 
 void Renderer::addComputePass(const ComputePass& pass)
 {
 	m_renderOrder.push_back(std::pair<PassType, size_t>(PassType::compute, m_computePasses.size()));
+	m_passScopes.push_back(GPUProfiler::getScope(pass.name.empty() ? "Compute pass " + std::to_string(m_computePasses.size()) : pass.name));
 	m_computePasses.push_back(pass);
 }
 
@@ -51,24 +63,87 @@ ComputePass& Renderer::getComputePass(size_t index)
 
 void Renderer::render() const
 {
-	ZoneScopedN("OverallRPass");
-	TracyGpuZone("OverallRPass");
+	extract(m_snapshot);
+	render(m_snapshot);
+}
+
+void Renderer::extract(RenderSnapshot& snapshot, float alpha) const
+{
+	ZoneAuditedN("RendererExtract");
+	MemoryTracker::Scope memoryScope(MemoryTag::rendering);
 
 	auto& mainPass = m_renderPasses[0];
 	CameraFrustrum cameraFrustum(mainPass.camera);
+	snapshot.camera = mainPass.camera;
+
+	// Bring each scene's packed renderables up to date once, however many passes draw it
+	std::pmr::vector<Scene*> syncedScenes(&Memory::frame());
+	auto syncScene = [&syncedScenes, alpha](const std::shared_ptr<Scene>& scene) {
+		if (!scene || std::find(syncedScenes.begin(), syncedScenes.end(), scene.get()) != syncedScenes.end()) return;
+		scene->m_renderProxies.sync(alpha);
+		syncedScenes.push_back(scene.get());
+	};
+	for (auto& pass : m_renderPasses) syncScene(pass.scene);
+	for (auto& pass : m_depthPasses) syncScene(pass.scene);
+
+	auto toPacket = [](const RenderProxy& proxy) { return DrawPacket{ proxy.model, proxy.render, proxy.instance, proxy.lodIndex, proxy.lodNumber }; };
+
+	snapshot.renderPasses.resize(m_renderPasses.size());
+	for (size_t idx = 0; idx < m_renderPasses.size(); idx++)
+	{
+		// Cull across the workers, then keep the visible proxies in order
+		const auto& proxies = m_renderPasses[idx].scene->m_renderProxies.getProxies();
+		m_visible.resize(proxies.size());
+		{
+			ZoneScopedN("Culling");
+			JobSystem::parallelFor(0, proxies.size(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++)
+				{
+					const RenderProxy& proxy = proxies[i];
+					//Perform frustum culling if an AABB exists
+					m_visible[i] = (proxy.flags & RenderProxy::hasLOD) && (!(proxy.flags & RenderProxy::hasBounds) || cameraFrustum.intersects({ proxy.boundsMin, proxy.boundsMax }));
+				}
+			}, cullingGrain);
+		}
+
+		auto& packets = snapshot.renderPasses[idx];
+		packets.clear();
+		for (size_t i = 0; i < proxies.size(); i++)
+		{
+			if (m_visible[i]) packets.push_back(toPacket(proxies[i]));
+		}
+	}
+
+	snapshot.depthPasses.resize(m_depthPasses.size());
+	for (size_t idx = 0; idx < m_depthPasses.size(); idx++)
+	{
+		const auto& proxies = m_depthPasses[idx].scene->m_renderProxies.getProxies();
+		auto& packets = snapshot.depthPasses[idx];
+		packets.clear();
+		for (const RenderProxy& proxy : proxies) packets.push_back(toPacket(proxy));
+	}
+}
+
+void Renderer::render(const RenderSnapshot& snapshot) const
+{
+	ZoneAuditedN("OverallRPass");
+	TracyGpuZone("OverallRPass");
 
-	for (auto& [passType, idx] : m_renderOrder)
+	for (size_t i = 0; i < m_renderOrder.size(); i++)
 	{
+		auto& [passType, idx] = m_renderOrder[i];
+		GPUProfiler::Scope gpuScope(m_passScopes[i]);
+
 		if (passType == PassType::render)
 		{
 			ZoneScopedN("RPass");
 			TracyGpuZone("RPass");
 			auto& renderPass = m_renderPasses[idx];
 
-			if (s_ID != renderPass.target->getID())
+			if (s_targetID != renderPass.target->getID())
 			{
 				renderPass.target->use();
-				s_ID = renderPass.target->getID();
+				s_targetID = renderPass.target->getID();
 			}
 			setViewport(renderPass.viewPort.x, renderPass.viewPort.y, renderPass.viewPort.width, renderPass.viewPort.height);
 
@@ -84,77 +159,56 @@ void Renderer::render() const
 
 			renderPass.UBOmanager.uploadCachedValues();
 
-			// Get all entities with render and transform component
-			auto view = renderPass.scene->m_entities.view<Render, Transform, LODAssign>();
-
-			view.each([this, &cameraFrustum, &renderPass](entt::entity entity, const auto& renderComp, const auto& transformComp, const auto& lodComp) 
+			for (const DrawPacket& packet : snapshot.renderPasses[idx])
 			{
-
-					AABB aabb;
-					bool hasAABB = renderPass.scene->m_entities.all_of<AABB>(entity);
-
-					if (hasAABB)
-					{
-
-						aabb = renderPass.scene->m_entities.get<AABB>(entity);
-
-					}
-
-					//Perform frustum culling if an AABB exists
-					if (hasAABB && !cameraFrustum.intersects(aabb)) {
-						return;
-					}
-
-
 				ZoneScopedN("Entity");
-				TracyGpuZone("Entity");
-				if (renderComp.material)
+				Material* material = ResourceRegistry::get(packet.render.material);
+				if (material)
 				{
 					ZoneScopedN("Material");
-					TracyGpuZone("Material");
-					renderComp.material->apply();
-					if (renderComp.material->getTransformUniformName().length() > 0)
+					material->apply();
+					if (material->getTransformUniformName().length() > 0)
+					{
+						material->m_shader->uploadUniform(material->getTransformUniformName(), packet.model);
+					}
+					// Analytically animated entities build their model matrix in the vertex shader from an instance index
+					if (material->getInstanceUniformName().length() > 0 && packet.instance >= 0)
 					{
-						renderComp.material->m_shader->uploadUniform(renderComp.material->getTransformUniformName(), transformComp.transform);
+						material->m_shader->uploadUniform(material->getInstanceUniformName(), static_cast<int>(packet.instance));
 					}
 
-					if (renderComp.geometry)
+					VAO* geometry = ResourceRegistry::get(packet.render.geometry);
+					if (geometry)
 					{
 						ZoneScopedN("Draw");
-						TracyGpuZone("Draw");
 
-						
-
-						//Added if statement to prevent redundant binding calls as it calls getID when binding the vertex array.
-						if (s_ID != renderComp.geometry->getID())
+						//Only the bind is skipped when consecutive entities share a vertex array, the draw always happens.
+						if (s_VAOID != geometry->getID())
 						{
+							glBindVertexArray(geometry->getID());
+							s_VAOID = geometry->getID();
+						}
 
-							glBindVertexArray(renderComp.geometry->getID());
-							
-							if (lodComp.lodNumber == 1)
-							{
-															
-
-								void* baseVertexIndex = (void*)(sizeof(GLuint) * renderComp.geometry->LOD_data[lodComp.lodIndex].first);
-								auto& drawCount = renderComp.geometry->LOD_data[lodComp.lodIndex].second;
-								glDrawElements(renderComp.material->getPrimitive(), drawCount, GL_UNSIGNED_INT, baseVertexIndex);
-								s_ID = renderComp.geometry->getID();
-
-							}
-							else
-							{
-																
-								glDrawElements(renderComp.material->getPrimitive(), renderComp.geometry->getDrawCount(), GL_UNSIGNED_INT, NULL);
-								s_ID = renderComp.geometry->getID();
-
-							}
-
-							
+						if (packet.lodNumber == 1)
+						{
+							void* baseVertexIndex = (void*)(sizeof(GLuint) * geometry->LOD_data[packet.lodIndex].first);
+							auto& drawCount = geometry->LOD_data[packet.lodIndex].second;
+							glDrawElements(material->getPrimitive(), drawCount, GL_UNSIGNED_INT, baseVertexIndex);
+						}
+						else
+						{
+							glDrawElements(material->getPrimitive(), geometry->getDrawCount(), GL_UNSIGNED_INT, NULL);
 						}
 					}
 				}
+			}
 
-			});
+			// Transparent particles last, depth tested against the pass's geometry
+			for (auto& particleSystem : renderPass.particleSystems)
+			{
+				particleSystem->draw();
+				s_VAOID = particleSystem->getVertexArrayID();
+			}
 
 		}
 		
@@ -164,10 +218,10 @@ void Renderer::render() const
 			glCullFace(GL_FRONT);
 			auto& depthPass = m_depthPasses[idx];
 
-			if (s_ID != depthPass.target->getID())
+			if (s_targetID != depthPass.target->getID())
 			{
 				depthPass.target->use();
-				s_ID = depthPass.target->getID();
+				s_targetID = depthPass.target->getID();
 			}
 
 			setViewport(depthPass.viewPort.x, depthPass.viewPort.y, depthPass.viewPort.width, depthPass.viewPort.height);
@@ -178,38 +232,33 @@ void Renderer::render() const
 
 			depthPass.UBOmanager.uploadCachedValues();
 
-			auto depthView = depthPass.scene->m_entities.view<Render, Transform>();
-
-			depthView.each([](const auto& renderComp, const auto& transformComp)
+			for (const DrawPacket& packet : snapshot.depthPasses[idx])
+			{
+				ZoneScopedN("Entity");
+				Material* depthMaterial = ResourceRegistry::get(packet.render.depthMaterial);
+				if (depthMaterial)
 				{
-
-					ZoneScopedN("Entity");
-					TracyGpuZone("Entity");
-					if (renderComp.depthMaterial)
+					ZoneScopedN("Material");
+					depthMaterial->apply();
+					if (depthMaterial->getTransformUniformName().length() > 0)
 					{
-						ZoneScopedN("Material");
-						TracyGpuZone("Material");
-						renderComp.depthMaterial->apply();
-						if (renderComp.depthMaterial->getTransformUniformName().length() > 0)
-						{
-							renderComp.depthMaterial->m_shader->uploadUniform(renderComp.depthMaterial->getTransformUniformName(), transformComp.transform);
-						}
+						depthMaterial->m_shader->uploadUniform(depthMaterial->getTransformUniformName(), packet.model);
+					}
 
-						if (renderComp.depthGeometry)
+					VAO* depthGeometry = ResourceRegistry::get(packet.render.depthGeometry);
+					if (depthGeometry)
+					{
+						ZoneScopedN("Draw");
+						//Only the bind is skipped when consecutive entities share a vertex array, the draw always happens.
+						if (s_VAOID != depthGeometry->getID())
 						{
-							ZoneScopedN("Draw");
-							TracyGpuZone("Draw");
-							//Added if statement to prevent redundant binding calls as it calls getID when binding the vertex array.
-							if (s_ID != renderComp.depthGeometry->getID())
-							{
-								glBindVertexArray(renderComp.depthGeometry->getID());
-								glDrawElements(renderComp.depthMaterial->getPrimitive(), renderComp.depthGeometry->getDrawCount(), GL_UNSIGNED_INT, NULL);
-								s_ID = renderComp.depthGeometry->getID();
-							}
+							glBindVertexArray(depthGeometry->getID());
+							s_VAOID = depthGeometry->getID();
 						}
+						glDrawElements(depthMaterial->getPrimitive(), depthGeometry->getDrawCount(), GL_UNSIGNED_INT, NULL);
 					}
-
-				});
+				}
+			}
 
 			
 
@@ -237,22 +286,14 @@ void Renderer::render() const
 					break;
 				}
 
-				GLenum fmt = 0; // Ignoring depth for now
-				if (img.texture->isHDR()) {
-					if (img.texture->getChannels() == 3) fmt = GL_RGB16F;
-					else fmt = GL_RGBA16F;
-				}
-				else {
-					if (img.texture->getChannels() == 3) fmt = GL_RGB8;
-					else fmt = GL_RGBA8;
-				}
+				GLenum fmt = img.texture->getFormat();
 
 				// Need to deal with layers for cubemap
 				//Added if statement for preventing redundant bind calls, as it calls getID when binding the image texture.
-				if (s_ID != img.texture->getID())
+				if (s_imageID != img.texture->getID())
 				{
 					glBindImageTexture(img.imageUnit, img.texture->getID(), img.mipLevel, layered, 0, access, fmt);
-					s_ID = img.texture->getID();
+					s_imageID = img.texture->getID();
 				}
 			}
 
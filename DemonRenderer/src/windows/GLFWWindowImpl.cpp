@@ -170,7 +170,18 @@ void GLFWWindowImpl::doOnUpdate(float timestep)
 	}
 
 	m_graphicsContext.swapBuffers(m_nativeWindow.get(), isHostingImGui());
-	//TracyGpuCollect;
+	TracyGpuCollect;
+}
+
+void GLFWWindowImpl::pollEvents()
+{
+	glfwPollEvents();
+}
+
+void GLFWWindowImpl::present()
+{
+	m_graphicsContext.swapBuffers(m_nativeWindow.get(), false);
+	TracyGpuCollect;
 }
 
 void GLFWWindowImpl::doSetVSync(bool VSync)
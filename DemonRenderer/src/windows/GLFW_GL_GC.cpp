@@ -2,6 +2,7 @@
 #include <glad/gl.h>
 #include "windows/GLFW_GL_GC.hpp"
 #include "core/log.hpp"
+#include "core/memoryTracker.hpp"
 #include "tracy/TracyOpenGL.hpp"
 
 void GLFW_GL_Init::operator()(GLFWwindow* nativeWindow, bool hostingImGui)
@@ -14,6 +15,10 @@ void GLFW_GL_Init::operator()(GLFWwindow* nativeWindow, bool hostingImGui)
 	if(hostingImGui){ 
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
+		// ImGui allocates with malloc by default, route it through operator new so it is charged to the UI tag
+		ImGui::SetAllocatorFunctions(
+			[](size_t size, void*) { MemoryTracker::Scope memoryScope(MemoryTag::ui); return ::operator new(size); },
+			[](void* ptr, void*) { ::operator delete(ptr); });
 		ImGui::CreateContext();
 		ImGuiIO& io = ImGui::GetIO();
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
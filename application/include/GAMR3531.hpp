@@ -2,23 +2,53 @@
 #include <DemonRenderer.hpp>
 #include "include/ui.hpp"
 #include "include/ImGui/bloomPanel.hpp"
+#include "include/ImGui/lightingPanel.hpp"
+#include "include/ImGui/benchmarkPanel.hpp"
+#include "include/ImGui/schedulerPanel.hpp"
+#include "include/ImGui/memoryPanel.hpp"
+#include "include/ImGui/gpuTimingPanel.hpp"
 #include <entt/entt.hpp>
 #include <memory>
 
 enum class GameState {intro, running, gameOver};
 
+// Everything onRenderFrame reads, taken at the sync point so the render thread never touches the scene
+struct FrameSnapshot
+{
+	RenderSnapshot render; // Visible draws of the main renderer and its camera
+	glm::vec3 viewPos{ 0.f }; // Camera position for the b_camera block
+	MaterialHandle skyboxMaterial; // Skybox material, given the camera's rotation
+	float animationTime{ 0.f }; // Time of the analytic asteroid spin
+	std::vector<PointLight> pointLights; // Copy of the main scene's point lights
+	std::vector<SpotLight> spotLights; // Copy of the main scene's spot lights
+	ParticleSystem::Emission particles; // Packed emission for the particle dispatch
+	GameState state{ GameState::intro }; // Picks the intro, HUD or game over overlay
+	float speed{ 0.f }; // Ship speed for the speed widget
+	std::vector<glm::vec3> closeTargets; // HUD targets (x,y) dist
+	std::vector<glm::vec3> closeAsteroids; // HUD asteroids (x,y) dist
+	glm::vec2 windowSize{ 0.f }; // Size of the full screen overlays, the window can only be asked on the main thread
+	bool timeLighting{ false }; // Is the lighting benchmark timing this frame
+};
+
 class AsteriodBelt : public Layer
 {
 public:
 	AsteriodBelt(GLFWWindowImpl& win);
 private:
-	void onRender() override;
+	void onExtract(uint64_t frame) override;
+	void onRenderFrame(uint64_t frame) override;
+	bool useRenderThread() const override { return m_renderThreaded && !m_lightingPanel.isBenchmarking(); } // The lighting benchmark edits the scene's lights from onRenderFrame
 	void onUpdate(float timestep) override;
+	void onFixedUpdate(float timestep) override;
+	void onInterpolate(float alpha) override;
 	void onImGUIRender() override;
 	void onKeyPressed(KeyPressedEvent& e) override;
 	void generateLevel();
-	void checkWaypointCollisions();
-	void checkAsteroidCollisions();
+	void registerSystems(); // Add the update systems to the scheduler with their access
+	void updateSensors(); // Narrow phase, moves the ship's sensors
+	void extractHUD(); // Close asteroids and targets from the sensors' outer shells
+	void checkCollisions(); // Crashes and pickups from the sensors' inner shells
+	void collectWaypoint(entt::entity waypoint);
 private:
 	UI m_ui; // Seperate user interface
 	const std::array<glm::vec4, 16> m_speedUIColours = {
@@ -40,6 +70,11 @@ private:
 		glm::vec4(0.909803921568627f, 0.f,0.f, 0.85f)
 	};
 	Renderer m_mainRenderer;	
+	ClusteredLighting m_clusteredLighting; // Bins point and spot lights for the main pass
+	std::shared_ptr<ParticleSystem> m_particles{ nullptr }; // Exhaust, waypoint debris and belt dust
+	uint32_t m_exhaustEmitter{ 0 };
+	uint32_t m_debrisEmitter{ 0 };
+	uint32_t m_dustEmitter{ 0 };
 	const std::array<float, 15> m_speedThresholds = {
 			-0.82f,
 			-1.14f,
@@ -69,6 +104,8 @@ private:
 	std::shared_ptr<Scene> m_screenScene; // Rename this!
 	// ImGui panels
 	BloomPanel m_bloomPanel = BloomPanel(m_mainRenderer);
+	LightingPanel m_lightingPanel = LightingPanel(m_mainScene, m_clusteredLighting, camera);
+	BenchmarkPanel m_benchmarkPanel;
 	std::shared_ptr<Texture> m_introTexture{ nullptr };
 	std::shared_ptr<Texture> m_gameOverTexture{ nullptr };
 	const size_t vertexComponents = (3 + 3 + 2 + 3);
@@ -86,6 +123,24 @@ private:
 	int lodNonAsteroid = 2;
 
 	BroadPhase m_broadPhase;
+	uint32_t m_shipSensor{ 0 }; // Ship's box against the asteroids, shells for a crash and for the HUD
+	uint32_t m_hitSensor{ 0 }; // Point ahead of the ship against the waypoints, shells for a pickup and for the HUD
+	std::vector<entt::entity> m_waypoints; // Waypoints indexed by order, null once collected
+	std::vector<entt::entity> m_collected; // Waypoints hit this frame
+	AnalyticAnimation m_analyticAnimation; // Asteroid rotation, evaluated on the GPU
+	SpatialSort m_spatialSort; // Morton order maintenance of the main scene's pools
+	SystemScheduler m_systems; // Update systems run as a dependency graph
+	SchedulerPanel m_schedulerPanel = SchedulerPanel(m_systems);
+	MemoryPanel m_memoryPanel; // Allocation audit and memory stats
+	GPUTimingPanel m_gpuTimingPanel; // Per pass GPU times
+	uint32_t m_lightingGPUScope{ GPUProfiler::getScope("Clustered lighting") }; // Light culling dispatch, timed outside the renderer
+	uint32_t m_particlesGPUScope{ GPUProfiler::getScope("Particles") }; // Particle simulation dispatch, timed outside the renderer
+	float m_timestep{ 0.f }; // Fixed step the systems are being run with
+	float m_alpha{ 1.f }; // How far the frame being drawn is between the last two fixed steps
+	float m_previousAnimationTime{ 0.f }; // Spin time before the last fixed step
+	uint32_t m_frameSteps{ 0 }; // Fixed steps run this frame
+	std::array<FrameSnapshot, RenderSnapshot::slots> m_frames; // Written by onExtract while the render thread draws the other
+	bool m_renderThreaded{ true }; // Draw on the render thread, false falls back to single threaded
 
 
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "DemonRenderer.hpp"
+
+/** \class BenchmarkPanel
+*	\brief CPU side system benchmarks which run in their own scenes, away from the game's registry.
+*	Each benchmark runs synchronously when its button is pressed, so the frame stalls until it completes.
+*	Results go to the log and to a CSV file in ./benchmarks/.
+*/
+class BenchmarkPanel
+{
+public:
+	void onImGuiRender();
+private:
+	void runSpinBenchmark(); //!< RotationScript path against the SpinSystem at 2k, 100k and 1M entities
+	void runRenderIterationBenchmark(); //!< Per entity cost of the renderer's registry view against packed render proxies
+	void runBroadPhaseBenchmark(); //!< Build, update and query cost of each broadphase backend on belt and uniform layouts
+	void runNarrowPhaseBenchmark(); //!< Validate the narrow phase, then time its scalar and AVX2 paths
+	void runSpatialQueryBenchmark(); //!< Radius and k nearest queries through the k-d tree against brute force loops
+	void runCommandBufferBenchmark(); //!< Populating a registry one emplace at a time against recording into a CommandBuffer
+	void runJobSystemBenchmark(); //!< Scaling of parallelFor workloads from 1 thread to every worker, and the cost of a job
+	static void showResults(const std::vector<BenchmarkResult>& results); //!< List results in the panel
+
+	std::vector<BenchmarkResult> m_spinResults;
+	std::vector<BenchmarkResult> m_renderResults;
+	std::vector<BenchmarkResult> m_broadPhaseResults;
+	std::vector<BenchmarkResult> m_narrowPhaseResults;
+	bool m_narrowPhaseValid{ false };
+	std::vector<BenchmarkResult> m_spatialQueryResults;
+	bool m_spatialQueryValid{ false };
+	std::vector<BenchmarkResult> m_commandBufferResults;
+	std::vector<BenchmarkResult> m_jobSystemResults;
+};
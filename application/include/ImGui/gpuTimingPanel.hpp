@@ -0,0 +1,17 @@
+#pragma once
+#include "DemonRenderer.hpp"
+
+/** \class GPUTimingPanel
+*	\brief GPU time of each render pass, from the GPUProfiler.
+*	Lists the last, fastest, mean and 95th percentile time of every pass over the profiler's window, and can pin the
+*	same table as a small overlay in the corner of the screen so it stays visible with the panel closed. The timings can
+*	be exported to ./benchmarks/gpu_timings.csv.
+*/
+class GPUTimingPanel
+{
+public:
+	void onImGuiRender();
+private:
+	void drawTable(const char* id, const std::vector<GPUPassTiming>& timings) const; // Table of every pass's timings
+	bool m_showOverlay{ false }; // Draw the corner overlay
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include "DemonRenderer.hpp"
+
+/** \class LightingPanel
+*	\brief Clustered lighting statistics and a light scaling benchmark.
+*	The benchmark replaces the scene's point lights with 2, 4, 8 ... 4096 random lights around the camera and times
+*	the full frame (light upload, cluster cull and all render passes) for each count. Results go to the log and
+*	./benchmarks/clustered_lighting.csv.
+*/
+class LightingPanel
+{
+public:
+	LightingPanel(std::shared_ptr<Scene>& scene, ClusteredLighting& lighting, entt::entity& camera) :
+		m_scene(scene), m_lighting(lighting), m_camera(camera) {}
+	void onImGuiRender();
+	bool isBenchmarking() const { return m_running; } //!< Is a benchmark in progress
+	void beginFrame(); //!< Call before the frame's lighting and rendering work when benchmarking
+	void endFrame(); //!< Call after the frame's rendering work when benchmarking
+private:
+	void startBenchmark();
+	void startStep();
+	void finishBenchmark();
+
+	std::shared_ptr<Scene>& m_scene;
+	ClusteredLighting& m_lighting;
+	entt::entity& m_camera;
+
+	const uint32_t m_maxLights{ 4096 }; //!< Light count of the last step
+	const uint32_t m_warmupFrames{ 30 }; //!< Frames discarded after changing the light count
+	const uint32_t m_timedFrames{ 120 }; //!< Frames timed for each light count
+	const float m_spread{ 60.f }; //!< Half size of the box lights are scattered in
+
+	bool m_running{ false };
+	uint32_t m_lightCount{ 2 };
+	uint32_t m_frame{ 0 };
+	Timer m_timer;
+	std::vector<double> m_samples;
+	std::vector<PointLight> m_savedLights; //!< Scene lights restored after the benchmark
+	std::vector<BenchmarkResult> m_results;
+};
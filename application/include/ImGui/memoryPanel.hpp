@@ -0,0 +1,18 @@
+#pragma once
+#include "DemonRenderer.hpp"
+
+/** \class MemoryPanel
+*	\brief Heap allocations per frame and host and device memory held, from the AllocationAudit, MemoryTracker and GPUMemory.
+*	Shows the last frame's totals and, with zones enabled, each audited zone's share. Arming the audit declares the
+*	steady state, from then on the armed counters should stay at zero and Report logs every allocation that was not.
+*	The tags table shows current and peak bytes per subsystem with editable budgets, and can be written to
+*	./benchmarks/memory_report.json. Device memory from GPUMemory is split by type and by owner, with its own budget
+*	and report in ./benchmarks/gpu_memory_report.json.
+*/
+class MemoryPanel
+{
+public:
+	void onImGuiRender();
+private:
+	static constexpr float megabyte{ 1024.f * 1024.f }; // Bytes shown per MB
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include "DemonRenderer.hpp"
+
+/** \class SchedulerPanel
+*	\brief Frame graph of the update systems.
+*	Draws the last frame as a timeline with a row per job system thread, critical path systems in red, and lists each
+*	system's average time and dependencies. The graph can be exported to ./benchmarks/frame_graph.dot for Graphviz.
+*/
+class SchedulerPanel
+{
+public:
+	explicit SchedulerPanel(SystemScheduler& scheduler) : m_scheduler(scheduler) {}
+	void onImGuiRender();
+private:
+	SystemScheduler& m_scheduler;
+};
@@ -2,7 +2,7 @@
 
 #include "DemonRenderer.hpp"
 
-class CameraScript : public Script
+class CameraScript final : public Script
 {
 public:
 	CameraScript(entt::entity& entity, std::shared_ptr<Scene> scene, GLFWWindowImpl& win, const glm::vec3& movementSpeed, float turnSpeed) :
@@ -3,9 +3,9 @@
 #include <glm/glm.hpp>
 #include "core/log.hpp"
 #include "components/script.hpp"
-#include "components/transform.hpp"
+#include "core/transformSystem.hpp"
 
-class ControllerScript : public Script
+class ControllerScript final : public Script
 {
 public:
 	ControllerScript(entt::entity entity, std::shared_ptr<Scene> scene, GLFWWindowImpl& win, entt::entity& followCamera, const glm::vec3& movementSpeed, const glm::vec3& offset, float* speed) :
@@ -2,9 +2,9 @@
 
 #include <GLFW/glfw3.h>
 #include "components/script.hpp"
-#include "components/transform.hpp"
+#include "core/transformSystem.hpp"
 
-class RotationScript : public Script
+class RotationScript final : public Script
 {
 public:
 	//Added entity and scene to the constructor input parameters instead of actor.
@@ -16,6 +16,7 @@ public:
 	virtual void onUpdate(float timestep) override;
 	virtual void onKeyPress(KeyPressedEvent& e) override;
 	virtual void onKeyRelease(KeyReleasedEvent& e) override {};
+	static constexpr bool threadSafe = true; //!< Only touches its own entity's transform
 private:
 	glm::vec3 m_rotSpeed{0.f, 0.f, 0.f };
 	uint32_t m_pauseKey{ GLFW_KEY_P };
@@ -5,9 +5,10 @@ void CameraScript::onUpdate(float timestep)
 {
 	bool recalc = false;
 
-	auto& transformComp = m_registry.get<Transform>(m_entity);
-	glm::vec3 forward = { -transformComp.transform[2][0], -transformComp.transform[2][1], -transformComp.transform[2][2] };
-	glm::vec3 right = { transformComp.transform[0][0], transformComp.transform[0][1], transformComp.transform[0][2] };
+	auto& transformComp = m_registry.get<LocalTRS>(m_entity);
+	auto& worldComp = m_registry.get<WorldMatrix>(m_entity);
+	glm::vec3 forward = -worldComp.getAxis(2);
+	glm::vec3 right = worldComp.getAxis(0);
 
 	if (m_winRef.doIsKeyPressed(GLFW_KEY_W)) { transformComp.translation += forward * m_movementSpeed.z * timestep; recalc = true; }
 	if (m_winRef.doIsKeyPressed(GLFW_KEY_A)) { transformComp.translation -= right * m_movementSpeed.x * timestep; recalc = true; }
@@ -31,5 +32,5 @@ void CameraScript::onUpdate(float timestep)
 		recalc = true;
 	}
 
-	if (recalc) transformComp.recalc();
+	if (recalc) TransformSystem::markDirty(m_registry, m_entity);
 }
\ No newline at end of file
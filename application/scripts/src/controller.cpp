@@ -3,9 +3,10 @@
 void ControllerScript::onUpdate(float timestep)
 {
 	
-		auto& transformComp = m_registry.get<Transform>(m_entity);
+		auto& transformComp = m_registry.get<LocalTRS>(m_entity);
+		auto& worldComp = m_registry.get<WorldMatrix>(m_entity);
 
-		glm::vec3 forward = { -transformComp.transform[2][0], -transformComp.transform[2][1], -transformComp.transform[2][2] };
+		glm::vec3 forward = -worldComp.getAxis(2);
 
 		transformComp.translation += forward * m_movementSpeed.z * timestep;
 
@@ -31,7 +32,7 @@ void ControllerScript::onUpdate(float timestep)
 			transformComp.rotation *= delta;
 		}
 
-		transformComp.recalc();
+		TransformSystem::compose(transformComp, worldComp); // The follow camera needs this frame's axes
 
 		if (m_winRef.isKeyPressed(GLFW_KEY_UP)) {
 			m_movementSpeed.z = std::clamp(m_movementSpeed.z - timestep, m_maxSpeed, m_minSpeed);
@@ -43,12 +44,12 @@ void ControllerScript::onUpdate(float timestep)
 			*m_speedOut = m_movementSpeed.z;
 		}
 
-		auto& followTransformComp = m_registry.get<Transform>(m_followCamera);
+		auto& followTransformComp = m_registry.get<LocalTRS>(m_followCamera);
 
 		// Follow
-		glm::vec3 targetRight = { transformComp.transform[0][0], transformComp.transform[0][1], transformComp.transform[0][2] };
-		glm::vec3 targetUp = { transformComp.transform[1][0], transformComp.transform[1][1], transformComp.transform[1][2] };
-		glm::vec3 targetForward = { -transformComp.transform[2][0], -transformComp.transform[2][1], -transformComp.transform[2][2] };
+		glm::vec3 targetRight = worldComp.getAxis(0);
+		glm::vec3 targetUp = worldComp.getAxis(1);
+		glm::vec3 targetForward = -worldComp.getAxis(2);
 
 		followTransformComp.translation = transformComp.translation;
 
@@ -58,7 +59,7 @@ void ControllerScript::onUpdate(float timestep)
 
 		followTransformComp.rotation = transformComp.rotation * glm::quat(glm::vec3(0.f, glm::pi<float>(), 0.f)); // Hack as model is backward to start with
 
-		followTransformComp.recalc(); 
+		TransformSystem::markDirty(m_registry, m_followCamera);
 	
 }
 
@@ -3,9 +3,10 @@
 void RotationScript::onUpdate(float timestep)
 {
 	if (!m_paused) {
-		auto& transformComp = m_registry.get<Transform>(m_entity);
+		auto& transformComp = m_registry.get<LocalTRS>(m_entity);
 		transformComp.rotation *= glm::quat(m_rotSpeed * timestep);
-		transformComp.recalc();
+		// Composed here rather than tagged dirty, adding a tag would not be safe from the ScriptSystem's worker threads
+		TransformSystem::compose(transformComp, m_registry.get<WorldMatrix>(m_entity));
 	}
 }
 
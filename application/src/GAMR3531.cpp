@@ -16,20 +16,31 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 	TracyGpuZone("Main");
 
 	m_closeAsteroids.reserve(20);
+	m_closeTargets.reserve(20);
+
+	// An unattended allocation audit measures gameplay, so skip the intro screen
+	if (AllocationAudit::isRunConfigured()) m_state = GameState::running;
 
 	m_mainScene.reset(new Scene);
 
-	generateLevel();
+	{
+		GPUMemory::Owner gpuOwner("Level");
+		generateLevel();
+	}
 
 	m_broadPhase.init(m_mainScene); // Call the broad phase init function to setup the AABBs
+	m_shipSensor = m_broadPhase.addSensor(ProximityTarget::spheres, { 0.f, 25.f }); // Crash, HUD
+	m_hitSensor = m_broadPhase.addSensor(ProximityTarget::boxes, { 0.75f, 35.f }); // Pickup, HUD
 
 	/*************************
 	*  Main Render Pass
 	**************************/
+	GPUMemory::Owner mainPassOwner("Main pass"); // Owners nest, each section below charges its GL resources to its own name
 
 	RenderPass mainPass;
+	mainPass.name = "Main";
 	FBOLayout typicalLayout = {
-		{AttachmentType::ColourHDR, true},
+		{AttachmentType::ColourPackedHDR, true},
 		{AttachmentType::Depth, false}
 	};
 
@@ -39,21 +50,59 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 	mainPass.camera.projection = glm::perspective(45.f, m_winRef.getWidthf() / m_winRef.getHeightf(), 0.1f, 2000.f);
 	mainPass.viewPort = { 0, 0, m_winRef.getWidth(), m_winRef.getHeight() };
 
-	mainPass.camera.updateView(m_mainScene->m_entities.get<Transform>(camera).transform);
+	mainPass.camera.updateView(m_mainScene->m_entities.get<WorldMatrix>(camera).toMat4());
 
 	mainPass.UBOmanager.setCachedValue("b_camera", "u_view", mainPass.camera.view);
 	mainPass.UBOmanager.setCachedValue("b_camera", "u_projection", mainPass.camera.projection);
-	mainPass.UBOmanager.setCachedValue("b_camera", "u_viewPos", m_mainScene->m_entities.get<Transform>(camera).translation);
+	mainPass.UBOmanager.setCachedValue("b_camera", "u_viewPos", m_mainScene->m_entities.get<WorldMatrix>(camera).getTranslation());
 
 	mainPass.UBOmanager.setCachedValue("b_lights", "dLight.colour", m_mainScene->m_directionalLights.at(0).colour);
 	mainPass.UBOmanager.setCachedValue("b_lights", "dLight.direction", m_mainScene->m_directionalLights.at(0).direction);
 
+	// Point and spot lights are binned into clusters of the main camera's frustum
+	m_clusteredLighting.init(mainPass.camera, m_winRef.getSize(), 0.1f, 2000.f);
+	m_clusteredLighting.setClusterUniforms(mainPass.UBOmanager);
+
+	// GPU particles, scaled down when running on a software rasteriser
+	m_particles = std::make_shared<ParticleSystem>(ParticleSystem::getDefaultCapacity());
+	float particleScale = static_cast<float>(m_particles->getCapacity());
+
+	ParticleEmitter exhaust;
+	exhaust.positionSpread = 0.05f;
+	exhaust.velocitySpread = 0.5f;
+	exhaust.colour = glm::vec4(1.5f, 0.6f, 0.2f, 1.f);
+	exhaust.lifetime = { 0.2f, 0.5f };
+	exhaust.size = { 0.06f, 0.01f };
+	exhaust.rate = particleScale / 64.f;
+	m_exhaustEmitter = m_particles->addEmitter(exhaust);
+
+	ParticleEmitter debris;
+	debris.velocitySpread = 6.f;
+	debris.colour = glm::vec4(2.9f, 1.f, 3.5f, 1.f);
+	debris.lifetime = { 1.f, 2.5f };
+	debris.size = { 0.08f, 0.f };
+	debris.drag = 0.8f;
+	debris.enabled = false; // Bursts only
+	m_debrisEmitter = m_particles->addEmitter(debris);
+
+	ParticleEmitter dust;
+	dust.positionSpread = 60.f;
+	dust.velocitySpread = 0.2f;
+	dust.colour = glm::vec4(0.6f, 0.55f, 0.5f, 0.15f);
+	dust.lifetime = { 6.f, 8.f };
+	dust.size = { 0.03f, 0.03f };
+	dust.rate = particleScale / 8.f; // Roughly 90% of the pool alive at steady state
+	m_dustEmitter = m_particles->addEmitter(dust);
+
+	mainPass.particleSystems.push_back(m_particles);
+
 
 	m_mainRenderer.addRenderPass(mainPass);
 
 	/*************************
 	*  Bloom
 	**************************/
+	GPUMemory::Owner bloomOwner("Bloom");
 
 	// General setup
 
@@ -66,12 +115,13 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 	};
 
 	FBOLayout screenLayout = {
-		{AttachmentType::ColourHDR, true}
+		{AttachmentType::ColourPackedHDR, true}
 	};
 
 	// Bloom Threshold pass
 	auto thresholdPassIdx = m_mainRenderer.getRenderPassCount();
 	RenderPass thresholdPass;
+	thresholdPass.name = "Threshold";
 
 	ShaderDescription thresholdShaderDesc;
 	thresholdShaderDesc.type = ShaderType::rasterization;
@@ -101,6 +151,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 	std::shared_ptr<VAO> screenVAO = std::make_shared<VAO>(screenIndices);
 	screenVAO->addVertexBuffer(screenVertices, screenQuadLayout);
+	VAOHandle screenVAOHandle = ResourceRegistry::add(screenVAO);
 
 
 	// Scoped quad so that it is limited and can't be used outside of the curly braces.
@@ -111,10 +162,10 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 		//Add a render component and keep a reference to it in this scope.
 		auto& renderComp = thresholdScene->m_entities.emplace<Render>(quad);
 		// Set the geometry and material.
-		renderComp.geometry = screenVAO;
-		renderComp.material = thresholdMaterial;
+		renderComp.geometry = screenVAOHandle;
+		renderComp.material = ResourceRegistry::add(thresholdMaterial);
 		//Add the transform component.
-		thresholdScene->m_entities.emplace<Transform>(quad);
+		TransformSystem::emplace(thresholdScene->m_entities, quad);
 
 		auto& lodComp = thresholdScene->m_entities.emplace<LODAssign>(quad);
 		lodComp.lodNumber = lodNonAsteroid;
@@ -139,6 +190,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 	// VAOs for each set of vertices
 	std::array<std::shared_ptr<VAO>, downScalePasses> screenVAOs;
+	std::array<VAOHandle, downScalePasses> screenVAOHandles;
 
 	// Projection matrices, ortho
 	std::array<glm::mat4, downScalePasses> screenProjs;
@@ -172,6 +224,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 		screenVAOs[i] = std::make_shared<VAO>(screenIndices);
 		screenVAOs[i]->addVertexBuffer(screenVertices, screenQuadLayout);
+		screenVAOHandles[i] = ResourceRegistry::add(screenVAOs[i]);
 
 		screenProjs[i] = glm::ortho(0.f, w, h, 0.f);
 		screenViewports[i] = { 0, 0, w_i, h_i };
@@ -205,6 +258,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 	for (size_t i = 0; i < downScalePasses; i++) {
 		RenderPass downBlurPass;
+		downBlurPass.name = "Down blur " + std::to_string(i);
 
 		downBlurPass.camera.projection = screenProjs[i];
 		downBlurMaterials[i] = std::make_shared<Material>(downBlurShader, "");
@@ -221,14 +275,14 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 		auto& renderComp = m_bloomScenes.back()->m_entities.emplace<Render>(quad);
 
-		renderComp.geometry = screenVAOs[i];
-		renderComp.material = downBlurMaterial;
+		renderComp.geometry = screenVAOHandles[i];
+		renderComp.material = ResourceRegistry::add(downBlurMaterial);
 
 		
 		auto& lodComp = m_bloomScenes.back()->m_entities.emplace<LODAssign>(quad);
 		lodComp.lodNumber = lodNonAsteroid;
 
-		m_bloomScenes.back()->m_entities.emplace<Transform>(quad);
+		TransformSystem::emplace(m_bloomScenes.back()->m_entities, quad);
 
 		downBlurPass.scene = m_bloomScenes.back();
 		downBlurPass.parseScene();
@@ -253,6 +307,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 	for (size_t i = 0; i < upScalePasses; i++) {
 		RenderPass upFilterPass;
+		upFilterPass.name = "Up filter " + std::to_string(i);
 
 		size_t toAddToIdx = downScalePasses - 2 - i; // Index of to add to data, initially data from the penultimate down scale pass, think of this as current target
 		size_t toFilterToIdx = downScalePasses - 1 - i; // Index of to add to filter, initially data from the final scale pass, think of this as prevoius pass data to be filtered in
@@ -278,14 +333,14 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 		auto& renderComp = m_bloomScenes.back()->m_entities.emplace<Render>(quad);
 
-		renderComp.geometry = screenVAOs[toAddToIdx];
-		renderComp.material = upFilterMaterial;
+		renderComp.geometry = screenVAOHandles[toAddToIdx];
+		renderComp.material = ResourceRegistry::add(upFilterMaterial);
 
 		
 		auto& lodComp = m_bloomScenes.back()->m_entities.emplace<LODAssign>(quad);
 		lodComp.lodNumber = lodNonAsteroid;
 
-		m_bloomScenes.back()->m_entities.emplace<Transform>(quad);
+		TransformSystem::emplace(m_bloomScenes.back()->m_entities, quad);
 
 		upFilterPass.clearColour = false;
 		upFilterPass.clearDepth = false;
@@ -301,6 +356,7 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 	/*************************
 	*  Screen Pass
 	**************************/
+	GPUMemory::Owner screenPassOwner("Screen pass");
 
 	ShaderDescription screenShaderDesc;
 	screenShaderDesc.type = ShaderType::rasterization;
@@ -323,18 +379,19 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 
 		auto& renderComp = m_screenScene->m_entities.emplace<Render>(quad);
 
-		renderComp.geometry = screenVAO;
-		renderComp.material = screenQuadMaterial;
+		renderComp.geometry = screenVAOHandle;
+		renderComp.material = ResourceRegistry::add(screenQuadMaterial);
 
 		
 		auto& lodComp = m_screenScene->m_entities.emplace<LODAssign>(quad);
 		lodComp.lodNumber = lodNonAsteroid;
 
-		m_screenScene->m_entities.emplace<Transform>(quad);
+		TransformSystem::emplace(m_screenScene->m_entities, quad);
 
 	}
 
 	RenderPass screenPass;
+	screenPass.name = "Composition";
 	screenPass.scene = m_screenScene;
 	screenPass.parseScene();
 	screenPass.target = std::make_shared<FBO>(); // Default FBO
@@ -346,94 +403,147 @@ AsteriodBelt::AsteriodBelt(GLFWWindowImpl& win) : Layer(win)
 	m_mainRenderer.addRenderPass(screenPass);
 
 	// UI
+	GPUMemory::Owner uiOwner("UI");
 	m_ui.init(m_winRef.getSize());
 	m_introTexture.reset(new Texture("./assets/textures/UI/intro.png"));
 	m_gameOverTexture.reset(new Texture("./assets/textures/UI/gameOver.png"));
 
+	registerSystems();
 }
 
-void AsteriodBelt::onRender()
+void AsteriodBelt::onExtract(uint64_t frame)
 {
-	ZoneScopedN("OnRender");
+	ZoneAuditedN("OnExtract");
+	auto& snapshot = m_frames[RenderSnapshot::slot(frame)];
+
+	// Draw between the last two fixed steps, the camera is blended the same way as the ship it follows
+	auto& registry = m_mainScene->m_entities;
+	WorldMatrix cameraTransform;
+	TransformSystem::interpolate(registry.get<PreviousTRS>(camera).local, registry.get<LocalTRS>(camera), m_alpha, cameraTransform);
+	m_mainRenderer.getRenderPass(0).camera.updateView(cameraTransform.toMat4());
+
+	m_mainRenderer.extract(snapshot.render, m_alpha);
+	snapshot.viewPos = cameraTransform.getTranslation();
+	snapshot.skyboxMaterial = registry.get<Render>(skyBox).material;
+	snapshot.animationTime = glm::mix(m_previousAnimationTime, m_analyticAnimation.getTime(), m_alpha);
+	snapshot.pointLights = m_mainScene->m_pointLights;
+	snapshot.spotLights = m_mainScene->m_spotLights;
+	m_particles->extract(snapshot.particles);
+
+	snapshot.state = m_state;
+	snapshot.speed = speed;
+	snapshot.closeTargets = m_closeTargets;
+	snapshot.closeAsteroids = m_closeAsteroids;
+	snapshot.windowSize = m_winRef.getSizef();
+	snapshot.timeLighting = m_lightingPanel.isBenchmarking();
+}
+
+void AsteriodBelt::onRenderFrame(uint64_t frame)
+{
+	ZoneAuditedN("OnRender");
+	const auto& snapshot = m_frames[RenderSnapshot::slot(frame)];
+
+	// The benchmark steps the scene's lights between frames, so it only times single threaded ones
+	const bool timeLighting = snapshot.timeLighting && !RenderThread::isRenderThread();
+	if (timeLighting) m_lightingPanel.beginFrame();
+
+	// Camera values go into the UBO here so they match the snapshot being drawn
+	auto& mainPass = m_mainRenderer.getRenderPass(0);
+	const Camera& mainCamera = snapshot.render.camera;
+	mainPass.UBOmanager.setCachedValue("b_camera", "u_view", mainCamera.view);
+	mainPass.UBOmanager.setCachedValue("b_camera", "u_viewPos", snapshot.viewPos);
+	ResourceRegistry::get(snapshot.skyboxMaterial)->setValue("u_skyboxView", glm::mat4(glm::mat3(mainCamera.view)));
+	m_analyticAnimation.bind(snapshot.animationTime);
+
+	m_clusteredLighting.onUpdate(snapshot.pointLights, snapshot.spotLights);
+	{
+		GPUProfiler::Scope gpuScope(m_lightingGPUScope);
+		m_clusteredLighting.dispatch(mainCamera);
+	}
+	{
+		GPUProfiler::Scope gpuScope(m_particlesGPUScope);
+		m_particles->dispatch(snapshot.particles);
+	}
+	m_mainRenderer.render(snapshot.render);
+
+	if (timeLighting) m_lightingPanel.endFrame();
 
-	m_mainRenderer.render();
-	
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	// Draw UI
 	m_ui.begin();
 	{
 		ZoneScopedN("UIBegin");
-		if (m_state == GameState::intro) m_ui.drawTexturedQuad({ 0.f, 0.f }, m_winRef.getSizef(), m_introTexture);
+		if (snapshot.state == GameState::intro) m_ui.drawTexturedQuad({ 0.f, 0.f }, snapshot.windowSize, m_introTexture);
 	}
-	if (m_state == GameState::gameOver) m_ui.drawTexturedQuad({ 0.f, 0.f }, m_winRef.getSizef(), m_gameOverTexture);
+	if (snapshot.state == GameState::gameOver) m_ui.drawTexturedQuad({ 0.f, 0.f }, snapshot.windowSize, m_gameOverTexture);
 
-	if (m_state == GameState::running) {
+	if (snapshot.state == GameState::running) {
 		// Speed widget
 
 		glm::vec4 noColor(0.58, 0.573, 0.678, 0.60);
 		// Quads
 		m_ui.drawQuad({ 1015.23429376605f, 677.060052230405f }, { 15.f, 50.9399477695946f }, m_speedUIColours[0]);
-		m_ui.drawQuad({ 1036.10357597866f, 676.183738511636f }, { 15.f, 51.8162614883643f }, speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor);
-		m_ui.drawQuad({ 1056.97285819127f, 675.142292174748f }, { 15.f, 52.8577078252518f }, speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor);
+		m_ui.drawQuad({ 1036.10357597866f, 676.183738511636f }, { 15.f, 51.8162614883643f }, snapshot.speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor);
+		m_ui.drawQuad({ 1056.97285819127f, 675.142292174748f }, { 15.f, 52.8577078252518f }, snapshot.speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor);
 		{
 			ZoneScopedN("FourthQuadDraw");
-			m_ui.drawQuad({ 1077.84214040388f, 673.934247237929f }, { 15.f, 54.065752762071f }, speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor);
+			m_ui.drawQuad({ 1077.84214040388f, 673.934247237929f }, { 15.f, 54.065752762071f }, snapshot.speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor);
 		}
-		m_ui.drawQuad({ 1098.71142261648f, 672.557881377036f }, { 15.f, 55.4421186229637f }, speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor);
-		m_ui.drawQuad({ 1119.58070482909f, 671.011203218924f }, { 15.f, 56.9887967810764f }, speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor);
-		m_ui.drawQuad({ 1140.4499870417f,  669.291937293714f }, { 15.f, 58.7080627062856f }, speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor);
-		m_ui.drawQuad({ 1161.31926925431f, 667.397506369484f }, { 15.f, 60.602493630516f }, speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor);
-		m_ui.drawQuad({ 1182.18855146691f, 665.325010832928f }, { 15.f, 62.6749891670719f }, speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor);
-		m_ui.drawQuad({ 1203.05783367952f, 663.071204707666f }, { 15.f, 64.9287952923339f }, speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor);
-		m_ui.drawQuad({ 1223.92711589213f, 660.632467814566f }, { 15.f, 67.3675321854339f }, speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor);
-		m_ui.drawQuad({ 1244.79639810473f, 658.004773471693f }, { 15.f, 69.9952265283073f }, speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor);
-		m_ui.drawQuad({ 1265.66568031734f, 655.183650999685f }, { 15.f, 72.8163490003149f }, speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor);
-		m_ui.drawQuad({ 1286.53496252995f, 652.164142134382f }, { 15.f, 75.8358578656179f }, speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor);
-		m_ui.drawQuad({ 1307.40424474256f, 648.940750242794f }, { 15.f, 79.0592497572063f }, speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor);
-		m_ui.drawQuad({ 1328.27352695516f, 645.50738097831f }, { 15.f, 82.4926190216903f }, speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor);
+		m_ui.drawQuad({ 1098.71142261648f, 672.557881377036f }, { 15.f, 55.4421186229637f }, snapshot.speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor);
+		m_ui.drawQuad({ 1119.58070482909f, 671.011203218924f }, { 15.f, 56.9887967810764f }, snapshot.speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor);
+		m_ui.drawQuad({ 1140.4499870417f,  669.291937293714f }, { 15.f, 58.7080627062856f }, snapshot.speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor);
+		m_ui.drawQuad({ 1161.31926925431f, 667.397506369484f }, { 15.f, 60.602493630516f }, snapshot.speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor);
+		m_ui.drawQuad({ 1182.18855146691f, 665.325010832928f }, { 15.f, 62.6749891670719f }, snapshot.speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor);
+		m_ui.drawQuad({ 1203.05783367952f, 663.071204707666f }, { 15.f, 64.9287952923339f }, snapshot.speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor);
+		m_ui.drawQuad({ 1223.92711589213f, 660.632467814566f }, { 15.f, 67.3675321854339f }, snapshot.speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor);
+		m_ui.drawQuad({ 1244.79639810473f, 658.004773471693f }, { 15.f, 69.9952265283073f }, snapshot.speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor);
+		m_ui.drawQuad({ 1265.66568031734f, 655.183650999685f }, { 15.f, 72.8163490003149f }, snapshot.speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor);
+		m_ui.drawQuad({ 1286.53496252995f, 652.164142134382f }, { 15.f, 75.8358578656179f }, snapshot.speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor);
+		m_ui.drawQuad({ 1307.40424474256f, 648.940750242794f }, { 15.f, 79.0592497572063f }, snapshot.speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor);
+		m_ui.drawQuad({ 1328.27352695516f, 645.50738097831f }, { 15.f, 82.4926190216903f }, snapshot.speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor);
 
 		// Bottom Circles														
 		m_ui.drawCircle({ 1022.73429376605f, 728.f }, { 7.5f }, m_speedUIColours[0], 1.f);
-		m_ui.drawCircle({ 1043.60357597866f, 728.f }, { 7.5f }, speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor, 1.f);
-		m_ui.drawCircle({ 1064.47285819127f, 728.f }, { 7.5f }, speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor, 1.f);
-		m_ui.drawCircle({ 1085.34214040388f, 728.f }, { 7.5f }, speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor, 1.f);
-		m_ui.drawCircle({ 1106.21142261648f, 728.f }, { 7.5f }, speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor, 1.f);
-		m_ui.drawCircle({ 1127.08070482909f, 728.f }, { 7.5f }, speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor, 1.f);
-		m_ui.drawCircle({ 1147.9499870417f, 728.f }, { 7.5f }, speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor, 1.f);
-		m_ui.drawCircle({ 1168.81926925431f, 728.f }, { 7.5f }, speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor, 1.f);
-		m_ui.drawCircle({ 1189.68855146691f, 728.f }, { 7.5f }, speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor, 1.f);
+		m_ui.drawCircle({ 1043.60357597866f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor, 1.f);
+		m_ui.drawCircle({ 1064.47285819127f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor, 1.f);
+		m_ui.drawCircle({ 1085.34214040388f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor, 1.f);
+		m_ui.drawCircle({ 1106.21142261648f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor, 1.f);
+		m_ui.drawCircle({ 1127.08070482909f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor, 1.f);
+		m_ui.drawCircle({ 1147.9499870417f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor, 1.f);
+		m_ui.drawCircle({ 1168.81926925431f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor, 1.f);
+		m_ui.drawCircle({ 1189.68855146691f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor, 1.f);
 		{
 			ZoneScopedN("TenthBottomCircleDraw");
-			m_ui.drawCircle({ 1210.55783367952f, 728.f }, { 7.5f }, speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor, 1.f);
+			m_ui.drawCircle({ 1210.55783367952f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor, 1.f);
 		}
-		m_ui.drawCircle({ 1231.42711589213f, 728.f }, { 7.5f }, speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor, 1.f);
-		m_ui.drawCircle({ 1252.29639810473f, 728.f }, { 7.5f }, speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor, 1.f);
-		m_ui.drawCircle({ 1273.16568031734f, 728.f }, { 7.5f }, speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor, 1.f);
-		m_ui.drawCircle({ 1294.03496252995f, 728.f }, { 7.5f }, speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor, 1.f);
-		m_ui.drawCircle({ 1314.90424474256f, 728.f }, { 7.5f }, speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor, 1.f);
-		m_ui.drawCircle({ 1335.77352695516f, 728.f }, { 7.5f }, speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor, 1.f);
+		m_ui.drawCircle({ 1231.42711589213f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor, 1.f);
+		m_ui.drawCircle({ 1252.29639810473f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor, 1.f);
+		m_ui.drawCircle({ 1273.16568031734f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor, 1.f);
+		m_ui.drawCircle({ 1294.03496252995f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor, 1.f);
+		m_ui.drawCircle({ 1314.90424474256f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor, 1.f);
+		m_ui.drawCircle({ 1335.77352695516f, 728.f }, { 7.5f }, snapshot.speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor, 1.f);
 
 		// Top circles
 		m_ui.drawCircle({ 1022.73429376605f, 677.060052230405f }, { 7.5f }, m_speedUIColours[0], 1.f);
-		m_ui.drawCircle({ 1043.60357597866f, 676.183738511636f }, { 7.5f }, speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor, 1.f);
-		m_ui.drawCircle({ 1064.47285819127f, 675.142292174748f }, { 7.5f }, speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor, 1.f);
-		m_ui.drawCircle({ 1085.34214040388f, 673.934247237929f }, { 7.5f }, speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor, 1.f);
-		m_ui.drawCircle({ 1106.21142261648f, 672.557881377036f }, { 7.5f }, speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor, 1.f);
-		m_ui.drawCircle({ 1127.08070482909f, 671.011203218924f }, { 7.5f }, speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor, 1.f);
+		m_ui.drawCircle({ 1043.60357597866f, 676.183738511636f }, { 7.5f }, snapshot.speed < m_speedThresholds[0] ? m_speedUIColours[1] : noColor, 1.f);
+		m_ui.drawCircle({ 1064.47285819127f, 675.142292174748f }, { 7.5f }, snapshot.speed < m_speedThresholds[1] ? m_speedUIColours[2] : noColor, 1.f);
+		m_ui.drawCircle({ 1085.34214040388f, 673.934247237929f }, { 7.5f }, snapshot.speed < m_speedThresholds[2] ? m_speedUIColours[3] : noColor, 1.f);
+		m_ui.drawCircle({ 1106.21142261648f, 672.557881377036f }, { 7.5f }, snapshot.speed < m_speedThresholds[3] ? m_speedUIColours[4] : noColor, 1.f);
+		m_ui.drawCircle({ 1127.08070482909f, 671.011203218924f }, { 7.5f }, snapshot.speed < m_speedThresholds[4] ? m_speedUIColours[5] : noColor, 1.f);
 		{
 			ZoneScopedN("SeventhTopCircleDraw");
-			m_ui.drawCircle({ 1147.9499870417f,  669.291937293714f }, { 7.5f }, speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor, 1.f);
+			m_ui.drawCircle({ 1147.9499870417f,  669.291937293714f }, { 7.5f }, snapshot.speed < m_speedThresholds[5] ? m_speedUIColours[6] : noColor, 1.f);
 		}
-		m_ui.drawCircle({ 1168.81926925431f, 667.397506369484f }, { 7.5f }, speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor, 1.f);
-		m_ui.drawCircle({ 1189.68855146691f, 665.325010832928f }, { 7.5f }, speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor, 1.f);
-		m_ui.drawCircle({ 1210.55783367952f, 663.071204707666f }, { 7.5f }, speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor, 1.f);
-		m_ui.drawCircle({ 1231.42711589213f, 660.632467814566f }, { 7.5f }, speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor, 1.f);
-		m_ui.drawCircle({ 1252.29639810473f, 658.004773471693f }, { 7.5f }, speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor, 1.f);
-		m_ui.drawCircle({ 1273.16568031734f, 655.183650999685f }, { 7.5f }, speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor, 1.f);
-		m_ui.drawCircle({ 1294.03496252995f, 652.164142134382f }, { 7.5f }, speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor, 1.f);
-		m_ui.drawCircle({ 1314.90424474256f, 648.940750242794f }, { 7.5f }, speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor, 1.f);
-		m_ui.drawCircle({ 1335.77352695516f, 645.50738097831f }, { 7.5f }, speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor, 1.f);
+		m_ui.drawCircle({ 1168.81926925431f, 667.397506369484f }, { 7.5f }, snapshot.speed < m_speedThresholds[6] ? m_speedUIColours[7] : noColor, 1.f);
+		m_ui.drawCircle({ 1189.68855146691f, 665.325010832928f }, { 7.5f }, snapshot.speed < m_speedThresholds[7] ? m_speedUIColours[8] : noColor, 1.f);
+		m_ui.drawCircle({ 1210.55783367952f, 663.071204707666f }, { 7.5f }, snapshot.speed < m_speedThresholds[8] ? m_speedUIColours[9] : noColor, 1.f);
+		m_ui.drawCircle({ 1231.42711589213f, 660.632467814566f }, { 7.5f }, snapshot.speed < m_speedThresholds[9] ? m_speedUIColours[10] : noColor, 1.f);
+		m_ui.drawCircle({ 1252.29639810473f, 658.004773471693f }, { 7.5f }, snapshot.speed < m_speedThresholds[10] ? m_speedUIColours[11] : noColor, 1.f);
+		m_ui.drawCircle({ 1273.16568031734f, 655.183650999685f }, { 7.5f }, snapshot.speed < m_speedThresholds[11] ? m_speedUIColours[12] : noColor, 1.f);
+		m_ui.drawCircle({ 1294.03496252995f, 652.164142134382f }, { 7.5f }, snapshot.speed < m_speedThresholds[12] ? m_speedUIColours[13] : noColor, 1.f);
+		m_ui.drawCircle({ 1314.90424474256f, 648.940750242794f }, { 7.5f }, snapshot.speed < m_speedThresholds[13] ? m_speedUIColours[14] : noColor, 1.f);
+		m_ui.drawCircle({ 1335.77352695516f, 645.50738097831f }, { 7.5f }, snapshot.speed < m_speedThresholds[14] ? m_speedUIColours[15] : noColor, 1.f);
 
 
 		// Target circles
@@ -448,7 +558,7 @@ void AsteriodBelt::onRender()
 		// Close Ship Circles 
 		{
 			ZoneScopedN("CloseShipCircles");
-			for (auto& circle : m_closeAsteroids) {
+			for (auto& circle : snapshot.closeAsteroids) {
 				float radius = 7.5f + circle.z / 2.5f;
 				m_ui.drawCircle({ 184.f + circle.x * 5.0f, 618.f + circle.y * 5.f }, { radius }, { targetCircleColour.x, targetCircleColour.y, targetCircleColour.z, circle.z / 50.f + 0.25f }, 0.2f);
 			}
@@ -456,7 +566,7 @@ void AsteriodBelt::onRender()
 		// Close Target quads
 		{
 			ZoneScopedN("CloseTargetQuads");
-			for (auto& quad : m_closeTargets) {
+			for (auto& quad : snapshot.closeTargets) {
 				float size = 10.f + quad.z / 3.5f;
 				m_ui.drawQuad({ 184.f + quad.x * 5.0f - size / 2.f, 618.f + quad.y * 5.f - size / 2.f }, { size, size }, { 0.463f, 0.031f, 0.769f, quad.z / 35.f });
 			}
@@ -471,89 +581,192 @@ void AsteriodBelt::onRender()
 
 void AsteriodBelt::onUpdate(float timestep)
 {
-	ZoneScopedN("OnUpdate");
-	if (m_state == GameState::running)
-	{
-		timestep = std::clamp(timestep, 0.f, 0.1f);
-
-		auto view = m_mainScene->m_entities.view<ScriptComp>();
-		for (auto entity : view)
-		{
-
-			auto& script = view.get<ScriptComp>(entity);
-			script.onUpdate(timestep);
-
-		}
-
-		m_broadPhase.onUpdate(timestep); // Update broadphase based on the value of timestep
-
-		//Check for and action collisions
-		m_closeAsteroids.clear();
-		m_closeTargets.clear();
-		checkWaypointCollisions();
-		checkAsteroidCollisions();
-
-		//Using camera position and the position of each asteroid, I iterate through a for loop of entities,
-		// which check the distance between the camera and each asteroid's position. It assigns a size_t
-		// value to lodLevel from 0 to 2 and then uses the component script for lodassign to assign the index
-		// which is used in the renderer class, to use the correct LOD data. For example, lodLevel being 2 means
-		// it has the least indices and 0 has the most, but it is closer and can use more detail.
-		auto& cameraTransform = m_mainScene->m_entities.get<Transform>(camera);
-		
-		glm::vec3 cameraPos = cameraTransform.translation;
-		
-		//For distance calculation for asteroid/LODIndex value changing.
-		
-		auto asteroidView = m_mainScene->m_entities.view<Transform, Render, LODAssign>();
-		for (auto entity : asteroidView)
-		{
-			auto& asteroidTransform = m_mainScene->m_entities.get<Transform>(entity);
-			glm::vec3 asteroidPos = asteroidTransform.translation;
-
-			float distance = glm::distance(cameraPos, asteroidPos);
-
-			if (distance <= 25.0f) lodLevel = 0;
-			else if (distance <= 100.0f) lodLevel = 1;
-			else lodLevel = 2;
+	ZoneAuditedN("OnUpdate");
+	m_frameSteps = 0;
+	// Particles are simulated on the GPU once per drawn frame, so they advance with the frame's time
+	if (m_state == GameState::running) m_particles->onUpdate(std::clamp(timestep, 0.f, 0.1f));
+}
 
-			auto& lodComp = m_mainScene->m_entities.get<LODAssign>(entity);
-			lodComp.lodIndex = lodLevel;
+void AsteriodBelt::onFixedUpdate(float timestep)
+{
+	ZoneAuditedN("OnFixedUpdate");
+	m_frameSteps++;
 
-			
-		}
+	// What the frame is drawn from, kept while paused too so nothing is blended towards a stale state
+	TransformSystem::storePrevious(m_mainScene->m_entities);
+	m_previousAnimationTime = m_analyticAnimation.getTime();
+	m_timestep = timestep;
 
-		auto& pass = m_mainRenderer.getRenderPass(0);
+	if (m_state == GameState::running)
+	{
+		// Scripts, transforms, physics, HUD and LOD as a graph, see registerSystems
+		m_systems.run();
+	}
+}
 
-		pass.camera.updateView(cameraTransform.transform);
-		pass.UBOmanager.setCachedValue("b_camera", "u_view", pass.camera.view);
-		pass.UBOmanager.setCachedValue("b_camera", "u_viewPos", cameraTransform.translation);
+void AsteriodBelt::onInterpolate(float alpha)
+{
+	m_alpha = alpha;
+}
 
-		auto& skyboxRenderComp = m_mainScene->m_entities.get<Render>(skyBox);
-		skyboxRenderComp.material->setValue("u_skyboxView", glm::mat4(glm::mat3(pass.camera.view)));
+void AsteriodBelt::registerSystems()
+{
+	// Scripts compose the world matrices of what they move and tag it dirty, so they write all three
+	m_systems.add("Scripts", SystemAccess().writes<LocalTRS, WorldMatrix, TransformDirty>(), [this]() {
+		ScriptSystem::onUpdate(m_mainScene->m_entities, m_timestep);
+	}, true); // The controller polls the window for input
+
+	// Runs on a worker, so it only advances the spin time, the instance buffer is bound with the time in onRenderFrame
+	m_systems.add("Spin", SystemAccess().writesResource("AnalyticAnimation"), [this]() {
+		m_analyticAnimation.onUpdate(m_timestep); // Asteroid spin is evaluated in the vertex shader from this time
+	});
+
+	m_systems.add("Transforms", SystemAccess().reads<LocalTRS>().writes<WorldMatrix, TransformDirty>(), [this]() {
+		TransformSystem::update(m_mainScene->m_entities); // Compose world matrices for everything the scripts moved
+	});
+
+	m_systems.add("BroadPhase", SystemAccess().reads<WorldMatrix, OBBCollider, SphereCollider>().writes<AABB>().writesResource("BroadPhase"), [this]() {
+		m_broadPhase.onUpdate(m_timestep); // Update broadphase based on the value of timestep
+	});
+
+	// Particle emitters follow the ship
+	m_systems.add("Particles", SystemAccess().reads<WorldMatrix>().writesResource("Particles"), [this]() {
+		auto& shipTransform = m_mainScene->m_entities.get<WorldMatrix>(ship);
+		glm::vec3 shipForward = -shipTransform.getAxis(2);
+		glm::vec3 shipPosition = shipTransform.getTranslation();
+
+		auto& exhaust = m_particles->getEmitter(m_exhaustEmitter);
+		exhaust.position = shipPosition - shipForward * 1.f;
+		exhaust.velocity = -shipForward * 8.f;
+
+		m_particles->getEmitter(m_dustEmitter).position = shipPosition;
+	});
+
+	m_systems.add("NarrowPhase", SystemAccess().reads<WorldMatrix>().writesResource("BroadPhase"), [this]() { updateSensors(); });
+
+	m_systems.add("HUD", SystemAccess().reads<WorldMatrix>().readsResource("BroadPhase").writesResource("HUD"), [this]() { extractHUD(); });
+
+	m_systems.add("Collisions", SystemAccess().reads<WorldMatrix, Order>().writes<Render>().readsResource("BroadPhase")
+		.writesResource("Particles").writesResource("PointLights").writesResource("Commands").writesResource("GameState"), [this]() { checkCollisions(); });
+
+	// Sync point, structural changes recorded so far this frame are made together
+	m_systems.add("Commands", SystemAccess().exclusive(), [this]() {
+		m_mainScene->m_commands.apply(m_mainScene->m_entities);
+	});
+
+	//Using camera position and the position of each asteroid, I iterate through a for loop of entities,
+	// which check the distance between the camera and each asteroid's position. It assigns a size_t
+	// level from 0 to 2 and then uses the component script for lodassign to assign the index
+	// which is used in the renderer class, to use the correct LOD data. For example, a level of 2 means
+	// it has the least indices and 0 has the most, but it is closer and can use more detail.
+	m_systems.add("LOD", SystemAccess().reads<WorldMatrix, Render>().writes<LODAssign>(), [this]() {
+		glm::vec3 cameraPos = m_mainScene->m_entities.get<WorldMatrix>(camera).getTranslation();
+
+		// Each entity only writes its own LODAssign, so the pool is split across the job system's workers
+		auto& lods = m_mainScene->m_entities.storage<LODAssign>();
+		const auto& worlds = m_mainScene->m_entities.storage<WorldMatrix>();
+		const auto& renders = m_mainScene->m_entities.storage<Render>();
+		JobSystem::parallelFor(0, lods.size(), [&](size_t begin, size_t end) {
+			ZoneScopedN("LODAssign");
+			for (size_t i = begin; i < end; i++)
+			{
+				const entt::entity entity = lods.data()[i];
+				if (!worlds.contains(entity) || !renders.contains(entity)) continue;
 
+				float distance = glm::distance(cameraPos, worlds.get(entity).getTranslation());
 
-		//Draw UI
-		
-		m_ui.begin();
+				size_t level = 2;
+				if (distance <= 25.0f) level = 0;
+				else if (distance <= 100.0f) level = 1;
 
-	}
+				lods.get(entity).lodIndex = level;
+			}
+		}, 1024);
+	});
+
+	// Keep spatially close entities close in memory, last as it moves components the others reference.
+	// The render proxies are invalidated by the sort, any other cache of component addresses registers with addInvalidation
+	m_systems.add("SpatialSort", SystemAccess().exclusive(), [this]() {
+		m_spatialSort.onUpdate(*m_mainScene, m_timestep);
+	});
 }
 
 void AsteriodBelt::onImGUIRender()
 {
-	ZoneScopedN("onImGUIRender");
+	ZoneAuditedN("onImGUIRender");
 	// Scripts widgets
 	if (ImGui::TreeNode("Script settings"))
 	{
-		auto view = m_mainScene->m_entities.view<ScriptComp>();
-		for (auto entity : view)
-		{
-			view.get<ScriptComp>(entity).onImGuiRender();
-		}
+		ScriptSystem::onImGuiRender(m_mainScene->m_entities);
 		ImGui::TreePop();
 	}
 	// Bloom detail
 	//m_bloomPanel.onImGuiRender();
+	// Lighting stats and benchmark
+	m_lightingPanel.onImGuiRender();
+	// CPU system benchmarks
+	m_benchmarkPanel.onImGuiRender();
+	// Update systems, their frame graph and critical path
+	m_schedulerPanel.onImGuiRender();
+	// Allocation audit
+	m_memoryPanel.onImGuiRender();
+	// GPU time per pass
+	m_gpuTimingPanel.onImGuiRender();
+	// Particles
+	if (ImGui::TreeNode("Particles"))
+	{
+		ImGui::Text("Capacity: %u%s", m_particles->getCapacity(), ParticleSystem::isSoftwareRenderer() ? " (software renderer)" : "");
+		ImGui::Text("Emitted last frame: %u", m_particles->getLastEmitCount());
+		ImGui::DragFloat("Dust rate", &m_particles->getEmitter(m_dustEmitter).rate, 1000.f, 0.f, static_cast<float>(m_particles->getCapacity()));
+		ImGui::Checkbox("Exhaust", &m_particles->getEmitter(m_exhaustEmitter).enabled);
+		ImGui::TreePop();
+	}
+	// Render thread, the single threaded path stays available as a fallback
+	if (ImGui::TreeNode("Render thread"))
+	{
+		ImGui::Checkbox("Draw on the render thread", &m_renderThreaded);
+		if (m_renderThreaded && m_lightingPanel.isBenchmarking()) ImGui::Text("Single threaded while the lighting benchmark runs");
+		ImGui::TreePop();
+	}
+	// Fixed step simulation, the rate is set by the application
+	if (ImGui::TreeNode("Simulation"))
+	{
+		ImGui::Text("Step: %.2fms (%.0f Hz)", m_timestep * 1000.f, m_timestep > 0.f ? 1.f / m_timestep : 0.f);
+		ImGui::Text("Steps this frame: %u, alpha: %.2f", m_frameSteps, m_alpha);
+		ImGui::TreePop();
+	}
+		// Spatial sorting of the main scene's pools
+	if (ImGui::TreeNode("Spatial sort"))
+	{
+		ImGui::Text("Passes: %u, sorted: %u%s", m_spatialSort.getPassCount(), m_spatialSort.getSortCount(), m_spatialSort.isRunning() ? " (running)" : "");
+		ImGui::Text("Out of order at last pass: %.2f%%", m_spatialSort.getLastOutOfOrder() * 100.f);
+		float budget = m_spatialSort.getBudget();
+		if (ImGui::DragFloat("Budget (ms)", &budget, 0.05f, 0.05f, 10.f)) m_spatialSort.setBudget(budget);
+		if (ImGui::Button("Sort now")) m_spatialSort.request();
+		ImGui::TreePop();
+	}
+	// Broadphase backend used for the colliders
+	if (ImGui::TreeNode("Broadphase"))
+	{
+		const BroadPhaseType types[] = { BroadPhaseType::PlaneSweep, BroadPhaseType::AABBTree, BroadPhaseType::HashGrid };
+		const BroadPhaseType current = m_broadPhase.getBackendType();
+		if (ImGui::BeginCombo("Backend", BroadPhaseBackend::getName(current)))
+		{
+			for (BroadPhaseType type : types)
+			{
+				if (ImGui::Selectable(BroadPhaseBackend::getName(type), type == current)) m_broadPhase.setBackend(type);
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::Text("Overlapping pairs: %zu", m_broadPhase.getPairs().size());
+
+		// Nearest colliders to the ship, through the spatial index rather than a loop over every collider
+		SpatialHit nearest[3];
+		const glm::vec3 shipPosition = m_mainScene->m_entities.get<WorldMatrix>(ship).getTranslation();
+		const uint32_t found = m_broadPhase.getSpatialIndex().nearest(shipPosition, nearest);
+		for (uint32_t i = 0; i < found; i++) ImGui::Text("Nearest %u: entity %u at %.2f", i, static_cast<uint32_t>(nearest[i].entity), nearest[i].distance);
+		ImGui::TreePop();
+	}
 
 }
 
@@ -562,121 +775,111 @@ void AsteriodBelt::onKeyPressed(KeyPressedEvent& e)
 	if (e.getKeyCode() == GLFW_KEY_SPACE && m_state == GameState::intro) m_state = GameState::running;
 }
 
-void AsteriodBelt::checkWaypointCollisions()
+void AsteriodBelt::updateSensors()
 {
-	ZoneScopedN("CheckWaypointCollision");
-	TracyGpuZone("checkWaypointCollisions");
-	// Generate collision point in front of ship
-	auto& shipTransform = m_mainScene->m_entities.get<Transform>(ship);
-
-	glm::vec3 shipRight = { -shipTransform.transform[0][0], -shipTransform.transform[0][1], -shipTransform.transform[0][2] };
-	glm::vec3 shipUp = { -shipTransform.transform[1][0], -shipTransform.transform[1][1], -shipTransform.transform[1][2] };
-	glm::vec3 shipForward = { -shipTransform.transform[2][0], -shipTransform.transform[2][1], -shipTransform.transform[2][2] };
+	auto& shipTransform = m_mainScene->m_entities.get<WorldMatrix>(ship);
 
+	// Ship's box against the asteroids
 	OBBCollider obb(glm::vec3(0.72f, 0.18f, 1.f), ship);
-
-	auto view = m_mainScene->m_entities.view<SphereCollider, Transform>();
-
-
-	for (auto& entity : view)
-	{
-
-		auto& sphereCollider = view.get<SphereCollider>(entity);
-		float dist = Physics::DistanceOBBToSphere(m_mainScene.get(), obb, sphereCollider);
-		if (dist < 25.f)
-		{
-
-			glm::vec3 shipToAsteroid = view.get<Transform>(entity).translation - m_mainScene->m_entities.get<Transform>(ship).translation;
-
-			if (glm::dot(shipToAsteroid, shipForward) > 0)
-			{
-
-				float x = glm::dot(shipRight, shipToAsteroid);
-				float y = glm::dot(shipUp, shipToAsteroid);
-				m_closeAsteroids.push_back(glm::vec3(x, y, 25.f - dist));
-
-			}
-
-		}
-		if (dist < 0.f) m_state = GameState::gameOver;
-	}
-
-	
-}
-
-void AsteriodBelt::checkAsteroidCollisions()
-{
+	m_broadPhase.updateSensor(m_shipSensor, OrientedBox::fromCollider(obb, shipTransform));
 
 	//Set the off-set.
 	glm::vec3 offset(0.f, 0.18f, -0.14f);
 
-	//Assign transform functions to the ship, to calculate right, up and forward vectors.
-	auto& shipTransform = m_mainScene->m_entities.get<Transform>(ship);
-
-	glm::vec3 shipRight = { -shipTransform.transform[0][0], -shipTransform.transform[0][1], -shipTransform.transform[0][2] };
-	glm::vec3 shipUp = { -shipTransform.transform[1][0], -shipTransform.transform[1][1], -shipTransform.transform[1][2] };
-	glm::vec3 shipForward = { shipTransform.transform[2][0], shipTransform.transform[2][1], shipTransform.transform[2][2] };
+	glm::vec3 shipRight = -shipTransform.getAxis(0);
+	glm::vec3 shipUp = -shipTransform.getAxis(1);
+	glm::vec3 shipForward = shipTransform.getAxis(2);
 
-	glm::vec3 hitPoint = shipTransform.translation;
+	glm::vec3 hitPoint = shipTransform.getTranslation();
 
 	hitPoint += shipRight * offset.x;
 	hitPoint += shipUp * offset.y;
 	hitPoint += shipForward * offset.z;
 
-	// Get all entities with a sphere collider
-	auto view = m_mainScene->m_entities.view<OBBCollider, Transform, Order>();
-
-	for (auto& entity : view) {
-		// Compute distance
-		auto& obbCollider = view.get<OBBCollider>(entity);
-		float dist = Physics::DistanceOBBToPoint(m_mainScene.get(), obbCollider, hitPoint);
-
-		if (dist < 0.75f) {
-			// Hit
+	// The hit point is a sensor with no extent, against the waypoints
+	OrientedBox hitBox;
+	hitBox.centre = hitPoint;
+	m_broadPhase.updateSensor(m_hitSensor, hitBox);
+}
 
-			// Make a record of order
-			auto order = view.get<Order>(entity);
+void AsteriodBelt::extractHUD()
+{
+	auto& shipTransform = m_mainScene->m_entities.get<WorldMatrix>(ship);
+
+	glm::vec3 shipRight = -shipTransform.getAxis(0);
+	glm::vec3 shipUp = -shipTransform.getAxis(1);
+	glm::vec3 shipPosition = shipTransform.getTranslation();
+
+	// Shell 1 of each sensor is everything close enough to show on the HUD, projected to 2d if in front of the ship
+	const float asteroidRange = 25.f;
+	const float targetRange = 35.f;
+	m_closeAsteroids.clear();
+	m_closeTargets.clear();
+	for (auto& event : m_broadPhase.getProximityEvents())
+	{
+		if (event.shell != 1 || event.phase == ProximityPhase::exit) continue;
 
-			//Create an entity called index and set it to null.
-			entt::entity index{ entt::null };
-			uint32_t lowest{ std::numeric_limits<uint32_t>::max() };
+		glm::vec3 shipToEntity = m_mainScene->m_entities.get<WorldMatrix>(event.entity).getTranslation() - shipPosition;
+		float x = glm::dot(shipRight, shipToEntity);
+		float y = glm::dot(shipUp, shipToEntity);
 
-			auto orderView = m_mainScene->m_entities.view<Order>();
-			for (auto& entity2 : orderView) {
-				auto order2 = orderView.get<Order>(entity2);
-				if (order2.order > order.order && order2.order < lowest) {
-					index = entity2;
-					lowest = order2.order;
-				}
-			}
+		if (event.sensor == m_shipSensor) {
+			if (glm::dot(shipToEntity, -shipTransform.getAxis(2)) > 0) m_closeAsteroids.push_back(glm::vec3(x, y, asteroidRange - event.distance));
+		}
+		else if (event.sensor == m_hitSensor) {
+			if (glm::dot(shipToEntity, shipTransform.getAxis(2)) > 0) m_closeTargets.push_back(glm::vec3(x, y, targetRange - event.distance));
+		}
+	}
+}
 
-			// Give material to next target
-			if (index != entt::null) {
-				// Set material
-				auto& target = m_mainScene->m_entities.get<Render>(index);
-				target.material = m_mainScene->m_entities.get<Render>(nextTarget).material;
-				// Update next target
-				nextTarget = index;
-			}
+void AsteriodBelt::checkCollisions()
+{
+	// Shell 0 of the ship's sensor is a crash, of the hit point's a pickup
+	m_collected.clear();
+	for (auto& event : m_broadPhase.getProximityEvents())
+	{
+		if (event.shell != 0 || event.phase == ProximityPhase::exit) continue;
 
-			// Remove waypoint that has been hit
-			m_mainScene->m_entities.destroy(entity);
-		}
+		if (event.sensor == m_shipSensor) m_state = GameState::gameOver;
+		else if (event.sensor == m_hitSensor && event.phase == ProximityPhase::enter) m_collected.push_back(event.entity);
+	}
 
-		if (dist < 35.f) {
-			// Ship to asteroid
-			glm::vec3 shipToTarget = view.get<Transform>(entity).translation - m_mainScene->m_entities.get<Transform>(ship).translation;
-			// Project to 2d for UI if infront of ship
-			if (glm::dot(shipToTarget, shipForward) > 0) {
-				float x = glm::dot(shipRight, shipToTarget);
-				float y = glm::dot(shipUp, shipToTarget);
-				m_closeTargets.push_back(glm::vec3(x, y, 35.f - dist));
+	// Destroyed after the events have been read, never while iterating them
+	for (entt::entity waypoint : m_collected) collectWaypoint(waypoint);
+}
 
-			}
-		}
+void AsteriodBelt::collectWaypoint(entt::entity waypoint)
+{
+	auto& registry = m_mainScene->m_entities;
+	const uint32_t order = registry.get<Order>(waypoint).order;
+
+	// Next target is the first uncollected waypoint after this one
+	entt::entity index{ entt::null };
+	uint32_t next = order + 1;
+	while (next < m_waypoints.size() && m_waypoints[next] == entt::null) next++;
+	if (next < m_waypoints.size()) index = m_waypoints[next];
+
+	// Give material to next target
+	if (index != entt::null) {
+		// Set material
+		auto& target = registry.get<Render>(index);
+		target.material = registry.get<Render>(nextTarget).material;
+		// Update next target
+		nextTarget = index;
 	}
 
+	// Debris burst from the collected waypoint
+	m_particles->getEmitter(m_debrisEmitter).position = registry.get<WorldMatrix>(waypoint).getTranslation();
+	m_particles->burst(m_debrisEmitter, 5000);
 
+	// Waypoint lights are indexed by order, the hit waypoint goes dark and the next one turns green
+	auto& pointLights = m_mainScene->m_pointLights;
+	if (order < pointLights.size()) pointLights[order].colour = glm::vec3(0.f);
+	if (index != entt::null && next < pointLights.size()) pointLights[next].colour = glm::vec3(0.392f, 0.859f, 0.196f);
+
+	// Remove waypoint that has been hit at the sync point, which also takes it out of the broadphase
+	if (order < m_waypoints.size()) m_waypoints[order] = entt::null;
+	m_mainScene->m_commands.destroy(waypoint);
 }
 
 
@@ -686,6 +889,7 @@ void AsteriodBelt::generateLevel()
 {
 	ZoneScopedN("generateLevel");
 	TracyGpuZone("generateLevel");
+	MemoryTracker::Scope memoryScope(MemoryTag::ecs); // Registry emplaces land in ECS, the model, texture and shader loaders open their own assets scopes
 
 	const int wayPointCount = 100; // Number of waypoints
 	const int asteroidsPerWayPointCount = 20; // Number of asteroids per way Point
@@ -776,16 +980,17 @@ void AsteriodBelt::generateLevel()
 
 	{
 		camera = m_mainScene->m_entities.create();
-		m_mainScene->m_entities.emplace<Transform>(camera);
+		TransformSystem::emplace(m_mainScene->m_entities, camera);
+		TransformSystem::emplacePrevious(m_mainScene->m_entities, camera);
 	}
 
 	{
 		skyBox = m_mainScene->m_entities.create();
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(skyBox);
-		renderComp.geometry = skyboxVAO;
-		renderComp.material = skyboxMaterial;
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(skyBox);
-		skyboxMaterial->setValue("u_skyboxView", glm::inverse(transformComp.transform));
+		renderComp.geometry = ResourceRegistry::add(skyboxVAO);
+		renderComp.material = ResourceRegistry::add(skyboxMaterial);
+		TransformSystem::emplace(m_mainScene->m_entities, skyBox);
+		skyboxMaterial->setValue("u_skyboxView", glm::inverse(m_mainScene->m_entities.get<WorldMatrix>(skyBox).toMat4()));
 
 		auto& lodComp = m_mainScene->m_entities.emplace<LODAssign>(skyBox);
 		lodComp.lodNumber = lodNonAsteroid;
@@ -801,6 +1006,14 @@ void AsteriodBelt::generateLevel()
 	std::shared_ptr<Shader> pbrShader;
 	pbrShader = std::make_shared<Shader>(pbrShaderDesc);
 
+	ShaderDescription pbrAnalyticShaderDesc;
+	pbrAnalyticShaderDesc.type = ShaderType::rasterization;
+	pbrAnalyticShaderDesc.vertexSrcPath = "./assets/shaders/PBR/pbrVertexAnalytic.glsl";
+	pbrAnalyticShaderDesc.fragmentSrcPath = "./assets/shaders/PBR/pbrFrag.glsl";
+
+	std::shared_ptr<Shader> pbrAnalyticShader;
+	pbrAnalyticShader = std::make_shared<Shader>(pbrAnalyticShaderDesc);
+
 	ShaderDescription pbrEShaderDesc;
 	pbrEShaderDesc.type = ShaderType::rasterization;
 	pbrEShaderDesc.vertexSrcPath = "./assets/shaders/PBR/pbrVertex.glsl";
@@ -848,24 +1061,19 @@ void AsteriodBelt::generateLevel()
 		ship = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(ship);
-		renderComp.geometry = shipVAO;
-		renderComp.material = shipMaterial;
-
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(ship);
-		transformComp.translation = glm::vec3(0.f, 0.f, -2.f);
-		transformComp.rotation = glm::quat(glm::vec3(0.f, glm::pi<float>(), 0.f));
-		transformComp.scale = glm::vec3(1.f);
-		transformComp.recalc();
+		renderComp.geometry = ResourceRegistry::add(shipVAO);
+		renderComp.material = ResourceRegistry::add(shipMaterial);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(ship);
+		TransformSystem::emplace(m_mainScene->m_entities, ship, LocalTRS(glm::vec3(0.f, 0.f, -2.f), glm::vec3(0.f, glm::pi<float>(), 0.f), glm::vec3(1.f)));
+		TransformSystem::emplacePrevious(m_mainScene->m_entities, ship); // Moved by the controller, drawn between steps
 
 		auto& lodComp = m_mainScene->m_entities.emplace<LODAssign>(ship);
 		lodComp.lodNumber = lodNonAsteroid;
 
-		scriptComp.attachScript<ControllerScript>(ship, m_mainScene, m_winRef, camera, glm::vec3(0.06f, 0.06f, -1.5f), glm::vec3(0.f, 0.7f, 2.6f), &speed);
+		ScriptSystem::attach<ControllerScript>(m_mainScene, ship, m_winRef, camera, glm::vec3(0.06f, 0.06f, -1.5f), glm::vec3(0.f, 0.7f, 2.6f), &speed);
 	}
 
-	auto meshOpt = [this](Model model, VBOLayout vbo, std::shared_ptr<VAO>& allLODsVAO)
+	auto meshOpt = [this](const Model& model, const VBOLayout& vbo, std::shared_ptr<VAO>& allLODsVAO)
 	{
 
 		const size_t vertexCountOnLoad = model.m_meshes[0].vertices.size() / vertexComponents;
@@ -1012,7 +1220,7 @@ void AsteriodBelt::generateLevel()
 		std::shared_ptr<Texture> asteroid_AO = std::make_shared<Texture>("./assets/models/asteroid1/AO.png");
 
 
-		asteroidMaterials[0] = std::make_shared<Material>(pbrShader);
+		asteroidMaterials[0] = std::make_shared<Material>(pbrAnalyticShader, "");
 		asteroidMaterials[0]->setValue("albedoTexture", asteroid_albedo);
 		asteroidMaterials[0]->setValue("normalTexture", asteroid_normal);
 		asteroidMaterials[0]->setValue("roughTexture", asteroid_rough);
@@ -1035,7 +1243,7 @@ void AsteriodBelt::generateLevel()
 		std::shared_ptr<Texture> asteroid_AO = std::make_shared<Texture>("./assets/models/asteroid2/AO.png");
 
 
-		asteroidMaterials[1] = std::make_shared<Material>(pbrShader);
+		asteroidMaterials[1] = std::make_shared<Material>(pbrAnalyticShader, "");
 		asteroidMaterials[1]->setValue("albedoTexture", asteroid_albedo);
 		asteroidMaterials[1]->setValue("normalTexture", asteroid_normal);
 		asteroidMaterials[1]->setValue("roughTexture", asteroid_rough);
@@ -1058,7 +1266,7 @@ void AsteriodBelt::generateLevel()
 		std::shared_ptr<Texture> asteroid_AO = std::make_shared<Texture>("./assets/models/asteroid3/AO.png");
 
 
-		asteroidMaterials[2] = std::make_shared<Material>(pbrShader);
+		asteroidMaterials[2] = std::make_shared<Material>(pbrAnalyticShader, "");
 		asteroidMaterials[2]->setValue("albedoTexture", asteroid_albedo);
 		asteroidMaterials[2]->setValue("normalTexture", asteroid_normal);
 		asteroidMaterials[2]->setValue("roughTexture", asteroid_rough);
@@ -1081,7 +1289,7 @@ void AsteriodBelt::generateLevel()
 		std::shared_ptr<Texture> asteroid_AO = std::make_shared<Texture>("./assets/models/asteroid4/AO.png");
 
 
-		asteroidMaterials[3] = std::make_shared<Material>(pbrShader);
+		asteroidMaterials[3] = std::make_shared<Material>(pbrAnalyticShader, "");
 		asteroidMaterials[3]->setValue("albedoTexture", asteroid_albedo);
 		asteroidMaterials[3]->setValue("normalTexture", asteroid_normal);
 		asteroidMaterials[3]->setValue("roughTexture", asteroid_rough);
@@ -1090,6 +1298,15 @@ void AsteriodBelt::generateLevel()
 
 		meshOpt(asteroidModel, modelLayout, asteroidVAOs[3]);
 	}
+
+	std::array<VAOHandle, 4> asteroidVAOHandles;
+	std::array<MaterialHandle, 4> asteroidMaterialHandles;
+	for (size_t i = 0; i < asteroidVAOs.size(); i++)
+	{
+		asteroidVAOHandles[i] = ResourceRegistry::add(asteroidVAOs[i]);
+		asteroidMaterialHandles[i] = ResourceRegistry::add(asteroidMaterials[i]);
+		m_analyticAnimation.addMaterial(asteroidMaterials[i]);
+	}
 	
 	// Waypoints
 	ShaderDescription phongEmissiveShdrDesc;
@@ -1127,18 +1344,29 @@ void AsteriodBelt::generateLevel()
 	firstCubeMaterial->setValue("u_emissive", glm::vec4(0.392f, 0.859f, 0.196f, 4.75f));
 	firstCubeMaterial->setValue("u_albedoMap", cubeTexture);
 
+	VAOHandle cubeVAOHandle = ResourceRegistry::add(cubeVAO);
+	MaterialHandle cubeMaterialHandle = ResourceRegistry::add(cubeMaterial);
+	MaterialHandle firstCubeMaterialHandle = ResourceRegistry::add(firstCubeMaterial);
+
 	//Create the cube entity for the waypoints.
 	entt::entity cube = m_mainScene->m_entities.create();
-	m_mainScene->m_entities.emplace<Transform>(cube);
+	TransformSystem::emplace(m_mainScene->m_entities, cube);
 
+	// Asteroids are created in one go and their components recorded, so each pool grows once when they are applied
+	auto& commands = m_mainScene->m_commands;
+	std::vector<entt::entity> asteroids((wayPointCount - 1) * asteroidsPerWayPointCount);
+	m_mainScene->m_entities.create(asteroids.begin(), asteroids.end());
+
+	m_waypoints.assign(wayPointCount - 1, entt::null);
 	for (int i = 0; i < wayPointCount - 1; i++)
 	{
 		ZoneScopedN("Waypoints");
 		TracyGpuZone("Waypoints");
-		auto& transformComp = m_mainScene->m_entities.get<Transform>(cube);
-		glm::vec3 right = { -transformComp.transform[0][0], -transformComp.transform[0][1], -transformComp.transform[0][2] };
-		glm::vec3 up = { -transformComp.transform[1][0], -transformComp.transform[1][1], -transformComp.transform[1][2] };
-		glm::vec3 forward = { -transformComp.transform[2][0], -transformComp.transform[2][1], -transformComp.transform[2][2] };
+		// Copied out as emplacing the next cube's components can reallocate the pools
+		const WorldMatrix previousWorld = m_mainScene->m_entities.get<WorldMatrix>(cube);
+		glm::vec3 right = -previousWorld.getAxis(0);
+		glm::vec3 up = -previousWorld.getAxis(1);
+		glm::vec3 forward = -previousWorld.getAxis(2);
 
 		entt::entity oldCube = cube;
 
@@ -1146,11 +1374,11 @@ void AsteriodBelt::generateLevel()
 		if (i == 0) nextTarget = cube;
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(cube);
-		renderComp.geometry = cubeVAO;
-		if (i == 0) renderComp.material = firstCubeMaterial;
-		else renderComp.material = cubeMaterial;
+		renderComp.geometry = cubeVAOHandle;
+		if (i == 0) renderComp.material = firstCubeMaterialHandle;
+		else renderComp.material = cubeMaterialHandle;
 
-		auto& newTransformComp = m_mainScene->m_entities.emplace<Transform>(cube);
+		LocalTRS newTransformComp;
 		newTransformComp.scale = glm::vec3(0.5f);
 
 		auto& lodComp = m_mainScene->m_entities.emplace<LODAssign>(cube);
@@ -1158,18 +1386,26 @@ void AsteriodBelt::generateLevel()
 
 		auto& order = m_mainScene->m_entities.emplace<Order>(cube);
 		order.order = i;
+		m_waypoints[i] = cube;
 
 		float fwdDelta = Randomiser::uniformFloatBetween(25.f, 35.f);
-		newTransformComp.translation = transformComp.translation + forward * fwdDelta;
+		newTransformComp.translation = previousWorld.getTranslation() + forward * fwdDelta;
 
 		glm::vec3 EulerAngle(Randomiser::uniformFloatBetween(-0.3f, 0.3f), Randomiser::uniformFloatBetween(-0.4f, 0.4f), 0.f);
 		glm::quat angleDelta(EulerAngle);
 		newTransformComp.rotation *= angleDelta;
-		newTransformComp.recalc();
+		TransformSystem::emplace(m_mainScene->m_entities, cube, newTransformComp);
 		m_mainScene->m_entities.emplace<OBBCollider>(cube, newTransformComp.scale * 0.5f, cube);
 
+		// Waypoint glow, the light's index matches the waypoint's order
+		PointLight waypointLight;
+		waypointLight.colour = (i == 0) ? glm::vec3(0.392f, 0.859f, 0.196f) : glm::vec3(0.722f, 0.251f, 0.871f);
+		waypointLight.position = newTransformComp.translation;
+		waypointLight.constants = glm::vec3(1.f, 0.22f, 0.2f);
+		m_mainScene->m_pointLights.push_back(waypointLight);
+
 		//Asteroids
-		std::vector<Transform> asteroidsThisWaypoint;
+		std::vector<LocalTRS> asteroidsThisWaypoint;
 		asteroidsThisWaypoint.reserve(asteroidsPerWayPointCount);
 
 		for (int j = 0; j < asteroidsPerWayPointCount; j++)
@@ -1194,7 +1430,7 @@ void AsteriodBelt::generateLevel()
 				scale = Randomiser::uniformFloatBetween(0.4f, 5.f);
 
 
-				position = m_mainScene->m_entities.get<Transform>(oldCube).translation;
+				position = m_mainScene->m_entities.get<WorldMatrix>(oldCube).getTranslation();
 				position += (forward * fwdDelta) * t;
 				position.x += cos(theta) * radius;
 				position.y += sin(theta) * radius;
@@ -1220,29 +1456,31 @@ void AsteriodBelt::generateLevel()
 			ZoneScopedN("Asteroids");
 			TracyGpuZone("Asteroids");
 
-			asteroid = m_mainScene->m_entities.create();
+			asteroid = asteroids[i * asteroidsPerWayPointCount + j];
 
-			auto& renderComp = m_mainScene->m_entities.emplace<Render>(asteroid);
+			Render renderComp;
 			auto modelIdx = Randomiser::uniformIntBetween(0, 3);
-			renderComp.geometry = asteroidVAOs[modelIdx];
-			renderComp.material = asteroidMaterials[modelIdx];
+			renderComp.geometry = asteroidVAOHandles[modelIdx];
+			renderComp.material = asteroidMaterialHandles[modelIdx];
+			commands.emplace(asteroid, renderComp);
 
-			auto& transformComp = m_mainScene->m_entities.emplace<Transform>(asteroid);
-			transformComp.translation = position;
-			transformComp.scale = glm::vec3(scale, scale, scale);
-			transformComp.recalc();
+			const LocalTRS local(position, glm::vec3(0.f), glm::vec3(scale, scale, scale));
+			WorldMatrix world;
+			TransformSystem::compose(local, world);
+			commands.emplace(asteroid, local);
+			commands.emplace(asteroid, world);
 
-			auto& lodComp = m_mainScene->m_entities.emplace<LODAssign>(asteroid);
+			LODAssign lodComp;
 			lodComp.lodNumber = lodAsteroid;
 			lodComp.lodIndex = lodLevel;
+			commands.emplace(asteroid, lodComp);
 
-			//Attach rotation script to the asteroids so that they rotate in the scene.
+			//Give the asteroids a spin which the vertex shader evaluates, their transforms stay as created.
 			auto x = Randomiser::uniformFloatBetween(-1.f, 1.f);
 			auto y = Randomiser::uniformFloatBetween(-1.f, 1.f);
 			auto z = Randomiser::uniformFloatBetween(-1.f, 1.f);
-			auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(asteroid);
-			scriptComp.attachScript<RotationScript>(asteroid, m_mainScene, glm::vec3(x, y, z), 0);
-			m_mainScene->m_entities.emplace<SphereCollider>(asteroid, scale, asteroid);
+			commands.emplace(asteroid, m_analyticAnimation.add(local, glm::vec3(x, y, z)));
+			commands.emplace(asteroid, SphereCollider(scale, asteroid));
 
 			
 
@@ -1251,7 +1489,8 @@ void AsteriodBelt::generateLevel()
 
 	}
 
-	
+	commands.apply(m_mainScene->m_entities);
+	m_analyticAnimation.upload(); // Instance data is static from here on
 
 	
 }
@@ -0,0 +1,635 @@
+#include "include/ImGui/benchmarkPanel.hpp"
+#include "core/randomiser.hpp"
+#include "core/spinSystem.hpp"
+#include "core/scriptSystem.hpp"
+#include "scripts/include/rotation.hpp"
+#include "rendering/cameraFrustum.hpp"
+#include "core/physics.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <thread>
+
+namespace
+{
+	// Entities spread through a box with a random orientation, scale and spin, as the asteroid belt uses
+	void populateSpinners(entt::registry& registry, uint32_t count, std::vector<entt::entity>& entities, std::vector<glm::vec3>& speeds)
+	{
+		entities.resize(count);
+		speeds.resize(count);
+		registry.create(entities.begin(), entities.end());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			glm::vec3 position(Randomiser::uniformFloatBetween(-500.f, 500.f), Randomiser::uniformFloatBetween(-500.f, 500.f), Randomiser::uniformFloatBetween(-500.f, 500.f));
+			glm::vec3 euler(Randomiser::uniformFloatBetween(-3.f, 3.f), Randomiser::uniformFloatBetween(-3.f, 3.f), Randomiser::uniformFloatBetween(-3.f, 3.f));
+			float scale = Randomiser::uniformFloatBetween(0.4f, 5.f);
+			TransformSystem::emplace(registry, entities[i], LocalTRS(position, euler, glm::vec3(scale)));
+			speeds[i] = glm::vec3(Randomiser::uniformFloatBetween(-1.f, 1.f), Randomiser::uniformFloatBetween(-1.f, 1.f), Randomiser::uniformFloatBetween(-1.f, 1.f));
+		}
+	}
+
+	// Renderables as the main scene has them, most with bounds and a few, like the skybox, without
+	void populateRenderables(entt::registry& registry, uint32_t count)
+	{
+		std::vector<entt::entity> entities(count);
+		registry.create(entities.begin(), entities.end());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			glm::vec3 position(Randomiser::uniformFloatBetween(-500.f, 500.f), Randomiser::uniformFloatBetween(-500.f, 500.f), Randomiser::uniformFloatBetween(-500.f, 500.f));
+			float scale = Randomiser::uniformFloatBetween(0.4f, 5.f);
+
+			auto& render = registry.emplace<Render>(entities[i]);
+			render.material = MaterialHandle(i % 4, 1);
+			render.geometry = VAOHandle(i % 4, 1);
+			TransformSystem::emplace(registry, entities[i], LocalTRS(position, glm::vec3(0.f), glm::vec3(scale)));
+			auto& lod = registry.emplace<LODAssign>(entities[i]);
+			lod.lodNumber = 1;
+			lod.lodIndex = i % 3;
+			if (i % 64 != 0) registry.emplace<AABB>(entities[i], position - glm::vec3(scale), position + glm::vec3(scale));
+		}
+	}
+
+	// Asteroid boxes around a path which turns a little at each waypoint, as generateLevel lays out the belt
+	void populateBelt(uint32_t count, std::vector<std::pair<entt::entity, AABB>>& boxes)
+	{
+		const uint32_t perWaypoint = 20;
+		boxes.clear();
+		boxes.reserve(count);
+		glm::vec3 position(0.f);
+		glm::quat orientation(1.f, 0.f, 0.f, 0.f);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (i % perWaypoint == 0) {
+				orientation *= glm::quat(glm::vec3(Randomiser::uniformFloatBetween(-0.3f, 0.3f), Randomiser::uniformFloatBetween(-0.4f, 0.4f), 0.f));
+				position += orientation * glm::vec3(0.f, 0.f, -Randomiser::uniformFloatBetween(25.f, 35.f));
+			}
+			const float radius = Randomiser::uniformFloatBetween(20.f, 80.f);
+			const float theta = Randomiser::uniformFloatBetween(-glm::pi<float>(), glm::pi<float>());
+			const float along = Randomiser::uniformFloatBetween(0.f, 30.f);
+			const glm::vec3 centre = position + orientation * glm::vec3(cos(theta) * radius, sin(theta) * radius, along);
+			const float scale = Randomiser::uniformFloatBetween(0.4f, 5.f);
+			boxes.emplace_back(static_cast<entt::entity>(i), AABB(centre - glm::vec3(scale), centre + glm::vec3(scale)));
+		}
+	}
+
+	// The same asteroids spread through a cube with the belt's density
+	void populateUniform(uint32_t count, std::vector<std::pair<entt::entity, AABB>>& boxes)
+	{
+		const float halfSide = 0.5f * std::cbrt(static_cast<float>(count) * 28000.f);
+		boxes.clear();
+		boxes.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::vec3 centre(Randomiser::uniformFloatBetween(-halfSide, halfSide), Randomiser::uniformFloatBetween(-halfSide, halfSide), Randomiser::uniformFloatBetween(-halfSide, halfSide));
+			const float scale = Randomiser::uniformFloatBetween(0.4f, 5.f);
+			boxes.emplace_back(static_cast<entt::entity>(i), AABB(centre - glm::vec3(scale), centre + glm::vec3(scale)));
+		}
+	}
+}
+
+void BenchmarkPanel::onImGuiRender()
+{
+	if (ImGui::TreeNode("Benchmarks"))
+	{
+		ImGui::TextUnformatted("Benchmarks stall the frame until they finish.");
+
+		if (ImGui::Button("Spin: scripts vs SpinSystem")) runSpinBenchmark();
+		showResults(m_spinResults);
+
+		if (ImGui::Button("Render: registry view vs proxies")) runRenderIterationBenchmark();
+		showResults(m_renderResults);
+
+		if (ImGui::Button("Broadphase: sweep vs tree vs grid")) runBroadPhaseBenchmark();
+		showResults(m_broadPhaseResults);
+
+		if (ImGui::Button("Narrow phase: scalar vs AVX2")) runNarrowPhaseBenchmark();
+		if (!m_narrowPhaseResults.empty()) ImGui::Text("Validation %s", m_narrowPhaseValid ? "passed" : "FAILED, see log");
+		showResults(m_narrowPhaseResults);
+
+		if (ImGui::Button("Spatial queries: k-d tree vs brute force")) runSpatialQueryBenchmark();
+		if (!m_spatialQueryResults.empty()) ImGui::Text("Results %s", m_spatialQueryValid ? "match" : "DIFFER, see log");
+		showResults(m_spatialQueryResults);
+
+		if (ImGui::Button("Structural changes: direct vs command buffer")) runCommandBufferBenchmark();
+		showResults(m_commandBufferResults);
+
+		if (ImGui::Button("Job system: scaling from 1 to N threads")) runJobSystemBenchmark();
+		showResults(m_jobSystemResults);
+
+		ImGui::TreePop();
+	}
+}
+
+void BenchmarkPanel::runSpinBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 100000, 1000000 };
+	const float timestep = 1.f / 60.f;
+	const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	m_spinResults.clear();
+	std::vector<entt::entity> entities;
+	std::vector<glm::vec3> speeds;
+
+	for (uint32_t count : counts)
+	{
+		const uint32_t iterations = count >= 1000000 ? 10 : (count >= 100000 ? 30 : 200);
+
+		// Script path, RotationScripts in their pool updated by the script system
+		{
+			auto scene = std::make_shared<Scene>();
+			auto& registry = scene->m_entities;
+			populateSpinners(registry, count, entities, speeds);
+			for (uint32_t i = 0; i < count; i++) ScriptSystem::attach<RotationScript>(scene, entities[i], speeds[i], 0);
+
+			const uint32_t previousThreads = ScriptSystem::getThreadCount();
+			ScriptSystem::setThreadCount(1);
+			m_spinResults.push_back(Benchmark::run("Spin RotationScript 1 thread", count, iterations, [&registry, timestep]() {
+				ScriptSystem::onUpdate(registry, timestep);
+			}));
+			Benchmark::log(m_spinResults.back());
+
+			ScriptSystem::setThreadCount(hardwareThreads);
+			m_spinResults.push_back(Benchmark::run("Spin RotationScript " + std::to_string(hardwareThreads) + " threads", count, iterations, [&registry, timestep]() {
+				ScriptSystem::onUpdate(registry, timestep);
+			}));
+			Benchmark::log(m_spinResults.back());
+			ScriptSystem::setThreadCount(previousThreads);
+		}
+
+		// SpinSystem, single threaded then across the hardware threads
+		{
+			auto scene = std::make_shared<Scene>();
+			auto& registry = scene->m_entities;
+			populateSpinners(registry, count, entities, speeds);
+			for (uint32_t i = 0; i < count; i++) registry.emplace<AngularVelocity>(entities[i], speeds[i]);
+
+			SpinSystem spinSystem(registry, timestep);
+
+			spinSystem.setThreadCount(1);
+			m_spinResults.push_back(Benchmark::run("Spin SpinSystem 1 thread", count, iterations, [&spinSystem]() { spinSystem.step(); }));
+			Benchmark::log(m_spinResults.back());
+
+			spinSystem.setThreadCount(hardwareThreads);
+			m_spinResults.push_back(Benchmark::run("Spin SpinSystem " + std::to_string(hardwareThreads) + " threads", count, iterations, [&spinSystem]() { spinSystem.step(); }));
+			Benchmark::log(m_spinResults.back());
+		}
+	}
+
+	Benchmark::writeCSV("./benchmarks/spin_system.csv", m_spinResults);
+}
+
+void BenchmarkPanel::showResults(const std::vector<BenchmarkResult>& results)
+{
+	for (auto& result : results)
+	{
+		ImGui::Text("%-32s n=%-8llu mean %.3fms  %.1fns/elem", result.name.c_str(), static_cast<unsigned long long>(result.elements), result.meanMs, result.nsPerElement());
+	}
+}
+
+void BenchmarkPanel::runRenderIterationBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 100000, 1000000 };
+
+	Camera camera;
+	camera.projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 1000.f);
+	camera.updateView(glm::mat4(1.f));
+	CameraFrustrum frustum(camera);
+
+	m_renderResults.clear();
+	for (uint32_t count : counts)
+	{
+		const uint32_t iterations = count >= 1000000 ? 10 : (count >= 100000 ? 30 : 200);
+		Scene scene;
+		auto& registry = scene.m_entities;
+		populateRenderables(registry, count);
+
+		// The culling, LOD and submission reads the renderer performs per entity, less the GL calls
+		uint64_t sink = 0;
+
+		// Previous path, a three component view plus an AABB lookup per entity
+		m_renderResults.push_back(Benchmark::run("Render registry view", count, iterations, [&registry, &frustum, &sink]() {
+			auto view = registry.view<Render, WorldMatrix, LODAssign>();
+			view.each([&registry, &frustum, &sink](entt::entity entity, const Render& render, const WorldMatrix& world, const LODAssign& lod) {
+				if (registry.all_of<AABB>(entity) && !frustum.intersects(registry.get<AABB>(entity))) return;
+				sink += render.material.id + render.geometry.id + lod.lodIndex + static_cast<uint64_t>(world.rows[0].w != 0.f);
+			});
+		}));
+		Benchmark::log(m_renderResults.back());
+
+		// Packed proxies, the sync is paid once per frame however many passes draw the scene
+		m_renderResults.push_back(Benchmark::run("Render proxy sync", count, iterations, [&scene]() { scene.m_renderProxies.sync(); }));
+		Benchmark::log(m_renderResults.back());
+
+		m_renderResults.push_back(Benchmark::run("Render proxy iterate", count, iterations, [&scene, &frustum, &sink]() {
+			for (const RenderProxy& proxy : scene.m_renderProxies.getProxies())
+			{
+				if (!(proxy.flags & RenderProxy::hasLOD)) continue;
+				if ((proxy.flags & RenderProxy::hasBounds) && !frustum.intersects({ proxy.boundsMin, proxy.boundsMax })) continue;
+				sink += proxy.render.material.id + proxy.render.geometry.id + proxy.lodIndex + static_cast<uint64_t>(proxy.model[0].w != 0.f);
+			}
+		}));
+		Benchmark::log(m_renderResults.back());
+
+		spdlog::debug("Render benchmark checksum {}", sink);
+	}
+
+	Benchmark::writeCSV("./benchmarks/render_iteration.csv", m_renderResults);
+}
+
+
+void BenchmarkPanel::runBroadPhaseBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 20000, 100000 };
+	const std::array<BroadPhaseType, 3> types = { BroadPhaseType::PlaneSweep, BroadPhaseType::AABBTree, BroadPhaseType::HashGrid };
+	const uint32_t queryCount = 1000;
+
+	m_broadPhaseResults.clear();
+	std::vector<std::pair<entt::entity, AABB>> boxes;
+	std::vector<AABB> queries(queryCount);
+	std::vector<entt::entity> found;
+
+	for (bool belt : { true, false })
+	{
+		const char* layout = belt ? "belt" : "uniform";
+		for (uint32_t count : counts)
+		{
+			const uint32_t iterations = count >= 100000 ? 10 : (count >= 20000 ? 30 : 100);
+			if (belt) populateBelt(count, boxes);
+			else populateUniform(count, boxes);
+
+			// Regions around random asteroids, roughly what a ship sized proximity check asks for
+			for (auto& query : queries)
+			{
+				const AABB& around = boxes[Randomiser::uniformIntBetween(0, static_cast<int>(count) - 1)].second;
+				const glm::vec3 centre = (around.first + around.second) * 0.5f;
+				query = { centre - glm::vec3(10.f), centre + glm::vec3(10.f) };
+			}
+
+			for (BroadPhaseType type : types)
+			{
+				const std::string name = std::string(BroadPhaseBackend::getName(type)) + " " + layout;
+				std::unique_ptr<BroadPhaseBackend> backend = BroadPhase::createBackend(type);
+
+				m_broadPhaseResults.push_back(Benchmark::run(name + " build", count, iterations, [&backend, &boxes]() {
+					backend->build(boxes);
+					backend->getPairs();
+				}));
+				Benchmark::log(m_broadPhaseResults.back());
+
+				// Every box drifts a little each frame and back again the next, then the pairs are read
+				std::vector<std::pair<entt::entity, AABB>> moving = boxes;
+				float direction = 1.f;
+				m_broadPhaseResults.push_back(Benchmark::run(name + " update", count, iterations, [&backend, &moving, &direction]() {
+					for (auto& [entity, box] : moving)
+					{
+						const glm::vec3 step(0.05f * direction, 0.02f * direction, -0.05f * direction);
+						box = { box.first + step, box.second + step };
+						backend->updateEntity(entity, box);
+					}
+					backend->getPairs();
+					direction = -direction;
+				}));
+				Benchmark::log(m_broadPhaseResults.back());
+
+				uint64_t hits = 0;
+				m_broadPhaseResults.push_back(Benchmark::run(name + " query", queryCount, iterations, [&backend, &queries, &found, &hits]() {
+					for (const AABB& query : queries)
+					{
+						found.clear();
+						backend->query(query, found);
+						hits += found.size();
+					}
+				}));
+				Benchmark::log(m_broadPhaseResults.back());
+				spdlog::debug("{} pairs {}, query hits {}", name, backend->getPairs().size(), hits);
+			}
+		}
+	}
+
+	Benchmark::writeCSV("./benchmarks/broadphase.csv", m_broadPhaseResults);
+}
+
+void BenchmarkPanel::runNarrowPhaseBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 100000, 1000000 };
+
+	m_narrowPhaseResults.clear();
+	m_narrowPhaseValid = NarrowPhase::validate();
+
+	const bool previous = NarrowPhase::isSIMDEnabled();
+	std::vector<bool> paths = { false };
+	if (NarrowPhase::hasAVX2()) paths.push_back(true);
+
+	for (uint32_t count : counts)
+	{
+		const uint32_t iterations = count >= 1000000 ? 10 : (count >= 100000 ? 30 : 200);
+
+		// The ship against asteroids spread around it, then one waypoint sized box per pair
+		OrientedBox ship;
+		ship.halfExtents = glm::vec3(0.72f, 0.18f, 1.f);
+		SphereBatch spheres;
+		BoxSpherePairBatch pairs;
+		spheres.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::vec3 centre(Randomiser::uniformFloatBetween(-80.f, 80.f), Randomiser::uniformFloatBetween(-80.f, 80.f), Randomiser::uniformFloatBetween(-80.f, 80.f));
+			const float radius = Randomiser::uniformFloatBetween(0.4f, 5.f);
+			spheres.add(static_cast<entt::entity>(i), centre, radius);
+
+			OrientedBox waypoint;
+			const glm::mat3 rotation = glm::mat3_cast(glm::quat(glm::vec3(Randomiser::uniformFloatBetween(-3.f, 3.f), Randomiser::uniformFloatBetween(-3.f, 3.f), 0.f)));
+			for (int k = 0; k < 3; k++) waypoint.axes[k] = rotation[k];
+			waypoint.centre = centre + glm::vec3(Randomiser::uniformFloatBetween(-10.f, 10.f), 0.f, 0.f);
+			waypoint.halfExtents = glm::vec3(0.25f);
+			pairs.add(waypoint, static_cast<entt::entity>(i), centre, radius, static_cast<entt::entity>(i));
+		}
+
+		std::vector<float> distances;
+		for (bool simd : paths)
+		{
+			NarrowPhase::setSIMDEnabled(simd);
+			const std::string path = simd ? "AVX2" : "scalar";
+
+			m_narrowPhaseResults.push_back(Benchmark::run("Narrow one box " + path, count, iterations, [&ship, &spheres, &distances]() {
+				NarrowPhase::distancesToSpheres(ship, spheres, distances);
+			}));
+			Benchmark::log(m_narrowPhaseResults.back());
+
+			m_narrowPhaseResults.push_back(Benchmark::run("Narrow pairs " + path, count, iterations, [&pairs, &distances]() {
+				NarrowPhase::distancesForPairs(pairs, distances);
+			}));
+			Benchmark::log(m_narrowPhaseResults.back());
+		}
+	}
+	NarrowPhase::setSIMDEnabled(previous);
+
+	Benchmark::writeCSV("./benchmarks/narrow_phase.csv", m_narrowPhaseResults);
+}
+
+void BenchmarkPanel::runSpatialQueryBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 100000, 1000000 };
+	const uint32_t queryCount = 256;
+	const uint32_t k = 8;
+	const float radius = 25.f;
+
+	m_spatialQueryResults.clear();
+	m_spatialQueryValid = true;
+	std::vector<std::pair<entt::entity, AABB>> boxes;
+	std::vector<glm::vec3> centres;
+	std::vector<float> radii;
+	std::vector<SpatialHit> scratch;
+
+	for (uint32_t count : counts)
+	{
+		const uint32_t iterations = count >= 1000000 ? 3 : (count >= 100000 ? 10 : 100);
+		populateBelt(count, boxes);
+		centres.resize(count);
+		radii.resize(count);
+		SpatialIndex index;
+		index.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			centres[i] = (boxes[i].second.first + boxes[i].second.second) * 0.5f;
+			radii[i] = (boxes[i].second.second.x - boxes[i].second.first.x) * 0.5f;
+			index.add(boxes[i].first, centres[i], radii[i]);
+		}
+
+		// Queries from points near random asteroids, as the ship and AI agents would make
+		std::vector<RadiusQuery> radiusQueries(queryCount);
+		std::vector<NearestQuery> nearestQueries(queryCount);
+		for (uint32_t i = 0; i < queryCount; i++)
+		{
+			const glm::vec3 centre = centres[Randomiser::uniformIntBetween(0, static_cast<int>(count) - 1)] + glm::vec3(Randomiser::uniformFloatBetween(-5.f, 5.f));
+			radiusQueries[i] = { centre, radius };
+			nearestQueries[i] = { centre, k };
+		}
+
+		m_spatialQueryResults.push_back(Benchmark::run("Spatial k-d build", count, iterations, [&index]() {
+			index.build();
+		}));
+		Benchmark::log(m_spatialQueryResults.back());
+
+		// Every collider's distance tested for every query, as the HUD loops in GAMR3531 used to
+		uint64_t bruteHits = 0;
+		m_spatialQueryResults.push_back(Benchmark::run("Spatial brute radius", queryCount, iterations, [&]() {
+			bruteHits = 0;
+			for (const RadiusQuery& query : radiusQueries)
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					if (glm::length(centres[i] - query.centre) - radii[i] <= query.radius) bruteHits++;
+				}
+			}
+		}));
+		Benchmark::log(m_spatialQueryResults.back());
+
+		std::vector<SpatialHit> hits(static_cast<size_t>(queryCount) * 256);
+		std::vector<QueryRange> ranges(queryCount);
+		uint64_t indexHits = 0;
+		m_spatialQueryResults.push_back(Benchmark::run("Spatial k-d radius", queryCount, iterations, [&]() {
+			index.withinRadius(radiusQueries, hits, ranges);
+			indexHits = 0;
+			for (const QueryRange& range : ranges) indexHits += range.count;
+		}));
+		Benchmark::log(m_spatialQueryResults.back());
+
+		bool truncated = false;
+		for (const QueryRange& range : ranges) truncated |= range.truncated;
+		if (!truncated && indexHits != bruteHits) {
+			spdlog::error("Spatial radius query at {} found {} hits, brute force found {}", count, indexHits, bruteHits);
+			m_spatialQueryValid = false;
+		}
+
+		// Brute force nearest measures everything then partially sorts
+		float bruteNearest = 0.f;
+		scratch.resize(count);
+		m_spatialQueryResults.push_back(Benchmark::run("Spatial brute nearest", queryCount, iterations, [&]() {
+			bruteNearest = 0.f;
+			for (const NearestQuery& query : nearestQueries)
+			{
+				for (uint32_t i = 0; i < count; i++) scratch[i] = { boxes[i].first, glm::length(centres[i] - query.centre) - radii[i] };
+				std::partial_sort(scratch.begin(), scratch.begin() + query.k, scratch.end(), [](const SpatialHit& a, const SpatialHit& b) { return a.distance < b.distance; });
+				bruteNearest += scratch[query.k - 1].distance;
+			}
+		}));
+		Benchmark::log(m_spatialQueryResults.back());
+
+		float indexNearest = 0.f;
+		m_spatialQueryResults.push_back(Benchmark::run("Spatial k-d nearest", queryCount, iterations, [&]() {
+			index.nearest(nearestQueries, hits, ranges);
+			indexNearest = 0.f;
+			for (const QueryRange& range : ranges) indexNearest += hits[range.offset + range.count - 1].distance;
+		}));
+		Benchmark::log(m_spatialQueryResults.back());
+
+		if (std::abs(indexNearest - bruteNearest) > 1e-3f * std::max(1.f, std::abs(bruteNearest))) {
+			spdlog::error("Spatial nearest query at {} summed {}, brute force summed {}", count, indexNearest, bruteNearest);
+			m_spatialQueryValid = false;
+		}
+	}
+
+	Benchmark::writeCSV("./benchmarks/spatial_query.csv", m_spatialQueryResults);
+}
+
+void BenchmarkPanel::runCommandBufferBenchmark()
+{
+	const std::array<uint32_t, 3> counts = { 2000, 100000, 1000000 };
+	const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	m_commandBufferResults.clear();
+	const uint32_t threads = std::min(hardwareThreads, CommandBuffer::maxLanes);
+
+	// The components every asteroid is given by generateLevel
+	auto makeLocal = [](uint32_t i) { return LocalTRS(glm::vec3(static_cast<float>(i % 1000), static_cast<float>(i / 1000), 0.f), glm::vec3(0.f), glm::vec3(1.f)); };
+	auto record = [&makeLocal](CommandBuffer& commands, uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++)
+		{
+			const PendingEntity entity = commands.create();
+			const LocalTRS local = makeLocal(i);
+			WorldMatrix world;
+			TransformSystem::compose(local, world);
+			commands.emplace(entity, Render{ MaterialHandle(i % 4, 1), VAOHandle(i % 4, 1) });
+			commands.emplace(entity, local);
+			commands.emplace(entity, world);
+			commands.emplace(entity, LODAssign{ 0, 1 });
+		}
+	};
+
+	for (uint32_t count : counts)
+	{
+		const uint32_t iterations = count >= 1000000 ? 5 : (count >= 100000 ? 20 : 100);
+
+		m_commandBufferResults.push_back(Benchmark::run("Structural direct emplace", count, iterations, [count, &makeLocal]() {
+			entt::registry registry;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const entt::entity entity = registry.create();
+				registry.emplace<Render>(entity, MaterialHandle(i % 4, 1), VAOHandle(i % 4, 1));
+				TransformSystem::emplace(registry, entity, makeLocal(i));
+				registry.emplace<LODAssign>(entity, 0u, 1);
+			}
+		}));
+		Benchmark::log(m_commandBufferResults.back());
+
+		CommandBuffer commands;
+		m_commandBufferResults.push_back(Benchmark::run("Structural command buffer 1 thread", count, iterations, [count, &commands, &record]() {
+			entt::registry registry;
+			record(commands, 0, count);
+			commands.apply(registry);
+		}));
+		Benchmark::log(m_commandBufferResults.back());
+
+		// Workers record into their own lanes with no locks, the apply is still one batch
+		m_commandBufferResults.push_back(Benchmark::run("Structural command buffer " + std::to_string(threads) + " threads", count, iterations, [count, threads, &commands, &record]() {
+			entt::registry registry;
+			std::vector<std::thread> workers;
+			const uint32_t perThread = (count + threads - 1) / threads;
+			for (uint32_t begin = 0; begin < count; begin += perThread) workers.emplace_back(record, std::ref(commands), begin, std::min(begin + perThread, count));
+			for (auto& worker : workers) worker.join();
+			commands.apply(registry);
+		}));
+		Benchmark::log(m_commandBufferResults.back());
+	}
+
+	Benchmark::writeCSV("./benchmarks/command_buffer.csv", m_commandBufferResults);
+}
+
+void BenchmarkPanel::runJobSystemBenchmark()
+{
+	const uint32_t maxThreads = JobSystem::getThreadCount();
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+	threadCounts.push_back(maxThreads);
+
+	m_jobSystemResults.clear();
+	auto logSpeedup = [this](double serialMs) {
+		const BenchmarkResult& result = m_jobSystemResults.back();
+		Benchmark::log(result);
+		spdlog::info("  {:.2f}x the 1 thread time", result.meanMs > 0.0 ? serialMs / result.meanMs : 0.0);
+	};
+
+	// Compute bound, every element independent, shows the ceiling the pool can reach
+	{
+		const uint32_t count = 4000000;
+		std::vector<float> input(count);
+		std::vector<float> output(count);
+		for (uint32_t i = 0; i < count; i++) input[i] = Randomiser::uniformFloatBetween(0.f, 100.f);
+
+		double serialMs = 0.0;
+		for (uint32_t threads : threadCounts)
+		{
+			m_jobSystemResults.push_back(Benchmark::run("Jobs compute " + std::to_string(threads) + " threads", count, 20, [&input, &output, count, threads]() {
+				JobSystem::parallelFor(0, count, [&input, &output](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++) output[i] = std::sqrt(input[i]) * std::sin(input[i]) + std::cos(input[i] * 0.5f);
+				}, 1, threads);
+			}));
+			if (threads == 1) serialMs = m_jobSystemResults.back().meanMs;
+			logSpeedup(serialMs);
+		}
+	}
+
+	// SpinSystem steps, memory bound as the results are written back to the registry
+	{
+		const uint32_t count = 1000000;
+		auto scene = std::make_shared<Scene>();
+		auto& registry = scene->m_entities;
+		std::vector<entt::entity> entities;
+		std::vector<glm::vec3> speeds;
+		populateSpinners(registry, count, entities, speeds);
+		for (uint32_t i = 0; i < count; i++) registry.emplace<AngularVelocity>(entities[i], speeds[i]);
+		SpinSystem spinSystem(registry, 1.f / 60.f);
+
+		double serialMs = 0.0;
+		for (uint32_t threads : threadCounts)
+		{
+			spinSystem.setThreadCount(threads);
+			m_jobSystemResults.push_back(Benchmark::run("Jobs SpinSystem " + std::to_string(threads) + " threads", count, 10, [&spinSystem]() { spinSystem.step(); }));
+			if (threads == 1) serialMs = m_jobSystemResults.back().meanMs;
+			logSpeedup(serialMs);
+		}
+	}
+
+	// Frustum culling of packed proxies, as the renderer does for each pass
+	{
+		const uint32_t count = 1000000;
+		Scene scene;
+		populateRenderables(scene.m_entities, count);
+		scene.m_renderProxies.sync();
+		const auto& proxies = scene.m_renderProxies.getProxies();
+		std::vector<uint8_t> visible(proxies.size());
+
+		Camera camera;
+		camera.projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 1000.f);
+		camera.updateView(glm::mat4(1.f));
+		const CameraFrustrum frustum(camera);
+
+		double serialMs = 0.0;
+		for (uint32_t threads : threadCounts)
+		{
+			m_jobSystemResults.push_back(Benchmark::run("Jobs culling " + std::to_string(threads) + " threads", count, 10, [&proxies, &visible, &frustum, threads]() {
+				JobSystem::parallelFor(0, proxies.size(), [&proxies, &visible, &frustum](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++)
+					{
+						const RenderProxy& proxy = proxies[i];
+						visible[i] = (proxy.flags & RenderProxy::hasLOD) && (!(proxy.flags & RenderProxy::hasBounds) || frustum.intersects({ proxy.boundsMin, proxy.boundsMax }));
+					}
+				}, Renderer::cullingGrain, threads);
+			}));
+			if (threads == 1) serialMs = m_jobSystemResults.back().meanMs;
+			logSpeedup(serialMs);
+		}
+	}
+
+	// Submission, execution and completion of tiny jobs, the floor below which work should not be split
+	{
+		const uint32_t count = 10000;
+		std::atomic<uint32_t> done{ 0 };
+		m_jobSystemResults.push_back(Benchmark::run("Jobs overhead " + std::to_string(maxThreads) + " threads", count, 50, [&done, count]() {
+			JobCounter counter;
+			for (uint32_t i = 0; i < count; i++) JobSystem::run(counter, [&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+			JobSystem::wait(counter);
+		}));
+		Benchmark::log(m_jobSystemResults.back());
+	}
+
+	Benchmark::writeCSV("./benchmarks/job_system.csv", m_jobSystemResults);
+}
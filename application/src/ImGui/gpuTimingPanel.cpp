@@ -0,0 +1,60 @@
+#include "include/ImGui/gpuTimingPanel.hpp"
+
+void GPUTimingPanel::onImGuiRender()
+{
+	const std::vector<GPUPassTiming> timings = GPUProfiler::getTimings();
+
+	if (ImGui::TreeNode("GPU timings"))
+	{
+		ImGui::Checkbox("Overlay", &m_showOverlay);
+		ImGui::SameLine();
+		if (ImGui::Button("Export CSV")) GPUProfiler::exportCSV("./benchmarks/gpu_timings.csv");
+
+		float total = 0.f;
+		for (const auto& timing : timings) total += timing.avgMs;
+		ImGui::Text("Average total: %.3fms, read back %u frames late, %llu frames not ready", total, GPUProfiler::latency, GPUProfiler::getLateFrames());
+
+		drawTable("GPUTimings", timings);
+		ImGui::TreePop();
+	}
+
+	if (!m_showOverlay) return;
+
+	// Top right corner, out of the way of the HUD
+	const ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos({ viewport->WorkPos.x + viewport->WorkSize.x - 10.f, viewport->WorkPos.y + 10.f }, ImGuiCond_Always, { 1.f, 0.f });
+	ImGui::SetNextWindowViewport(viewport->ID);
+	ImGui::SetNextWindowBgAlpha(0.6f);
+	const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+	if (ImGui::Begin("GPU timings overlay", &m_showOverlay, flags)) drawTable("GPUTimingsOverlay", timings);
+	ImGui::End();
+}
+
+void GPUTimingPanel::drawTable(const char* id, const std::vector<GPUPassTiming>& timings) const
+{
+	if (timings.empty()) {
+		ImGui::TextUnformatted("No passes timed yet");
+		return;
+	}
+
+	if (ImGui::BeginTable(id, 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+	{
+		ImGui::TableSetupColumn("Pass");
+		ImGui::TableSetupColumn("Last ms");
+		ImGui::TableSetupColumn("Min ms");
+		ImGui::TableSetupColumn("Avg ms");
+		ImGui::TableSetupColumn("P95 ms");
+		ImGui::TableHeadersRow();
+		for (const auto& timing : timings)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(timing.name.c_str());
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.lastMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.minMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.avgMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.p95Ms);
+		}
+		ImGui::EndTable();
+	}
+}
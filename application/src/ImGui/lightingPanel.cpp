@@ -0,0 +1,96 @@
+#include "include/ImGui/lightingPanel.hpp"
+#include "core/randomiser.hpp"
+
+void LightingPanel::onImGuiRender()
+{
+	if (ImGui::TreeNode("Clustered lighting"))
+	{
+		// The scene's counts, the uploaded ones belong to whichever thread is drawing
+		ImGui::Text("Point lights: %zu", m_scene->m_pointLights.size());
+		ImGui::Text("Spot lights: %zu", m_scene->m_spotLights.size());
+		ImGui::Text("Clusters: %u x %u x %u", ClusterConsts::gridX, ClusterConsts::gridY, ClusterConsts::gridZ);
+
+		if (m_running)
+		{
+			ImGui::Text("Benchmarking %u lights, frame %u", m_lightCount, m_frame);
+		}
+		else if (ImGui::Button("Run light scaling benchmark"))
+		{
+			startBenchmark();
+		}
+
+		for (auto& result : m_results)
+		{
+			ImGui::Text("%5llu lights: mean %.3fms  p95 %.3fms", static_cast<unsigned long long>(result.elements), result.meanMs, result.p95Ms);
+		}
+
+		ImGui::TreePop();
+	}
+}
+
+void LightingPanel::beginFrame()
+{
+	glFinish(); // Don't time work queued by the previous frame
+	static_cast<void>(m_timer.reset());
+}
+
+void LightingPanel::endFrame()
+{
+	glFinish();
+	double frameMs = static_cast<double>(m_timer.reset()) * 1000.0;
+
+	m_frame++;
+	if (m_frame <= m_warmupFrames) return;
+
+	m_samples.push_back(frameMs);
+	if (m_samples.size() < m_timedFrames) return;
+
+	auto result = Benchmark::fromSamples("Clustered lighting " + std::to_string(m_lightCount) + " lights", m_lightCount, m_samples);
+	Benchmark::log(result);
+	m_results.push_back(result);
+
+	if (m_lightCount >= m_maxLights) finishBenchmark();
+	else
+	{
+		m_lightCount *= 2;
+		startStep();
+	}
+}
+
+void LightingPanel::startBenchmark()
+{
+	m_savedLights = m_scene->m_pointLights;
+	m_results.clear();
+	m_lightCount = 2;
+	m_running = true;
+	startStep();
+}
+
+void LightingPanel::startStep()
+{
+	glm::vec3 centre = m_scene->m_entities.get<WorldMatrix>(m_camera).getTranslation();
+
+	m_scene->m_pointLights.resize(m_lightCount);
+	for (auto& light : m_scene->m_pointLights)
+	{
+		light.position = centre + glm::vec3(
+			Randomiser::uniformFloatBetween(-m_spread, m_spread),
+			Randomiser::uniformFloatBetween(-m_spread, m_spread),
+			Randomiser::uniformFloatBetween(-m_spread, m_spread));
+		light.colour = glm::vec3(
+			Randomiser::uniformFloatBetween(0.2f, 1.f),
+			Randomiser::uniformFloatBetween(0.2f, 1.f),
+			Randomiser::uniformFloatBetween(0.2f, 1.f));
+		light.constants = glm::vec3(1.f, 0.22f, 0.2f); // Range of roughly 15 units
+	}
+
+	m_frame = 0;
+	m_samples.clear();
+}
+
+void LightingPanel::finishBenchmark()
+{
+	m_running = false;
+	m_scene->m_pointLights = m_savedLights;
+	Benchmark::writeCSV("./benchmarks/clustered_lighting.csv", m_results);
+}
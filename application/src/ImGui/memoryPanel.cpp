@@ -0,0 +1,153 @@
+#include "include/ImGui/memoryPanel.hpp"
+#include <algorithm>
+#include <vector>
+
+void MemoryPanel::onImGuiRender()
+{
+	if (ImGui::TreeNode("Allocations"))
+	{
+		bool enabled = AllocationAudit::isEnabled();
+		if (ImGui::Checkbox("Audit zones", &enabled)) AllocationAudit::setEnabled(enabled);
+		ImGui::SameLine();
+		if (AllocationAudit::isArmed()) {
+			if (ImGui::Button("Disarm")) AllocationAudit::disarm();
+		}
+		else if (ImGui::Button("Arm")) AllocationAudit::arm();
+		ImGui::SameLine();
+		if (ImGui::Button("Report")) AllocationAudit::report();
+
+		ImGui::Text("Last frame: %llu allocations, %llu bytes, %llu frees", AllocationAudit::getLastFrameAllocations(), AllocationAudit::getLastFrameBytes(),
+			AllocationAudit::getLastFrameFrees());
+		ImGui::Text("Armed: %llu frames, %llu allocations, worst frame %llu", AllocationAudit::getArmedFrames(), AllocationAudit::getArmedAllocations(),
+			AllocationAudit::getWorstArmedFrame());
+
+		// Zones which allocated last frame, busiest first
+		std::vector<AllocationZoneStats> zones;
+		for (size_t i = 0; i < AllocationAudit::getZoneCount(); i++)
+		{
+			AllocationZoneStats zone = AllocationAudit::getZone(i);
+			if (zone.lastFrameAllocations > 0 || zone.armedAllocations > 0) zones.push_back(zone);
+		}
+		std::sort(zones.begin(), zones.end(), [](const AllocationZoneStats& a, const AllocationZoneStats& b) { return a.lastFrameAllocations > b.lastFrameAllocations; });
+
+		if (!zones.empty() && ImGui::BeginTable("AllocationZones", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Zone");
+			ImGui::TableSetupColumn("Allocations");
+			ImGui::TableSetupColumn("Bytes");
+			ImGui::TableSetupColumn("Armed");
+			ImGui::TableHeadersRow();
+			for (const auto& zone : zones)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(zone.name);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", zone.lastFrameAllocations);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", zone.lastFrameBytes);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", zone.armedAllocations);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Memory tags"))
+	{
+		ImGui::Text("Heap held: %.2fMB", static_cast<float>(MemoryTracker::getTotalBytes()) / megabyte);
+		if (ImGui::Button("Reset peaks")) MemoryTracker::resetPeaks();
+		ImGui::SameLine();
+		if (ImGui::Button("Write report")) MemoryTracker::writeReport("./benchmarks/memory_report.json");
+
+		if (ImGui::BeginTable("MemoryTags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Current MB");
+			ImGui::TableSetupColumn("Peak MB");
+			ImGui::TableSetupColumn("Live");
+			ImGui::TableSetupColumn("Budget MB");
+			ImGui::TableSetupColumn("Fail");
+			ImGui::TableHeadersRow();
+			for (size_t i = 0; i < MemoryTracker::tagCount; i++)
+			{
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				const MemoryTagStats stats = MemoryTracker::getStats(tag);
+				ImGui::PushID(static_cast<int>(i));
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.name);
+				ImGui::TableNextColumn();
+				if (stats.overBudget) ImGui::TextColored(ImVec4(1.f, 0.3f, 0.3f, 1.f), "%.2f", static_cast<float>(stats.currentBytes) / megabyte);
+				else ImGui::Text("%.2f", static_cast<float>(stats.currentBytes) / megabyte);
+				ImGui::TableNextColumn(); ImGui::Text("%.2f", static_cast<float>(stats.peakBytes) / megabyte);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", stats.liveAllocations);
+
+				// A budget of zero turns the check off
+				float budget = static_cast<float>(stats.budgetBytes) / megabyte;
+				bool fail = stats.action == MemoryBudgetAction::fail;
+				ImGui::TableNextColumn();
+				ImGui::SetNextItemWidth(-1.f);
+				const bool budgetChanged = ImGui::InputFloat("##Budget", &budget, 0.f, 0.f, "%.1f", ImGuiInputTextFlags_EnterReturnsTrue);
+				ImGui::TableNextColumn();
+				const bool failChanged = ImGui::Checkbox("##Fail", &fail);
+				if (budgetChanged || failChanged) MemoryTracker::setBudget(tag, static_cast<uint64_t>(std::max(budget, 0.f) * megabyte), fail ? MemoryBudgetAction::fail : MemoryBudgetAction::log);
+				ImGui::PopID();
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("GPU memory"))
+	{
+		const uint64_t budget = GPUMemory::getBudget();
+		ImGui::Text("Device memory: %.2fMB, peak %.2fMB", static_cast<float>(GPUMemory::getTotalBytes()) / megabyte, static_cast<float>(GPUMemory::getPeakBytes()) / megabyte);
+		if (budget > 0) ImGui::ProgressBar(static_cast<float>(GPUMemory::getTotalBytes()) / static_cast<float>(budget), ImVec2(-1.f, 0.f), "of budget");
+
+		float budgetMB = static_cast<float>(budget) / megabyte;
+		if (ImGui::InputFloat("Budget MB", &budgetMB, 0.f, 0.f, "%.1f", ImGuiInputTextFlags_EnterReturnsTrue)) GPUMemory::setBudget(static_cast<uint64_t>(std::max(budgetMB, 0.f) * megabyte));
+		if (ImGui::Button("Write GPU report")) GPUMemory::writeReport("./benchmarks/gpu_memory_report.json");
+
+		if (ImGui::BeginTable("GPUTypes", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Type");
+			ImGui::TableSetupColumn("MB");
+			ImGui::TableSetupColumn("Count");
+			ImGui::TableHeadersRow();
+			for (size_t i = 0; i < GPUMemory::typeCount; i++)
+			{
+				const GPUTypeStats stats = GPUMemory::getTypeStats(static_cast<GPUResourceType>(i));
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.name);
+				ImGui::TableNextColumn(); ImGui::Text("%.2f", static_cast<float>(stats.bytes) / megabyte);
+				ImGui::TableNextColumn(); ImGui::Text("%u", stats.count);
+			}
+			ImGui::EndTable();
+		}
+
+		// Owners, largest first, with their split by type on hover
+		if (ImGui::BeginTable("GPUOwners", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Owner");
+			ImGui::TableSetupColumn("MB");
+			ImGui::TableSetupColumn("Count");
+			ImGui::TableHeadersRow();
+			for (const auto& owner : GPUMemory::getOwnerStats())
+			{
+				if (owner.count == 0) continue;
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(owner.name.c_str());
+				if (ImGui::IsItemHovered())
+				{
+					ImGui::BeginTooltip();
+					for (size_t i = 0; i < GPUMemory::typeCount; i++)
+					{
+						if (owner.typeBytes[i] > 0) ImGui::Text("%s: %.2fMB", GPUMemory::getName(static_cast<GPUResourceType>(i)), static_cast<float>(owner.typeBytes[i]) / megabyte);
+					}
+					ImGui::EndTooltip();
+				}
+				ImGui::TableNextColumn(); ImGui::Text("%.2f", static_cast<float>(owner.bytes) / megabyte);
+				ImGui::TableNextColumn(); ImGui::Text("%u", owner.count);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
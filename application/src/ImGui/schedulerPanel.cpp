@@ -0,0 +1,49 @@
+#include "include/ImGui/schedulerPanel.hpp"
+#include <algorithm>
+
+void SchedulerPanel::onImGuiRender()
+{
+	if (ImGui::TreeNode("Systems"))
+	{
+		const float frameMs = m_scheduler.getFrameMs();
+		ImGui::Text("Frame %.3fms, serial %.3fms, critical path %.3fms", frameMs, m_scheduler.getSerialMs(), m_scheduler.getCriticalPathMs());
+		if (frameMs > 0.f) ImGui::Text("Parallel speedup %.2fx on %u threads", m_scheduler.getSerialMs() / frameMs, JobSystem::getThreadCount());
+
+		// Timeline of the last frame, a row per thread
+		uint32_t rows = 1;
+		for (uint32_t i = 0; i < m_scheduler.size(); i++) rows = std::max(rows, m_scheduler.getTiming(i).thread + 1);
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const float width = std::max(100.f, ImGui::GetContentRegionAvail().x);
+		const float rowHeight = ImGui::GetTextLineHeight() + 4.f;
+		const float scale = width / std::max(frameMs, 0.001f);
+
+		drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + rows * rowHeight), IM_COL32(30, 30, 30, 255));
+		for (uint32_t i = 0; i < m_scheduler.size(); i++)
+		{
+			const SystemTiming& timing = m_scheduler.getTiming(i);
+			const ImVec2 min(origin.x + timing.startMs * scale, origin.y + timing.thread * rowHeight + 1.f);
+			const ImVec2 max(min.x + std::max(2.f, timing.durationMs * scale), min.y + rowHeight - 2.f);
+			drawList->AddRectFilled(min, max, timing.critical ? IM_COL32(200, 60, 60, 255) : IM_COL32(70, 130, 180, 255));
+			drawList->PushClipRect(min, max, true);
+			drawList->AddText(ImVec2(min.x + 2.f, min.y + 1.f), IM_COL32_WHITE, m_scheduler.getName(i).c_str());
+			drawList->PopClipRect();
+			if (ImGui::IsMouseHoveringRect(min, max)) ImGui::SetTooltip("%s\n%.3fms, average %.3fms", m_scheduler.getName(i).c_str(), timing.durationMs, timing.averageMs);
+		}
+		ImGui::Dummy(ImVec2(width, rows * rowHeight));
+
+		// Each system, critical ones starred, with what it waits for
+		for (uint32_t i = 0; i < m_scheduler.size(); i++)
+		{
+			const SystemTiming& timing = m_scheduler.getTiming(i);
+			std::string after;
+			for (uint32_t dependency : m_scheduler.getDependencies(i)) after += (after.empty() ? "" : ", ") + m_scheduler.getName(dependency);
+			ImGui::Text("%s %-12s %7.3fms  thread %u%s  after: %s", timing.critical ? "*" : " ", m_scheduler.getName(i).c_str(), timing.averageMs, timing.thread,
+				m_scheduler.isMainThread(i) ? " (main)" : "", after.empty() ? "-" : after.c_str());
+		}
+
+		if (ImGui::Button("Export frame graph")) m_scheduler.exportGraph("./benchmarks/frame_graph.dot");
+		ImGui::TreePop();
+	}
+}
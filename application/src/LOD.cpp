@@ -47,6 +47,7 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 	asteroidMaterials->setValue("roughTexture", asteroid_rough);
 	asteroidMaterials->setValue("metalTexture", asteroid_metal);
 	asteroidMaterials->setValue("aoTexture", asteroid_AO);
+	MaterialHandle asteroidMaterialHandle = ResourceRegistry::add(asteroidMaterials);
 
 	Model asteroidModel("./assets/models/asteroid1/asteroid.obj", attributeTypes);
 
@@ -57,16 +58,15 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		entt::entity raw = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(raw);
-		renderComp.geometry = asteroidVAOs[0];
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(asteroidVAOs[0]);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(raw);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, raw);
 		transformComp.translation = glm::vec3(-2.f, 2.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, raw);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(raw);
-		scriptComp.attachScript<RotationScript>(raw, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, raw, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 	}
 
 	const size_t vertexCountOnLoad = asteroidModel.m_meshes[0].vertices.size() / vertexComponents;
@@ -193,16 +193,15 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		entt::entity optimised = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(optimised);
-		renderComp.geometry = asteroidVAOs[1];
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(asteroidVAOs[1]);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(optimised);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, optimised);
 		transformComp.translation = glm::vec3(2.f, 2.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, optimised);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(optimised);
-		scriptComp.attachScript<RotationScript>(optimised, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, optimised, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 
 	}
 
@@ -212,16 +211,15 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		entt::entity LOD1 = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(LOD1);
-		renderComp.geometry = asteroidVAOs[2];
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(asteroidVAOs[2]);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(LOD1);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, LOD1);
 		transformComp.translation = glm::vec3(-2.f, -2.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, LOD1);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(LOD1);
-		scriptComp.attachScript<RotationScript>(LOD1, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, LOD1, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 	}
 
 	asteroidVAOs[3] = std::make_shared<VAO>(m_indicesLOD2);
@@ -230,16 +228,15 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		entt::entity LOD2 = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(LOD2);
-		renderComp.geometry = asteroidVAOs[3];
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(asteroidVAOs[3]);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(LOD2);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, LOD2);
 		transformComp.translation = glm::vec3(2.f, -2.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, LOD2);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(LOD2);
-		scriptComp.attachScript<RotationScript>(LOD2, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, LOD2, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 	}
 
 	asteroidVAOs[4] = std::make_shared<VAO>(m_indicesLOD3);
@@ -248,16 +245,15 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		entt::entity LOD3 = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(LOD3);
-		renderComp.geometry = asteroidVAOs[4];
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(asteroidVAOs[4]);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(LOD3);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, LOD3);
 		transformComp.translation = glm::vec3(0.f, 0.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, LOD3);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(LOD3);
-		scriptComp.attachScript<RotationScript>(LOD3, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, LOD3, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 	}
 
 	std::vector<uint32_t> allIndices;
@@ -274,19 +270,19 @@ LOD::LOD(GLFWWindowImpl& win) : Layer(win)
 		allLODs = m_mainScene->m_entities.create();
 
 		auto& renderComp = m_mainScene->m_entities.emplace<Render>(allLODs);
-		renderComp.geometry = allLODsVAO;
-		renderComp.material = asteroidMaterials;
+		renderComp.geometry = ResourceRegistry::add(allLODsVAO);
+		renderComp.material = asteroidMaterialHandle;
 
-		auto& transformComp = m_mainScene->m_entities.emplace<Transform>(allLODs);
+		auto& transformComp = TransformSystem::emplace(m_mainScene->m_entities, allLODs);
 		transformComp.translation = glm::vec3(0.f, 0.f, -6.f);
 		transformComp.scale = glm::vec3(1.0);
-		transformComp.recalc();
+		TransformSystem::markDirty(m_mainScene->m_entities, allLODs);
 
-		auto& scriptComp = m_mainScene->m_entities.emplace<ScriptComp>(allLODs);
-		scriptComp.attachScript<RotationScript>(allLODs, m_mainScene, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
+		ScriptSystem::attach<RotationScript>(m_mainScene, allLODs, glm::vec3(0.4f, 0.25f, -0.6f), GLFW_KEY_SPACE);
 
 	}
 
+	mainPass.name = "Main";
 	mainPass.scene = m_mainScene;
 	mainPass.parseScene();
 	mainPass.target = std::make_shared<FBO>();
@@ -318,12 +314,9 @@ void LOD::onUpdate(float timestep)
 
 	timestep = std::clamp(timestep, 0.f, 0.1f); // Clamp to be no more than a 10th of a second for physics
 	// Update scripts
-	auto view = m_mainScene->m_entities.view<ScriptComp>();
-	for (auto entity : view)
-	{
-		auto& script = view.get<ScriptComp>(entity);
-		script.onUpdate(timestep);
-	}
+	ScriptSystem::onUpdate(m_mainScene->m_entities, timestep);
+
+	TransformSystem::update(m_mainScene->m_entities);
 
 }
 
@@ -348,11 +341,6 @@ void LOD::onImGUIRender()
 {
 
 	// Scripts
-	auto view = m_mainScene->m_entities.view<ScriptComp>();
-	for (auto entity : view)
-	{
-		auto& script = view.get<ScriptComp>(entity);
-		script.onImGuiRender();
-	}
+	ScriptSystem::onImGuiRender(m_mainScene->m_entities);
 
 }
@@ -6,6 +6,14 @@
 App::App(const WindowProperties& winProps) : Application(winProps)
 {
 	m_layer = std::unique_ptr<Layer>(new AsteriodBelt(m_window));
+	m_fixedTimestep.setRate(60.f); // Physics and collisions, rendering runs as fast as it can
+	m_fixedTimestep.setMaxSubsteps(4);
+	MemoryTracker::setBudget(MemoryTag::assets, 512ull << 20); // Host side budgets, over budget tags are logged once per crossing
+	MemoryTracker::setBudget(MemoryTag::ecs, 64ull << 20);
+	MemoryTracker::setBudget(MemoryTag::physics, 32ull << 20);
+	MemoryTracker::setBudget(MemoryTag::rendering, 64ull << 20);
+	MemoryTracker::setBudget(MemoryTag::ui, 16ull << 20);
+	GPUMemory::setBudget(1ull << 30); // Device memory across every GL resource
 	//m_layer = std::unique_ptr<Layer>(new LOD(m_window));
 }
 
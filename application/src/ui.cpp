@@ -58,14 +58,14 @@ void UI::init(const glm::ivec2& size)
 
 		m_quads = m_UIScene->m_entities.create();
 
-		m_UIScene->m_entities.emplace<Transform>(m_quads);
+		TransformSystem::emplace(m_UIScene->m_entities, m_quads);
 
 		auto& renderComp = m_UIScene->m_entities.emplace<Render>(m_quads);
-		renderComp.geometry = quadsVAO;
-		renderComp.material = quadsMaterial;
+		renderComp.geometry = ResourceRegistry::add(quadsVAO);
+		renderComp.material = ResourceRegistry::add(quadsMaterial);
 
-		renderComp.material->setValue("u_textureSlots[0]", slots.data());
-		renderComp.geometry->overrideDrawCount(0);
+		quadsMaterial->setValue("u_textureSlots[0]", slots.data());
+		quadsVAO->overrideDrawCount(0);
 
 		
 		auto& lodComp = m_UIScene->m_entities.emplace<LODAssign>(m_quads);
@@ -87,12 +87,12 @@ void UI::init(const glm::ivec2& size)
 	{
 		m_circles = m_UIScene->m_entities.create();
 
-		m_UIScene->m_entities.emplace<Transform>(m_circles);
+		TransformSystem::emplace(m_UIScene->m_entities, m_circles);
 
 		auto& renderComp = m_UIScene->m_entities.emplace<Render>(m_circles);
-		renderComp.geometry = circlesVAO;
-		renderComp.material = circleMaterial;
-		renderComp.geometry->overrideDrawCount(0);
+		renderComp.geometry = ResourceRegistry::add(circlesVAO);
+		renderComp.material = ResourceRegistry::add(circleMaterial);
+		circlesVAO->overrideDrawCount(0);
 
 		auto& lodComp = m_UIScene->m_entities.emplace<LODAssign>(m_circles);
 		lodComp.lodNumber = lodNonAsteroid;
@@ -102,6 +102,7 @@ void UI::init(const glm::ivec2& size)
 	*  UI Pass
 	**************************/
 	RenderPass UIpass;
+	UIpass.name = "UI";
 	UIpass.scene = m_UIScene;
 	UIpass.parseScene();
 	UIpass.clearColour = false;
@@ -145,12 +146,12 @@ void UI::begin()
 	// Clear quad data
 	m_currentQuadCount = 0;
 	auto& quadsRender = m_UIScene->m_entities.get<Render>(m_quads);
-	quadsRender.geometry->overrideDrawCount(0);
+	ResourceRegistry::get(quadsRender.geometry)->overrideDrawCount(0);
 
 	// Clear circle data
 	m_currentCircleCount = 0;
 	auto& circlesRender = m_UIScene->m_entities.get<Render>(m_circles);
-	circlesRender.geometry->overrideDrawCount(0);
+	ResourceRegistry::get(circlesRender.geometry)->overrideDrawCount(0);
 }
 
 void UI::end()
@@ -159,13 +160,13 @@ void UI::end()
 	m_quadsSSBO->edit(0, sizeof(QuadVertex) * m_currentQuadCount * 4, m_quadVertices.data());
 	// Set quad draw count
 	auto& quadsRender = m_UIScene->m_entities.get<Render>(m_quads);
-	quadsRender.geometry->overrideDrawCount(m_currentQuadCount * 6);
+	ResourceRegistry::get(quadsRender.geometry)->overrideDrawCount(m_currentQuadCount * 6);
 
 	// Send circle vertices to the SSBO
 	m_circlesSSBO->edit(0, sizeof(CircleVertex) * m_currentCircleCount * 4, m_circleVertices.data());
 	// Set circle draw count
 	auto& circlesRender = m_UIScene->m_entities.get<Render>(m_circles);
-	circlesRender.geometry->overrideDrawCount(m_currentCircleCount * 6);
+	ResourceRegistry::get(circlesRender.geometry)->overrideDrawCount(m_currentCircleCount * 6);
 }
 
 void UI::drawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& colour)
@@ -6,19 +6,18 @@ struct directionalLight
 	vec3 direction;
 };
 
+// Point and spot lights are packed for std430 storage buffers, see GPUPointLight and GPUSpotLight
 struct pointLight
 {
-	vec3 colour;
-	vec3 position;
-	vec3 constants;
+	vec4 positionRange;
+	vec4 colour;
+	vec4 constants;
 };
 
 struct spotLight
 {
-	vec3 colour;
-	vec3 position;
-	vec3 direction;
-	vec3 constants;
-	float cutOff;
-	float outerCutOff;
+	vec4 positionRange;
+	vec4 colour;
+	vec4 directionCutOff;
+	vec4 constantsOuterCutOff;
 };
\ No newline at end of file
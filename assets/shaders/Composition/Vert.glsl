@@ -11,10 +11,10 @@ layout (std140, binding = 2) uniform b_camera2D
 	uniform mat4 u_projection;
 };
 
-uniform mat4 u_model;
+uniform mat3x4 u_model; // Rows of the affine model matrix
 
 void main()
 {
 	texCoord = a_texCoord;
-	gl_Position =  u_projection * u_view * u_model * vec4(a_vertexPosition,1.0);
+	gl_Position =  u_projection * u_view * vec4(vec4(a_vertexPosition,1.0) * u_model, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#version 460 core
+
+// Builds the view space bounds of every cluster. Dispatched once per projection with one
+// workgroup per cluster (gridX, gridY, gridZ), see ClusteredLighting::init.
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+struct ClusterAABB
+{
+	vec4 minPoint;
+	vec4 maxPoint;
+};
+
+layout(std430, binding = 6) writeonly buffer b_clusterAABBs
+{
+	ClusterAABB clusters[];
+};
+
+uniform mat4 u_inverseProjection;
+uniform vec2 u_screenSize;
+uniform vec2 u_tileSize;
+uniform float u_zNear;
+uniform float u_zFar;
+
+// Screen position (pixels) on the near plane to view space
+vec3 screenToView(vec2 screen)
+{
+	vec2 ndc = (screen / u_screenSize) * 2.0 - 1.0;
+	vec4 view = u_inverseProjection * vec4(ndc, -1.0, 1.0);
+	return view.xyz / view.w;
+}
+
+// Point where the ray from the eye through point crosses the plane z = zPlane
+vec3 intersectZPlane(vec3 point, float zPlane)
+{
+	return point * (zPlane / point.z);
+}
+
+void main()
+{
+	uvec3 gridSize = gl_NumWorkGroups;
+	uvec3 cluster = gl_WorkGroupID;
+	uint clusterIndex = cluster.x + gridSize.x * (cluster.y + gridSize.y * cluster.z);
+
+	vec3 minView = screenToView(vec2(cluster.xy) * u_tileSize);
+	vec3 maxView = screenToView(vec2(cluster.xy + 1) * u_tileSize);
+
+	// Exponential slicing gives clusters of similar proportions at all depths
+	float sliceNear = -u_zNear * pow(u_zFar / u_zNear, float(cluster.z) / float(gridSize.z));
+	float sliceFar = -u_zNear * pow(u_zFar / u_zNear, float(cluster.z + 1) / float(gridSize.z));
+
+	vec3 minNear = intersectZPlane(minView, sliceNear);
+	vec3 minFar = intersectZPlane(minView, sliceFar);
+	vec3 maxNear = intersectZPlane(maxView, sliceNear);
+	vec3 maxFar = intersectZPlane(maxView, sliceFar);
+
+	clusters[clusterIndex].minPoint = vec4(min(min(minNear, minFar), min(maxNear, maxFar)), 0.0);
+	clusters[clusterIndex].maxPoint = vec4(max(max(minNear, minFar), max(maxNear, maxFar)), 0.0);
+}
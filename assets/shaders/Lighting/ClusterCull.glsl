@@ -0,0 +1,155 @@
+#version 460 core
+
+// Bins point and spot lights into clusters. One invocation per cluster, lights are streamed
+// through shared memory a workgroup sized batch at a time. Must match ClusterConsts.
+
+layout(local_size_x = 128) in;
+
+const uint clusterCount = 16 * 9 * 24;
+const uint maxLightsPerCluster = 256;
+
+struct PointLight
+{
+	vec4 positionRange;
+	vec4 colour;
+	vec4 constants;
+};
+
+struct SpotLight
+{
+	vec4 positionRange;
+	vec4 colour;
+	vec4 directionCutOff;
+	vec4 constantsOuterCutOff;
+};
+
+struct ClusterAABB
+{
+	vec4 minPoint;
+	vec4 maxPoint;
+};
+
+layout(std430, binding = 4) readonly buffer b_pointLights
+{
+	PointLight pointLights[];
+};
+
+layout(std430, binding = 5) readonly buffer b_spotLights
+{
+	SpotLight spotLights[];
+};
+
+layout(std430, binding = 6) readonly buffer b_clusterAABBs
+{
+	ClusterAABB clusters[];
+};
+
+layout(std430, binding = 7) writeonly buffer b_lightGrid
+{
+	uvec4 lightGrid[]; // offset, point count, spot count, unused
+};
+
+layout(std430, binding = 8) writeonly buffer b_lightIndices
+{
+	uint lightIndices[];
+};
+
+layout(std430, binding = 9) buffer b_indexCounter
+{
+	uint indexCount;
+};
+
+uniform mat4 u_view;
+uniform int u_pointLightCount;
+uniform int u_spotLightCount;
+uniform int u_indexCapacity;
+
+shared vec4 s_lights[gl_WorkGroupSize.x]; // View space position and range
+
+bool sphereIntersectsAABB(vec4 sphere, ClusterAABB box)
+{
+	vec3 closest = clamp(sphere.xyz, box.minPoint.xyz, box.maxPoint.xyz);
+	vec3 d = closest - sphere.xyz;
+	return dot(d, d) <= sphere.w * sphere.w;
+}
+
+void main()
+{
+	uint clusterIndex = gl_GlobalInvocationID.x;
+	bool active = clusterIndex < clusterCount;
+	ClusterAABB box = clusters[min(clusterIndex, clusterCount - 1)];
+
+	uint visible[maxLightsPerCluster];
+	uint pointCount = 0;
+	uint spotCount = 0;
+
+	// Point lights
+	uint lightCount = uint(u_pointLightCount);
+	for (uint batch = 0; batch < lightCount; batch += gl_WorkGroupSize.x)
+	{
+		uint lightIndex = batch + gl_LocalInvocationIndex;
+		if (lightIndex < lightCount)
+		{
+			vec4 light = pointLights[lightIndex].positionRange;
+			s_lights[gl_LocalInvocationIndex] = vec4((u_view * vec4(light.xyz, 1.0)).xyz, light.w);
+		}
+		barrier();
+
+		uint batchSize = min(gl_WorkGroupSize.x, lightCount - batch);
+		for (uint i = 0; i < batchSize; i++)
+		{
+			if (active && pointCount < maxLightsPerCluster && sphereIntersectsAABB(s_lights[i], box))
+			{
+				visible[pointCount] = batch + i;
+				pointCount++;
+			}
+		}
+		barrier();
+	}
+
+	// Spot lights, bounded conservatively by a sphere of their range
+	lightCount = uint(u_spotLightCount);
+	for (uint batch = 0; batch < lightCount; batch += gl_WorkGroupSize.x)
+	{
+		uint lightIndex = batch + gl_LocalInvocationIndex;
+		if (lightIndex < lightCount)
+		{
+			vec4 light = spotLights[lightIndex].positionRange;
+			s_lights[gl_LocalInvocationIndex] = vec4((u_view * vec4(light.xyz, 1.0)).xyz, light.w);
+		}
+		barrier();
+
+		uint batchSize = min(gl_WorkGroupSize.x, lightCount - batch);
+		for (uint i = 0; i < batchSize; i++)
+		{
+			if (active && pointCount + spotCount < maxLightsPerCluster && sphereIntersectsAABB(s_lights[i], box))
+			{
+				visible[pointCount + spotCount] = batch + i;
+				spotCount++;
+			}
+		}
+		barrier();
+	}
+
+	if (!active) return;
+
+	uint total = pointCount + spotCount;
+	uint offset = atomicAdd(indexCount, total);
+
+	// Drop lights rather than write past the end of the index list
+	uint capacity = uint(u_indexCapacity);
+	uint available = offset < capacity ? capacity - offset : 0;
+	if (total > available)
+	{
+		spotCount = min(spotCount, available - min(pointCount, available));
+		pointCount = min(pointCount, available);
+		total = pointCount + spotCount;
+	}
+
+	for (uint i = 0; i < total; i++)
+	{
+		lightIndices[offset + i] = visible[i];
+	}
+
+	lightGrid[clusterIndex] = uvec4(offset, pointCount, spotCount, 0);
+}
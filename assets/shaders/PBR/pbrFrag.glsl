@@ -8,30 +8,22 @@ struct directionalLight
 
 struct pointLight
 {
-    vec3 colour;
-    vec3 position;
-    vec3 constants;
+    vec4 positionRange;
+    vec4 colour;
+    vec4 constants;
 };
 
 struct spotLight
 {
-    vec3 colour;
-    vec3 position;
-    vec3 direction;
-    vec3 constants;
-    float cutOff;
-    float outerCutOff;
-}; 
-
-
-const int numPointLights = 2;
-const int numSpotLights = 2;
+    vec4 positionRange;
+    vec4 colour;
+    vec4 directionCutOff;
+    vec4 constantsOuterCutOff;
+};
 
 layout (std140, binding = 1) uniform b_lights
 {
     uniform directionalLight dLight;
-    uniform pointLight pLights[numPointLights];
-    uniform spotLight sLights[numSpotLights];
 };
 
 layout (std140, binding = 0) uniform b_camera
@@ -41,6 +33,18 @@ layout (std140, binding = 0) uniform b_camera
     uniform vec3 u_viewPos;
 };
 
+// Clustered lighting, see ClusteredLighting
+layout (std140, binding = 4) uniform b_clusters
+{
+    uniform vec4 u_clusterGrid;  // Grid dimensions in xyz
+    uniform vec4 u_clusterDepth; // Tile size in pixels in xy, depth slice scale and bias in zw
+};
+
+layout(std430, binding = 4) readonly buffer b_pointLights { pointLight pointLights[]; };
+layout(std430, binding = 5) readonly buffer b_spotLights { spotLight spotLights[]; };
+layout(std430, binding = 7) readonly buffer b_lightGrid { uvec4 lightGrid[]; };
+layout(std430, binding = 8) readonly buffer b_lightIndices { uint lightIndices[]; };
+
 
 ///////////////////////// INS OUTS
 out vec4 FragColour;
@@ -71,6 +75,9 @@ vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0);
 float GeometrySchlickGGX(float NdotV);
 float DistributionGGX();
 float GeometrySmith();
+vec3 cookTorrance(vec3 N, vec3 V, vec3 L, vec3 radiance, vec3 alb, vec3 F0);
+uvec4 getClusterLights();
+float getAttenuation(vec3 constants, float distance);
 
 
 ///////////////////////// Globals
@@ -102,38 +109,90 @@ void main()
 
 
     vec3 V = normalize(u_viewPos - posInWS);    // View Direction
-    vec3 L = normalize(-dLight.direction);      // Light Direction
-    vec3 H = normalize(L + V);                // Half-way vector
+    NdotV = max(dot(N, V), 0.0);
+
+    // Directional light
+    vec3 Lo = cookTorrance(N, V, normalize(-dLight.direction), dLight.colour, alb, F0);
+
+    // Only the point and spot lights binned into this fragment's cluster
+    uvec4 cluster = getClusterLights();
+    uint offset = cluster.x;
+
+    for (uint i = 0; i < cluster.y; i++)
+    {
+        pointLight light = pointLights[lightIndices[offset + i]];
+        vec3 toLight = light.positionRange.xyz - posInWS;
+        float distance = length(toLight);
+        if (distance > light.positionRange.w) continue;
+
+        vec3 radiance = light.colour.rgb * getAttenuation(light.constants.xyz, distance);
+        Lo += cookTorrance(N, V, toLight / distance, radiance, alb, F0);
+    }
+
+    offset += cluster.y;
+    for (uint i = 0; i < cluster.z; i++)
+    {
+        spotLight light = spotLights[lightIndices[offset + i]];
+        vec3 toLight = light.positionRange.xyz - posInWS;
+        float distance = length(toLight);
+        if (distance > light.positionRange.w) continue;
+
+        vec3 L = toLight / distance;
+        float theta = dot(-L, light.directionCutOff.xyz);
+        float epsilon = light.directionCutOff.w - light.constantsOuterCutOff.w;
+        float intensity = clamp((theta - light.constantsOuterCutOff.w) / epsilon, 0.0, 1.0);
+
+        vec3 radiance = light.colour.rgb * getAttenuation(light.constantsOuterCutOff.xyz, distance) * intensity;
+        Lo += cookTorrance(N, V, L, radiance, alb, F0);
+    }
+
+    vec3 ambient = vec3(0.03) * alb * AO;
+    
+    vec3 color = ambient + Lo;
+
+    FragColour = vec4(color, 1.0);
+}
+
 
-      
+
+vec3 cookTorrance(vec3 N, vec3 V, vec3 L, vec3 radiance, vec3 alb, vec3 F0)
+{
+    vec3 H = normalize(L + V);                // Half-way vector
 
     NdotL = max(dot(N, L), 0.0);              // cache these calculations
-    NdotV = max(dot(N, V), 0.0);
     NdotH = max(dot(N, H), 0.0);
 
-
-    /////////////////////
-    // Cook-Torrance BRDF
     float D = DistributionGGX();   
     float G = GeometrySchlickGGX(NdotV) * GeometrySchlickGGX(NdotL) ; 
     vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
            
     vec3 numerator    = D * G * F; 
-    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001; // + 0.0001 to prevent divide by zero
+    float denominator = 4.0 * NdotV * NdotL + 0.0001; // + 0.0001 to prevent divide by zero
     vec3 specular = numerator / denominator;
         
     // kS is equal to Fresnel
     vec3 kS = F;
     vec3 kD = vec3(1.0) - kS;
     kD *= 1.0 - metal;	  
-    vec3 Lo = (kD * alb / PI + specular) * NdotL;  
-    vec3 ambient = vec3(0.03) * alb * AO;
-    
-    vec3 color = ambient + Lo;
+    return (kD * alb / PI + specular) * radiance * NdotL;  
+}
 
-    FragColour = vec4(color, 1.0);
+float getAttenuation(vec3 constants, float distance)
+{
+    return 1.0 / (constants.x + constants.y * distance + constants.z * (distance * distance));
 }
 
+uvec4 getClusterLights()
+{
+    if (u_clusterGrid.x == 0.0) return uvec4(0); // Clustering has not been set up for this pass
+
+    float viewDepth = -(u_view * vec4(posInWS, 1.0)).z;
+    uint slice = uint(clamp(log(viewDepth) * u_clusterDepth.z - u_clusterDepth.w, 0.0, u_clusterGrid.z - 1.0));
+    uvec2 tile = uvec2(min(gl_FragCoord.xy / u_clusterDepth.xy, u_clusterGrid.xy - 1.0));
+    uint clusterIndex = tile.x + uint(u_clusterGrid.x) * (tile.y + uint(u_clusterGrid.y) * slice);
+
+    return lightGrid[clusterIndex];
+}
 
 float DistributionGGX()
 {
@@ -16,16 +16,16 @@ layout (std140, binding = 0) uniform b_camera
 	uniform vec3 u_viewPos;
 };
 
-uniform mat4 u_model;
+uniform mat3x4 u_model; // Rows of the affine model matrix
 
 
 void main()
 {  
-    posInWS = (u_model*vec4(aPos,1.0)).xyz; 
+    posInWS = vec4(aPos,1.0)*u_model; 
     gl_Position = u_projection*u_view*vec4(posInWS,1.0);
     UV = aUV ;
-    norm = (u_model*vec4(aNorm,0.0)).xyz;
-    vec3 T = (u_model * vec4(aTan, 0.0)).xyz;
+    norm = vec4(aNorm,0.0)*u_model;
+    vec3 T = vec4(aTan, 0.0) * u_model;
     vec3 B = cross(norm, T);
     B = normalize(B);
     TBN = mat3(T, B, norm);
@@ -0,0 +1,70 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNorm;
+layout (location = 2) in vec2 aUV;
+layout(location = 3) in vec3 aTan;
+
+out vec2 UV ;
+out vec3 norm;
+out vec3 posInWS ;
+out mat3 TBN;
+
+layout (std140, binding = 0) uniform b_camera
+{
+	uniform mat4 u_view;
+	uniform mat4 u_projection;
+	uniform vec3 u_viewPos;
+};
+
+// Matches GPUAnalyticInstance in analyticAnimation.hpp
+struct AnalyticInstance
+{
+	vec4 initialRotation; // Quaternion xyzw
+	vec4 axisRate; // Unit axis, radians per second in w
+	vec4 translation;
+	vec4 scale;
+};
+
+layout(std430, binding = 3) readonly buffer b_analyticInstances
+{
+	AnalyticInstance instances[];
+};
+
+uniform int u_instance; // Instance being drawn
+uniform float u_time; // Seconds since the animation started
+
+vec4 quatMul(vec4 a, vec4 b)
+{
+	return vec4(a.w * b.xyz + b.w * a.xyz + cross(a.xyz, b.xyz), a.w * b.w - dot(a.xyz, b.xyz));
+}
+
+// Same expansion as TransformSystem::compose, without the scale
+mat3 quatToMat3(vec4 q)
+{
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+	return mat3(
+		1.0 - 2.0 * (yy + zz), 2.0 * (xy + wz), 2.0 * (xz - wy),
+		2.0 * (xy - wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz + wx),
+		2.0 * (xz + wy), 2.0 * (yz - wx), 1.0 - 2.0 * (xx + yy));
+}
+
+void main()
+{  
+    AnalyticInstance inst = instances[u_instance];
+    float halfAngle = 0.5 * inst.axisRate.w * u_time;
+    vec4 delta = vec4(inst.axisRate.xyz * sin(halfAngle), cos(halfAngle));
+    mat3 rotation = quatToMat3(quatMul(inst.initialRotation, delta));
+    mat3 model = mat3(rotation[0] * inst.scale.x, rotation[1] * inst.scale.y, rotation[2] * inst.scale.z);
+
+    posInWS = model * aPos + inst.translation.xyz; 
+    gl_Position = u_projection*u_view*vec4(posInWS,1.0);
+    UV = aUV ;
+    norm = model * aNorm;
+    vec3 T = model * aTan;
+    vec3 B = cross(norm, T);
+    B = normalize(B);
+    TBN = mat3(T, B, norm);
+   
+}
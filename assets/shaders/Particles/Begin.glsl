@@ -0,0 +1,39 @@
+#version 460 core
+
+// Start of a particle frame. Promotes last frame's surviving list to the current list,
+// clamps emission to the free slots and writes the emit and simulate dispatch sizes.
+
+layout(local_size_x = 1) in;
+
+layout(std430, binding = 14) buffer b_particleCounters
+{
+	uint deadCount;
+	uint aliveCount;
+	uint aliveNextCount;
+	uint emitCount;
+};
+
+layout(std430, binding = 15) writeonly buffer b_particleIndirect
+{
+	uint indirectArgs[]; // emit dispatch xyz, simulate dispatch xyz, draw count, instances, first, base instance
+};
+
+uniform int u_requestedEmitCount;
+
+const uint groupSize = 256;
+
+void main()
+{
+	aliveCount = aliveNextCount;
+	aliveNextCount = 0;
+	emitCount = min(uint(u_requestedEmitCount), deadCount);
+
+	indirectArgs[0] = (emitCount + groupSize - 1) / groupSize;
+	indirectArgs[1] = 1;
+	indirectArgs[2] = 1;
+
+	// Newly emitted particles are simulated in the same frame
+	indirectArgs[3] = (aliveCount + emitCount + groupSize - 1) / groupSize;
+	indirectArgs[4] = 1;
+	indirectArgs[5] = 1;
+}
@@ -0,0 +1,87 @@
+#version 460 core
+
+// Spawns particles. Each emitter owns a contiguous range of invocations, a free slot is
+// popped from the dead list and appended to the current alive list.
+
+layout(local_size_x = 256) in;
+
+struct Particle
+{
+	vec4 positionLife;    // position in xyz, remaining life in w
+	vec4 velocityMaxLife; // velocity in xyz, lifetime in w
+	vec4 colour;
+	vec4 sizeDrag;        // start size, end size, drag, unused
+};
+
+struct Emitter
+{
+	vec4 positionSpread;
+	vec4 velocitySpread;
+	vec4 colour;
+	vec4 lifeSize;        // min life, max life, start size, end size
+	vec4 drag;
+	uvec4 range;          // first emit index, count
+};
+
+layout(std430, binding = 10) writeonly buffer b_particles { Particle particles[]; };
+layout(std430, binding = 11) readonly buffer b_deadList { uint deadList[]; };
+layout(std430, binding = 12) writeonly buffer b_aliveList { uint aliveList[]; };
+layout(std430, binding = 14) buffer b_particleCounters
+{
+	uint deadCount;
+	uint aliveCount;
+	uint aliveNextCount;
+	uint emitCount;
+};
+layout(std430, binding = 2) readonly buffer b_emitters { Emitter emitters[]; };
+
+uniform int u_emitterCount;
+uniform int u_seed;
+
+uint pcgHash(uint v)
+{
+	uint state = v * 747796405u + 2891336453u;
+	uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+float random(inout uint state)
+{
+	state = pcgHash(state);
+	return float(state) / 4294967295.0;
+}
+
+vec3 randomInSphere(inout uint state)
+{
+	float z = random(state) * 2.0 - 1.0;
+	float theta = random(state) * 6.28318530718;
+	float r = sqrt(max(1.0 - z * z, 0.0));
+	return vec3(r * cos(theta), r * sin(theta), z) * pow(random(state), 1.0 / 3.0);
+}
+
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= emitCount) return;
+
+	Emitter emitter = emitters[0];
+	for (int i = 0; i < u_emitterCount; i++)
+	{
+		emitter = emitters[i];
+		if (id < emitter.range.x + emitter.range.y) break;
+	}
+
+	uint state = pcgHash(id ^ pcgHash(uint(u_seed)));
+
+	Particle p;
+	float life = mix(emitter.lifeSize.x, emitter.lifeSize.y, random(state));
+	p.positionLife = vec4(emitter.positionSpread.xyz + randomInSphere(state) * emitter.positionSpread.w, life);
+	p.velocityMaxLife = vec4(emitter.velocitySpread.xyz + randomInSphere(state) * emitter.velocitySpread.w, life);
+	p.colour = emitter.colour;
+	p.sizeDrag = vec4(emitter.lifeSize.zw, emitter.drag.x, 0.0);
+
+	// emitCount never exceeds deadCount so the pop cannot underflow
+	uint particleIndex = deadList[atomicAdd(deadCount, 0xFFFFFFFFu) - 1u];
+	particles[particleIndex] = p;
+	aliveList[atomicAdd(aliveCount, 1u)] = particleIndex;
+}
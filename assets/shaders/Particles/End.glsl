@@ -0,0 +1,26 @@
+#version 460 core
+
+// Writes the billboard draw from the number of surviving particles, six vertices each.
+
+layout(local_size_x = 1) in;
+
+layout(std430, binding = 14) readonly buffer b_particleCounters
+{
+	uint deadCount;
+	uint aliveCount;
+	uint aliveNextCount;
+	uint emitCount;
+};
+
+layout(std430, binding = 15) writeonly buffer b_particleIndirect
+{
+	uint indirectArgs[];
+};
+
+void main()
+{
+	indirectArgs[6] = aliveNextCount * 6;
+	indirectArgs[7] = 1;
+	indirectArgs[8] = 0;
+	indirectArgs[9] = 0;
+}
@@ -0,0 +1,15 @@
+#version 460 core
+
+layout(location = 0) out vec4 fragColour;
+
+in vec2 corner;
+in vec4 colour;
+
+void main()
+{
+	float falloff = 1.0 - smoothstep(0.25, 1.0, length(corner));
+	if (falloff <= 0.0) discard;
+
+	// Additive blending, premultiply by alpha
+	fragColour = vec4(colour.rgb * colour.a * falloff, 1.0);
+}
@@ -0,0 +1,85 @@
+#version 460 core
+
+// Integrates the current alive list. Survivors are compacted into the next alive list and
+// expired particles return to the dead list. Appends are aggregated per workgroup so only
+// one global atomic per list is issued for each group.
+
+layout(local_size_x = 256) in;
+
+struct Particle
+{
+	vec4 positionLife;
+	vec4 velocityMaxLife;
+	vec4 colour;
+	vec4 sizeDrag;
+};
+
+layout(std430, binding = 10) buffer b_particles { Particle particles[]; };
+layout(std430, binding = 11) writeonly buffer b_deadList { uint deadList[]; };
+layout(std430, binding = 12) readonly buffer b_aliveList { uint aliveList[]; };
+layout(std430, binding = 13) writeonly buffer b_aliveNextList { uint aliveNextList[]; };
+layout(std430, binding = 14) buffer b_particleCounters
+{
+	uint deadCount;
+	uint aliveCount;
+	uint aliveNextCount;
+	uint emitCount;
+};
+
+uniform float u_timestep;
+
+shared uint s_aliveCount;
+shared uint s_deadCount;
+shared uint s_aliveBase;
+shared uint s_deadBase;
+
+void main()
+{
+	if (gl_LocalInvocationIndex == 0)
+	{
+		s_aliveCount = 0;
+		s_deadCount = 0;
+	}
+	barrier();
+
+	uint id = gl_GlobalInvocationID.x;
+	bool valid = id < aliveCount;
+	bool alive = false;
+	uint particleIndex = 0;
+	uint localSlot = 0;
+
+	if (valid)
+	{
+		particleIndex = aliveList[id];
+		Particle p = particles[particleIndex];
+
+		p.positionLife.w -= u_timestep;
+		alive = p.positionLife.w > 0.0;
+
+		if (alive)
+		{
+			p.velocityMaxLife.xyz *= max(1.0 - p.sizeDrag.z * u_timestep, 0.0);
+			p.positionLife.xyz += p.velocityMaxLife.xyz * u_timestep;
+			particles[particleIndex] = p;
+			localSlot = atomicAdd(s_aliveCount, 1u);
+		}
+		else
+		{
+			localSlot = atomicAdd(s_deadCount, 1u);
+		}
+	}
+	barrier();
+
+	if (gl_LocalInvocationIndex == 0)
+	{
+		s_aliveBase = atomicAdd(aliveNextCount, s_aliveCount);
+		s_deadBase = atomicAdd(deadCount, s_deadCount);
+	}
+	barrier();
+
+	if (valid)
+	{
+		if (alive) aliveNextList[s_aliveBase + localSlot] = particleIndex;
+		else deadList[s_deadBase + localSlot] = particleIndex;
+	}
+}
@@ -0,0 +1,42 @@
+#version 460 core
+
+// Camera facing billboards pulled from the particle pool, six vertices per alive particle.
+
+struct Particle
+{
+	vec4 positionLife;
+	vec4 velocityMaxLife;
+	vec4 colour;
+	vec4 sizeDrag;
+};
+
+layout(std430, binding = 10) readonly buffer b_particles { Particle particles[]; };
+layout(std430, binding = 12) readonly buffer b_aliveList { uint aliveList[]; };
+
+layout (std140, binding = 0) uniform b_camera
+{
+	uniform mat4 u_view;
+	uniform mat4 u_projection;
+	uniform vec3 u_viewPos;
+};
+
+out vec2 corner;
+out vec4 colour;
+
+const vec2 corners[6] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0), vec2(-1.0, -1.0));
+
+void main()
+{
+	Particle p = particles[aliveList[gl_VertexID / 6]];
+	corner = corners[gl_VertexID % 6];
+
+	float age = 1.0 - p.positionLife.w / p.velocityMaxLife.w;
+	float size = mix(p.sizeDrag.x, p.sizeDrag.y, age);
+
+	vec3 right = vec3(u_view[0][0], u_view[1][0], u_view[2][0]);
+	vec3 up = vec3(u_view[0][1], u_view[1][1], u_view[2][1]);
+	vec3 position = p.positionLife.xyz + (right * corner.x + up * corner.y) * size;
+
+	colour = vec4(p.colour.rgb, p.colour.a * (1.0 - age));
+	gl_Position = u_projection * u_view * vec4(position, 1.0);
+}
@@ -15,29 +15,22 @@ struct directionalLight
 
 struct pointLight
 {
-	vec3 colour;
-	vec3 position;
-	vec3 constants;
+	vec4 positionRange;
+	vec4 colour;
+	vec4 constants;
 };
 
 struct spotLight
 {
-	vec3 colour;
-	vec3 position;
-	vec3 direction;
-	vec3 constants;
-	float cutOff;
-	float outerCutOff;
+	vec4 positionRange;
+	vec4 colour;
+	vec4 directionCutOff;
+	vec4 constantsOuterCutOff;
 };
 
-const int numPointLights = 1;
-const int numSpotLights = 1;
-
 layout (std140, binding = 1) uniform b_lights
 {
 	uniform directionalLight dLight;
-	uniform pointLight pLights[numPointLights];
-	uniform spotLight sLights[numSpotLights];
 };
 
 layout (std140, binding = 0) uniform b_camera
@@ -47,6 +40,18 @@ layout (std140, binding = 0) uniform b_camera
 	uniform vec3 u_viewPos;
 };
 
+// Clustered lighting, see ClusteredLighting
+layout (std140, binding = 4) uniform b_clusters
+{
+	uniform vec4 u_clusterGrid;  // Grid dimensions in xyz
+	uniform vec4 u_clusterDepth; // Tile size in pixels in xy, depth slice scale and bias in zw
+};
+
+layout(std430, binding = 4) readonly buffer b_pointLights { pointLight pointLights[]; };
+layout(std430, binding = 5) readonly buffer b_spotLights { spotLight spotLights[]; };
+layout(std430, binding = 7) readonly buffer b_lightGrid { uvec4 lightGrid[]; };
+layout(std430, binding = 8) readonly buffer b_lightIndices { uint lightIndices[]; };
+
 uniform vec3 u_albedo;
 uniform vec4 u_emissive;
 uniform sampler2D u_albedoMap;
@@ -65,12 +70,77 @@ vec3 getDirectionalLight()
 	return ambient * (diffuse + specular);
 }
 
+vec3 getPhong(vec3 lightDir, vec3 lightColour)
+{
+	float diff = max(dot(normal, lightDir), 0.0);
+	vec3 diffuse = diff * lightColour;
+	float specularStrength = 0.8;
+	vec3 viewDir = normalize(u_viewPos - fragmentPos);
+	vec3 reflectDir = reflect(-lightDir, normal);
+	float spec = pow(max(dot(viewDir, reflectDir), 0.0), 64);
+	vec3 specular = specularStrength * spec * lightColour;
+	return diffuse + specular;
+}
+
+float getAttenuation(vec3 constants, float distance)
+{
+	return 1.0 / (constants.x + constants.y * distance + constants.z * (distance * distance));
+}
+
+uvec4 getClusterLights()
+{
+	if (u_clusterGrid.x == 0.0) return uvec4(0); // Clustering has not been set up for this pass
+
+	float viewDepth = -(u_view * vec4(fragmentPos, 1.0)).z;
+	uint slice = uint(clamp(log(viewDepth) * u_clusterDepth.z - u_clusterDepth.w, 0.0, u_clusterGrid.z - 1.0));
+	uvec2 tile = uvec2(min(gl_FragCoord.xy / u_clusterDepth.xy, u_clusterGrid.xy - 1.0));
+	uint clusterIndex = tile.x + uint(u_clusterGrid.x) * (tile.y + uint(u_clusterGrid.y) * slice);
+
+	return lightGrid[clusterIndex];
+}
+
+// Point and spot lights binned into this fragment's cluster
+vec3 getClusteredLights()
+{
+	vec3 result = vec3(0.0);
+	uvec4 cluster = getClusterLights();
+	uint offset = cluster.x;
+
+	for (uint i = 0; i < cluster.y; i++)
+	{
+		pointLight light = pointLights[lightIndices[offset + i]];
+		vec3 toLight = light.positionRange.xyz - fragmentPos;
+		float distance = length(toLight);
+		if (distance > light.positionRange.w) continue;
+
+		result += getPhong(toLight / distance, light.colour.rgb) * getAttenuation(light.constants.xyz, distance);
+	}
+
+	offset += cluster.y;
+	for (uint i = 0; i < cluster.z; i++)
+	{
+		spotLight light = spotLights[lightIndices[offset + i]];
+		vec3 toLight = light.positionRange.xyz - fragmentPos;
+		float distance = length(toLight);
+		if (distance > light.positionRange.w) continue;
+
+		vec3 lightDir = toLight / distance;
+		float theta = dot(-lightDir, light.directionCutOff.xyz);
+		float epsilon = light.directionCutOff.w - light.constantsOuterCutOff.w;
+		float intensity = clamp((theta - light.constantsOuterCutOff.w) / epsilon, 0.0, 1.0);
+
+		result += getPhong(lightDir, light.colour.rgb) * getAttenuation(light.constantsOuterCutOff.xyz, distance) * intensity;
+	}
+
+	return result;
+}
+
 void main()
 {   
 	vec3 emissive = u_emissive.rgb;
 	float strength = u_emissive.a;
 	
-	vec3 result = getDirectionalLight();
+	vec3 result = getDirectionalLight() + getClusteredLights();
 	
 	vec4 albedo = vec4(result * u_albedo, 1.0) * texture(u_albedoMap, texCoord);
 	colour = albedo + vec4(emissive, 1.0) * strength;
@@ -16,13 +16,14 @@ layout (std140, binding = 0) uniform b_camera
 	uniform vec3 u_viewPos;
 };
 
-uniform mat4 u_model;
+uniform mat3x4 u_model; // Rows of the affine model matrix
 uniform mat4 u_lightSpaceTranform;
 
 void main()
 {
-	fragmentPos = vec3(u_model * vec4(a_vertexPosition, 1.0));
-	normal = normalize(mat3(transpose(inverse(u_model))) * a_vertexNormal);
+	fragmentPos = vec4(a_vertexPosition, 1.0) * u_model;
+	mat3 model = transpose(mat3(u_model));
+	normal = normalize(transpose(inverse(model)) * a_vertexNormal);
 	fragmentPosLightSpace = u_lightSpaceTranform * vec4(fragmentPos, 1.0);
 	texCoord = a_texCoord;
 	gl_Position = u_projection * u_view * vec4(fragmentPos,1.0);
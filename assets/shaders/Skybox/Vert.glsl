@@ -8,7 +8,7 @@ layout (std140, binding = 0) uniform b_camera
 	uniform mat4 u_projection;
 };
 
-uniform mat4 u_model;
+uniform mat3x4 u_model; // Rows of the affine model matrix
 uniform mat4 u_skyboxView;
 
 out vec3 texCoords;
@@ -16,5 +16,5 @@ out vec3 texCoords;
 void main()
 {
 	texCoords = a_vertexPosition;
-	gl_Position = u_projection * u_skyboxView * u_model * vec4(a_vertexPosition,1.0);
+	gl_Position = u_projection * u_skyboxView * vec4(vec4(a_vertexPosition,1.0) * u_model, 1.0);
 }
\ No newline at end of file